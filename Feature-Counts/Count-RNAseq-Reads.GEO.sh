@@ -133,16 +133,18 @@ if [ ${EXIT_CODE} -eq 0 ]; then
 	COUNTS_FILE_EXT_NAME="txt"
 	COUNTS_FILE_NAME="${COUNTS_FILE_MAIN_NAME}.${COUNTS_FILE_EXT_NAME}"
 	COUNTS_FILE_PATH="${COUNTS_DIR}/${COUNTS_FILE_NAME}"
-	# Set the paramters for a four-step reads counting procedure.
+	# Set the paramters for a two-step reads counting procedure.
 	UMI_SAM_ALIGN_SUFFIX="umi.sam"
-	UMI_BAM_ALIGN_SUFFIX="$(basename "${UMI_SAM_ALIGN_SUFFIX}" | sed "s/sam/bam/g")"
 	FEATURE_ALIGN_SUFFIX="featureCounts.sam"
+	# The read-counts file of all aligned reads, whose gene annotations are
+	# copied into the read-counts file of unique UMI reads.
+	ANNOT_COUNTS_FILE_PATH="${COUNTS_DIR}/${COUNTS_FILE_MAIN_NAME}.annot.${COUNTS_FILE_EXT_NAME}"
 	if [ "${SEQ_METHOD}" == "conv" ]; then
 		REPORTS=(0)
 		ALIGN_SUFFIXES=("${ALIGN_FILE_SUFFIX}")
 	elif [ "${SEQ_METHOD}" == "dge" ]; then
-		REPORTS=(1 0)
-		ALIGN_SUFFIXES=("${ALIGN_FILE_SUFFIX}" "${UMI_BAM_ALIGN_SUFFIX}")
+		REPORTS=(1)
+		ALIGN_SUFFIXES=("${ALIGN_FILE_SUFFIX}")
 	else
 		echo "ERROR: The sequencing method must be one of: conv and dge (case insensitive)!" 1>&2
 	fi
@@ -157,9 +159,8 @@ if [ ${EXIT_CODE} -eq 0 ]; then
 		if [ ${EXIT_CODE} -eq 0 ]; then
 			N_ALIGN_FILES="${#ALIGN_FILES[@]}"
 			if [ ${N_ALIGN_FILES} -gt 0 ]; then
-				# Step 1: Count the aligned reads from the bam files (*.bam) generated by STAR.
-				# Step 4: Count the aligned reads with unique UMI taggs (*.umi.bam) in the BAM
-				#         format generated by SAM-Alignment-Counter and converted from samtools.
+				# Step 1: Count the aligned reads from the bam files (*.bam) generated by STAR,
+				#         with detailed alignment information of each read for DGE data.
 				echo "featureCounts is counting aligned reads ${ALIGN_SUFFIX} alignment files in ${ALIGN_DIR} ..."
 				featureCounts \
 					-a "${ANNOT_FILE}" \
@@ -173,10 +174,12 @@ if [ ${EXIT_CODE} -eq 0 ]; then
 				EXIT_CODE=$?
 				# Clean up the read-counts files as needed.
 				if [ ${EXIT_CODE} -eq 0 ]; then
-					if [ ${IDX} -eq 0 ] && [ ${N_REPEATS} -eq 2 ]; then
-						# Clean up the read-counts files generated from the bam files.
-						echo "Removing the read-counts file ..."
-						rm "${COUNTS_FILE_PATH}"
+					if [ ${REPORT} -eq 1 ]; then
+						# Keep the read-counts file generated from the bam files for
+						# its gene annotations.
+						echo "Moving the read-counts file to ${ANNOT_COUNTS_FILE_PATH} ..."
+						mv "${COUNTS_FILE_PATH}" "${ANNOT_COUNTS_FILE_PATH}"
+						EXIT_CODE=$?
 					fi
 					echo "Removing the read-counts summary file ..."
 					rm "${COUNTS_FILE_PATH}.summary"
@@ -186,8 +189,8 @@ if [ ${EXIT_CODE} -eq 0 ]; then
 				EXIT_CODE=1
 			fi
 		fi
-		# Between step 1 and 4, run the SAM-Alignment-Counter program to remove
-		# the sequence reads with duplicate UMI tags.
+		# After step 1, run the SAM-Alignment-Counter program to remove the
+		# sequence reads with duplicate UMI tags and count the unique UMI reads.
 		if [ ${EXIT_CODE} -eq 0 ] && [ ${REPORT} -eq 1 ]; then
 			# Move the featurecounts.sam files generated by the report mode of
 			# featureCounts with detailed alignment information from COUNTS_DIR
@@ -206,8 +209,9 @@ if [ ${EXIT_CODE} -eq 0 ]; then
 					EXIT_CODE=1
 				fi
 			fi
-			# Step 2: Remove the aligned reads containing duplicate UMI taggs and generate
-			# the sequence aligment files containing the reads with unique UMI tags.
+			# Step 2: Remove the aligned reads containing duplicate UMI taggs, generate
+			# the sequence aligment files containing the reads with unique UMI tags, and
+			# write the read-counts file of unique UMI reads of all the alignment files.
 			if [ ${EXIT_CODE} -eq 0 ]; then
 				# Retrieve the names of a set of sequence alignment files.
 				readarray -t -d $'\0' FEATURE_ALIGN_FILES < <(find -L "${ALIGN_DIR}" -maxdepth 1 -type f -name "*\.${FEATURE_ALIGN_SUFFIX}" -print0)
@@ -215,18 +219,21 @@ if [ ${EXIT_CODE} -eq 0 ]; then
 				if [ ${EXIT_CODE} -eq 0 ]; then
 					N_FEATURE_ALIGN_FILES="${#FEATURE_ALIGN_FILES[@]}"
 					if [ ${N_FEATURE_ALIGN_FILES} -gt 0 ]; then
-						# Run the SAM-Alignment-Counter program to generate the sequence reads
-						# with unique UMI tags for each sequemence aligment file.
-						for FEATURE_ALIGN_FILE in "${FEATURE_ALIGN_FILES[@]}"; do
-							UMI_ALIGN_FILE_NAME="$(basename "${FEATURE_ALIGN_FILE}" | sed "s/${ALIGN_FILE_SUFFIX}.${FEATURE_ALIGN_SUFFIX}$/${UMI_SAM_ALIGN_SUFFIX}/g")"
-							UMI_ALIGN_FILE="${ALIGN_DIR}/${UMI_ALIGN_FILE_NAME}"
-							echo "SAM-Alignment-Counter is counting unique UMI reads in ${FEATURE_ALIGN_FILE} ..."
-							SAM-Alignment-Counter "${FEATURE_ALIGN_FILE}" "${UMI_ALIGN_FILE}"
-							EXIT_CODE=$?
-						done
+						# Run the SAM-Alignment-Counter program in batch mode to generate the
+						# sequence reads with unique UMI tags for all sequemence aligment files
+						# concurrently, where * in the output naming rule is replaced by the
+						# part of each input file name matched by * in the input pattern, and
+						# the unique UMI reads of each gene are counted along the way.
+						FEATURE_ALIGN_PATTERN="${ALIGN_DIR}/*.${ALIGN_FILE_SUFFIX}.${FEATURE_ALIGN_SUFFIX}"
+						UMI_ALIGN_RULE="${ALIGN_DIR}/*.${UMI_SAM_ALIGN_SUFFIX}"
+						echo "SAM-Alignment-Counter is counting unique UMI reads in ${FEATURE_ALIGN_PATTERN} ..."
+						SAM-Alignment-Counter "${FEATURE_ALIGN_PATTERN}" "${UMI_ALIGN_RULE}" false false false true false true false true unix hash "${THREAD_NUMBER}" 0 0 1 "${COUNTS_FILE_PATH}" "${ANNOT_COUNTS_FILE_PATH}"
+						EXIT_CODE=$?
 						if [ ${EXIT_CODE} -eq 0 ]; then
 							echo "Removing the sequence aligment files generated by featureCounts ..."
 							rm "${FEATURE_ALIGN_FILES[@]}"
+							echo "Removing the read-counts file of all aligned reads ..."
+							rm "${ANNOT_COUNTS_FILE_PATH}"
 						fi
 					else
 						echo "ERROR: No ${FEATURE_ALIGN_SUFFIX} alignment file is found in ${ALIGN_DIR}!" 1>&2
@@ -234,32 +241,6 @@ if [ ${EXIT_CODE} -eq 0 ]; then
 					fi
 				fi
 			fi
-			# Step 3: Convert the sequence aligment files of unique UMI reads from SAM to BAM format.
-			if [ ${EXIT_CODE} -eq 0 ]; then
-				# Retrieve the names of a set of sequence alignment files.
-				readarray -t -d $'\0' UMI_SAM_ALIGN_FILES < <(find -L "${ALIGN_DIR}" -maxdepth 1 -type f -name "*\.${UMI_SAM_ALIGN_SUFFIX}" -print0)
-				EXIT_CODE=$?
-				if [ ${EXIT_CODE} -eq 0 ]; then
-					N_UMI_SAM_ALIGN_FILES="${#UMI_SAM_ALIGN_FILES[@]}"
-					if [ ${N_UMI_SAM_ALIGN_FILES} -gt 0 ]; then
-						# Use Samtools to convert sequence aligment files from SAM to BAM format.
-						for UMI_SAM_ALIGN_FILE in "${UMI_SAM_ALIGN_FILES[@]}"; do
-							UMI_BAM_ALIGN_FILE_NAME="$(basename "${UMI_SAM_ALIGN_FILE}" | sed "s/${UMI_SAM_ALIGN_SUFFIX}$/${UMI_BAM_ALIGN_SUFFIX}/g")"
-							UMI_BAM_ALIGN_FILE="${ALIGN_DIR}/${UMI_BAM_ALIGN_FILE_NAME}"
-							echo "samtools is converting ${UMI_SAM_ALIGN_FILE} to BAM format ..."
-							samtools view -b "${UMI_SAM_ALIGN_FILE}" > "${UMI_BAM_ALIGN_FILE}"
-							EXIT_CODE=$?
-						done
-						if [ ${EXIT_CODE} -eq 0 ]; then
-							echo "Removing the unique UMI aligment files in SAM format ..."
-							rm "${UMI_SAM_ALIGN_FILES[@]}"
-						fi
-					else
-						echo "ERROR: No ${UMI_SAM_ALIGN_SUFFIX} alignment file is found in ${ALIGN_DIR}!" 1>&2
-						EXIT_CODE=1
-					fi
-				fi
-			fi
 		fi
 		# Quit if error occurs.
 		if [ ${EXIT_CODE} -ne 0 ]; then
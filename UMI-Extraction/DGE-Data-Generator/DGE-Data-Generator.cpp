@@ -0,0 +1,65 @@
+//
+//  DGE-Data-Generator.cpp
+//  DGE-Data-Generator
+//
+//  Created on 10/18/26.
+//
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <cstdlib>
+#include <DGEDataGenerator.hpp>
+#include <DGEDataGeneratorArguments.hpp>
+
+int main(int argc, const char *argv[])
+{
+    int exit_code = EXIT_SUCCESS;
+
+    try
+    {
+        // Retrieve input arguments from command line.
+        DGEDataGeneratorArguments args(argc, argv);
+        // Check input arguments.
+        args.check();
+
+        bool generate_sam = args.output_type != "fastq";
+        bool generate_fastq = args.output_type != "sam";
+        DGEDataGenerator generator(args.params, generate_sam, generate_fastq);
+
+        // Write the well barcode table for demultiplexing the FASTQ files.
+        if(generate_fastq)
+        {
+            std::string well_barcode_file_path = args.output_prefix + "_Well_Barcodes.tsv";
+            std::ofstream well_barcode_file(well_barcode_file_path, std::ios::binary | std::ios::trunc);
+            if(!well_barcode_file.is_open()) throw std::runtime_error("Cannot open output file " + well_barcode_file_path + '!');
+            well_barcode_file << generator.getWellBarcodeTable();
+            well_barcode_file.close();
+            if(!well_barcode_file) throw std::runtime_error("Failed to write output file " + well_barcode_file_path);
+        }
+
+        // Generate the SAM and FASTQ files.
+        auto begin_time = std::chrono::steady_clock::now();
+        auto summary = generator.run(generate_sam ? args.output_prefix + ".sam" : std::string(), generate_fastq ? args.output_prefix + "_R1.fastq" : std::string(), generate_fastq ? args.output_prefix + "_R2.fastq" : std::string(), static_cast<std::uint64_t>(args.total_size*1e9), args.n_threads);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-begin_time).count();
+        std::cout << "Generate " << summary.n_reads << " reads of " << summary.n_bytes << " bytes in " << seconds << " seconds (" << static_cast<double>(summary.n_bytes)/1e9/seconds << " GB/s)" << std::endl;
+    }
+    catch (const std::logic_error& e)
+    {
+        std::cerr << "Logical error: " << e.what() << std::endl;
+        exit_code = EXIT_FAILURE;
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cerr << "Runtime error: " << e.what() << std::endl;
+        exit_code = EXIT_FAILURE;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Other error: " << e.what() << std::endl;
+        exit_code = EXIT_FAILURE;
+    }
+
+    return exit_code;
+}
@@ -0,0 +1,504 @@
+//
+//  DGEDataGenerator.cpp
+//  DGE-Data-Generator
+//
+//  Created on 10/18/26.
+//
+
+#include <cmath>
+#include <array>
+#include <memory>
+#include <fstream>
+#include <cstring>
+#include <charconv>
+#include <stdexcept>
+#include <algorithm>
+#include <utk/WorkStealingThreadPool.hpp>
+#include <hts/DGEIlluminaFASTQSequence.hpp>
+#include <DGEDataGenerator.hpp>
+
+/// Number of autosomes that genes are placed on.
+static constexpr std::uint32_t n_references {22};
+
+/// Distance between the loci of adjacent genes on a reference sequence.
+static constexpr std::uint32_t locus_spacing {100000};
+
+/// Span of the alignment positions of the molecules of a locus.
+static constexpr std::uint32_t locus_span {2000};
+
+/// Fraction of intergenic molecules.
+static constexpr double intergenic_fraction {0.2};
+
+/// Size of the pool of base qualities.
+static constexpr std::size_t quality_pool_size {1 << 16};
+
+/// The first part of the sequence identifier of all reads.
+static const std::string instrument_run_flowcell {"NB501:48:HGENDGEXX:"};
+
+/// The index sequence of the second part of the sequence identifier.
+static const std::string index_sequence {"ATCACG"};
+
+/// \brief A SplitMix64 random engine.
+/// It passes BigCrush and costs a few arithmetic operations per 64-bit draw,
+/// and its state of one word makes it cheap to seed an engine for each block
+/// and each molecule.
+class RandomEngine
+{
+private:
+
+    std::uint64_t state;
+
+public:
+
+    explicit RandomEngine(std::uint64_t seed) : state{seed} {}
+
+    std::uint64_t operator()()
+    {
+        std::uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    /// Draw an integer in [0, n) for n up to 2^32.
+    std::uint32_t below(std::uint64_t n)
+    {
+        return static_cast<std::uint32_t>(((*this)() >> 32) * n >> 32);
+    }
+
+    /// Draw a double in [0, 1).
+    double uniform()
+    {
+        return static_cast<double>((*this)() >> 11) * 0x1.0p-53;
+    }
+};
+
+/// Mix a seed with an index into the seed of an engine.
+static std::uint64_t mixSeed(std::uint64_t seed, std::uint64_t index)
+{
+    return RandomEngine(seed ^ (index * 0xd1b54a32d192ed03ULL))();
+}
+
+/// The bases of 2-bit codes.
+static constexpr char bases[] {'A','C','G','T'};
+
+/// The four bases of each byte, with two bits per base.
+static const std::array<std::array<char, 4>, 256> byte_bases = []
+{
+    std::array<std::array<char, 4>, 256> table {};
+    for(std::size_t byte = 0; byte < 256; ++byte)
+    {
+        for(std::size_t i = 0; i < 4; ++i) table[byte][i] = bases[(byte >> (2*i)) & 3];
+    }
+    return table;
+}();
+
+/// Draw random bases into a buffer, 32 for each draw of an engine.
+/// \return  The start of the bases.
+static const char* drawBases(std::string& buffer, RandomEngine& engine, std::size_t length)
+{
+    buffer.resize((length+31)/32*32);
+    for(std::size_t i = 0; i < length; i += 32)
+    {
+        std::uint64_t bits = engine();
+        for(std::size_t j = 0; j < 8; ++j, bits >>= 8) std::copy_n(byte_bases[bits & 0xff].data(), 4, &buffer[i+4*j]);
+    }
+    return buffer.data();
+}
+
+/// \brief A cursor writing the text of a read.
+/// The cursor writes to a character buffer, or to the end of an output text
+/// grown by the maximum size of a read, which is shrunk to the written text
+/// when the cursor is closed. It saves the checks of capacity of appending
+/// each piece of a read to a string.
+struct TextCursor
+{
+    char* end;
+
+    explicit TextCursor(char* buffer) : end{buffer} {}
+
+    TextCursor(std::string& text, std::size_t max_size)
+    {
+        std::size_t size = text.size();
+        text.resize(size + max_size);
+        end = &text[size];
+    }
+
+    void put(char c)
+    {
+        *end++ = c;
+    }
+
+    void put(const char* chars, std::size_t n)
+    {
+        std::memcpy(end, chars, n);
+        end += n;
+    }
+
+    template<std::size_t N>
+    void put(const char (&chars)[N])
+    {
+        put(chars, N-1);
+    }
+
+    void put(const std::string& chars)
+    {
+        put(chars.data(), chars.size());
+    }
+
+    void putNumber(std::uint64_t number)
+    {
+        end = std::to_chars(end, end+20, number).ptr;
+    }
+
+    /// Shrink an output text to the written text.
+    /// \return  The size of the output text.
+    std::size_t close(std::string& text)
+    {
+        text.resize(static_cast<std::size_t>(end-text.data()));
+        return text.size();
+    }
+};
+
+DGEDataGenerator::DGEDataGenerator(const DGEDataParameters& params, bool generate_sam, bool generate_fastq) : params{params}, generate_sam{generate_sam}, generate_fastq{generate_fastq}
+{
+    initWells();
+    initGenes();
+    // Bound the size of a read by its sequences and qualities, its gene, and
+    // the other fields of at most 256 bytes.
+    std::size_t max_gene_length = 0;
+    for(const auto& gene : genes) max_gene_length = std::max(max_gene_length, gene.size());
+    max_read_bytes = 2*params.read_length + max_gene_length + 256;
+    // Draw a pool of mostly high base qualities.
+    RandomEngine engine(mixSeed(params.seed, 3));
+    quality_pool.resize(quality_pool_size + std::max<std::size_t>(params.read_length, hts::DGEIlluminaFASTQSequence::well_barcode_length+hts::DGEIlluminaFASTQSequence::umi_barcode_length));
+    for(auto& quality : quality_pool) quality = engine.below(50) == 0 ? '#' : static_cast<char>('A' + engine.below(10));
+}
+
+/// Draw the well barcodes and the names of wells.
+/// Note: the well barcodes differ from each other by at least two bases, so
+/// that a substitution doesn't turn one into another.
+void DGEDataGenerator::initWells()
+{
+    RandomEngine engine(mixSeed(params.seed, 1));
+    std::size_t n_columns = params.n_wells <= 96 ? 12 : 24;
+    while(well_barcodes.size() < params.n_wells)
+    {
+        std::string buffer;
+        std::string well_barcode(drawBases(buffer, engine, hts::DGEIlluminaFASTQSequence::well_barcode_length), hts::DGEIlluminaFASTQSequence::well_barcode_length);
+        bool distinct = std::all_of(well_barcodes.begin(), well_barcodes.end(), [&well_barcode](const std::string& drawn_barcode)
+        {
+            std::size_t n_diffs = 0;
+            for(std::size_t i = 0; i < well_barcode.size(); ++i) n_diffs += well_barcode[i] != drawn_barcode[i];
+            return n_diffs >= 2;
+        });
+        if(!distinct) continue;
+        std::size_t well_index = well_barcodes.size();
+        wells.push_back(static_cast<char>('A' + well_index/n_columns) + std::to_string(well_index%n_columns + 1));
+        well_barcodes.push_back(std::move(well_barcode));
+    }
+}
+
+/// Draw the gene symbols and the alias table of gene expression.
+void DGEDataGenerator::initGenes()
+{
+    // Draw gene symbols of letters followed by the rank of gene.
+    RandomEngine engine(mixSeed(params.seed, 2));
+    for(std::size_t i = 0; i < params.n_genes; ++i)
+    {
+        std::string gene;
+        for(std::size_t n = 2 + engine.below(3); n > 0; --n) gene += static_cast<char>('A' + engine.below(26));
+        gene += std::to_string(i+1);
+        genes.push_back(std::move(gene));
+    }
+
+    // Build the alias table of the Zipf distribution by Vose's method.
+    std::size_t n_genes = params.n_genes;
+    std::vector<double> weights(n_genes);
+    double total_weight = 0;
+    for(std::size_t i = 0; i < n_genes; ++i) total_weight += weights[i] = std::pow(static_cast<double>(i+1), -params.expression_skew);
+    gene_probs.resize(n_genes);
+    gene_aliases.resize(n_genes);
+    std::vector<std::uint32_t> small_genes, large_genes;
+    for(std::size_t i = 0; i < n_genes; ++i)
+    {
+        gene_probs[i] = weights[i] / total_weight * static_cast<double>(n_genes);
+        (gene_probs[i] < 1 ? small_genes : large_genes).push_back(static_cast<std::uint32_t>(i));
+    }
+    while(!small_genes.empty() && !large_genes.empty())
+    {
+        std::uint32_t small_gene = small_genes.back(), large_gene = large_genes.back();
+        small_genes.pop_back();
+        gene_aliases[small_gene] = large_gene;
+        gene_probs[large_gene] -= 1 - gene_probs[small_gene];
+        if(gene_probs[large_gene] < 1)
+        {
+            large_genes.pop_back();
+            small_genes.push_back(large_gene);
+        }
+    }
+    for(auto gene : small_genes) gene_probs[gene] = 1;
+    for(auto gene : large_genes) gene_probs[gene] = 1;
+}
+
+/// Draw a molecule.
+template<typename EngineType>
+DGEDataGenerator::Molecule DGEDataGenerator::drawMolecule(EngineType& engine) const
+{
+    Molecule molecule;
+    molecule.well = engine.below(params.n_wells);
+    molecule.umi = static_cast<std::uint32_t>(engine() >> 44);
+    molecule.reverse = engine.below(2) == 1;
+    molecule.seq_seed = engine();
+    std::uint32_t n_loci = static_cast<std::uint32_t>((params.n_genes + n_references - 1) / n_references);
+    if(engine.uniform() < intergenic_fraction)
+    {
+        // Place an intergenic molecule halfway between two genes.
+        molecule.gene = static_cast<std::uint32_t>(params.n_genes);
+        molecule.reference = engine.below(n_references);
+        molecule.position = locus_spacing*(engine.below(n_loci)+1) + locus_spacing/2 + engine.below(locus_span) + 1;
+    }
+    else
+    {
+        std::uint32_t gene = engine.below(params.n_genes);
+        if(engine.uniform() >= gene_probs[gene]) gene = gene_aliases[gene];
+        molecule.gene = gene;
+        molecule.reference = gene % n_references;
+        molecule.position = locus_spacing*(gene/n_references+1) + engine.below(locus_span) + 1;
+    }
+    return molecule;
+}
+
+/// Append a read of a molecule to the outputs of a block.
+template<typename EngineType>
+void DGEDataGenerator::appendRead(EngineType& engine, const Molecule& molecule, Block& block) const
+{
+    static constexpr std::size_t barcode_length = hts::DGEIlluminaFASTQSequence::well_barcode_length + hts::DGEIlluminaFASTQSequence::umi_barcode_length;
+
+    // Substitute a base of the UMI barcode.
+    std::uint32_t umi = molecule.umi;
+    if(engine.uniform() < params.umi_error_rate) umi ^= (1 + engine.below(3)) << (2*engine.below(hts::DGEIlluminaFASTQSequence::umi_barcode_length));
+
+    // Draw the first part of the sequence identifier.
+    char seq_id_buffer[64];
+    TextCursor seq_id(seq_id_buffer);
+    seq_id.put(instrument_run_flowcell);
+    seq_id.putNumber(1 + engine.below(4));
+    seq_id.put(':');
+    seq_id.putNumber((1 + engine.below(2))*1000 + 101 + engine.below(12));
+    seq_id.put(':');
+    seq_id.putNumber(1000 + engine.below(30000));
+    seq_id.put(':');
+    seq_id.putNumber(1000 + engine.below(30000));
+    std::size_t seq_id_length = static_cast<std::size_t>(seq_id.end-seq_id_buffer);
+
+    // Get the barcodes and the cDNA sequence of the molecule.
+    char barcode[barcode_length];
+    std::copy_n(well_barcodes[molecule.well].data(), hts::DGEIlluminaFASTQSequence::well_barcode_length, barcode);
+    for(std::size_t i = 0; i < hts::DGEIlluminaFASTQSequence::umi_barcode_length; ++i) barcode[hts::DGEIlluminaFASTQSequence::well_barcode_length+i] = bases[(umi >> (2*i)) & 3];
+    RandomEngine seq_engine(molecule.seq_seed);
+    const char* cdna_seq = drawBases(block.cdna_seq, seq_engine, params.read_length);
+    const char* r1_quals = &quality_pool[engine.below(quality_pool_size)];
+    const char* r2_quals = &quality_pool[engine.below(quality_pool_size)];
+
+    if(generate_sam)
+    {
+        TextCursor text(block.sam_text, max_read_bytes);
+        text.put(seq_id_buffer, seq_id_length);
+        text.put(':');
+        text.put(barcode, barcode_length);
+        text.put(molecule.reverse ? "\t16\tchr" : "\t0\tchr");
+        text.putNumber(molecule.reference+1);
+        text.put('\t');
+        text.putNumber(molecule.position);
+        text.put("\t255\t");
+        text.putNumber(params.read_length);
+        text.put("M\t*\t0\t0\t");
+        text.put(cdna_seq, params.read_length);
+        text.put('\t');
+        text.put(r2_quals, params.read_length);
+        text.put("\tNH:i:1\tHI:i:1\tAS:i:");
+        text.putNumber(params.read_length-2);
+        text.put("\tnM:i:0\tXS:Z:");
+        if(molecule.gene < params.n_genes)
+        {
+            text.put("Assigned\tXN:i:1\tXT:Z:");
+            text.put(genes[molecule.gene]);
+        }
+        else text.put("Unassigned_NoFeatures");
+        text.put('\n');
+        block.sam_read_ends.push_back(text.close(block.sam_text));
+    }
+
+    if(generate_fastq)
+    {
+        TextCursor r1_text(block.r1_fastq_text, max_read_bytes);
+        r1_text.put('@');
+        r1_text.put(seq_id_buffer, seq_id_length);
+        r1_text.put(" 1:N:0:");
+        r1_text.put(index_sequence);
+        r1_text.put('\n');
+        r1_text.put(barcode, barcode_length);
+        r1_text.put("\n+\n");
+        r1_text.put(r1_quals, barcode_length);
+        r1_text.put('\n');
+        block.r1_fastq_read_ends.push_back(r1_text.close(block.r1_fastq_text));
+
+        TextCursor r2_text(block.r2_fastq_text, max_read_bytes);
+        r2_text.put('@');
+        r2_text.put(seq_id_buffer, seq_id_length);
+        r2_text.put(" 2:N:0:");
+        r2_text.put(index_sequence);
+        r2_text.put('\n');
+        r2_text.put(cdna_seq, params.read_length);
+        r2_text.put("\n+\n");
+        r2_text.put(r2_quals, params.read_length);
+        r2_text.put('\n');
+        block.r2_fastq_read_ends.push_back(r2_text.close(block.r2_fastq_text));
+    }
+}
+
+/// Generate a block of reads.
+void DGEDataGenerator::generateBlock(std::uint64_t block_index, Block& block) const
+{
+    block.sam_text.clear();
+    block.r1_fastq_text.clear();
+    block.r2_fastq_text.clear();
+    block.sam_read_ends.clear();
+    block.r1_fastq_read_ends.clear();
+    block.r2_fastq_read_ends.clear();
+
+    // Draw the reads of the block, of which duplicates are drawn from the
+    // molecules drawn so far.
+    RandomEngine engine(mixSeed(params.seed, block_index + 16));
+    std::vector<Molecule> molecules;
+    molecules.reserve(n_block_reads);
+    for(std::size_t i = 0; i < n_block_reads; ++i)
+    {
+        if(!molecules.empty() && engine.uniform() < params.duplication_rate)
+        {
+            appendRead(engine, molecules[engine.below(molecules.size())], block);
+        }
+        else
+        {
+            molecules.push_back(drawMolecule(engine));
+            appendRead(engine, molecules.back(), block);
+        }
+    }
+}
+
+/// Get the SAM header lines of the reference sequences.
+std::string DGEDataGenerator::getSAMHeader() const
+{
+    std::uint64_t reference_length = locus_spacing * ((params.n_genes + n_references - 1) / n_references + 2);
+    std::string header = "@HD\tVN:1.4\tSO:unsorted\n";
+    for(std::uint32_t i = 1; i <= n_references; ++i)
+    {
+        header += "@SQ\tSN:chr";
+        header += std::to_string(i);
+        header += "\tLN:";
+        header += std::to_string(reference_length);
+        header += '\n';
+    }
+    header += "@PG\tID:DGE-Data-Generator\tPN:DGE-Data-Generator\n";
+    return header;
+}
+
+/// Get the well barcode table of plate, well, and well barcode.
+std::string DGEDataGenerator::getWellBarcodeTable() const
+{
+    std::string table;
+    for(std::size_t i = 0; i < well_barcodes.size(); ++i) table += "1\t" + wells[i] + '\t' + well_barcodes[i] + '\n';
+    return table;
+}
+
+/// Generate the data files up to a total size.
+DGEDataGenerator::Summary DGEDataGenerator::run(const std::string& sam_file_path, const std::string& r1_fastq_file_path, const std::string& r2_fastq_file_path, std::uint64_t n_total_bytes, std::size_t n_threads) const
+{
+    // Open the output files.
+    std::ofstream sam_file, r1_fastq_file, r2_fastq_file;
+    auto openFile = [](std::ofstream& file, const std::string& file_path)
+    {
+        if(file_path.empty()) return;
+        file.open(file_path, std::ios::binary | std::ios::trunc);
+        if(!file.is_open()) throw std::runtime_error("Cannot open output file " + file_path + '!');
+    };
+    openFile(sam_file, sam_file_path);
+    openFile(r1_fastq_file, r1_fastq_file_path);
+    openFile(r2_fastq_file, r2_fastq_file_path);
+
+    Summary summary;
+    if(sam_file.is_open())
+    {
+        std::string header = getSAMHeader();
+        sam_file.write(header.data(), static_cast<std::streamsize>(header.size()));
+        summary.n_bytes += header.size();
+    }
+
+    // Write the reads of a block up to the total size.
+    auto writeBlock = [&](const Block& block)
+    {
+        auto getReadEnd = [](const std::vector<std::size_t>& read_ends, std::size_t i) -> std::size_t
+        {
+            return read_ends.empty() ? 0 : read_ends[i];
+        };
+        auto getBlockBytes = [&](std::size_t i)
+        {
+            return getReadEnd(block.sam_read_ends, i) + getReadEnd(block.r1_fastq_read_ends, i) + getReadEnd(block.r2_fastq_read_ends, i);
+        };
+        // Find the read reaching the total size.
+        std::size_t n_reads = n_block_reads;
+        if(summary.n_bytes + getBlockBytes(n_block_reads-1) >= n_total_bytes)
+        {
+            std::size_t lower = 0, upper = n_block_reads-1;
+            while(lower < upper)
+            {
+                std::size_t middle = (lower+upper)/2;
+                if(summary.n_bytes + getBlockBytes(middle) >= n_total_bytes) upper = middle;
+                else lower = middle+1;
+            }
+            n_reads = lower+1;
+        }
+        if(sam_file.is_open()) sam_file.write(block.sam_text.data(), static_cast<std::streamsize>(getReadEnd(block.sam_read_ends, n_reads-1)));
+        if(r1_fastq_file.is_open()) r1_fastq_file.write(block.r1_fastq_text.data(), static_cast<std::streamsize>(getReadEnd(block.r1_fastq_read_ends, n_reads-1)));
+        if(r2_fastq_file.is_open()) r2_fastq_file.write(block.r2_fastq_text.data(), static_cast<std::streamsize>(getReadEnd(block.r2_fastq_read_ends, n_reads-1)));
+        summary.n_reads += n_reads;
+        summary.n_bytes += getBlockBytes(n_reads-1);
+    };
+
+    // Generate a round of blocks while the previous round is written.
+    n_threads = std::max<std::size_t>(n_threads, 1);
+    // Note: the blocks must outlive the thread pool, which finishes the
+    // submitted tasks when it is destroyed.
+    std::vector<Block> blocks(2*n_threads);
+    utk::WorkStealingThreadPool thread_pool(n_threads);
+    auto submitRound = [&](std::uint64_t round)
+    {
+        for(std::size_t i = 0; i < n_threads; ++i)
+        {
+            Block& block = blocks[(round%2)*n_threads + i];
+            std::uint64_t block_index = round*n_threads + i;
+            thread_pool.submit([this, block_index, &block]() { generateBlock(block_index, block); });
+        }
+    };
+    submitRound(0);
+    thread_pool.wait();
+    for(std::uint64_t round = 0; summary.n_bytes < n_total_bytes; ++round)
+    {
+        submitRound(round+1);
+        for(std::size_t i = 0; i < n_threads && summary.n_bytes < n_total_bytes; ++i) writeBlock(blocks[(round%2)*n_threads + i]);
+        thread_pool.wait();
+    }
+
+    // Check the output files.
+    auto closeFile = [](std::ofstream& file, const std::string& file_path)
+    {
+        if(!file.is_open()) return;
+        file.close();
+        if(!file) throw std::runtime_error("Failed to write output file " + file_path);
+    };
+    closeFile(sam_file, sam_file_path);
+    closeFile(r1_fastq_file, r1_fastq_file_path);
+    closeFile(r2_fastq_file, r2_fastq_file_path);
+    return summary;
+}
@@ -0,0 +1,193 @@
+//
+//  DGEDataGenerator.hpp
+//  DGE-Data-Generator
+//
+//  Created on 10/18/26.
+//
+
+#ifndef DGEDataGenerator_hpp
+#define DGEDataGenerator_hpp
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/// \brief The parameters of synthetic DGE sequencing data.
+struct DGEDataParameters
+{
+    /// Seed of all random draws.
+    std::uint64_t seed {1};
+
+    /// Number of wells, each tagged with a distinct well barcode.
+    std::size_t n_wells {96};
+
+    /// Number of genes.
+    std::size_t n_genes {20000};
+
+    /// Exponent of the Zipf distribution of gene expression, where the gene
+    /// of rank k is drawn with a weight of 1/k^skew, or 0 for a uniform
+    /// distribution.
+    double expression_skew {1.0};
+
+    /// Fraction of reads that are PCR duplicates of an earlier read of the
+    /// same molecule.
+    double duplication_rate {0.5};
+
+    /// Probability of a substitution in the UMI barcode of a read.
+    double umi_error_rate {0.01};
+
+    /// Length of the cDNA sequences of read 2, which are aligned.
+    std::size_t read_length {46};
+};
+
+/// \brief A generator of synthetic 3'-DGE sequencing data.
+/// The generator draws sequenced molecules of a model library and writes the
+/// reads of them as paired DGE Illumina FASTQ files, as a featureCounts SAM
+/// file of their alignments, or as both. Each molecule has a well, a gene,
+/// a 10-nt UMI barcode, an alignment locus, and a cDNA sequence:
+///
+/// 1) The genes are drawn from a Zipf distribution, and are placed 100 kb
+///    apart on the 22 autosomes. One in five molecules is intergenic, whose
+///    alignment is unassigned by featureCounts.
+/// 2) A read is a PCR duplicate of an earlier molecule at the duplication
+///    rate, with the same well, gene, UMI barcode, locus, and cDNA sequence.
+/// 3) The UMI barcode of a read has a substitution at the UMI error rate, so
+///    that it differs from that of its molecule by one base.
+///
+/// Read 1 of a FASTQ file pair holds the 6-nt well barcode followed by the
+/// 10-nt UMI barcode, and read 2 holds the cDNA sequence, both with Illumina
+/// sequence identifiers, e.g.
+///
+///     @NB501:48:HGENDGEXX:1:1101:1103:2053 1:N:0:ATCACG
+///
+/// The alignment of a read in the SAM file has a composite QNAME of the
+/// first part of the sequence identifier and the barcodes of read 1, the
+/// cDNA sequence of read 2, and the XS, XN, and XT tags of featureCounts,
+/// e.g.
+///
+///     NB501:48:HGENDGEXX:1:1101:1103:2053:TAAGTACATAGCGTGG  0  chr1  1023  255  46M  *  0  0  SEQ  QUAL  NH:i:1  HI:i:1  AS:i:44  nM:i:0  XS:Z:Assigned  XN:i:1  XT:Z:GENE
+///
+/// The reads are generated in blocks of a fixed number of reads, each drawn
+/// from a random engine seeded by the seed and the index of the block, and
+/// duplicates are drawn from the molecules of the same block. The blocks are
+/// generated by multiple threads and written in order, so that the output
+/// depends only on the parameters, not on the number of threads.
+class DGEDataGenerator
+{
+public:
+
+    /// Number of reads of each block.
+    static constexpr std::size_t n_block_reads {16384};
+
+    /// The outputs of a block of reads.
+    struct Block
+    {
+        std::string sam_text;
+        std::string r1_fastq_text;
+        std::string r2_fastq_text;
+
+        /// The end of each read in each output text.
+        std::vector<std::size_t> sam_read_ends;
+        std::vector<std::size_t> r1_fastq_read_ends;
+        std::vector<std::size_t> r2_fastq_read_ends;
+
+        /// Scratch buffer of the cDNA sequence of a read.
+        std::string cdna_seq;
+    };
+
+    /// The numbers of reads and bytes written by a run.
+    struct Summary
+    {
+        std::uint64_t n_reads {0};
+        std::uint64_t n_bytes {0};
+    };
+
+private:
+
+    /// A molecule of the model library.
+    struct Molecule
+    {
+        std::uint32_t well {0};
+        /// Gene, or n_genes for an intergenic molecule.
+        std::uint32_t gene {0};
+        /// UMI barcode with 2 bits per base.
+        std::uint32_t umi {0};
+        std::uint32_t reference {0};
+        std::uint32_t position {0};
+        bool reverse {false};
+        /// Seed of the cDNA sequence.
+        std::uint64_t seq_seed {0};
+    };
+
+private:
+
+    DGEDataParameters params;
+
+    std::vector<std::string> well_barcodes;
+
+    std::vector<std::string> wells;
+
+    std::vector<std::string> genes;
+
+    /// Alias table of the Zipf distribution of genes.
+    std::vector<double> gene_probs;
+    std::vector<std::uint32_t> gene_aliases;
+
+    /// Pool of base qualities copied into reads.
+    std::string quality_pool;
+
+    /// Maximum size of a read in any output text.
+    std::size_t max_read_bytes {0};
+
+    /// Whether to generate the SAM file and the FASTQ files.
+    bool generate_sam {true};
+    bool generate_fastq {true};
+
+private:
+
+    /// Draw the well barcodes and the names of wells.
+    void initWells();
+
+    /// Draw the gene symbols and the alias table of gene expression.
+    void initGenes();
+
+    /// Draw a molecule.
+    template<typename EngineType>
+    Molecule drawMolecule(EngineType& engine) const;
+
+    /// Append a read of a molecule to the outputs of a block.
+    template<typename EngineType>
+    void appendRead(EngineType& engine, const Molecule& molecule, Block& block) const;
+
+public:
+
+    /// \param  params  The parameters of the synthetic data.
+    /// \param  generate_sam    Whether to generate the SAM file.
+    /// \param  generate_fastq  Whether to generate the FASTQ files.
+    DGEDataGenerator(const DGEDataParameters& params, bool generate_sam, bool generate_fastq);
+
+    /// \brief Generate a block of reads.
+    /// Note: this function doesn't change the generator and can be called by
+    /// multiple threads at the same time.
+    void generateBlock(std::uint64_t block_index, Block& block) const;
+
+    /// Get the SAM header lines of the reference sequences.
+    std::string getSAMHeader() const;
+
+    /// Get the well barcode table of plate, well, and well barcode.
+    std::string getWellBarcodeTable() const;
+
+    /// \brief Generate the data files up to a total size.
+    /// \param  sam_file_path       The output SAM file, or empty for none.
+    /// \param  r1_fastq_file_path  The output FASTQ file of read 1, or empty
+    ///                             for none.
+    /// \param  r2_fastq_file_path  The output FASTQ file of read 2, or empty
+    ///                             for none.
+    /// \param  n_total_bytes       The total size of the output files, which
+    ///                             is reached by the last read written.
+    /// \param  n_threads           The number of threads generating blocks.
+    Summary run(const std::string& sam_file_path, const std::string& r1_fastq_file_path, const std::string& r2_fastq_file_path, std::uint64_t n_total_bytes, std::size_t n_threads) const;
+};
+
+#endif /* DGEDataGenerator_hpp */
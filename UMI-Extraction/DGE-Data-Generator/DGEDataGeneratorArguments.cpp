@@ -0,0 +1,103 @@
+//
+//  DGEDataGeneratorArguments.cpp
+//  DGE-Data-Generator
+//
+//  Created on 10/18/26.
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <utk/StringUtils.hpp>
+#include <DGEDataGeneratorArguments.hpp>
+
+/// Retrieve input arguments.
+DGEDataGeneratorArguments::DGEDataGeneratorArguments(int argc, const char** argv) :
+    utk::ProgramArguments(argc, argv, 2, 12),
+    output_type{"both"},
+    total_size{1},
+    params{},
+    n_threads{1} {}
+
+/// Assign mandatory input arguments
+void DGEDataGeneratorArguments::assignMandatoryArguments()
+{
+    // Assign mandatory arguments.
+    output_prefix = argv[1];
+}
+
+/// Assign optional input arguments
+void DGEDataGeneratorArguments::assignOptionalArguments()
+{
+    // Assign optional arguments.
+    // 2nd argument.
+    if(argc > 2) output_type = utk::toLowerString(argv[2]);
+    // 3rd argument.
+    if(argc > 3) total_size = utk::convert<double>(argv[3]);
+    // 4th argument.
+    if(argc > 4) params.seed = utk::convert<std::size_t>(argv[4]);
+    // 5th argument.
+    if(argc > 5) params.n_wells = utk::convert<std::size_t>(argv[5]);
+    // 6th argument.
+    if(argc > 6) params.n_genes = utk::convert<std::size_t>(argv[6]);
+    // 7th argument.
+    if(argc > 7) params.expression_skew = utk::convert<double>(argv[7]);
+    // 8th argument.
+    if(argc > 8) params.duplication_rate = utk::convert<double>(argv[8]);
+    // 9th argument.
+    if(argc > 9) params.umi_error_rate = utk::convert<double>(argv[9]);
+    // 10th argument.
+    if(argc > 10) params.read_length = utk::convert<std::size_t>(argv[10]);
+    // 11th argument.
+    if(argc > 11) n_threads = utk::convert<std::size_t>(argv[11]);
+}
+
+/// Validate input arguments
+void DGEDataGeneratorArguments::validateArguments()
+{
+    // Check the output file prefix.
+    if(output_prefix.empty()) throw std::logic_error("Output Prefix must not be empty");
+
+    // Check the output type.
+    if(output_type != "sam" && output_type != "fastq" && output_type != "both") throw std::logic_error("Output Type must be sam, fastq, or both");
+
+    // Check the total size.
+    if(!(total_size > 0)) throw std::logic_error("Total Size must be positive");
+
+    // Check the number of wells, whose barcodes differ by at least two bases.
+    if(params.n_wells < 1 || params.n_wells > 384) throw std::logic_error("Number of Wells must be between 1 and 384");
+
+    // Check the number of genes.
+    if(params.n_genes < 1 || params.n_genes > 1000000) throw std::logic_error("Number of Genes must be between 1 and 1000000");
+
+    // Check the skew of gene expression.
+    if(!(params.expression_skew >= 0)) throw std::logic_error("Expression Skew must not be negative");
+
+    // Check the duplication rate.
+    if(!(params.duplication_rate >= 0 && params.duplication_rate < 1)) throw std::logic_error("Duplication Rate must be at least 0 and less than 1");
+
+    // Check the UMI error rate.
+    if(!(params.umi_error_rate >= 0 && params.umi_error_rate <= 1)) throw std::logic_error("UMI Error Rate must be between 0 and 1");
+
+    // Check the read length.
+    if(params.read_length < 1 || params.read_length > 1000) throw std::logic_error("Read Length must be between 1 and 1000");
+
+    // Check the number of threads.
+    if(n_threads < 1) throw std::logic_error("Number of Threads must be at least 1");
+}
+
+/// Print help messages on program usage.
+void DGEDataGeneratorArguments::helpMessage()
+{
+    std::cerr << "Usage: " << prog_name << " [Output Prefix] [Output Type] [Total Size] [Random Seed] [Number of Wells] [Number of Genes] [Expression Skew] [Duplication Rate] [UMI Error Rate] [Read Length] [Number of Threads]" << '\n';
+    std::cerr << "       " << "[Output Prefix]: the prefix of output files, i.e. [Output Prefix].sam for the featureCounts SAM file, [Output Prefix]_R1.fastq and [Output Prefix]_R2.fastq for the paired DGE FASTQ files, and [Output Prefix]_Well_Barcodes.tsv for the well barcode table." << '\n';
+    std::cerr << "       " << "[Output Type]: sam for the SAM file, fastq for the FASTQ files and the well barcode table, or both, which have the same reads (Default: both)." << '\n';
+    std::cerr << "       " << "[Total Size]: the total size in GB (10^9 bytes) of the SAM and FASTQ files, which is reached by the last read (Default: 1)." << '\n';
+    std::cerr << "       " << "[Random Seed]: the seed of all random draws, so that the same arguments generate the same files regardless of Number of Threads (Default: 1)." << '\n';
+    std::cerr << "       " << "[Number of Wells]: the number of wells, each tagged with a distinct 6-nt well barcode, up to 384 (Default: 96)." << '\n';
+    std::cerr << "       " << "[Number of Genes]: the number of genes (Default: 20000)." << '\n';
+    std::cerr << "       " << "[Expression Skew]: the exponent s of the Zipf distribution of gene expression, where the gene of rank k is expressed in proportion to 1/k^s, or 0 for a uniform distribution (Default: 1)." << '\n';
+    std::cerr << "       " << "[Duplication Rate]: the fraction of reads that are PCR duplicates of an earlier read of the same molecule (Default: 0.5)." << '\n';
+    std::cerr << "       " << "[UMI Error Rate]: the probability of a substitution in the UMI barcode of a read (Default: 0.01)." << '\n';
+    std::cerr << "       " << "[Read Length]: the length of the cDNA sequences of read 2 and of the alignments (Default: 46)." << '\n';
+    std::cerr << "       " << "[Number of Threads]: the number of threads generating reads (Default: 1)." << std::endl;
+}
@@ -0,0 +1,64 @@
+//
+//  DGEDataGeneratorArguments.hpp
+//  DGE-Data-Generator
+//
+//  Created on 10/18/26.
+//
+
+#ifndef DGEDataGeneratorArguments_hpp
+#define DGEDataGeneratorArguments_hpp
+
+#include <string>
+#include <cstddef>
+#include <utk/ProgramArguments.hpp>
+#include <DGEDataGenerator.hpp>
+
+/// \brief DGEDataGeneratorArguments checks input arguments for entire program
+/// This class takes input arguments of main function, checks their validity,
+/// and store them in corresponding member variables.
+class DGEDataGeneratorArguments : public utk::ProgramArguments
+{
+public:
+
+    /// \brief Output file prefix.
+    /// The SAM file is named by the prefix followed by .sam, the FASTQ files
+    /// of read 1 and read 2 by the prefix followed by _R1.fastq and
+    /// _R2.fastq, and the well barcode table by the prefix followed by
+    /// _Well_Barcodes.tsv.
+    std::string output_prefix;
+
+    /// \brief Output type.
+    /// sam for the SAM file, fastq for the FASTQ files and the well barcode
+    /// table, or both.
+    std::string output_type;
+
+    /// \brief Total size in GB of the output SAM and FASTQ files.
+    double total_size;
+
+    /// \brief The parameters of the synthetic data.
+    DGEDataParameters params;
+
+    /// \brief Number of threads generating reads.
+    std::size_t n_threads;
+
+protected:
+
+    /// \brief Help messages on program usage
+    virtual void helpMessage() override;
+
+    /// \brief Assign mandatory input arguments
+    virtual void assignMandatoryArguments() override;
+
+    /// \brief Assign optional input arguments
+    virtual void assignOptionalArguments() override;
+
+    /// \brief Validate input arguments
+    virtual void validateArguments() override;
+
+public:
+
+    /// \brief Retrieve input arguments
+    DGEDataGeneratorArguments(int argc, const char** argv);
+};
+
+#endif /* DGEDataGeneratorArguments_hpp */
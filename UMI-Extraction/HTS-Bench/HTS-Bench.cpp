@@ -0,0 +1,65 @@
+//
+//  HTS-Bench.cpp
+//  HTS-Bench
+//
+//  Created on 10/18/26.
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <cstdlib>
+#include <memory>
+#include <utk/CPUFeatures.hpp>
+#include <MicroBenchmark.hpp>
+#include <HTSBenchmarks.hpp>
+#include <HTSBenchArguments.hpp>
+
+int main(int argc, const char *argv[])
+{
+    int exit_code = EXIT_SUCCESS;
+
+    try
+    {
+        // Retrieve input arguments from command line.
+        HTSBenchArguments args(argc, argv);
+        // Check input arguments.
+        args.check();
+
+        // Open the hardware counters if requested, which are reported as n/a
+        // when unavailable.
+        std::unique_ptr<utk::HardwareCounters> counters;
+        if(args.count_hardware_events)
+        {
+            counters = std::make_unique<utk::HardwareCounters>();
+            if(!counters->getUnavailableReason().empty()) std::cerr << "Warning: " << counters->getUnavailableReason() << std::endl;
+        }
+
+        // Report the SIMD level of the kernels selected for the running CPU.
+        std::cout << "SIMD level: " << utk::getSIMDLevelName(utk::getSIMDLevel()) << '\n';
+
+        // Run the benchmarks matching the filter.
+        MicroBenchmarkRegistry registry;
+        addHTSBenchmarks(registry);
+        if(registry.run(args.benchmark_filter, args.min_seconds, args.n_repetitions, std::cout, counters.get()).empty())
+        {
+            throw std::logic_error("No benchmark matches Benchmark Filter " + args.benchmark_filter);
+        }
+    }
+    catch (const std::logic_error& e)
+    {
+        std::cerr << "Logical error: " << e.what() << std::endl;
+        exit_code = EXIT_FAILURE;
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cerr << "Runtime error: " << e.what() << std::endl;
+        exit_code = EXIT_FAILURE;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Other error: " << e.what() << std::endl;
+        exit_code = EXIT_FAILURE;
+    }
+
+    return exit_code;
+}
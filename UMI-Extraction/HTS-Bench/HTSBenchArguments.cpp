@@ -0,0 +1,53 @@
+//
+//  HTSBenchArguments.cpp
+//  HTS-Bench
+//
+//  Created on 10/18/26.
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <utk/StringUtils.hpp>
+#include <HTSBenchArguments.hpp>
+
+/// Retrieve input arguments.
+HTSBenchArguments::HTSBenchArguments(int argc, const char** argv) :
+    utk::ProgramArguments(argc, argv, 1, 5),
+    benchmark_filter{},
+    min_seconds{0.2},
+    n_repetitions{5},
+    count_hardware_events{false} {}
+
+/// Assign optional input arguments
+void HTSBenchArguments::assignOptionalArguments()
+{
+    // Assign optional arguments.
+    // 1st argument.
+    if(argc > 1) benchmark_filter = argv[1];
+    // 2nd argument.
+    if(argc > 2) min_seconds = utk::convert<double>(argv[2]);
+    // 3rd argument.
+    if(argc > 3) n_repetitions = utk::convert<std::size_t>(argv[3]);
+    // 4th argument.
+    if(argc > 4) count_hardware_events = utk::convert<bool>(argv[4]);
+}
+
+/// Validate input arguments
+void HTSBenchArguments::validateArguments()
+{
+    // Check the minimum time of each run.
+    if(!(min_seconds > 0)) throw std::logic_error("Minimum Time must be positive");
+
+    // Check the number of runs.
+    if(n_repetitions < 1) throw std::logic_error("Repetitions must be at least 1");
+}
+
+/// Print help messages on program usage.
+void HTSBenchArguments::helpMessage()
+{
+    std::cerr << "Usage: " << prog_name << " [Benchmark Filter] [Minimum Time] [Repetitions] [Hardware Counters]" << '\n';
+    std::cerr << "       " << "[Benchmark Filter]: a substring of the names of benchmarks to run, or an empty string for all benchmarks (Default: \"\")." << '\n';
+    std::cerr << "       " << "[Minimum Time]: the minimum time in seconds of each timed run of a benchmark (Default: 0.2)." << '\n';
+    std::cerr << "       " << "[Repetitions]: the number of timed runs of each benchmark, of which the run of the median time is reported (Default: 5)." << '\n';
+    std::cerr << "       " << "[Hardware Counters]: indicator for counting the cycles, instructions, L1 data cache misses, last-level cache misses, branch misses, and data TLB misses per operation by Linux perf events, which are reported as n/a when unavailable (Default: false)." << std::endl;
+}
@@ -0,0 +1,54 @@
+//
+//  HTSBenchArguments.hpp
+//  HTS-Bench
+//
+//  Created on 10/18/26.
+//
+
+#ifndef HTSBenchArguments_hpp
+#define HTSBenchArguments_hpp
+
+#include <string>
+#include <cstddef>
+#include <utk/ProgramArguments.hpp>
+
+/// \brief HTSBenchArguments checks input arguments for entire program
+/// This class takes input arguments of main function, checks their validity,
+/// and store them in corresponding member variables.
+class HTSBenchArguments : public utk::ProgramArguments
+{
+public:
+
+    /// \brief Benchmark filter.
+    /// Only the benchmarks whose names contain the filter are run, or all
+    /// benchmarks are run if it is empty.
+    std::string benchmark_filter;
+
+    /// \brief Minimum time in seconds of each timed run of a benchmark.
+    double min_seconds;
+
+    /// \brief Number of timed runs of each benchmark.
+    /// The run of the median time is reported.
+    std::size_t n_repetitions;
+
+    /// \brief Flag for counting hardware events of each benchmark.
+    bool count_hardware_events;
+
+protected:
+
+    /// \brief Help messages on program usage
+    virtual void helpMessage() override;
+
+    /// \brief Assign optional input arguments
+    virtual void assignOptionalArguments() override;
+
+    /// \brief Validate input arguments
+    virtual void validateArguments() override;
+
+public:
+
+    /// \brief Retrieve input arguments
+    HTSBenchArguments(int argc, const char** argv);
+};
+
+#endif /* HTSBenchArguments_hpp */
@@ -0,0 +1,518 @@
+//
+//  HTSBenchmarks.cpp
+//  HTS-Bench
+//
+//  Created on 10/18/26.
+//
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <fstream>
+#include <stdexcept>
+#include <utk/FileUtils.hpp>
+#include <utk/LineReader.hpp>
+#include <utk/StringUtils.hpp>
+#include <utk/StringSearch.hpp>
+#include <utk/BlockedBloomFilter.hpp>
+#include <hts/WellBarcodeTable.hpp>
+#include <hts/UMIBarcodePacker.hpp>
+#include <hts/AdaptiveUMIContainer.hpp>
+#include <hts/FASTQFileReader.hpp>
+#include <hts/FASTQFileGroupOutputStreams.hpp>
+#include <hts/DGEIlluminaFASTQSequence.hpp>
+#include <hts/DGEIlluminaFASTQSequenceDemuxer.hpp>
+#include <hts/CompositedDGEIlluminaFASTQSequence.hpp>
+#include <hts/SAMGeneUMIAlignmentCounter.hpp>
+#include <hts/SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine.hpp>
+#include <HTSBenchmarks.hpp>
+
+/// Seed of the random inputs of benchmarks.
+static constexpr std::uint64_t input_seed {20261018};
+
+/// Number of distinct inputs of each benchmark, which are cycled through.
+static constexpr std::size_t n_inputs {4096};
+
+/// Length of the cDNA sequences of inputs.
+static constexpr std::size_t read_length {46};
+
+/// Number of wells of the well barcode table.
+static constexpr std::size_t n_wells {96};
+
+/// Number of genes of the inputs.
+static constexpr std::size_t n_genes {2000};
+
+/// Null device for the output of demultiplexed sequences.
+#if defined(_WIN32)
+static const std::string null_device_path {"NUL"};
+#else
+static const std::string null_device_path {"/dev/null"};
+#endif
+
+/// \brief A generator of random, realistic inputs.
+/// The alignment lines follow the featureCounts report of STAR alignments of
+/// composite DGE Illumina sequences, of which three quarters are assigned to
+/// a gene, e.g.
+///
+///     NB501:48:C7302ANXX:1:1101:22304:1919:TAAGTACTTGGTAAGA  0  chr1  1023  255  46M  *  0  0  SEQ  QUAL  NH:i:1  HI:i:1  AS:i:44  nM:i:0  XS:Z:Assigned  XN:i:1  XT:Z:MT-CO1
+class InputGenerator
+{
+private:
+
+    std::mt19937_64 engine {input_seed};
+
+    std::vector<std::string> well_barcodes;
+
+    std::vector<std::string> genes;
+
+public:
+
+    InputGenerator()
+    {
+        // Use the well barcodes of the well barcode table.
+        for(const auto& well_barcode : getWellBarcodeTable()) well_barcodes.push_back(well_barcode.first);
+        // Draw gene symbols of 3 to 8 characters.
+        for(std::size_t i = 0; i < n_genes; ++i) genes.push_back(randomLetters(3 + getIndex(4)) + std::to_string(1 + getIndex(20)));
+    }
+
+    std::size_t getIndex(std::size_t n)
+    {
+        return std::uniform_int_distribution<std::size_t>(0, n-1)(engine);
+    }
+
+    std::string randomBases(std::size_t length)
+    {
+        static constexpr char bases[] {'A','C','G','T'};
+        std::string seq(length, 'N');
+        for(auto& base : seq) base = bases[getIndex(4)];
+        return seq;
+    }
+
+    std::string randomLetters(std::size_t length)
+    {
+        std::string letters(length, 'A');
+        for(auto& letter : letters) letter = static_cast<char>('A' + getIndex(26));
+        return letters;
+    }
+
+    std::string randomQualities(std::size_t length)
+    {
+        std::string quals(length, 'E');
+        for(auto& qual : quals) qual = static_cast<char>('A' + getIndex(6));
+        return quals;
+    }
+
+    /// Get a table of distinct well barcodes and well numbers.
+    static hts::WellBarcodeTable getWellBarcodeTable()
+    {
+        std::mt19937_64 table_engine {input_seed+1};
+        hts::WellBarcodeTable table;
+        while(table.size() < n_wells)
+        {
+            static constexpr char bases[] {'A','C','G','T'};
+            std::string well_barcode(hts::DGEIlluminaFASTQSequence::well_barcode_length, 'N');
+            for(auto& base : well_barcode) base = bases[table_engine() % 4];
+            table.emplace(well_barcode, std::to_string(table.size()+1));
+        }
+        return table;
+    }
+
+    /// Get a sequence identifier of a composite DGE Illumina sequence, with
+    /// a well barcode of the table in 19 out of 20 sequences.
+    std::string getSeqId()
+    {
+        std::string well_barcode = getIndex(20) > 0 ? well_barcodes[getIndex(well_barcodes.size())] : randomBases(hts::DGEIlluminaFASTQSequence::well_barcode_length);
+        return "NB501:48:C7302ANXX:1:" + std::to_string(1101 + getIndex(12)) + ':' + std::to_string(1000 + getIndex(25000)) + ':' + std::to_string(1000 + getIndex(20000)) + ':' + well_barcode + randomBases(hts::DGEIlluminaFASTQSequence::umi_barcode_length);
+    }
+
+    /// Get a gene symbol.
+    const std::string& getGene()
+    {
+        return genes[getIndex(genes.size())];
+    }
+
+    /// Get a featureCounts alignment line.
+    std::string getAlignmentLine()
+    {
+        std::string line = getSeqId() + '\t' + (getIndex(2) ? "0" : "16") + "\tchr" + std::to_string(1 + getIndex(22)) + '\t' + std::to_string(1 + getIndex(100000000)) + "\t255\t" + std::to_string(read_length) + "M\t*\t0\t0\t" + randomBases(read_length) + '\t' + randomQualities(read_length) + "\tNH:i:1\tHI:i:1\tAS:i:44\tnM:i:0";
+        if(getIndex(4) > 0) line += "\tXS:Z:Assigned\tXN:i:1\tXT:Z:" + getGene();
+        else line += "\tXS:Z:Unassigned_NoFeatures";
+        return line;
+    }
+
+    /// Get the four lines of a composite DGE Illumina FASTQ sequence.
+    hts::FASTQSequenceLines getFASTQSequenceLines()
+    {
+        return {'@' + getSeqId(), randomBases(read_length), "+", randomQualities(read_length)};
+    }
+};
+
+/// A temporary input file removed when it goes out of scope.
+struct TempInputFile
+{
+    std::string path;
+
+    explicit TempInputFile(const std::vector<std::string>& lines) : path{utk::createTempFile("HTS-Bench")}
+    {
+        std::ofstream file(path, std::ios::binary);
+        for(const auto& line : lines) file << line << '\n';
+        file.close();
+        if(!file) throw std::runtime_error("Failed to write temporary input file " + path);
+    }
+
+    ~TempInputFile() noexcept
+    {
+        try
+        {
+            utk::removeFile(path);
+        }
+        catch(...) {}
+    }
+};
+
+/// Get the lines of the inputs of a benchmark.
+static std::vector<std::string> getAlignmentLines()
+{
+    InputGenerator generator;
+    std::vector<std::string> lines;
+    for(std::size_t i = 0; i < n_inputs; ++i) lines.push_back(generator.getAlignmentLine());
+    return lines;
+}
+
+static std::vector<std::string> getFASTQFileLines()
+{
+    InputGenerator generator;
+    std::vector<std::string> lines;
+    for(std::size_t i = 0; i < n_inputs; ++i) for(auto& line : generator.getFASTQSequenceLines()) lines.push_back(std::move(line));
+    return lines;
+}
+
+/// Add the benchmarks of reading lines.
+static void addLineReaderBenchmarks(MicroBenchmarkRegistry& registry)
+{
+    registry.add("LineReader/readLine", []
+    {
+        auto file = std::make_shared<TempInputFile>(getAlignmentLines());
+        auto reader = std::make_shared<utk::LineReader>(file->path, "unix");
+        return [file, reader](std::size_t n_ops)
+        {
+            std::string line;
+            for(std::size_t i = 0; i < n_ops; ++i)
+            {
+                if(!reader->readLine(line))
+                {
+                    reader->resetStream();
+                    reader->readLine(line);
+                }
+                keepValue(line);
+            }
+        };
+    });
+
+    // Each operation reads the four lines of a FASTQ sequence.
+    registry.add("LineReader/readLines/4", []
+    {
+        auto file = std::make_shared<TempInputFile>(getFASTQFileLines());
+        auto reader = std::make_shared<utk::LineReader>(file->path, "unix");
+        return [file, reader](std::size_t n_ops)
+        {
+            for(std::size_t i = 0; i < n_ops; ++i)
+            {
+                auto lines = reader->readLines(hts::FASTQSequence::n_fastq_sequence_lines);
+                if(lines.size() < hts::FASTQSequence::n_fastq_sequence_lines)
+                {
+                    reader->resetStream();
+                    lines = reader->readLines(hts::FASTQSequence::n_fastq_sequence_lines);
+                }
+                keepValue(lines);
+            }
+        };
+    });
+}
+
+/// Add the benchmarks of splitting and converting strings.
+static void addStringUtilsBenchmarks(MicroBenchmarkRegistry& registry)
+{
+    registry.add("splitString/tab", []
+    {
+        auto lines = std::make_shared<std::vector<std::string>>(getAlignmentLines());
+        return [lines](std::size_t n_ops)
+        {
+            for(std::size_t i = 0; i < n_ops; ++i) keepValue(utk::splitString((*lines)[i % n_inputs], '\t'));
+        };
+    });
+
+    registry.add("splitString/colon", []
+    {
+        InputGenerator generator;
+        auto seq_ids = std::make_shared<std::vector<std::string>>();
+        for(std::size_t i = 0; i < n_inputs; ++i) seq_ids->push_back(generator.getSeqId());
+        return [seq_ids](std::size_t n_ops)
+        {
+            for(std::size_t i = 0; i < n_ops; ++i) keepValue(utk::splitString((*seq_ids)[i % n_inputs], ':'));
+        };
+    });
+
+    // Target features of reads assigned to one to three overlapping genes.
+    registry.add("splitString/comma", []
+    {
+        InputGenerator generator;
+        auto features = std::make_shared<std::vector<std::string>>();
+        for(std::size_t i = 0; i < n_inputs; ++i)
+        {
+            std::string feature = generator.getGene();
+            for(std::size_t n = generator.getIndex(3); n > 0; --n) feature += ',' + generator.getGene();
+            features->push_back(std::move(feature));
+        }
+        return [features](std::size_t n_ops)
+        {
+            for(std::size_t i = 0; i < n_ops; ++i) keepValue(utk::splitString((*features)[i % n_inputs], ','));
+        };
+    });
+
+    // Positions of alignments.
+    registry.add("convert/size_t", []
+    {
+        InputGenerator generator;
+        auto numbers = std::make_shared<std::vector<std::string>>();
+        for(std::size_t i = 0; i < n_inputs; ++i) numbers->push_back(std::to_string(1 + generator.getIndex(100000000)));
+        return [numbers](std::size_t n_ops)
+        {
+            for(std::size_t i = 0; i < n_ops; ++i) keepValue(utk::convert<std::size_t>((*numbers)[i % n_inputs]));
+        };
+    });
+}
+
+/// Add the benchmarks of parsing SAM alignment lines.
+static void addSAMAlignmentLineBenchmarks(MicroBenchmarkRegistry& registry)
+{
+    using AlignmentLineType = hts::SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine;
+    static const hts::SAMAlignmentOptionalFieldParts pref_opt_fields_tags {"XS","XN","XT"};
+
+    // The default parsing of SAM-Alignment-Counter, i.e. the top structure of
+    // the preferred optional fields only.
+    registry.add("SAMAlignmentLine/construct", []
+    {
+        auto lines = std::make_shared<std::vector<std::string>>(getAlignmentLines());
+        return [lines](std::size_t n_ops)
+        {
+            for(std::size_t i = 0; i < n_ops; ++i)
+            {
+                AlignmentLineType alignment_line((*lines)[i % n_inputs], true, false, true, false, pref_opt_fields_tags);
+                keepValue(alignment_line);
+            }
+        };
+    });
+
+    // The parsing of all mandatory fields as well.
+    // Note: the attributes of optional fields aren't parsed, since a warning
+    // is printed for each non-standard tag of featureCounts.
+    registry.add("SAMAlignmentLine/construct/mandatory", []
+    {
+        auto lines = std::make_shared<std::vector<std::string>>(getAlignmentLines());
+        return [lines](std::size_t n_ops)
+        {
+            for(std::size_t i = 0; i < n_ops; ++i)
+            {
+                AlignmentLineType alignment_line((*lines)[i % n_inputs], true, true, true, false, pref_opt_fields_tags);
+                keepValue(alignment_line);
+            }
+        };
+    });
+
+    registry.add("SAMAlignmentOptionalFields/getValue", []
+    {
+        std::vector<std::string> lines = getAlignmentLines();
+        auto alignment_lines = std::make_shared<std::vector<AlignmentLineType>>();
+        for(const auto& line : lines) alignment_lines->emplace_back(line, true, false, true, false, pref_opt_fields_tags);
+        return [alignment_lines](std::size_t n_ops)
+        {
+            static const std::string tag {"XT"};
+            std::string value;
+            for(std::size_t i = 0; i < n_ops; ++i) keepValue((*alignment_lines)[i % n_inputs].getOptionalFields().getValue(tag, value));
+        };
+    });
+}
+
+/// Add the benchmarks of parsing and demultiplexing FASTQ sequences.
+static void addFASTQSequenceBenchmarks(MicroBenchmarkRegistry& registry)
+{
+    using SeqType = hts::CompositedDGEIlluminaFASTQSequence;
+
+    registry.add("CompositedDGEIlluminaFASTQSequence/parse", []
+    {
+        InputGenerator generator;
+        auto seq_lines = std::make_shared<std::vector<hts::FASTQSequenceLines>>();
+        for(std::size_t i = 0; i < n_inputs; ++i) seq_lines->push_back(generator.getFASTQSequenceLines());
+        return [seq_lines](std::size_t n_ops)
+        {
+            for(std::size_t i = 0; i < n_ops; ++i)
+            {
+                SeqType seq((*seq_lines)[i % n_inputs], true, true);
+                keepValue(seq);
+            }
+        };
+    });
+
+    // Each operation reads a sequence in batches of 64 sequences.
+    registry.add("FASTQFileReader/readSequences", []
+    {
+        using FASTQFileReaderType = hts::FASTQFileReader<SeqType, bool, bool>;
+        auto file = std::make_shared<TempInputFile>(getFASTQFileLines());
+        auto reader = std::make_shared<FASTQFileReaderType>(file->path, "unix", true, true);
+        return [file, reader](std::size_t n_ops)
+        {
+            static constexpr std::size_t n_batch_seqs {64};
+            for(std::size_t n_read_seqs = 0; n_read_seqs < n_ops; )
+            {
+                auto seqs = reader->readSequences(std::min(n_batch_seqs, n_ops-n_read_seqs));
+                if(seqs.empty()) reader->resetStream();
+                n_read_seqs += seqs.size();
+                keepValue(seqs);
+            }
+        };
+    });
+
+    // Each operation adds a copy of a sequence, and the demultiplexed
+    // sequences are written to the null device in groups of 1000 sequences.
+    registry.add("FASTQSequenceDemuxer/addSequence", []
+    {
+        InputGenerator generator;
+        hts::WellBarcodeTable well_barcode_table = InputGenerator::getWellBarcodeTable();
+        hts::FASTQFileGroupOutputStreams output_streams;
+        for(const auto& well_barcode : well_barcode_table)
+        {
+            auto& output_stream = output_streams[well_barcode.second];
+            output_stream.open(null_device_path);
+            if(!output_stream.is_open()) throw std::runtime_error("Cannot open output file " + null_device_path);
+        }
+        auto seqs = std::make_shared<std::vector<SeqType>>();
+        for(std::size_t i = 0; i < n_inputs; ++i) seqs->emplace_back(generator.getFASTQSequenceLines(), true, true);
+        auto demuxer = std::make_shared<hts::DGEIlluminaFASTQSequenceDemuxer>(well_barcode_table, std::move(output_streams), 1000, false);
+        return [seqs, demuxer](std::size_t n_ops)
+        {
+            for(std::size_t i = 0; i < n_ops; ++i) demuxer->addSequence((*seqs)[i % n_inputs]);
+        };
+    });
+}
+
+/// Add the benchmarks of counting unique gene-UMI combinations.
+static void addGeneUMIPoolBenchmarks(MicroBenchmarkRegistry& registry)
+{
+    // Each key is drawn from half as many distinct gene-UMI combinations, and
+    // the gene-UMI pool is renewed after all keys are counted, so that more
+    // than half of the insertions find a duplicate.
+    registry.add("SAMGeneUMIAlignmentCounter/gene_umi_pool/insert", []
+    {
+        InputGenerator generator;
+        std::vector<hts::GeneUMILocusKey> distinct_keys(n_inputs/2);
+        for(auto& key : distinct_keys)
+        {
+            key.target_gene = generator.getGene();
+            key.umi_barcode = generator.randomBases(hts::DGEIlluminaFASTQSequence::umi_barcode_length);
+        }
+        auto keys = std::make_shared<std::vector<hts::GeneUMILocusKey>>();
+        for(std::size_t i = 0; i < n_inputs; ++i) keys->push_back(distinct_keys[generator.getIndex(distinct_keys.size())]);
+        auto counter = std::make_shared<std::unique_ptr<hts::SAMGeneUMIAlignmentCounter>>();
+        return [keys, counter](std::size_t n_ops)
+        {
+            bool aux_count = false;
+            for(std::size_t i = 0; i < n_ops; ++i)
+            {
+                if(i % n_inputs == 0) *counter = std::make_unique<hts::SAMGeneUMIAlignmentCounter>();
+                keepValue((*counter)->countAlignmentKey((*keys)[i % n_inputs], aux_count));
+            }
+        };
+    });
+
+    // A single densely tagged gene is filled with distinct UMI barcodes up to
+    // the break-even size of its bitmap, and is renewed after that, so that
+    // the insertions cover the whole sparse layout and its conversion.
+    registry.add("AdaptiveUMIContainer/fill_gene", []
+    {
+        std::size_t n_code_bits = hts::UMIBarcodePacker::getNumberOfBits(hts::DGEIlluminaFASTQSequence::umi_barcode_length);
+        std::vector<hts::AdaptiveUMIContainer::CodeType> all_codes(std::size_t(1) << n_code_bits);
+        for(std::size_t code = 0; code < all_codes.size(); ++code) all_codes[code] = static_cast<hts::AdaptiveUMIContainer::CodeType>(code);
+        std::shuffle(all_codes.begin(), all_codes.end(), std::mt19937_64(input_seed));
+        all_codes.resize(hts::AdaptiveUMIContainer::getBreakEvenArraySize(n_code_bits));
+        auto codes = std::make_shared<std::vector<hts::AdaptiveUMIContainer::CodeType>>(std::move(all_codes));
+        auto container = std::make_shared<hts::AdaptiveUMIContainer>(n_code_bits);
+        return [codes, container, n_code_bits](std::size_t n_ops)
+        {
+            for(std::size_t i = 0; i < n_ops; ++i)
+            {
+                if(i % codes->size() == 0) *container = hts::AdaptiveUMIContainer(n_code_bits);
+                keepValue(container->insert((*codes)[i % codes->size()]));
+            }
+        };
+    });
+}
+
+/// Add the benchmarks of the SIMD kernels selected for the running CPU.
+static void addSIMDKernelBenchmarks(MicroBenchmarkRegistry& registry)
+{
+    registry.add("findLastSubstring/XN", []
+    {
+        auto lines = std::make_shared<std::vector<std::string>>(getAlignmentLines());
+        return [lines](std::size_t n_ops)
+        {
+            for(std::size_t i = 0; i < n_ops; ++i) keepValue(utk::findLastSubstring((*lines)[i % n_inputs], "\tXN:"));
+        };
+    });
+
+    registry.add("findCharPositions/tab", []
+    {
+        auto lines = std::make_shared<std::vector<std::string>>(getAlignmentLines());
+        auto positions = std::make_shared<std::vector<std::size_t>>();
+        return [lines, positions](std::size_t n_ops)
+        {
+            for(std::size_t i = 0; i < n_ops; ++i)
+            {
+                positions->clear();
+                utk::findCharPositions((*lines)[i % n_inputs], '\t', *positions);
+                keepValue(positions->size());
+            }
+        };
+    });
+
+    registry.add("UMIBarcodePacker/pack", []
+    {
+        InputGenerator generator;
+        auto umi_barcodes = std::make_shared<std::vector<std::string>>();
+        for(std::size_t i = 0; i < n_inputs; ++i) umi_barcodes->push_back(generator.randomBases(hts::DGEIlluminaFASTQSequence::umi_barcode_length));
+        return [umi_barcodes](std::size_t n_ops)
+        {
+            hts::UMIBarcodePacker::CodeType code = 0;
+            for(std::size_t i = 0; i < n_ops; ++i) keepValue(hts::UMIBarcodePacker::pack((*umi_barcodes)[i % n_inputs], code) ? code : 0);
+        };
+    });
+
+    // The filter is renewed after all values are inserted, so that it stays
+    // at the expected load.
+    registry.add("BlockedBloomFilter/insert", []
+    {
+        std::mt19937_64 engine {input_seed};
+        auto values = std::make_shared<std::vector<std::uint64_t>>();
+        for(std::size_t i = 0; i < n_inputs; ++i) values->push_back(utk::BlockedBloomFilter::mixHash(engine()));
+        auto filter = std::make_shared<std::unique_ptr<utk::BlockedBloomFilter>>();
+        return [values, filter](std::size_t n_ops)
+        {
+            for(std::size_t i = 0; i < n_ops; ++i)
+            {
+                if(i % n_inputs == 0) *filter = std::make_unique<utk::BlockedBloomFilter>(n_inputs, 0.001);
+                keepValue((*filter)->insert((*values)[i % n_inputs]));
+            }
+        };
+    });
+}
+
+/// Add the benchmarks of the hot paths of utk and hts.
+void addHTSBenchmarks(MicroBenchmarkRegistry& registry)
+{
+    addLineReaderBenchmarks(registry);
+    addStringUtilsBenchmarks(registry);
+    addSAMAlignmentLineBenchmarks(registry);
+    addFASTQSequenceBenchmarks(registry);
+    addGeneUMIPoolBenchmarks(registry);
+    addSIMDKernelBenchmarks(registry);
+}
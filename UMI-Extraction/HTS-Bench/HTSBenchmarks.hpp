@@ -0,0 +1,25 @@
+//
+//  HTSBenchmarks.hpp
+//  HTS-Bench
+//
+//  Created on 10/18/26.
+//
+
+#ifndef HTSBenchmarks_hpp
+#define HTSBenchmarks_hpp
+
+#include <MicroBenchmark.hpp>
+
+/// \brief Add the benchmarks of the hot paths of utk and hts.
+/// The benchmarks cover reading lines and FASTQ sequences, splitting and
+/// converting strings, parsing SAM alignment lines and composite DGE FASTQ
+/// sequences, demultiplexing FASTQ sequences, and inserting gene-UMI
+/// combinations into the gene-UMI pool.
+///
+/// The inputs are synthetic featureCounts alignment lines and composite DGE
+/// Illumina FASTQ sequences drawn with a fixed seed, so that every run
+/// measures the same operations. The input files are created in TMPDIR, or
+/// /tmp, and removed after each benchmark.
+void addHTSBenchmarks(MicroBenchmarkRegistry& registry);
+
+#endif /* HTSBenchmarks_hpp */
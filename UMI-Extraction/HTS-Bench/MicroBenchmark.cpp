@@ -0,0 +1,232 @@
+//
+//  MicroBenchmark.cpp
+//  HTS-Bench
+//
+//  Created on 10/18/26.
+//
+
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utk/AllocationTracker.hpp>
+#include <MicroBenchmark.hpp>
+
+// The global operator new is replaced by the allocation tracker of utk when
+// it is compiled in, whose total counts are used instead.
+#ifndef UTK_ALLOCATION_TRACKING
+
+/// Counts of heap allocations of the program.
+static std::atomic<std::uint64_t> n_heap_allocs {0};
+static std::atomic<std::uint64_t> n_heap_bytes {0};
+
+/// Allocate heap memory and count the allocation.
+static void* allocateCounted(std::size_t size)
+{
+    n_heap_allocs.fetch_add(1, std::memory_order_relaxed);
+    n_heap_bytes.fetch_add(size, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+/// Allocate aligned heap memory and count the allocation.
+static void* allocateCounted(std::size_t size, std::align_val_t alignment)
+{
+    n_heap_allocs.fetch_add(1, std::memory_order_relaxed);
+    n_heap_bytes.fetch_add(size, std::memory_order_relaxed);
+    std::size_t align = std::max(static_cast<std::size_t>(alignment), sizeof(void*));
+    void* ptr = nullptr;
+#if defined(_WIN32)
+    ptr = _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+    if(posix_memalign(&ptr, align, size == 0 ? 1 : size) != 0) ptr = nullptr;
+#endif
+    return ptr;
+}
+
+/// Free aligned heap memory.
+static void freeAligned(void* ptr) noexcept
+{
+#if defined(_WIN32)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+void* operator new(std::size_t size)
+{
+    if(void* ptr = allocateCounted(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    if(void* ptr = allocateCounted(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocateCounted(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocateCounted(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if(void* ptr = allocateCounted(size, alignment)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    if(void* ptr = allocateCounted(size, alignment)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    freeAligned(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+    freeAligned(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    freeAligned(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    freeAligned(ptr);
+}
+
+#endif
+
+/// Get the counts of heap allocations made so far by the program.
+AllocationCounts getAllocationCounts()
+{
+    AllocationCounts counts;
+#ifdef UTK_ALLOCATION_TRACKING
+    utk::AllocationCounts total_counts = utk::AllocationTracker::getTotalCounts();
+    counts.n_allocs = total_counts.n_allocs;
+    counts.n_bytes = total_counts.n_bytes;
+#else
+    counts.n_allocs = n_heap_allocs.load(std::memory_order_relaxed);
+    counts.n_bytes = n_heap_bytes.load(std::memory_order_relaxed);
+#endif
+    return counts;
+}
+
+/// Run a body once and measure its time, allocations, and hardware events.
+MicroBenchmarkResult MicroBenchmarkRegistry::runOnce(const BodyType& body, std::size_t n_ops, utk::HardwareCounters* counters)
+{
+    using ClockType = std::chrono::steady_clock;
+    AllocationCounts begin_counts = getAllocationCounts();
+    if(counters != nullptr) counters->start();
+    ClockType::time_point begin_time = ClockType::now();
+    body(n_ops);
+    ClockType::time_point end_time = ClockType::now();
+    if(counters != nullptr) counters->stop();
+    AllocationCounts end_counts = getAllocationCounts();
+
+    MicroBenchmarkResult result;
+    result.n_ops = n_ops;
+    result.ns_per_op = std::chrono::duration<double, std::nano>(end_time-begin_time).count() / static_cast<double>(n_ops);
+    result.bytes_per_op = static_cast<double>(end_counts.n_bytes-begin_counts.n_bytes) / static_cast<double>(n_ops);
+    result.allocs_per_op = static_cast<double>(end_counts.n_allocs-begin_counts.n_allocs) / static_cast<double>(n_ops);
+    result.counts_per_op.fill(std::numeric_limits<double>::quiet_NaN());
+    if(counters != nullptr)
+    {
+        result.counts_per_op = counters->read();
+        for(double& count : result.counts_per_op) count /= static_cast<double>(n_ops);
+    }
+    return result;
+}
+
+/// Add a benchmark.
+void MicroBenchmarkRegistry::add(const std::string& name, SetupType setup)
+{
+    benchmarks.push_back({name, std::move(setup)});
+}
+
+/// Run the benchmarks whose names contain a filter.
+std::vector<MicroBenchmarkResult> MicroBenchmarkRegistry::run(const std::string& filter, double min_seconds, std::size_t n_repetitions, std::ostream& out, utk::HardwareCounters* counters) const
+{
+    // Limit of the number of operations of a run.
+    static constexpr std::size_t max_n_ops {std::size_t(1) << 30};
+
+    std::size_t name_width = 9;
+    for(const auto& benchmark : benchmarks) name_width = std::max(name_width, benchmark.name.size());
+    std::vector<MicroBenchmarkResult> results;
+    for(const auto& benchmark : benchmarks)
+    {
+        if(!filter.empty() && benchmark.name.find(filter) == std::string::npos) continue;
+        if(results.empty())
+        {
+            out << std::left << std::setw(static_cast<int>(name_width)) << "Benchmark" << std::right << std::setw(12) << "Operations" << std::setw(12) << "ns/op" << std::setw(12) << "B/op" << std::setw(12) << "allocs/op";
+            if(counters != nullptr)
+            {
+                for(std::size_t event = 0; event < utk::HardwareCounters::n_events; ++event) out << std::setw(18) << std::string(utk::HardwareCounters::getEventName(event)) + "/op";
+            }
+            out << '\n' << std::fixed;
+        }
+        BodyType body = benchmark.setup();
+
+        // Double the number of operations until a run is long enough, which
+        // also warms up the caches and the inputs of the body.
+        std::size_t n_ops = 1;
+        while(n_ops < max_n_ops && runOnce(body, n_ops, nullptr).ns_per_op*static_cast<double>(n_ops) < min_seconds*1e9) n_ops *= 2;
+
+        // Report the run of the median time.
+        std::vector<MicroBenchmarkResult> runs;
+        for(std::size_t i = 0; i < std::max(n_repetitions, std::size_t(1)); ++i) runs.push_back(runOnce(body, n_ops, counters));
+        auto median_run = runs.begin() + static_cast<std::ptrdiff_t>(runs.size()/2);
+        std::nth_element(runs.begin(), median_run, runs.end(), [](const MicroBenchmarkResult& a, const MicroBenchmarkResult& b) { return a.ns_per_op < b.ns_per_op; });
+        MicroBenchmarkResult result = *median_run;
+        result.name = benchmark.name;
+
+        out << std::left << std::setw(static_cast<int>(name_width)) << result.name << std::right << std::setw(12) << result.n_ops << std::setprecision(1) << std::setw(12) << result.ns_per_op << std::setw(12) << result.bytes_per_op << std::setprecision(2) << std::setw(12) << result.allocs_per_op;
+        if(counters != nullptr)
+        {
+            for(double count : result.counts_per_op)
+            {
+                if(std::isnan(count)) out << std::setw(18) << "n/a";
+                else out << std::setw(18) << count;
+            }
+        }
+        out << std::endl;
+        results.push_back(std::move(result));
+    }
+    return results;
+}
@@ -0,0 +1,120 @@
+//
+//  MicroBenchmark.hpp
+//  HTS-Bench
+//
+//  Created on 10/18/26.
+//
+
+#ifndef MicroBenchmark_hpp
+#define MicroBenchmark_hpp
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <functional>
+#include <utk/HardwareCounters.hpp>
+
+/// \brief Keep a value computed by a benchmark from being optimized away.
+template<typename T>
+inline void keepValue(const T& value)
+{
+#if defined(__GNUC__)
+    asm volatile("" : : "m"(value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+/// \brief Counts of the heap allocations made by the global operator new.
+struct AllocationCounts
+{
+    std::uint64_t n_allocs {0};
+    std::uint64_t n_bytes {0};
+};
+
+/// Get the counts of heap allocations made so far by the program.
+AllocationCounts getAllocationCounts();
+
+/// \brief The measurements of a benchmark.
+struct MicroBenchmarkResult
+{
+    std::string name;
+
+    /// Number of operations of each timed run.
+    std::size_t n_ops {0};
+
+    /// Median time of an operation among timed runs.
+    double ns_per_op {0};
+
+    /// Heap bytes and allocations of an operation in the median run.
+    double bytes_per_op {0};
+    double allocs_per_op {0};
+
+    /// Hardware event counts of an operation in the median run, or NaN for
+    /// the counters not collected or unavailable.
+    utk::HardwareCounters::CountsType counts_per_op;
+};
+
+/// \brief A registry of named microbenchmarks.
+/// Each benchmark is a setup function that prepares the inputs of a
+/// benchmark and returns its body, which performs a given number of
+/// operations. Neither the setup nor the destruction of the body is timed.
+///
+/// A benchmark is run in two steps:
+///
+/// 1) The number of operations is doubled until a run takes at least the
+///    minimum time.
+/// 2) The benchmark is run repeatedly with that number of operations, and
+///    the run of the median time is reported.
+///
+/// The heap allocations are counted by replacing the global operator new of
+/// the program, so that the allocations inside the standard library, e.g.
+/// by std::string and std::vector, are included. The hardware events, e.g.
+/// cycles and cache misses, are optionally counted around each run as well.
+class MicroBenchmarkRegistry
+{
+public:
+
+    /// Body of a benchmark to perform a number of operations.
+    using BodyType = std::function<void(std::size_t n_ops)>;
+
+    /// Setup of a benchmark returning its body.
+    using SetupType = std::function<BodyType()>;
+
+private:
+
+    struct MicroBenchmark
+    {
+        std::string name;
+        SetupType setup;
+    };
+
+    std::vector<MicroBenchmark> benchmarks;
+
+private:
+
+    /// Run a body once and measure its time, allocations, and hardware events.
+    static MicroBenchmarkResult runOnce(const BodyType& body, std::size_t n_ops, utk::HardwareCounters* counters);
+
+public:
+
+    /// Add a benchmark.
+    void add(const std::string& name, SetupType setup);
+
+    /// \brief Run the benchmarks whose names contain a filter.
+    /// \param  filter         A substring of the names of benchmarks to run,
+    ///                        or empty for all benchmarks.
+    /// \param  min_seconds    The minimum time of each timed run.
+    /// \param  n_repetitions  The number of timed runs of each benchmark.
+    /// \param  out            The output stream of a table of results, which
+    ///                        is written as each benchmark finishes.
+    /// \param  counters       The hardware counters of the calling thread,
+    ///                        or nullptr for no hardware events.
+    /// \return  The results of the benchmarks run.
+    std::vector<MicroBenchmarkResult> run(const std::string& filter, double min_seconds, std::size_t n_repetitions, std::ostream& out, utk::HardwareCounters* counters=nullptr) const;
+};
+
+#endif /* MicroBenchmark_hpp */
@@ -0,0 +1,103 @@
+//
+//  HTS-Perf.cpp
+//  HTS-Perf
+//
+//  Created on 10/18/26.
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <cstdlib>
+#include <cmath>
+#include <memory>
+#include <algorithm>
+#include <vector>
+#include <PerfWorkload.hpp>
+#include <PerfBaseline.hpp>
+#include <HTSPerfArguments.hpp>
+
+int main(int argc, const char *argv[])
+{
+    int exit_code = EXIT_SUCCESS;
+
+    try
+    {
+        // Retrieve input arguments from command line.
+        HTSPerfArguments args(argc, argv);
+        // Check input arguments.
+        args.check();
+
+        // Open the hardware counters inherited by the child processes of the
+        // workload if requested, which are reported as n/a when unavailable.
+        std::unique_ptr<utk::HardwareCounters> counters;
+        if(args.count_hardware_events)
+        {
+            counters = std::make_unique<utk::HardwareCounters>(true);
+            if(!counters->getUnavailableReason().empty()) std::cerr << "Warning: " << counters->getUnavailableReason() << std::endl;
+        }
+
+        // Run the workload in a child process repeatedly. The baseline is
+        // recorded from the run of the median throughput, and the run of the
+        // highest throughput is compared against it, so that a slow run on a
+        // busy machine isn't taken as a regression. Both take the highest
+        // peak memory of all runs.
+        std::vector<PerfMeasurement> runs;
+        for(std::size_t i = 0; i < args.n_repetitions; ++i)
+        {
+            runs.push_back(args.workload == "sam" ? runSAMAlignmentCounterWorkload(args.sam_alignment_counter_path, args.data_prefix, args.output_dir, counters.get()) : runFASTQDemuxWorkload(args.data_prefix, args.output_dir, counters.get()));
+            if(runs.back().checksum != runs.front().checksum) throw std::runtime_error("Output checksum of case " + args.case_name + " changes between runs");
+        }
+        std::sort(runs.begin(), runs.end(), [](const PerfMeasurement& a, const PerfMeasurement& b) { return a.records_per_second < b.records_per_second; });
+        PerfMeasurement measurement = args.update_baseline ? runs[runs.size()/2] : runs.back();
+        for(const auto& run : runs) measurement.peak_rss = std::max(measurement.peak_rss, run.peak_rss);
+        std::cout << "Case " << args.case_name << ": " << measurement.n_records << " records in " << measurement.seconds << " seconds, " << measurement.records_per_second << " records/s, peak RSS " << measurement.peak_rss << " bytes, checksum " << measurement.checksum << ", build type " << measurement.build_type << ", host " << measurement.host << ", CPU " << measurement.cpu << std::endl;
+        if(counters)
+        {
+            std::cout << "Hardware events per record of case " << args.case_name << ":";
+            for(std::size_t event = 0; event < utk::HardwareCounters::n_events; ++event)
+            {
+                std::cout << ' ' << utk::HardwareCounters::getEventName(event) << ' ';
+                if(std::isnan(measurement.counts_per_record[event])) std::cout << "n/a";
+                else std::cout << measurement.counts_per_record[event];
+            }
+            std::cout << std::endl;
+        }
+
+        // Record or compare against the baseline of the case.
+        PerfBaseline baseline(args.baseline_file_path);
+        if(args.update_baseline)
+        {
+            baseline.set(args.case_name, measurement);
+            baseline.write();
+            std::cout << "Update the baseline of case " << args.case_name << " in " << args.baseline_file_path << std::endl;
+        }
+        else if(const PerfMeasurement* case_baseline = baseline.find(args.case_name))
+        {
+            std::cout << "Baseline " << args.case_name << ": " << case_baseline->n_records << " records, " << case_baseline->records_per_second << " records/s, peak RSS " << case_baseline->peak_rss << " bytes, checksum " << case_baseline->checksum << ", build type " << case_baseline->build_type << ", host " << case_baseline->host << ", CPU " << case_baseline->cpu << std::endl;
+            // A baseline of another build or host is only checked for its
+            // records and checksum, which is reported as a warning.
+            for(const auto& change : findPerfEnvironmentChanges(measurement, *case_baseline)) std::cerr << "Warning: " << change << std::endl;
+            std::vector<std::string> regressions = findPerfRegressions(measurement, *case_baseline, args.throughput_tolerance, args.memory_tolerance);
+            for(const auto& regression : regressions) std::cerr << "Regression: " << regression << std::endl;
+            if(!regressions.empty()) throw std::runtime_error("Case " + args.case_name + " regressed against its baseline");
+        }
+        else std::cout << "No baseline of case " << args.case_name << " in " << args.baseline_file_path << " to compare against" << std::endl;
+    }
+    catch (const std::logic_error& e)
+    {
+        std::cerr << "Logical error: " << e.what() << std::endl;
+        exit_code = EXIT_FAILURE;
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cerr << "Runtime error: " << e.what() << std::endl;
+        exit_code = EXIT_FAILURE;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Other error: " << e.what() << std::endl;
+        exit_code = EXIT_FAILURE;
+    }
+
+    return exit_code;
+}
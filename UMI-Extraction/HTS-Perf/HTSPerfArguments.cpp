@@ -0,0 +1,87 @@
+//
+//  HTSPerfArguments.cpp
+//  HTS-Perf
+//
+//  Created on 10/18/26.
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <utk/StringUtils.hpp>
+#include <HTSPerfArguments.hpp>
+
+/// Retrieve input arguments.
+HTSPerfArguments::HTSPerfArguments(int argc, const char** argv) :
+    utk::ProgramArguments(argc, argv, 6, 12),
+    throughput_tolerance{0.5},
+    memory_tolerance{0.3},
+    n_repetitions{3},
+    update_baseline{false},
+    sam_alignment_counter_path{},
+    count_hardware_events{false} {}
+
+/// Assign mandatory input arguments
+void HTSPerfArguments::assignMandatoryArguments()
+{
+    // Assign mandatory arguments.
+    workload = utk::toLowerString(argv[1]);
+    data_prefix = argv[2];
+    output_dir = argv[3];
+    baseline_file_path = argv[4];
+    case_name = argv[5];
+}
+
+/// Assign optional input arguments
+void HTSPerfArguments::assignOptionalArguments()
+{
+    // Assign optional arguments.
+    // 6th argument.
+    if(argc > 6) throughput_tolerance = utk::convert<double>(argv[6]);
+    // 7th argument.
+    if(argc > 7) memory_tolerance = utk::convert<double>(argv[7]);
+    // 8th argument.
+    if(argc > 8) n_repetitions = utk::convert<std::size_t>(argv[8]);
+    // 9th argument.
+    if(argc > 9) update_baseline = utk::convert<bool>(argv[9]);
+    // 10th argument.
+    if(argc > 10) sam_alignment_counter_path = argv[10];
+    // 11th argument.
+    if(argc > 11) count_hardware_events = utk::convert<bool>(argv[11]);
+}
+
+/// Validate input arguments
+void HTSPerfArguments::validateArguments()
+{
+    // Check the workload.
+    if(workload != "sam" && workload != "fastq") throw std::logic_error("Workload must be sam or fastq");
+
+    // Check the SAM-Alignment-Counter executable of the sam workload.
+    if(workload == "sam" && sam_alignment_counter_path.empty()) throw std::logic_error("SAM-Alignment-Counter must be given for the sam workload");
+
+    // Check the case name.
+    if(case_name.empty()) throw std::logic_error("Case Name must not be empty");
+
+    // Check the tolerances.
+    if(!(throughput_tolerance >= 0 && throughput_tolerance < 1)) throw std::logic_error("Throughput Tolerance must be in [0, 1)");
+    if(!(memory_tolerance >= 0)) throw std::logic_error("Memory Tolerance must be non-negative");
+
+    // Check the number of runs.
+    if(n_repetitions < 1) throw std::logic_error("Repetitions must be at least 1");
+}
+
+/// Print help messages on program usage.
+void HTSPerfArguments::helpMessage()
+{
+    std::cerr << "Usage: " << prog_name << " [Workload] [Data Prefix] [Output Directory] [Baseline File] [Case Name] [Throughput Tolerance] [Memory Tolerance] [Repetitions] [Update Baseline] [SAM-Alignment-Counter] [Hardware Counters]" << '\n';
+    std::cerr << "       " << "[Workload]: sam for running SAM-Alignment-Counter on the SAM file of the dataset, or fastq for demultiplexing the paired FASTQ files of the dataset." << '\n';
+    std::cerr << "       " << "[Data Prefix]: the output prefix of a synthetic dataset generated by DGE-Data-Generator with both output types." << '\n';
+    std::cerr << "       " << "[Output Directory]: an existing directory of the output files of the workload." << '\n';
+    std::cerr << "       " << "[Baseline File]: a JSON file of the baseline records, records per second, peak resident memory, and output checksum of each case." << '\n';
+    std::cerr << "       " << "[Case Name]: the name of the case in Baseline File." << '\n';
+    std::cerr << "       " << "[Throughput Tolerance]: the allowed fraction of records per second below the baseline (Default: 0.5)." << '\n';
+    std::cerr << "       " << "[Memory Tolerance]: the allowed fraction of peak resident memory above the baseline (Default: 0.3)." << '\n';
+    std::cerr << "       " << "[Repetitions]: the number of runs of the workload, of which the run of the highest throughput is compared against the baseline, or the run of the median throughput is recorded as the baseline (Default: 3)." << '\n';
+    std::cerr << "       " << "[Update Baseline]: indicator for replacing the baseline of the case with the measurement instead of comparing against it (Default: false)." << '\n';
+    std::cerr << "       " << "[SAM-Alignment-Counter]: the path of the SAM-Alignment-Counter executable, required by the sam workload (Default: empty)." << '\n';
+    std::cerr << "       " << "[Hardware Counters]: indicator for counting the cycles, instructions, L1 data cache misses, last-level cache misses, branch misses, and data TLB misses per record of the workload by Linux perf events, which are reported as n/a when unavailable (Default: false)." << std::endl;
+}
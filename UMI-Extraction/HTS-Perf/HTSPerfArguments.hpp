@@ -0,0 +1,79 @@
+//
+//  HTSPerfArguments.hpp
+//  HTS-Perf
+//
+//  Created on 10/18/26.
+//
+
+#ifndef HTSPerfArguments_hpp
+#define HTSPerfArguments_hpp
+
+#include <string>
+#include <cstddef>
+#include <utk/ProgramArguments.hpp>
+
+/// \brief HTSPerfArguments checks input arguments for entire program
+/// This class takes input arguments of main function, checks their validity,
+/// and store them in corresponding member variables.
+class HTSPerfArguments : public utk::ProgramArguments
+{
+public:
+
+    /// \brief Workload to run: sam for SAM-Alignment-Counter, or fastq for
+    /// the FASTQ demux path.
+    std::string workload;
+
+    /// \brief Output prefix of the synthetic dataset of DGE-Data-Generator.
+    std::string data_prefix;
+
+    /// \brief Directory of output files of the workload.
+    std::string output_dir;
+
+    /// \brief JSON file of baseline measurements.
+    std::string baseline_file_path;
+
+    /// \brief Name of the perf case in the baseline file.
+    std::string case_name;
+
+    /// \brief Allowed fraction of throughput below the baseline.
+    double throughput_tolerance;
+
+    /// \brief Allowed fraction of peak resident memory above the baseline.
+    double memory_tolerance;
+
+    /// \brief Number of runs of the workload.
+    /// The run of the highest throughput is compared against the baseline,
+    /// and the run of the median throughput is recorded as the baseline.
+    std::size_t n_repetitions;
+
+    /// \brief Flag for replacing the baseline of the case with the
+    /// measurement instead of comparing against it.
+    bool update_baseline;
+
+    /// \brief Path of the SAM-Alignment-Counter executable.
+    std::string sam_alignment_counter_path;
+
+    /// \brief Flag for counting hardware events of the workload.
+    bool count_hardware_events;
+
+protected:
+
+    /// \brief Help messages on program usage
+    virtual void helpMessage() override;
+
+    /// \brief Assign mandatory input arguments
+    virtual void assignMandatoryArguments() override;
+
+    /// \brief Assign optional input arguments
+    virtual void assignOptionalArguments() override;
+
+    /// \brief Validate input arguments
+    virtual void validateArguments() override;
+
+public:
+
+    /// \brief Retrieve input arguments
+    HTSPerfArguments(int argc, const char** argv);
+};
+
+#endif /* HTSPerfArguments_hpp */
@@ -0,0 +1,126 @@
+//
+//  PerfBaseline.cpp
+//  HTS-Perf
+//
+//  Created on 10/18/26.
+//
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utk/FileUtils.hpp>
+#include <utk/JSONValue.hpp>
+#include <utk/JSONWriter.hpp>
+#include <PerfBaseline.hpp>
+
+/// Read the baseline file.
+PerfBaseline::PerfBaseline(const std::string& file_path) : file_path{file_path}
+{
+    if(!utk::isFileReadable(file_path)) return;
+    utk::JSONValue document = utk::JSONValue::readFile(file_path);
+    for(const auto& perf_case : document.at("cases").getObject())
+    {
+        const utk::JSONValue& value = perf_case.second;
+        PerfMeasurement measurement;
+        measurement.n_records = static_cast<std::uint64_t>(value.at("records").getNumber());
+        measurement.records_per_second = value.at("records_per_second").getNumber();
+        measurement.peak_rss = static_cast<std::size_t>(value.at("peak_rss_bytes").getNumber());
+        measurement.checksum = value.at("checksum").getString();
+        // Baselines recorded without their build type and host have them
+        // empty.
+        if(const utk::JSONValue* build_type = value.find("build_type")) measurement.build_type = build_type->getString();
+        if(const utk::JSONValue* host = value.find("host")) measurement.host = host->getString();
+        if(const utk::JSONValue* cpu = value.find("cpu")) measurement.cpu = cpu->getString();
+        measurements[perf_case.first] = measurement;
+    }
+}
+
+/// Find the baseline measurement of a case.
+const PerfMeasurement* PerfBaseline::find(const std::string& case_name) const
+{
+    auto search = measurements.find(case_name);
+    return search != measurements.end() ? &search->second : nullptr;
+}
+
+/// Set the baseline measurement of a case.
+void PerfBaseline::set(const std::string& case_name, const PerfMeasurement& measurement)
+{
+    measurements[case_name] = measurement;
+}
+
+/// Write all baseline measurements back to the baseline file.
+void PerfBaseline::write() const
+{
+    // Write a temporary file first so that a failed write keeps the old file.
+    std::string temp_file_path = file_path + ".tmp";
+    {
+        std::ofstream file(temp_file_path);
+        if(!file.is_open()) throw std::runtime_error("Cannot open output file " + temp_file_path);
+        utk::JSONWriter writer(file);
+        writer.beginObject().key("cases").beginObject();
+        for(const auto& measurement : measurements)
+        {
+            writer.key(measurement.first).beginObject();
+            writer.member("records", measurement.second.n_records);
+            writer.member("records_per_second", measurement.second.records_per_second);
+            writer.member("peak_rss_bytes", measurement.second.peak_rss);
+            writer.member("checksum", measurement.second.checksum);
+            writer.member("build_type", measurement.second.build_type);
+            writer.member("host", measurement.second.host);
+            writer.member("cpu", measurement.second.cpu);
+            writer.endObject();
+        }
+        writer.endObject().endObject();
+        if(!file) throw std::runtime_error("Cannot write output file " + temp_file_path);
+    }
+    utk::renameFile(temp_file_path, file_path);
+}
+
+/// Compare a measurement against its baseline.
+std::vector<std::string> findPerfRegressions(const PerfMeasurement& measurement, const PerfMeasurement& baseline, double throughput_tolerance, double memory_tolerance)
+{
+    std::vector<std::string> regressions;
+    if(measurement.n_records != baseline.n_records)
+    {
+        regressions.push_back("records " + std::to_string(measurement.n_records) + " differ from baseline " + std::to_string(baseline.n_records));
+    }
+    if(measurement.checksum != baseline.checksum)
+    {
+        regressions.push_back("output checksum " + measurement.checksum + " differs from baseline " + baseline.checksum);
+    }
+    if(measurement.build_type != baseline.build_type || measurement.host != baseline.host || measurement.cpu != baseline.cpu) return regressions;
+    if(measurement.records_per_second < baseline.records_per_second*(1-throughput_tolerance))
+    {
+        std::ostringstream regression;
+        regression << "throughput " << measurement.records_per_second << " records/s is " << 100*(1-measurement.records_per_second/baseline.records_per_second) << "% below baseline " << baseline.records_per_second << " records/s";
+        regressions.push_back(regression.str());
+    }
+    if(static_cast<double>(measurement.peak_rss) > static_cast<double>(baseline.peak_rss)*(1+memory_tolerance))
+    {
+        std::ostringstream regression;
+        regression << "peak RSS " << measurement.peak_rss << " bytes is " << 100*(static_cast<double>(measurement.peak_rss)/static_cast<double>(baseline.peak_rss)-1) << "% above baseline " << baseline.peak_rss << " bytes";
+        regressions.push_back(regression.str());
+    }
+    return regressions;
+}
+
+/// Compare the build type and host of a measurement against those of its
+/// baseline.
+std::vector<std::string> findPerfEnvironmentChanges(const PerfMeasurement& measurement, const PerfMeasurement& baseline)
+{
+    std::vector<std::string> changes;
+    auto describe = [](const std::string& value) { return value.empty() ? std::string("none") : '"' + value + '"'; };
+    if(measurement.build_type != baseline.build_type)
+    {
+        changes.push_back("build type " + describe(measurement.build_type) + " differs from baseline " + describe(baseline.build_type) + ", so that throughput and peak RSS are not compared");
+    }
+    if(measurement.host != baseline.host)
+    {
+        changes.push_back("host " + describe(measurement.host) + " differs from baseline " + describe(baseline.host) + ", so that throughput and peak RSS are not compared");
+    }
+    if(measurement.cpu != baseline.cpu)
+    {
+        changes.push_back("CPU " + describe(measurement.cpu) + " differs from baseline " + describe(baseline.cpu) + ", so that throughput and peak RSS are not compared");
+    }
+    return changes;
+}
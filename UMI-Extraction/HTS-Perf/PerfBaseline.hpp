@@ -0,0 +1,76 @@
+//
+//  PerfBaseline.hpp
+//  HTS-Perf
+//
+//  Created on 10/18/26.
+//
+
+#ifndef PerfBaseline_hpp
+#define PerfBaseline_hpp
+
+#include <map>
+#include <string>
+#include <vector>
+#include <PerfWorkload.hpp>
+
+/// \brief The baseline measurements of perf cases kept in a JSON file.
+/// The file holds an object of cases keyed by their names, each with the
+/// number of records, records per second, peak resident set size in bytes,
+/// and output checksum of a reference run, together with the build type,
+/// host name, and CPU model of that run, e.g.
+///
+///     {
+///       "cases": {
+///         "SAM-Alignment-Counter/16MB": {
+///           "records": 68423,
+///           "records_per_second": 41000.5,
+///           "peak_rss_bytes": 10485760,
+///           "checksum": "5b1e0c5f2d3a4e71",
+///           "build_type": "Release",
+///           "host": "perf-node-01",
+///           "cpu": "Intel(R) Xeon(R) Gold 6248 CPU @ 2.50GHz"
+///         }
+///       }
+///     }
+class PerfBaseline
+{
+private:
+
+    std::string file_path;
+
+    std::map<std::string, PerfMeasurement> measurements;
+
+public:
+
+    /// \brief Read the baseline file, or start an empty baseline if it
+    /// doesn't exist.
+    explicit PerfBaseline(const std::string& file_path);
+
+    /// Find the baseline measurement of a case, or return nullptr if absent.
+    const PerfMeasurement* find(const std::string& case_name) const;
+
+    /// Set the baseline measurement of a case.
+    void set(const std::string& case_name, const PerfMeasurement& measurement);
+
+    /// Write all baseline measurements back to the baseline file.
+    void write() const;
+};
+
+/// \brief Compare a measurement against its baseline.
+/// A regression is a different number of records or output checksum, a
+/// throughput below the baseline by more than the throughput tolerance, or a
+/// peak resident set size above the baseline by more than the memory
+/// tolerance, where both tolerances are fractions of the baseline.
+/// Note: the throughput and peak resident set size are compared only if the
+/// baseline was recorded with the same build type on the same host and CPU,
+/// since a baseline of another build or machine, or of none recorded, guards
+/// nothing.
+/// \return  The descriptions of all regressions, or none.
+std::vector<std::string> findPerfRegressions(const PerfMeasurement& measurement, const PerfMeasurement& baseline, double throughput_tolerance, double memory_tolerance);
+
+/// \brief Compare the build type and host of a measurement against those of
+/// its baseline.
+/// \return  The descriptions of all differences, or none.
+std::vector<std::string> findPerfEnvironmentChanges(const PerfMeasurement& measurement, const PerfMeasurement& baseline);
+
+#endif /* PerfBaseline_hpp */
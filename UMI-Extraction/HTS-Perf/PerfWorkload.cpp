@@ -0,0 +1,230 @@
+//
+//  PerfWorkload.cpp
+//  HTS-Perf
+//
+//  Created on 10/18/26.
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include <utk/FileUtils.hpp>
+#include <utk/SystemProperties.hpp>
+#include <utk/Tracer.hpp>
+#include <hts/DGEIlluminaFASTQFile.hpp>
+#include <hts/DGEIlluminaFASTQSequenceDemuxer.hpp>
+#include <hts/PairedFASTQSequencePipe.hpp>
+#include <hts/FASTQSequenceDemuxController.hpp>
+#include <PerfWorkload.hpp>
+
+/// The wall time, peak memory, and hardware events of a child process.
+struct ChildProcessUsage
+{
+    double seconds {0};
+    std::size_t peak_rss {0};
+    utk::HardwareCounters::CountsType counts;
+};
+
+/// \brief Run a function in a child process and measure its usage.
+/// The child process exits with the return value of the function, so that
+/// its peak resident set size covers only the workload, not the parent. The
+/// hardware counters opened with inheritance count the child process and
+/// its threads, whose counts are added to them when the child exits.
+/// Note: the calling process must have a single thread.
+template<typename BodyType>
+static ChildProcessUsage runChildProcess(const BodyType& body, utk::HardwareCounters* counters)
+{
+    using ClockType = std::chrono::steady_clock;
+    std::cout.flush();
+    std::cerr.flush();
+    if(counters != nullptr) counters->start();
+    ClockType::time_point begin_time = ClockType::now();
+    pid_t pid = fork();
+    if(pid < 0) throw std::runtime_error("Cannot create a child process of the workload");
+    if(pid == 0)
+    {
+        int exit_code = EXIT_FAILURE;
+        try
+        {
+            exit_code = body();
+        } catch(const std::exception& e)
+        {
+            std::cerr << "Workload error: " << e.what() << std::endl;
+        }
+        std::cout.flush();
+        std::cerr.flush();
+        std::_Exit(exit_code);
+    }
+
+    int status = 0;
+    rusage usage {};
+    if(wait4(pid, &status, 0, &usage) != pid) throw std::runtime_error("Cannot wait for the child process of the workload");
+    ClockType::time_point end_time = ClockType::now();
+    if(counters != nullptr) counters->stop();
+    if(!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) throw std::runtime_error("The child process of the workload failed");
+
+    ChildProcessUsage child_usage;
+    child_usage.seconds = std::chrono::duration<double>(end_time-begin_time).count();
+    child_usage.counts.fill(std::numeric_limits<double>::quiet_NaN());
+    if(counters != nullptr) child_usage.counts = counters->read();
+#ifdef __APPLE__
+    // macOS reports the size in bytes.
+    child_usage.peak_rss = static_cast<std::size_t>(usage.ru_maxrss);
+#else
+    // Linux reports the size in kilobytes.
+    child_usage.peak_rss = static_cast<std::size_t>(usage.ru_maxrss)*1024;
+#endif
+    return child_usage;
+}
+
+/// \brief Compute the checksum of the names and contents of files.
+/// The 64-bit FNV-1a hash is computed over the name of each file followed by
+/// a null character and its content, in the given order of files.
+static std::string checksumFiles(const std::vector<std::string>& file_paths)
+{
+    std::uint64_t hash = 14695981039346656037ULL;
+    auto update = [&hash](const char* data, std::size_t size)
+    {
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 1099511628211ULL;
+        }
+    };
+
+    std::vector<char> buffer(std::size_t(1) << 20);
+    for(const auto& file_path : file_paths)
+    {
+        std::string file_name = std::get<0>(utk::extractFileNameDirectory(file_path));
+        update(file_name.c_str(), file_name.size()+1);
+        std::ifstream file(file_path, std::ios::binary);
+        if(!file.is_open()) throw std::runtime_error("Cannot open output file " + file_path);
+        while(file.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || file.gcount() > 0)
+        {
+            update(buffer.data(), static_cast<std::size_t>(file.gcount()));
+        }
+    }
+
+    char checksum[17];
+    std::snprintf(checksum, sizeof(checksum), "%016llx", static_cast<unsigned long long>(hash));
+    return checksum;
+}
+
+/// Count the lines of a file, excluding the header lines starting with @.
+static std::uint64_t countLines(const std::string& file_path, bool skip_header)
+{
+    std::ifstream file(file_path);
+    if(!file.is_open()) throw std::runtime_error("Cannot open input file " + file_path);
+    std::uint64_t n_lines = 0;
+    std::string line;
+    while(std::getline(file, line))
+    {
+        if(!(skip_header && !line.empty() && line[0] == '@')) ++n_lines;
+    }
+    return n_lines;
+}
+
+/// Fill in a measurement from the usage of a run.
+static PerfMeasurement makeMeasurement(std::uint64_t n_records, const ChildProcessUsage& usage, const std::vector<std::string>& output_file_paths)
+{
+    PerfMeasurement measurement;
+    measurement.n_records = n_records;
+    measurement.seconds = usage.seconds;
+    measurement.records_per_second = usage.seconds > 0 ? static_cast<double>(n_records)/usage.seconds : 0;
+    measurement.peak_rss = usage.peak_rss;
+    measurement.checksum = checksumFiles(output_file_paths);
+    measurement.counts_per_record = usage.counts;
+    for(double& count : measurement.counts_per_record) count /= static_cast<double>(n_records > 0 ? n_records : 1);
+    measurement.build_type = getPerfBuildType();
+    measurement.host = getPerfHostName();
+    measurement.cpu = getPerfCPUModel();
+    return measurement;
+}
+
+/// Build type of hts-perf and the workloads it runs.
+std::string getPerfBuildType()
+{
+    return HTS_PERF_BUILD_TYPE;
+}
+
+/// Name of the host running the workloads.
+std::string getPerfHostName()
+{
+    char host_name[256] {};
+    if(gethostname(host_name, sizeof(host_name)-1) != 0) return std::string();
+    return host_name;
+}
+
+/// Model name of the CPU of the host.
+std::string getPerfCPUModel()
+{
+    // Linux lists the model name of each processor in /proc/cpuinfo.
+    std::ifstream cpu_info("/proc/cpuinfo");
+    for(std::string line; std::getline(cpu_info, line);)
+    {
+        if(line.compare(0, 10, "model name") != 0) continue;
+        std::size_t pos = line.find(':');
+        if(pos == std::string::npos) break;
+        pos = line.find_first_not_of(' ', pos+1);
+        return pos != std::string::npos ? line.substr(pos) : std::string();
+    }
+    return std::string();
+}
+
+/// Measure a run of SAM-Alignment-Counter on a synthetic dataset.
+PerfMeasurement runSAMAlignmentCounterWorkload(const std::string& program_path, const std::string& data_prefix, const std::string& output_dir, utk::HardwareCounters* counters)
+{
+    std::string input_file_path = data_prefix + ".sam";
+    std::string output_file_path = output_dir + utk::FileSystem::path_sep + "SAM-Alignment-Counter.sam";
+    std::uint64_t n_records = countLines(input_file_path, true);
+
+    ChildProcessUsage usage = runChildProcess([&]
+    {
+        std::vector<char*> exec_args {const_cast<char*>(program_path.c_str()), const_cast<char*>(input_file_path.c_str()), const_cast<char*>(output_file_path.c_str()), nullptr};
+        execv(program_path.c_str(), exec_args.data());
+        std::cerr << "Cannot execute " << program_path << std::endl;
+        return 127;
+    }, counters);
+
+    return makeMeasurement(n_records, usage, {output_file_path});
+}
+
+/// Measure a run of the FASTQ demux path on a synthetic dataset.
+PerfMeasurement runFASTQDemuxWorkload(const std::string& data_prefix, const std::string& output_dir, utk::HardwareCounters* counters)
+{
+    std::string r1_fastq_file_path = data_prefix + "_R1.fastq";
+    std::string r2_fastq_file_path = data_prefix + "_R2.fastq";
+    std::string well_barcode_file_path = data_prefix + "_Well_Barcodes.tsv";
+    std::string demux_file_name = "FASTQ-Demux";
+    std::uint64_t n_records = countLines(r1_fastq_file_path, false)/4;
+
+    // Write the paths file of the paired FASTQ files after its header line.
+    std::string fastq_paths_file_path = output_dir + utk::FileSystem::path_sep + "FASTQ_Paths.tsv";
+    {
+        std::ofstream fastq_paths_file(fastq_paths_file_path);
+        if(!fastq_paths_file.is_open()) throw std::runtime_error("Cannot open output file " + fastq_paths_file_path);
+        fastq_paths_file << "Read1" << '\t' << "Read2" << '\n';
+        fastq_paths_file << r1_fastq_file_path << '\t' << r2_fastq_file_path << '\n';
+    }
+
+    ChildProcessUsage usage = runChildProcess([&]
+    {
+        hts::FASTQSequenceDemuxController<hts::PairedFASTQSequencePipe, hts::DGEIlluminaFASTQFile, hts::DGEIlluminaFASTQSequenceDemuxer> demux_controller(fastq_paths_file_path, well_barcode_file_path, demux_file_name, output_dir);
+        demux_controller.run(true);
+        if constexpr (utk::Tracer::enabled)
+        {
+            if(const char* trace_file_path = std::getenv("UTK_TRACE_FILE")) utk::Tracer::writeChromeTrace(std::string(trace_file_path));
+        }
+        return EXIT_SUCCESS;
+    }, counters);
+
+    return makeMeasurement(n_records, usage, utk::expandFilePattern(output_dir + utk::FileSystem::path_sep + demux_file_name + ".*.fastq"));
+}
@@ -0,0 +1,74 @@
+//
+//  PerfWorkload.hpp
+//  HTS-Perf
+//
+//  Created on 10/18/26.
+//
+
+#ifndef PerfWorkload_hpp
+#define PerfWorkload_hpp
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <utk/HardwareCounters.hpp>
+
+/// \brief The measurement of a run of a perf workload.
+struct PerfMeasurement
+{
+    /// Number of input records, i.e. alignment lines or read pairs.
+    std::uint64_t n_records {0};
+
+    /// Wall time in seconds of the run.
+    double seconds {0};
+
+    /// Number of input records processed per second.
+    double records_per_second {0};
+
+    /// Peak resident set size in bytes of the process of the run.
+    std::size_t peak_rss {0};
+
+    /// Checksum of the names and contents of all output files.
+    std::string checksum;
+
+    /// Build type of the workload, e.g. Release, or empty for no build type.
+    std::string build_type;
+
+    /// Name and CPU model of the host of the run.
+    std::string host;
+    std::string cpu;
+
+    /// Hardware event counts per input record, or NaN for the counters not
+    /// collected or unavailable.
+    utk::HardwareCounters::CountsType counts_per_record;
+};
+
+/// Build type of hts-perf and the workloads it runs, which are built together.
+std::string getPerfBuildType();
+
+/// Name of the host running the workloads.
+std::string getPerfHostName();
+
+/// Model name of the CPU of the host, or empty if unknown.
+std::string getPerfCPUModel();
+
+/// \brief Measure a run of SAM-Alignment-Counter on a synthetic dataset.
+/// The program counts the unique alignments of the SAM file of the dataset
+/// with its default arguments, and writes them to the output directory.
+/// \param  program_path  The path of the SAM-Alignment-Counter executable.
+/// \param  data_prefix   The output prefix of DGE-Data-Generator.
+/// \param  output_dir    The directory of output files.
+/// \param  counters      The hardware counters inherited by child processes,
+///                       or nullptr for no hardware events.
+PerfMeasurement runSAMAlignmentCounterWorkload(const std::string& program_path, const std::string& data_prefix, const std::string& output_dir, utk::HardwareCounters* counters=nullptr);
+
+/// \brief Measure a run of the FASTQ demux path on a synthetic dataset.
+/// The paired DGE FASTQ files of the dataset are demultiplexed by their well
+/// barcodes into the output directory by FASTQSequenceDemuxController.
+/// \param  data_prefix   The output prefix of DGE-Data-Generator.
+/// \param  output_dir    The directory of output files.
+/// \param  counters      The hardware counters inherited by child processes,
+///                       or nullptr for no hardware events.
+PerfMeasurement runFASTQDemuxWorkload(const std::string& data_prefix, const std::string& output_dir, utk::HardwareCounters* counters=nullptr);
+
+#endif /* PerfWorkload_hpp */
@@ -9,12 +9,11 @@
 #include <iostream>
 #include <stdexcept>
 #include <cstdlib>
-#include <hts/SAMFileReader.hpp>
-#include <hts/SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine.hpp>
-#include <hts/SAMGeneUMIAlignmentCounter.hpp>
-#include <hts/SAMAlignmentPipe.hpp>
-#include <utk/LineWriter.hpp>
+#include <utk/SystemProperties.hpp>
+#include <utk/Tracer.hpp>
 #include <SAMAlignmentCounterArguments.hpp>
+#include <SAMAlignmentCounterTask.hpp>
+#include <SAMAlignmentCounterBatch.hpp>
 
 int main(int argc, const char *argv[])
 {
@@ -22,33 +21,39 @@ int main(int argc, const char *argv[])
 
     try
     {
-        // Define some convenient types.
-        using SAMDGEAlignmentLine = hts::SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine;
-        using SAMFileReader = hts::SAMFileReader<SAMDGEAlignmentLine>;
-        using SAMFileWriter = utk::LineWriter;
-        using SAMGeneUMIAlignmentCounter = hts::SAMGeneUMIAlignmentCounter;
-
         // Retrieve input arguments from command line.
         SAMAlignmentCounterArguments args(argc, argv);
         // Check input arguments.
         args.check();
 
-        // Don't flush output stream manually.
-        bool flush_ostream = false;
-        // Initialize an input SAM file reader.
-        SAMFileReader sam_file_reader(args.input_sam_file_path, args.parse_header_line, args.parse_header_fields, args.parse_header_fields_attribs, args.parse_align_line, args.parse_mand_align_fields, args.parse_opt_align_fields, args.parse_opt_align_fields_attribs, args.pref_opt_fields_tags, flush_ostream, args.sam_file_line_delim_type);
-
-        // Initialize an output SAM file.
-        SAMFileWriter sam_file_writer(args.output_sam_file_path);
-
-        // Initialize a SAM alignment counter.
-        SAMGeneUMIAlignmentCounter sam_align_counter;
-
-        // Initialize a SAM aligment pipe.
-        hts::SAMAlignmentPipe<SAMFileReader, SAMFileWriter, SAMDGEAlignmentLine, SAMGeneUMIAlignmentCounter> sam_align_pipe(sam_file_reader, sam_file_writer, sam_align_counter, "uniquely aligned");
+        // Count a single input SAM file or a batch of input SAM files.
+        if(args.batch_mode)
+        {
+            SAMAlignmentCounterBatch sam_align_counter_batch(args);
+            if(sam_align_counter_batch.run() > 0) exit_code = EXIT_FAILURE;
+        }
+        else
+        {
+            // Keep the statistics out of the output SAM lines written to
+            // standard output.
+            std::ostream& info_stream = utk::FileSystem::isStdStream(args.output_sam_file_path) ? std::cerr : std::cout;
+            auto gene_count_table = createGeneCountTable(args, {getCountsColumnName(args.input_sam_file_path, args.output_sam_file_path)});
+            hts::GeneExonEnds gene_exon_ends = getGeneExonEnds(args, gene_count_table.get());
+            hts::GeneCounts gene_counts;
+            countSAMAlignmentFile(args, args.input_sam_file_path, args.output_sam_file_path, args.n_threads, info_stream, gene_count_table ? &gene_counts : nullptr, static_cast<std::uintmax_t>(args.memory_budget)*1024*1024, gene_exon_ends.empty() ? nullptr : &gene_exon_ends, args.snapshot_file_path, args.stats_file_path, args.progress_file_path);
+            if(gene_count_table)
+            {
+                gene_count_table->setSampleCounts(0, gene_counts);
+                writeGeneCountTable(args, *gene_count_table);
+            }
+        }
 
-        // Start processing the input SAM file and write the output.
-        sam_align_pipe.run();
+        // Write the timeline of pipeline stages to a Chrome trace file if
+        // requested by the environment variable UTK_TRACE_FILE.
+        if constexpr (utk::Tracer::enabled)
+        {
+            if(const char* trace_file_path = std::getenv("UTK_TRACE_FILE")) utk::Tracer::writeChromeTrace(std::string(trace_file_path));
+        }
     }
     catch (const std::logic_error& e)
     {
@@ -11,11 +11,12 @@
 #include <utk/SystemProperties.hpp>
 #include <utk/StringUtils.hpp>
 #include <utk/FileUtils.hpp>
+#include <hts/SAMRecordFilter.hpp>
 #include <SAMAlignmentCounterArguments.hpp>
 
 /// Retrieve input arguments.
 SAMAlignmentCounterArguments::SAMAlignmentCounterArguments(int argc, const char** argv) :
-    utk::ProgramArguments(argc, argv, 3, 12),
+    utk::ProgramArguments(argc, argv, 3, 27),
     parse_header_line{false},
     parse_header_fields{false},
     parse_header_fields_attribs{false},
@@ -25,6 +26,21 @@ SAMAlignmentCounterArguments::SAMAlignmentCounterArguments(int argc, const char*
     parse_opt_align_fields_attribs{false},
     use_pref_opt_fields{true},
     sam_file_line_delim_type{"unix"},
+    umi_counter_type{"hash"},
+    n_threads{1},
+    n_dedup_shards{0},
+    memory_budget{0},
+    position_window{default_position_window},
+    counts_file_path{},
+    annot_counts_file_path{},
+    n_expected_molecules{default_n_expected_molecules},
+    false_positive_rate{default_false_positive_rate},
+    sorted_input{"false"},
+    snapshot_file_path{},
+    stats_file_path{},
+    progress_interval{0},
+    progress_file_path{},
+    filter_expression{},
     preset_pref_opt_fields_tags{"XS","XN","XT"} {}
 
 /// Assign mandatory input arguments
@@ -33,6 +49,8 @@ void SAMAlignmentCounterArguments::assignMandatoryArguments()
     // Assign mandatory arguments.
     input_sam_file_path = argv[1];
     output_sam_file_path = argv[2];
+    // Use batch mode for a wildcard pattern or a list file of input SAM files.
+    batch_mode = utk::isFilePattern(input_sam_file_path) || (!input_sam_file_path.empty() && input_sam_file_path.front() == '@');
 }
 
 /// Assign optional input arguments
@@ -57,13 +75,53 @@ void SAMAlignmentCounterArguments::assignOptionalArguments()
     if(argc > 10) use_pref_opt_fields = utk::convert<bool>(argv[10]);
     // 11th argument.
     if(argc > 11) sam_file_line_delim_type = utk::toLowerString(argv[11]);
+    // 12th argument.
+    if(argc > 12) umi_counter_type = utk::toLowerString(argv[12]);
+    // 13th argument.
+    if(argc > 13) n_threads = utk::convert<std::size_t>(argv[13]);
+    // 14th argument.
+    if(argc > 14) n_dedup_shards = utk::convert<std::size_t>(argv[14]);
+    // 15th argument.
+    if(argc > 15) memory_budget = utk::convert<std::size_t>(argv[15]);
+    // 16th argument.
+    if(argc > 16) position_window = utk::convert<std::size_t>(argv[16]);
+    // 17th argument.
+    if(argc > 17) counts_file_path = argv[17];
+    // 18th argument.
+    if(argc > 18) annot_counts_file_path = argv[18];
+    // 19th argument.
+    if(argc > 19) n_expected_molecules = utk::convert<std::size_t>(argv[19]);
+    // 20th argument.
+    if(argc > 20) false_positive_rate = utk::convert<double>(argv[20]);
+    // 21st argument.
+    if(argc > 21) sorted_input = utk::toLowerString(argv[21]);
+    // 22nd argument.
+    if(argc > 22) snapshot_file_path = argv[22];
+    // 23rd argument.
+    if(argc > 23) stats_file_path = argv[23];
+    // 24th argument.
+    if(argc > 24) progress_interval = utk::convert<double>(argv[24]);
+    // 25th argument.
+    if(argc > 25) progress_file_path = argv[25];
+    // 26th argument.
+    if(argc > 26) filter_expression = argv[26];
 }
 
 /// Check input arguments.
 void SAMAlignmentCounterArguments::validateArguments()
 {
     // Check the path of the input SAM file.
-    utk::checkFileReadability(input_sam_file_path);
+    if(batch_mode)
+    {
+        // Check the list file of input SAM files.
+        if(input_sam_file_path.front() == '@') utk::checkFileReadability(input_sam_file_path.substr(1));
+        // Check the output naming rule.
+        if(output_sam_file_path.find('*') == std::string::npos)
+        {
+            throw std::logic_error("Output SAM File must be a naming rule containing * for multiple input SAM files");
+        }
+    }
+    else if(!utk::FileSystem::isStdStream(input_sam_file_path)) utk::checkFileReadability(input_sam_file_path);
 
     // Check the type of line delimiter of SAM file.
     if(sam_file_line_delim_type != "windows" && sam_file_line_delim_type != "unix" && sam_file_line_delim_type != "macintosh")
@@ -71,6 +129,127 @@ void SAMAlignmentCounterArguments::validateArguments()
         throw std::logic_error("Line Delimiter Type of Input SAM File must be one of: unix, windows, or macintosh");
     }
 
+    // Check the type of UMI counter.
+    if(umi_counter_type != "hash" && umi_counter_type != "adaptive" && umi_counter_type != "directional" && umi_counter_type != "position" && umi_counter_type != "approximate" && umi_counter_type != "export")
+    {
+        throw std::logic_error("UMI Counter Type must be one of: hash, adaptive, directional, position, approximate, or export");
+    }
+
+    // The export of alignment info doesn't count any gene.
+    if(umi_counter_type == "export" && !counts_file_path.empty())
+    {
+        throw std::logic_error("Counts File doesn't apply to the export UMI Counter Type");
+    }
+
+    // Check the window of 5' end, which only the position UMI counter uses.
+    if(position_window == 0)
+    {
+        throw std::logic_error("Position Window must be greater than zero");
+    }
+    if(position_window != default_position_window && umi_counter_type != "position")
+    {
+        throw std::logic_error("Position Window needs the position UMI counter");
+    }
+
+    // Check the sizing of the Bloom filter.
+    if(n_expected_molecules == 0)
+    {
+        throw std::logic_error("Expected Molecules must be greater than zero");
+    }
+    if(!(false_positive_rate > 0 && false_positive_rate < 1))
+    {
+        throw std::logic_error("False Positive Rate must be between 0 and 1");
+    }
+    if((n_expected_molecules != default_n_expected_molecules || false_positive_rate != default_false_positive_rate) && umi_counter_type != "approximate")
+    {
+        throw std::logic_error("Expected Molecules and False Positive Rate need the approximate UMI counter");
+    }
+
+    // Check the indicator of sorted input.
+    if(sorted_input != "auto" && sorted_input != "true" && sorted_input != "false")
+    {
+        throw std::logic_error("Sorted Input must be one of: auto, true, or false");
+    }
+
+    // Check the read counts table of featureCounts for gene annotations.
+    if(!annot_counts_file_path.empty())
+    {
+        if(counts_file_path.empty()) throw std::logic_error("Counts Annotation File needs Counts File");
+        utk::checkFileReadability(annot_counts_file_path);
+    }
+
+    // Only the gene-UMI pool of the hash UMI counter without a snapshot is
+    // bounded by the memory budget.
+    if(memory_budget > 0)
+    {
+        if(umi_counter_type != "hash") throw std::logic_error("Memory Budget needs the hash UMI counter");
+        if(!snapshot_file_path.empty()) throw std::logic_error("Memory Budget doesn't apply to Dedup Snapshot");
+    }
+
+    // Check the dedup snapshot file.
+    if(!snapshot_file_path.empty())
+    {
+        if(umi_counter_type != "hash") throw std::logic_error("Dedup Snapshot needs the hash UMI counter");
+        if(batch_mode && snapshot_file_path.find('*') == std::string::npos)
+        {
+            throw std::logic_error("Dedup Snapshot must be a naming rule containing * for multiple input SAM files");
+        }
+    }
+
+    // Only the gene-UMI pool of the hash UMI counter without a snapshot is
+    // partitioned into shards, which a single input SAM file spilled by the
+    // memory budget doesn't use either.
+    if(n_dedup_shards > 0)
+    {
+        if(umi_counter_type != "hash") throw std::logic_error("Number of Dedup Shards needs the hash UMI counter");
+        if(!snapshot_file_path.empty()) throw std::logic_error("Number of Dedup Shards doesn't apply to Dedup Snapshot");
+        if(!batch_mode && memory_budget > 0) throw std::logic_error("Number of Dedup Shards doesn't apply to Memory Budget for a single input SAM file");
+    }
+
+    // Only the single gene-UMI pool of the hash UMI counter releases the
+    // gene-UMI combinations of sorted input.
+    if(sorted_input != "false")
+    {
+        if(umi_counter_type != "hash") throw std::logic_error("Sorted Input needs the hash UMI counter");
+        if(!snapshot_file_path.empty()) throw std::logic_error("Sorted Input doesn't apply to Dedup Snapshot");
+        if(memory_budget > 0) throw std::logic_error("Sorted Input doesn't apply to Memory Budget");
+        if(n_threads > 1 && n_dedup_shards > 0) throw std::logic_error("Sorted Input doesn't apply to Number of Dedup Shards with multiple threads");
+    }
+
+    // Check the naming rule of performance statistics files.
+    if(batch_mode && !stats_file_path.empty() && stats_file_path.find('*') == std::string::npos)
+    {
+        throw std::logic_error("Stats File must be a naming rule containing * for multiple input SAM files");
+    }
+
+    // Check the interval and status files of progress reports.
+    if(!(progress_interval >= 0))
+    {
+        throw std::logic_error("Progress Interval must not be negative");
+    }
+    if(batch_mode && !progress_file_path.empty() && progress_file_path.find('*') == std::string::npos)
+    {
+        throw std::logic_error("Progress File must be a naming rule containing * for multiple input SAM files");
+    }
+
+    // Compile the filter expression to check its syntax.
+    if(!filter_expression.empty()) hts::SAMRecordFilter record_filter(filter_expression);
+
+    // The export of alignment info decodes the raw text of alignment lines.
+    if(umi_counter_type == "export")
+    {
+        parse_align_line = false;
+        parse_mand_align_fields = false;
+        parse_opt_align_fields = false;
+        parse_opt_align_fields_attribs = false;
+    }
+
+    // Check the number of threads.
+    if(n_threads == 0)
+    {
+        throw std::logic_error("Number of Threads must be greater than zero");
+    }
+
     // Set the tags of preferred optional fields to be parsed according to
     // input argument use_pref_opt_fields.
     if(use_pref_opt_fields) pref_opt_fields_tags = preset_pref_opt_fields_tags;
@@ -79,9 +258,9 @@ void SAMAlignmentCounterArguments::validateArguments()
 /// Print help messages on program usage.
 void SAMAlignmentCounterArguments::helpMessage()
 {
-    std::cerr << "Usage: " << prog_name << " [Input SAM File] [Output SAM File] [Parse Header Line] [Parse Header Fields] [Parse Header Fields Attribs] [Parse Alignment Line] [Parse Mandatory Alignment Fields] [Parse Optional Alignment Fields] [Parse Optional Alignment Fields Attribs] [Use Preferred Optional Fields] [Line Delimiter Type of SAM File]" << '\n';
-    std::cerr << "       " << "[Input SAM File]: an input SAM file reported by featureCounts from STAR's alignment results." << '\n';
-    std::cerr << "       " << "[Output SAM File]: an output SAM file containing unique sequence alignments tagged with unique UMI barcodes. " << '\n';
+    std::cerr << "Usage: " << prog_name << " [Input SAM File] [Output SAM File] [Parse Header Line] [Parse Header Fields] [Parse Header Fields Attribs] [Parse Alignment Line] [Parse Mandatory Alignment Fields] [Parse Optional Alignment Fields] [Parse Optional Alignment Fields Attribs] [Use Preferred Optional Fields] [Line Delimiter Type of SAM File] [UMI Counter Type] [Number of Threads] [Number of Dedup Shards] [Memory Budget] [Position Window] [Counts File] [Counts Annotation File] [Expected Molecules] [False Positive Rate] [Sorted Input] [Dedup Snapshot] [Stats File] [Progress Interval] [Progress File] [Filter Expression]" << '\n';
+    std::cerr << "       " << "[Input SAM File]: an input SAM file reported by featureCounts from STAR's alignment results, - for standard input, or a quoted wildcard pattern or an @-prefixed list file of input SAM files for batch mode." << '\n';
+    std::cerr << "       " << "[Output SAM File]: an output SAM file containing unique sequence alignments tagged with unique UMI barcodes, - for standard output, or an output naming rule for batch mode where * is replaced by the part of input file name matched by * or by the input file name without extension. " << '\n';
     std::cerr << "       " << "[Parse Header Line]: indicator for parsing header line (Default: false)." << '\n';
     std::cerr << "       " << "[Parse Header Fields]: indicator for parsing the top structure of each field of header line (Default: false)." << '\n';
     std::cerr << "       " << "[Parse Header Fields Attribs]: indicator for parsing the tag and value attributes of each field of header line (Default: false)." << '\n';
@@ -90,5 +269,20 @@ void SAMAlignmentCounterArguments::helpMessage()
     std::cerr << "       " << "[Parse Optional Alignment Fields]: indicator for parsing the top structure of each optional field of alignment line (Default: true)." << '\n';
     std::cerr << "       " << "[Parse Optional Alignment Fields Attribs]: indicator for parsing the tag, type, and value attributes of each optional field of alignment line (Default: false)." << '\n';
     std::cerr << "       " << "[Use Preferred Optional Fields]: indicator for using a list of preferred optional fields (Default: true)." << '\n';
-    std::cerr << "       " << "[Line Delimiter Type of SAM File]: type of line delimiter of input SAM file: unix or windows (Default: unix)." << std::endl;
+    std::cerr << "       " << "[Line Delimiter Type of SAM File]: type of line delimiter of input SAM file: unix or windows (Default: unix)." << '\n';
+    std::cerr << "       " << "[UMI Counter Type]: backend for unique gene-UMI combinations: hash for a pool of gene-UMI strings, adaptive for per-gene sorted-array/bitmap UMI containers, directional for merging UMI barcodes one substitution apart by directional adjacency, position for gene-UMI combinations further distinguished by strand and 5' end of alignment, approximate for a fixed-size Bloom filter of gene-UMI combinations with an estimated collision rate and per-gene HyperLogLog counts, or export for writing the read-level metadata of all alignment lines to Output SAM File as a columnar binary table instead of counting (Default: hash)." << '\n';
+    std::cerr << "       " << "[Number of Threads]: number of worker threads for parsing alignment lines, where the output is identical to that of a single thread, or for processing input SAM files in batch mode (Default: 1)." << '\n';
+    std::cerr << "       " << "[Number of Dedup Shards]: number of threads deduplicating gene-UMI combinations partitioned by gene when using the hash UMI counter with multiple threads, or 0 for a single gene-UMI pool. It is rejected with other UMI counters, Dedup Snapshot, or Memory Budget for a single input SAM file (Default: 0)." << '\n';
+    std::cerr << "       " << "[Memory Budget]: memory budget in MB for the dedup tables of input SAM files processed at the same time in batch mode, or 0 for no limit. The gene-UMI pool of the hash UMI counter of a single input SAM file, or of an input SAM file too large for the budget in batch mode, is spilled to scratch files in TMPDIR when it exceeds the budget, with identical output. It only applies to the hash UMI counter without Dedup Snapshot (Default: 0)." << '\n';
+    std::cerr << "       " << "[Position Window]: number of bases in a window of 5' ends regarded as the same position when using the position UMI counter, which is rejected with other UMI counters unless it is 1 (Default: 1)." << '\n';
+    std::cerr << "       " << "[Counts File]: an output read counts table in the format of featureCounts with the number of unique molecules of each gene in each output SAM file, which is merged from all input SAM files in batch mode, or empty for no table (Default: empty)." << '\n';
+    std::cerr << "       " << "[Counts Annotation File]: a read counts table generated by featureCounts whose gene annotation columns and genes are copied into Counts File, or empty to write only the counted genes without annotation (Default: empty)." << '\n';
+    std::cerr << "       " << "[Expected Molecules]: expected number of distinct gene-UMI combinations for sizing the Bloom filter of the approximate UMI counter, which is rejected with other UMI counters unless it is 10000000 (Default: 10000000)." << '\n';
+    std::cerr << "       " << "[False Positive Rate]: target false positive rate of the Bloom filter of the approximate UMI counter at Expected Molecules, i.e. the fraction of distinct gene-UMI combinations falsely regarded as duplicates, which is rejected with other UMI counters unless it is 0.001 (Default: 0.001)." << '\n';
+    std::cerr << "       " << "[Sorted Input]: indicator for an input SAM file sorted by coordinate, whose gene-UMI combinations of the hash UMI counter are released once the input has passed the last exon of each gene in Counts Annotation File, or the reference sequence of each gene without Counts Annotation File, or auto to detect it from the SO:coordinate tag of @HD header line. A gene aligned again after being released, e.g. on both chrX and chrY without Counts Annotation File, or an input not sorted by coordinate is rejected with an error. It is rejected with other UMI counters, Dedup Snapshot, Memory Budget, or Number of Dedup Shards with multiple threads (Default: false)." << '\n';
+    std::cerr << "       " << "[Dedup Snapshot]: a dedup snapshot file of the gene-UMI combinations counted by earlier runs on the same sample when using the hash UMI counter, e.g. on its earlier sequencing lanes, whose combinations are regarded as duplicates and which is created or updated with the new combinations after the run, so that Counts File has the cumulative counts of all runs. In batch mode, it is a naming rule where * is replaced by the stem of each input SAM file. Number of Dedup Shards, Sorted Input, and Memory Budget are rejected with a snapshot. Empty for no snapshot (Default: empty)." << '\n';
+    std::cerr << "       " << "[Stats File]: an output JSON file of performance statistics with the wall time, CPU time, lines, and bytes of the read, parse, count, and write stages, the size, load factor, and probe-length histogram of the dedup table, and the peak resident memory of the process. In batch mode, it is a naming rule where * is replaced by the stem of each input SAM file. Empty for no file (Default: empty)." << '\n';
+    std::cerr << "       " << "[Progress Interval]: interval in seconds of progress reports with the number of lines read, the current and average throughput, the estimated time to finish from the bytes read of the input SAM file, and the memory of the dedup table, or 0 for no reports (Default: 0)." << '\n';
+    std::cerr << "       " << "[Progress File]: a status file replaced with the latest progress report, or empty to print progress reports to the standard error. In batch mode, it is a naming rule where * is replaced by the stem of each input SAM file (Default: empty)." << '\n';
+    std::cerr << "       " << "[Filter Expression]: an expression selecting the alignment lines to count from their raw text before parsing, made of the mandatory fields QNAME, FLAG, RNAME, POS, MAPQ, CIGAR, RNEXT, PNEXT, TLEN, SEQ, and QUAL or two-character tags of optional fields, integer or double-quoted string literals, comparisons ==, !=, <, <=, >, >=, & for any of the bits set, or a bare tag for its presence, and !, &&, ||, and parentheses, e.g. \"MAPQ >= 255 && !(FLAG & 0x900) && NH == 1\". Empty for no filter (Default: empty)." << std::endl;
 }
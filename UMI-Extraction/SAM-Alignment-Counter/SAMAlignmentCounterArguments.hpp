@@ -21,14 +21,23 @@ public:
 
     /// \brief Input SAM file.
     /// The input SAM file is generated by the report mode of featureCounts on
-    /// the alignment results from STAR aligner.
+    /// the alignment results from STAR aligner, or read from standard input if
+    /// it is "-". In batch mode, it is either a
+    /// wildcard pattern of input SAM files or a list file of input SAM files
+    /// prefixed with @.
     std::string input_sam_file_path;
 
     /// \brief Output SAM file.
     /// The output SAM file contains the alignment lines for uniquely aligned
-    /// sequences tagged with unique UMI barcodes for each gene.
+    /// sequences tagged with unique UMI barcodes for each gene, or written to
+    /// standard output if it is "-". In batch mode,
+    /// it is an output naming rule where * is replaced by the stem of each
+    /// input SAM file.
     std::string output_sam_file_path;
 
+    /// Indicator for processing multiple input SAM files.
+    bool batch_mode {false};
+
     /// Indicator for parsing header line.
     bool parse_header_line {false};
 
@@ -62,6 +71,108 @@ public:
     /// Type of line delimiter of SAM file.
     std::string sam_file_line_delim_type;
 
+    /// \brief Type of the backend for unique gene-UMI combinations.
+    /// hash: a pool of concatenated gene-UMI strings.
+    /// adaptive: per-gene adaptive containers of packed UMI barcodes.
+    /// directional: UMI error correction by directional adjacency clustering.
+    /// position: gene-UMI combinations with strand-aware 5' end of alignment.
+    /// approximate: a fixed-size Bloom filter of gene-UMI combinations.
+    /// export: no counting, but a columnar binary table of the read-level
+    /// metadata of all alignment lines.
+    std::string umi_counter_type;
+
+    /// \brief Number of worker threads for parsing alignment lines.
+    /// With more than one thread, alignment lines are parsed in parallel while
+    /// the output stays identical to that of a single thread.
+    std::size_t n_threads {1};
+
+    /// \brief Number of shards for deduplicating gene-UMI combinations.
+    /// With multiple threads and a positive number of shards, the gene-UMI
+    /// combinations are partitioned by gene and deduplicated by dedicated
+    /// shard threads instead of a single gene-UMI pool.
+    std::size_t n_dedup_shards {0};
+
+    /// \brief Memory budget in MB for the dedup tables.
+    /// The number of input SAM files processed at the same time is limited so
+    /// that their estimated dedup tables fit into the budget, or unlimited if
+    /// the budget is 0. The gene-UMI pool of the hash UMI counter is spilled
+    /// to scratch files when it exceeds the budget for a single input SAM
+    /// file, or for an input SAM file too large for the budget in batch mode.
+    std::size_t memory_budget {0};
+
+    /// Default number of bases in a window of 5' ends.
+    static constexpr std::size_t default_position_window {1};
+
+    /// \brief Number of bases in a window of 5' ends for the position counter.
+    /// Alignments whose 5' ends fall into the same window are regarded as
+    /// starting at the same position.
+    std::size_t position_window {default_position_window};
+
+    /// \brief The output read counts table of unique molecules of each gene.
+    /// The table is written in the format of featureCounts with one column for
+    /// each output SAM file, or not written if empty.
+    std::string counts_file_path;
+
+    /// \brief A read counts table of featureCounts for gene annotations.
+    /// The gene annotation columns and the genes of this table are copied into
+    /// the output read counts table if not empty.
+    std::string annot_counts_file_path;
+
+    /// Default sizing of the Bloom filter of the approximate UMI counter.
+    static constexpr std::size_t default_n_expected_molecules {10000000};
+    static constexpr double default_false_positive_rate {0.001};
+
+    /// \brief Expected number of distinct gene-UMI combinations.
+    /// The Bloom filter of the approximate UMI counter is sized to reach the
+    /// target false positive rate at this number of combinations.
+    std::size_t n_expected_molecules {default_n_expected_molecules};
+
+    /// \brief Target false positive rate of the Bloom filter.
+    /// This is the probability that a distinct gene-UMI combination is
+    /// falsely regarded as a duplicate by the approximate UMI counter.
+    double false_positive_rate {default_false_positive_rate};
+
+    /// \brief Indicator for an input SAM file sorted by coordinate.
+    /// true or false, or auto to detect it from the @HD header line. The
+    /// hash UMI counter releases the gene-UMI combinations of the genes that
+    /// sorted input has passed. It is false by default, since a gene aligned
+    /// again after being released fails the run.
+    std::string sorted_input;
+
+    /// \brief Dedup snapshot file of earlier runs on the same sample.
+    /// The gene-UMI combinations in the snapshot are regarded as duplicates,
+    /// and the snapshot is updated with the new combinations after the run,
+    /// so that new sequencing lanes can be counted without the earlier ones.
+    /// In batch mode, it is a naming rule where * is replaced by the stem of
+    /// each input SAM file. No snapshot is used if it is empty.
+    std::string snapshot_file_path;
+
+    /// \brief Output JSON file of performance statistics.
+    /// The file records the wall and CPU time, lines, and bytes of each stage
+    /// of counting, the statistics of the dedup table, and the peak memory.
+    /// In batch mode, it is a naming rule where * is replaced by the stem of
+    /// each input SAM file. No file is written if it is empty.
+    std::string stats_file_path;
+
+    /// \brief Interval of progress reports in seconds.
+    /// A timer thread reports the lines read, the throughput, the estimated
+    /// time to finish, and the memory of the dedup table at this interval.
+    /// No progress is reported if it is 0.
+    double progress_interval {0};
+
+    /// \brief Status file of progress reports.
+    /// The file is replaced with the latest report at each interval. In batch
+    /// mode, it is a naming rule where * is replaced by the stem of each
+    /// input SAM file. Progress is reported to the standard error if it is
+    /// empty.
+    std::string progress_file_path;
+
+    /// \brief Filter expression of alignment lines.
+    /// Only the alignment lines satisfying the expression are counted, which
+    /// is compiled once and evaluated on the raw text of each alignment line
+    /// before it is parsed. No filter is used if it is empty.
+    std::string filter_expression;
+
     /// \brief The tags of preferred optional fields to be parsed.
     /// If not empty, only these preferred optional fields will be parsed while
     /// other fileds will be skipped.
@@ -0,0 +1,229 @@
+//
+//  SAMAlignmentCounterBatch.cpp
+//  SAM-Alignment-Counter
+//
+//  Created on 10/18/26.
+//
+
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include <utk/FileUtils.hpp>
+#include <utk/LineReader.hpp>
+#include <utk/SystemProperties.hpp>
+#include <SAMAlignmentCounterBatch.hpp>
+#include <SAMAlignmentCounterTask.hpp>
+
+SAMAlignmentCounterBatch::SAMAlignmentCounterBatch(const SAMAlignmentCounterArguments& args) : args{args}, thread_pool(args.n_threads), memory_budget{static_cast<std::uintmax_t>(args.memory_budget)*1024*1024}
+{
+    findFileJobs();
+
+    // Keep the columns of read counts table in the order of input SAM files.
+    std::vector<std::string> sample_names(file_jobs.size());
+    for(const auto& file_job : file_jobs) sample_names[file_job.sample_index] = getCountsColumnName(file_job.input_sam_file_path, file_job.output_sam_file_path);
+    gene_count_table = createGeneCountTable(args, std::move(sample_names));
+    gene_exon_ends = getGeneExonEnds(args, gene_count_table.get());
+}
+
+/// Replace the * in an output naming rule with the stem of an input file.
+std::string SAMAlignmentCounterBatch::makeOutputFilePath(const std::string& output_rule, const std::string& stem)
+{
+    std::string output_file_path = output_rule;
+    if(std::size_t pos = output_file_path.find('*'); pos != std::string::npos) output_file_path.replace(pos, 1, stem);
+    return output_file_path;
+}
+
+/// Name the per-file output of an input file from a naming rule, or nothing
+/// if the rule is not given.
+std::string SAMAlignmentCounterBatch::makeFileJobPath(const std::string& file_rule, const std::string& stem)
+{
+    return file_rule.empty() ? std::string() : makeOutputFilePath(file_rule, stem);
+}
+
+/// Find all input SAM files and name their output SAM files.
+void SAMAlignmentCounterBatch::findFileJobs()
+{
+    const std::string& input_arg = args.input_sam_file_path;
+    if(input_arg.front() == '@')
+    {
+        // Read input SAM files from a list file, one file per line, and use
+        // the file name without extension as the stem.
+        utk::LineReader list_reader(input_arg.substr(1), args.sam_file_line_delim_type);
+        for(std::string input_file_path; list_reader.readLine(input_file_path);)
+        {
+            if(input_file_path.empty()) continue;
+            auto [file_name, file_dir] = utk::extractFileNameDirectory(input_file_path);
+            auto [main_name, ext_name] = utk::extractFileMainExtNames(file_name);
+            file_jobs.push_back({input_file_path, makeOutputFilePath(args.output_sam_file_path, main_name), makeFileJobPath(args.snapshot_file_path, main_name), makeFileJobPath(args.stats_file_path, main_name), makeFileJobPath(args.progress_file_path, main_name)});
+        }
+    }
+    else
+    {
+        // Search for input SAM files matching a wildcard pattern, and use the
+        // part of file name matched by * as the stem.
+        auto [pattern_name, pattern_dir] = utk::extractFileNameDirectory(input_arg);
+        std::size_t star_pos = pattern_name.find('*');
+        if(star_pos == std::string::npos || pattern_name.find('*', star_pos+1) != std::string::npos)
+        {
+            throw std::logic_error("File name of Input SAM File pattern must contain exactly one *");
+        }
+        std::string prefix = pattern_name.substr(0, star_pos);
+        std::string suffix = pattern_name.substr(star_pos+1);
+        for(const auto& input_file_path : utk::expandFilePattern(input_arg))
+        {
+            auto [file_name, file_dir] = utk::extractFileNameDirectory(input_file_path);
+            std::string stem = file_name.substr(prefix.size(), file_name.size()-prefix.size()-suffix.size());
+            file_jobs.push_back({input_file_path, makeOutputFilePath(args.output_sam_file_path, stem), makeFileJobPath(args.snapshot_file_path, stem), makeFileJobPath(args.stats_file_path, stem), makeFileJobPath(args.progress_file_path, stem)});
+        }
+    }
+    if(file_jobs.empty())
+    {
+        std::stringstream str;
+        str << "No input SAM file is found for " << input_arg;
+        throw std::runtime_error(str.str());
+    }
+
+    // Check all input SAM files and start from the largest one.
+    for(std::size_t i = 0; i < file_jobs.size(); ++i)
+    {
+        auto& file_job = file_jobs[i];
+        file_job.sample_index = i;
+        utk::checkFileReadability(file_job.input_sam_file_path);
+        if(file_job.output_sam_file_path == file_job.input_sam_file_path)
+        {
+            std::stringstream str;
+            str << "Output SAM file of " << file_job.input_sam_file_path << " overwrites itself";
+            throw std::logic_error(str.str());
+        }
+        file_job.input_file_size = utk::getFileSize(file_job.input_sam_file_path);
+    }
+    std::stable_sort(file_jobs.begin(), file_jobs.end(), [](const SAMFileJob& a, const SAMFileJob& b){ return a.input_file_size > b.input_file_size; });
+}
+
+/// Estimate the memory of the dedup table of an input SAM file.
+std::uintmax_t SAMAlignmentCounterBatch::estimateTableMemory(const SAMFileJob& file_job) const
+{
+    return file_job.input_file_size / input_bytes_per_table_byte;
+}
+
+/// Wait until the dedup table of a file fits into the memory budget.
+void SAMAlignmentCounterBatch::reserveMemory(std::uintmax_t table_memory)
+{
+    std::unique_lock<std::mutex> lock(batch_mutex);
+    // A table larger than the budget is processed alone.
+    if(memory_budget > 0) memory_cond.wait(lock, [&]{ return reserved_memory == 0 || reserved_memory+table_memory <= memory_budget; });
+    reserved_memory += table_memory;
+}
+
+/// Return the memory reserved for a dedup table.
+void SAMAlignmentCounterBatch::releaseMemory(std::uintmax_t table_memory)
+{
+    {
+        std::lock_guard<std::mutex> lock(batch_mutex);
+        reserved_memory -= table_memory;
+    }
+    memory_cond.notify_all();
+}
+
+/// Take the idle pool threads that no unstarted file is going to use.
+std::size_t SAMAlignmentCounterBatch::borrowIdleThreads()
+{
+    std::lock_guard<std::mutex> lock(batch_mutex);
+    n_unstarted_files--;
+    std::size_t n_idle_threads = thread_pool.getNumberOfIdleThreads();
+    std::size_t n_needed_threads = n_unstarted_files + n_lent_threads;
+    std::size_t n_threads = n_idle_threads > n_needed_threads ? n_idle_threads-n_needed_threads : 0;
+    n_lent_threads += n_threads;
+    return n_threads;
+}
+
+/// Return the idle pool threads taken by a file.
+void SAMAlignmentCounterBatch::returnIdleThreads(std::size_t n_threads)
+{
+    std::lock_guard<std::mutex> lock(batch_mutex);
+    n_lent_threads -= n_threads;
+}
+
+/// Process one input SAM file.
+void SAMAlignmentCounterBatch::processFileJob(const SAMFileJob& file_job)
+{
+    std::uintmax_t table_memory = estimateTableMemory(file_job);
+    reserveMemory(table_memory);
+    std::size_t n_extra_threads = borrowIdleThreads();
+    // Return the threads and the memory however the file ends, or the other
+    // files waiting for the memory would wait forever.
+    struct FileJobResources
+    {
+        SAMAlignmentCounterBatch& batch;
+        std::uintmax_t table_memory;
+        std::size_t n_extra_threads;
+
+        ~FileJobResources()
+        {
+            batch.returnIdleThreads(n_extra_threads);
+            batch.releaseMemory(table_memory);
+        }
+    } file_job_resources {*this, table_memory, n_extra_threads};
+
+    // Collect the statistics of the file to print them together.
+    std::stringstream info;
+    info << "Count " << file_job.input_sam_file_path << " to " << file_job.output_sam_file_path << " with " << n_extra_threads+1 << " threads" << '\n';
+    bool failed = false;
+    try
+    {
+        hts::GeneCounts gene_counts;
+        // Spill the dedup table of a file that doesn't fit into the budget.
+        std::uintmax_t spill_budget = memory_budget > 0 && table_memory > memory_budget ? memory_budget : 0;
+        countSAMAlignmentFile(args, file_job.input_sam_file_path, file_job.output_sam_file_path, n_extra_threads+1, info, gene_count_table ? &gene_counts : nullptr, spill_budget, gene_exon_ends.empty() ? nullptr : &gene_exon_ends, file_job.snapshot_file_path, file_job.stats_file_path, file_job.progress_file_path);
+        if(gene_count_table) gene_count_table->setSampleCounts(file_job.sample_index, gene_counts);
+    }
+    catch(const std::logic_error& e)
+    {
+        info << "Logical error: " << e.what() << '\n';
+        failed = true;
+    }
+    catch(const std::runtime_error& e)
+    {
+        info << "Runtime error: " << e.what() << '\n';
+        failed = true;
+    }
+    catch(const std::exception& e)
+    {
+        // E.g. std::bad_alloc under the memory pressure of other files.
+        info << "Error: " << e.what() << '\n';
+        failed = true;
+    }
+    catch(...)
+    {
+        info << "Unknown error" << '\n';
+        failed = true;
+    }
+
+    std::lock_guard<std::mutex> lock(batch_mutex);
+    if(failed)
+    {
+        n_failed_files++;
+        std::cerr << info.str() << std::flush;
+    }
+    else std::cout << info.str() << std::flush;
+}
+
+/// Process all input SAM files.
+std::size_t SAMAlignmentCounterBatch::run()
+{
+    n_unstarted_files = file_jobs.size();
+    for(const auto& file_job : file_jobs)
+    {
+        thread_pool.submit([this, &file_job]{ processFileJob(file_job); });
+    }
+    thread_pool.wait();
+    std::cout << "Count " << file_jobs.size()-n_failed_files << " of " << file_jobs.size() << " input SAM files" << '\n';
+    // Write the read counts table only if all input SAM files are counted.
+    if(gene_count_table && n_failed_files == 0)
+    {
+        writeGeneCountTable(args, *gene_count_table);
+        std::cout << "Write the read counts table of " << file_jobs.size() << " output SAM files to " << args.counts_file_path << '\n';
+    }
+    return n_failed_files;
+}
@@ -0,0 +1,135 @@
+//
+//  SAMAlignmentCounterBatch.hpp
+//  SAM-Alignment-Counter
+//
+//  Created on 10/18/26.
+//
+
+#ifndef SAMAlignmentCounterBatch_hpp
+#define SAMAlignmentCounterBatch_hpp
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <memory>
+#include <cstdint>
+#include <condition_variable>
+#include <utk/WorkStealingThreadPool.hpp>
+#include <hts/GeneCountTable.hpp>
+#include <SAMAlignmentCounterArguments.hpp>
+
+/// \brief Count unique gene-UMI alignments of multiple input SAM files
+/// This class processes a batch of input SAM files, given by a wildcard
+/// pattern or a list file, on a work-stealing thread pool, with one task for
+/// each input SAM file. The output SAM file of each input SAM file is named by
+/// replacing the * in an output naming rule with the stem of the input SAM
+/// file, i.e. the part of its name matched by the * of the wildcard pattern,
+/// or its name without extension if it comes from a list file.
+///
+/// Input SAM files are started from the largest one. When the pool is about
+/// to run out of queued files, the remaining idle threads are handed to the
+/// files being started, which then parse their alignment lines with multiple
+/// threads. The dedup tables of all the files processed at the same time are
+/// kept within a memory budget by estimating each table from the file size.
+///
+/// The per-gene counts of all output SAM files are merged into one read counts
+/// table as requested, with the columns in the order of input SAM files.
+class SAMAlignmentCounterBatch
+{
+public:
+
+    /// Estimated number of input bytes for each byte of dedup table, which
+    /// assumes all the alignment lines are unique gene-UMI combinations.
+    static constexpr std::uintmax_t input_bytes_per_table_byte {3};
+
+private:
+
+    /// An input SAM file and its output SAM file.
+    struct SAMFileJob
+    {
+        std::string input_sam_file_path;
+        std::string output_sam_file_path;
+        std::string snapshot_file_path;
+        std::string stats_file_path;
+        std::string progress_file_path;
+        std::uintmax_t input_file_size {0};
+        std::size_t sample_index {0};
+    };
+
+private:
+
+    /// The program arguments for parsing and counting.
+    const SAMAlignmentCounterArguments& args;
+
+    /// All input SAM files to process.
+    std::vector<SAMFileJob> file_jobs;
+
+    /// Read counts table of all output SAM files, or nullptr if not needed.
+    std::unique_ptr<hts::GeneCountTable> gene_count_table;
+
+    /// The end of the last exon of each gene for retiring genes of sorted
+    /// input, or empty if not given.
+    hts::GeneExonEnds gene_exon_ends;
+
+    /// Thread pool for processing input SAM files.
+    utk::WorkStealingThreadPool thread_pool;
+
+    /// Memory budget in bytes for dedup tables, or 0 for no limit.
+    std::uintmax_t memory_budget {0};
+
+    /// Memory reserved for the dedup tables of the files being processed.
+    std::uintmax_t reserved_memory {0};
+
+    /// Number of files not started yet.
+    std::size_t n_unstarted_files {0};
+
+    /// Number of idle pool threads handed to the files being processed.
+    std::size_t n_lent_threads {0};
+
+    /// Number of files failed to be processed.
+    std::size_t n_failed_files {0};
+
+    /// Synchronization for the memory budget, idle threads, and output.
+    std::mutex batch_mutex;
+    std::condition_variable memory_cond;
+
+private:
+
+    /// Name the per-file output of an input file from a naming rule, or
+    /// nothing if the rule is not given.
+    static std::string makeFileJobPath(const std::string& file_rule, const std::string& stem);
+
+    /// Find all input SAM files and name their output SAM files.
+    void findFileJobs();
+
+    /// Estimate the memory of the dedup table of an input SAM file.
+    std::uintmax_t estimateTableMemory(const SAMFileJob& file_job) const;
+
+    /// Wait until the dedup table of a file fits into the memory budget.
+    void reserveMemory(std::uintmax_t table_memory);
+
+    /// Return the memory reserved for a dedup table.
+    void releaseMemory(std::uintmax_t table_memory);
+
+    /// Take the idle pool threads that no unstarted file is going to use.
+    std::size_t borrowIdleThreads();
+
+    /// Return the idle pool threads taken by a file.
+    void returnIdleThreads(std::size_t n_threads);
+
+    /// Process one input SAM file.
+    void processFileJob(const SAMFileJob& file_job);
+
+public:
+
+    /// Replace the * in an output naming rule with the stem of an input file.
+    static std::string makeOutputFilePath(const std::string& output_rule, const std::string& stem);
+
+    explicit SAMAlignmentCounterBatch(const SAMAlignmentCounterArguments& args);
+
+    /// Process all input SAM files.
+    /// \return  The number of input SAM files failed to be processed.
+    std::size_t run();
+};
+
+#endif /* SAMAlignmentCounterBatch_hpp */
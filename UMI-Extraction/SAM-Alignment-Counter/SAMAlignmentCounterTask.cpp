@@ -0,0 +1,201 @@
+//
+//  SAMAlignmentCounterTask.cpp
+//  SAM-Alignment-Counter
+//
+//  Created on 10/18/26.
+//
+
+#include <type_traits>
+#include <hts/SAMFileReader.hpp>
+#include <hts/SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine.hpp>
+#include <hts/SAMGeneUMIAlignmentCounter.hpp>
+#include <hts/SAMGeneUMIAdaptiveAlignmentCounter.hpp>
+#include <hts/SAMGeneUMIDirectionalAlignmentCounter.hpp>
+#include <hts/SAMGeneUMIPositionAlignmentCounter.hpp>
+#include <hts/SAMGeneUMIExternalAlignmentCounter.hpp>
+#include <hts/SAMGeneUMIApproximateAlignmentCounter.hpp>
+#include <hts/SAMGeneUMIIncrementalAlignmentCounter.hpp>
+#include <hts/SAMAlignmentInfoExporter.hpp>
+#include <hts/SAMAlignmentPipe.hpp>
+#include <hts/SAMAlignmentPipeReport.hpp>
+#include <hts/SAMFilteredAlignmentCounter.hpp>
+#include <hts/SAMRecordFilter.hpp>
+#include <utk/LineWriter.hpp>
+#include <utk/FileUtils.hpp>
+#include <utk/ProgressReporter.hpp>
+#include <utk/SystemProperties.hpp>
+#include <SAMAlignmentCounterTask.hpp>
+
+/// Count unique gene-UMI alignments of one input SAM file.
+void countSAMAlignmentFile(const SAMAlignmentCounterArguments& args, const std::string& input_sam_file_path, const std::string& output_sam_file_path, std::size_t n_threads, std::ostream& info_stream, hts::GeneCounts* gene_counts, std::uintmax_t memory_budget, const hts::GeneExonEnds* gene_exon_ends, const std::string& snapshot_file_path, const std::string& stats_file_path, const std::string& progress_file_path)
+{
+    // Define some convenient types.
+    using SAMDGEAlignmentLine = hts::SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine;
+    using SAMFileReader = hts::SAMFileReader<SAMDGEAlignmentLine>;
+    using SAMFileWriter = utk::LineWriter;
+    using SAMGeneUMIAlignmentCounter = hts::SAMGeneUMIAlignmentCounter;
+    using SAMGeneUMIAdaptiveAlignmentCounter = hts::SAMGeneUMIAdaptiveAlignmentCounter;
+    using SAMGeneUMIDirectionalAlignmentCounter = hts::SAMGeneUMIDirectionalAlignmentCounter;
+    using SAMGeneUMIPositionAlignmentCounter = hts::SAMGeneUMIPositionAlignmentCounter;
+    using SAMGeneUMIExternalAlignmentCounter = hts::SAMGeneUMIExternalAlignmentCounter;
+    using SAMGeneUMIApproximateAlignmentCounter = hts::SAMGeneUMIApproximateAlignmentCounter;
+    using SAMGeneUMIIncrementalAlignmentCounter = hts::SAMGeneUMIIncrementalAlignmentCounter;
+    using SAMAlignmentInfoExporter = hts::SAMAlignmentInfoExporter;
+
+    // Don't flush output stream manually.
+    bool flush_ostream = false;
+    // Initialize an input SAM file reader.
+    SAMFileReader sam_file_reader(input_sam_file_path, args.parse_header_line, args.parse_header_fields, args.parse_header_fields_attribs, args.parse_align_line, args.parse_mand_align_fields, args.parse_opt_align_fields, args.parse_opt_align_fields_attribs, args.pref_opt_fields_tags, flush_ostream, args.sam_file_line_delim_type);
+
+    // Initialize an output SAM file, which is replaced by the table of
+    // alignment info when exporting it.
+    bool export_align_info = args.umi_counter_type == "export";
+    SAMFileWriter sam_file_writer = export_align_info ? SAMFileWriter() : SAMFileWriter(output_sam_file_path);
+
+    // Collect performance statistics as requested.
+    std::unique_ptr<hts::SAMAlignmentPipeReport> pipe_report;
+    if(!stats_file_path.empty())
+    {
+        pipe_report = std::make_unique<hts::SAMAlignmentPipeReport>();
+        pipe_report->input_file_path = input_sam_file_path;
+        pipe_report->output_file_path = output_sam_file_path;
+    }
+
+    // Report the progress periodically as requested, whose estimated time to
+    // finish is unknown for the standard input.
+    std::unique_ptr<utk::ProgressReporter> progress_reporter;
+    if(args.progress_interval > 0)
+    {
+        std::uintmax_t n_total_bytes = utk::FileSystem::isStdStream(input_sam_file_path) ? 0 : utk::getFileSize(input_sam_file_path);
+        progress_reporter = std::make_unique<utk::ProgressReporter>(input_sam_file_path, "lines", n_total_bytes, args.progress_interval, progress_file_path);
+    }
+
+    // Process the input SAM file with a SAM alignment counter and write the
+    // output.
+    auto runCounterPipe = [&](auto& sam_align_counter, std::size_t n_dedup_shards)
+    {
+        using SAMAlignmentCounterType = std::decay_t<decltype(sam_align_counter)>;
+        hts::SAMAlignmentPipe<SAMFileReader, SAMFileWriter, SAMDGEAlignmentLine, SAMAlignmentCounterType> sam_align_pipe(sam_file_reader, sam_file_writer, sam_align_counter, "uniquely aligned");
+        sam_align_pipe.setInfoStream(info_stream);
+        if(pipe_report) sam_align_pipe.setReport(*pipe_report);
+        if(progress_reporter) sam_align_pipe.setProgressReporter(*progress_reporter);
+        sam_align_pipe.run(n_threads, n_dedup_shards);
+        if(progress_reporter) progress_reporter->finish();
+    };
+
+    // Fuse the filter expression with the SAM alignment counter as requested.
+    auto runPipe = [&](auto& sam_align_counter, std::size_t n_dedup_shards)
+    {
+        if(!args.filter_expression.empty())
+        {
+            using SAMAlignmentCounterType = std::decay_t<decltype(sam_align_counter)>;
+            hts::SAMFilteredAlignmentCounter<SAMAlignmentCounterType, hts::SAMRecordFilter> filtered_align_counter(sam_align_counter, hts::SAMRecordFilter(args.filter_expression));
+            runCounterPipe(filtered_align_counter, n_dedup_shards);
+        }
+        else runCounterPipe(sam_align_counter, n_dedup_shards);
+    };
+
+    // Initialize a SAM alignment counter with the selected backend and
+    // start processing the input SAM file and write the output.
+    if(export_align_info)
+    {
+        SAMAlignmentInfoExporter sam_align_counter(output_sam_file_path);
+        runPipe(sam_align_counter, 0);
+        sam_align_counter.close();
+        info_stream << "Export the info of " << sam_align_counter.getNumberOfExportedAlignments() << " alignments to " << output_sam_file_path << '\n';
+    }
+    else if(args.umi_counter_type == "adaptive")
+    {
+        SAMGeneUMIAdaptiveAlignmentCounter sam_align_counter;
+        runPipe(sam_align_counter, 0);
+        info_stream << "Count " << sam_align_counter.getNumberOfGenes() << " genes with " << sam_align_counter.getNumberOfBitmapGenes() << " bitmap UMI containers using " << sam_align_counter.getMemoryUsage() << " bytes" << '\n';
+        if(gene_counts != nullptr) sam_align_counter.getGeneCounts(*gene_counts);
+    }
+    else if(args.umi_counter_type == "directional")
+    {
+        SAMGeneUMIDirectionalAlignmentCounter sam_align_counter;
+        runPipe(sam_align_counter, 0);
+        info_stream << "Correct " << sam_align_counter.getNumberOfCandidates() << " distinct gene-UMI combinations into " << sam_align_counter.getNumberOfClusters() << " molecules of " << sam_align_counter.getNumberOfGenes() << " genes" << '\n';
+        if(gene_counts != nullptr) sam_align_counter.getGeneCounts(*gene_counts);
+    }
+    else if(args.umi_counter_type == "position")
+    {
+        SAMGeneUMIPositionAlignmentCounter sam_align_counter(args.position_window);
+        runPipe(sam_align_counter, 0);
+        info_stream << "Count " << sam_align_counter.getNumberOfCombinations() << " distinct gene-UMI-position combinations of " << sam_align_counter.getNumberOfGenes() << " genes" << '\n';
+        if(gene_counts != nullptr) sam_align_counter.getGeneCounts(*gene_counts);
+    }
+    else if(args.umi_counter_type == "approximate")
+    {
+        SAMGeneUMIApproximateAlignmentCounter sam_align_counter(args.n_expected_molecules, args.false_positive_rate);
+        runPipe(sam_align_counter, 0);
+        info_stream << "Count " << sam_align_counter.getNumberOfDistinctCombinations() << " distinct gene-UMI combinations of " << sam_align_counter.getNumberOfGenes() << " genes with " << sam_align_counter.getNumberOfSketchGenes() << " HyperLogLog sketches using " << sam_align_counter.getMemoryUsage() << " bytes, with estimated collision rate " << sam_align_counter.getEstimatedCollisionRate() << " and false positive rate " << sam_align_counter.getFalsePositiveRate() << '\n';
+        if(gene_counts != nullptr) sam_align_counter.getGeneCounts(*gene_counts);
+    }
+    else if(!snapshot_file_path.empty())
+    {
+        SAMGeneUMIIncrementalAlignmentCounter sam_align_counter(snapshot_file_path);
+        runPipe(sam_align_counter, 0);
+        // Update the snapshot only after the whole input is counted.
+        sam_align_counter.writeSnapshot(snapshot_file_path);
+        info_stream << "Skip " << sam_align_counter.getNumberOfSnapshotDuplicates() << " alignments of " << sam_align_counter.getNumberOfSnapshotCombinations() << " gene-UMI combinations in snapshot and add " << sam_align_counter.getNumberOfNewCombinations() << " new combinations to " << snapshot_file_path << '\n';
+        if(gene_counts != nullptr) sam_align_counter.getGeneCounts(*gene_counts);
+    }
+    else if(memory_budget > 0)
+    {
+        SAMGeneUMIExternalAlignmentCounter sam_align_counter(static_cast<std::size_t>(memory_budget));
+        runPipe(sam_align_counter, 0);
+        info_stream << "Merge " << sam_align_counter.getNumberOfCandidates() << " candidate gene-UMI combinations from " << sam_align_counter.getNumberOfSpilledRuns() << " spilled runs" << '\n';
+        if(gene_counts != nullptr) sam_align_counter.getGeneCounts(*gene_counts);
+    }
+    else
+    {
+        // Retiring genes by locus is opt-in, since it rejects the genes aligned
+        // again after being retired and the input not sorted by coordinate.
+        // Sorted input with sharded gene-UMI pools is rejected by the
+        // arguments.
+        auto sorted_input_mode = SAMGeneUMIAlignmentCounter::SortedInputMode::Unsorted;
+        if(args.sorted_input == "true") sorted_input_mode = SAMGeneUMIAlignmentCounter::SortedInputMode::Sorted;
+        else if(args.sorted_input == "auto") sorted_input_mode = SAMGeneUMIAlignmentCounter::SortedInputMode::Detect;
+        SAMGeneUMIAlignmentCounter sam_align_counter(sorted_input_mode, gene_exon_ends);
+        runPipe(sam_align_counter, args.n_dedup_shards);
+        if(sam_align_counter.isSortedInput()) info_stream << "Retire " << sam_align_counter.getNumberOfRetiredGenes() << " genes of sorted input with at most " << sam_align_counter.getMaxNumberOfActiveCombinations() << " active gene-UMI combinations" << '\n';
+        if(gene_counts != nullptr) sam_align_counter.getGeneCounts(*gene_counts);
+    }
+
+    // Write the performance statistics.
+    if(pipe_report)
+    {
+        pipe_report->writeJSON(stats_file_path);
+        info_stream << "Write performance statistics to " << stats_file_path << '\n';
+    }
+}
+
+/// Name the column of an output SAM file in the read counts table.
+std::string getCountsColumnName(const std::string& input_sam_file_path, const std::string& output_sam_file_path)
+{
+    // Use the input SAM file for the output SAM lines written to standard output.
+    return utk::FileSystem::isStdStream(output_sam_file_path) ? input_sam_file_path : output_sam_file_path;
+}
+
+/// Create the read counts table for output SAM files.
+std::unique_ptr<hts::GeneCountTable> createGeneCountTable(const SAMAlignmentCounterArguments& args, std::vector<std::string> sample_names)
+{
+    if(args.counts_file_path.empty()) return nullptr;
+    auto gene_count_table = std::make_unique<hts::GeneCountTable>(std::move(sample_names));
+    if(!args.annot_counts_file_path.empty()) gene_count_table->readAnnotations(args.annot_counts_file_path);
+    return gene_count_table;
+}
+
+/// Get the end of the last exon of each gene from the Counts Annotation File.
+hts::GeneExonEnds getGeneExonEnds(const SAMAlignmentCounterArguments& args, const hts::GeneCountTable* gene_count_table)
+{
+    if(gene_count_table == nullptr || args.annot_counts_file_path.empty()) return hts::GeneExonEnds();
+    return gene_count_table->getGeneExonEnds();
+}
+
+/// Write the read counts table to the Counts File.
+void writeGeneCountTable(const SAMAlignmentCounterArguments& args, const hts::GeneCountTable& gene_count_table)
+{
+    gene_count_table.write(args.counts_file_path, "Program:SAM-Alignment-Counter; Command:" + args.getCommandLine());
+}
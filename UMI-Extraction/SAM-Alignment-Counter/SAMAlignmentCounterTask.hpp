@@ -0,0 +1,57 @@
+//
+//  SAMAlignmentCounterTask.hpp
+//  SAM-Alignment-Counter
+//
+//  Created on 10/18/26.
+//
+
+#ifndef SAMAlignmentCounterTask_hpp
+#define SAMAlignmentCounterTask_hpp
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <iostream>
+#include <hts/GeneCountTable.hpp>
+#include <SAMAlignmentCounterArguments.hpp>
+
+/// \brief Count unique gene-UMI alignments of one input SAM file.
+/// \param  args                  The program arguments for parsing and counting.
+/// \param  input_sam_file_path   The input SAM file.
+/// \param  output_sam_file_path  The output SAM file.
+/// \param  n_threads             The number of worker threads for the file.
+/// \param  info_stream           The output stream for counting statistics.
+/// \param  gene_counts           The number of unique molecules of each gene
+///                               to add to, or nullptr if not needed.
+/// \param  memory_budget         The memory budget in bytes of the gene-UMI
+///                               pool of the hash UMI counter, beyond which
+///                               the pool is spilled to scratch files, or 0
+///                               to keep the pool in memory.
+/// \param  gene_exon_ends        The end of the last exon of each gene for
+///                               retiring genes of sorted input, or nullptr
+///                               to retire genes by reference sequence.
+/// \param  snapshot_file_path    The dedup snapshot file of earlier runs to
+///                               deduplicate against and update, or empty
+///                               for no snapshot.
+/// \param  stats_file_path       The output JSON file of performance
+///                               statistics, or empty for no file.
+/// \param  progress_file_path    The status file of periodic progress
+///                               reports, or empty for the standard error.
+void countSAMAlignmentFile(const SAMAlignmentCounterArguments& args, const std::string& input_sam_file_path, const std::string& output_sam_file_path, std::size_t n_threads, std::ostream& info_stream=std::cout, hts::GeneCounts* gene_counts=nullptr, std::uintmax_t memory_budget=0, const hts::GeneExonEnds* gene_exon_ends=nullptr, const std::string& snapshot_file_path="", const std::string& stats_file_path="", const std::string& progress_file_path="");
+
+/// Name the column of an output SAM file in the read counts table.
+std::string getCountsColumnName(const std::string& input_sam_file_path, const std::string& output_sam_file_path);
+
+/// \brief Create the read counts table for output SAM files.
+/// \return  The read counts table, or nullptr if no table is requested.
+std::unique_ptr<hts::GeneCountTable> createGeneCountTable(const SAMAlignmentCounterArguments& args, std::vector<std::string> sample_names);
+
+/// Get the end of the last exon of each gene from the Counts Annotation File
+/// read into the read counts table, or nothing if not given.
+hts::GeneExonEnds getGeneExonEnds(const SAMAlignmentCounterArguments& args, const hts::GeneCountTable* gene_count_table);
+
+/// Write the read counts table to the Counts File.
+void writeGeneCountTable(const SAMAlignmentCounterArguments& args, const hts::GeneCountTable& gene_count_table);
+
+#endif /* SAMAlignmentCounterTask_hpp */
@@ -0,0 +1,194 @@
+//
+//  AdaptiveUMIContainer.hpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#ifndef AdaptiveUMIContainer_hpp
+#define AdaptiveUMIContainer_hpp
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "UMIBarcodePacker.hpp"
+
+namespace hts
+{
+
+/// \brief A set of packed UMI barcodes that adapts its layout to its density.
+/// This class stores the distinct packed UMI barcodes of a single gene in the
+/// layout of a roaring bitmap. The codes are split by their upper bits into
+/// chunks of up to 2^16 codes, and each chunk keeps the lower 16 bits of its
+/// codes in one of two layouts:
+///
+/// 1) A sorted array while the chunk is sparse, which costs 2 bytes per UMI
+///    barcode and is searched with binary search.
+/// 2) A dense bitmap covering the chunk once the array reaches its maximum
+///    size, which costs a fixed 2^16 bits (8 KB) and is updated with a single
+///    bit operation.
+///
+/// The maximum array size of a chunk defaults to the break-even size at which
+/// the array takes as much memory as the bitmap, i.e. the size of the chunk
+/// bitmap in bytes divided by the size of an entry (4096 entries), so that
+/// the memory used by a gene never exceeds the bitmap of the entire UMI space
+/// (128 KB for 10-nt UMI barcodes) plus the index of its chunks. An insertion
+/// only moves the entries of its own chunk, i.e. at most 8 KB, so that its
+/// cost stays bounded for highly expressed genes.
+///
+/// The conversion from array to bitmap happens only once for each chunk.
+class AdaptiveUMIContainer
+{
+public:
+
+    using CodeType = UMIBarcodePacker::CodeType;
+
+    /// Default number of bits of a packed UMI barcode (10-nt UMI barcode).
+    static constexpr std::size_t default_n_code_bits {20};
+
+    /// Maximum number of the lower bits of codes kept by a chunk.
+    static constexpr std::size_t max_n_chunk_bits {16};
+
+private:
+
+    /// Type of the lower bits of a code in a chunk, which is also the word of
+    /// chunk bitmaps.
+    using ChunkCodeType = std::uint16_t;
+
+    /// Type of the upper bits of a code selecting its chunk.
+    using ChunkKeyType = std::uint16_t;
+
+    static constexpr std::size_t n_word_bits {sizeof(ChunkCodeType)*8};
+
+private:
+
+    /// Number of bits of a packed UMI barcode.
+    std::size_t n_code_bits {default_n_code_bits};
+
+    /// Number of the lower bits of codes kept by a chunk.
+    std::size_t n_chunk_bits {max_n_chunk_bits};
+
+    /// Number of words of a chunk bitmap.
+    std::size_t n_chunk_words {0};
+
+    /// Maximum number of codes held by the sorted array of a chunk before
+    /// conversion.
+    std::size_t max_array_size {0};
+
+    /// Upper bits of the codes of each chunk in ascending order.
+    std::vector<ChunkKeyType> chunk_keys;
+
+    /// Sorted array of the lower bits of codes, which is always shorter than
+    /// a chunk bitmap, or chunk bitmap of each chunk.
+    std::vector<std::vector<ChunkCodeType>> chunks;
+
+    /// Number of distinct codes in the container.
+    std::size_t n_codes {0};
+
+    /// Number of chunks using the bitmap layout.
+    std::size_t n_bitmap_chunks {0};
+
+private:
+
+    /// Check if a chunk uses the bitmap layout.
+    bool isChunkBitmap(const std::vector<ChunkCodeType>& chunk) const
+    {
+        return chunk.size() == n_chunk_words;
+    }
+
+    /// Convert the sorted array of a chunk to the bitmap.
+    void convertToBitmap(std::vector<ChunkCodeType>& chunk);
+
+public:
+
+    /// \param  n_code_bits     Number of bits of a packed UMI barcode.
+    /// \param  max_array_size  Maximum number of codes held by the sorted
+    ///                         array of a chunk, or 0 for the break-even size
+    ///                         of the chunk bitmap.
+    AdaptiveUMIContainer(std::size_t n_code_bits=default_n_code_bits, std::size_t max_array_size=0);
+
+    /// Number of the lower bits of codes kept by a chunk.
+    static constexpr std::size_t getNumberOfChunkBits(std::size_t n_code_bits)
+    {
+        return n_code_bits < max_n_chunk_bits ? n_code_bits : max_n_chunk_bits;
+    }
+
+    /// Number of bytes of the bitmap covering a chunk.
+    static constexpr std::size_t getChunkBitmapSize(std::size_t n_code_bits)
+    {
+        return ((std::size_t(1) << getNumberOfChunkBits(n_code_bits)) + n_word_bits - 1) / n_word_bits * sizeof(ChunkCodeType);
+    }
+
+    /// Number of bytes of the bitmaps covering the entire UMI space.
+    static constexpr std::size_t getBitmapSize(std::size_t n_code_bits)
+    {
+        return getChunkBitmapSize(n_code_bits) << (n_code_bits - getNumberOfChunkBits(n_code_bits));
+    }
+
+    /// Number of codes at which the sorted array of a chunk takes as much
+    /// memory as the chunk bitmap.
+    static constexpr std::size_t getBreakEvenArraySize(std::size_t n_code_bits)
+    {
+        return getChunkBitmapSize(n_code_bits) / sizeof(ChunkCodeType);
+    }
+
+    /// Number of codes at which the sorted arrays of all chunks take as much
+    /// memory as the bitmaps of the entire UMI space.
+    static constexpr std::size_t getBreakEvenSize(std::size_t n_code_bits)
+    {
+        return getBitmapSize(n_code_bits) / sizeof(ChunkCodeType);
+    }
+
+    /// Maximum number of codes held by the sorted array of a chunk.
+    std::size_t getMaxArraySize() const
+    {
+        return max_array_size;
+    }
+
+    /// Insert a packed UMI barcode.
+    /// \return  True if the code is new to the container, false otherwise.
+    bool insert(CodeType code);
+
+    /// Check if a packed UMI barcode is contained.
+    bool contains(CodeType code) const;
+
+    /// Number of distinct packed UMI barcodes.
+    std::size_t size() const
+    {
+        return n_codes;
+    }
+
+    bool empty() const
+    {
+        return n_codes == 0;
+    }
+
+    /// Check if the dense bitmap layout is in use by any chunk.
+    bool isBitmap() const
+    {
+        return n_bitmap_chunks > 0;
+    }
+
+    /// Number of chunks using the dense bitmap layout.
+    std::size_t getNumberOfBitmapChunks() const
+    {
+        return n_bitmap_chunks;
+    }
+
+    /// Count the number of distinct codes by the population count of the
+    /// chunk bitmaps and the sizes of the sorted arrays.
+    std::size_t countCodes() const;
+
+    /// Number of bytes allocated by the container.
+    std::size_t getMemoryUsage() const;
+
+    /// Retrieve all codes in ascending order.
+    std::vector<CodeType> getCodes() const;
+
+    /// Remove all codes and return to the sparse layout.
+    void clear();
+};
+
+}
+
+#endif /* AdaptiveUMIContainer_hpp */
@@ -0,0 +1,196 @@
+//
+//  AlignmentInfoTable.hpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#ifndef AlignmentInfoTable_hpp
+#define AlignmentInfoTable_hpp
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+
+namespace hts
+{
+
+/// \brief The read-level metadata of an alignment line.
+/// The read is identified by the QNAME of a composite DGE Illumina sequence,
+/// i.e. the seven elements of an Illumina sequence identifier followed by the
+/// well and UMI barcodes, e.g.
+///
+///     NB501:48:C7302ANXX:1:1101:1103:2053:TAAGTACATAGCGTGG
+struct AlignmentInfo
+{
+    std::string instrument_id;
+    std::uint32_t run_number {0};
+    std::string flowcell_id;
+    std::uint16_t lane_number {0};
+    std::uint16_t tile_number {0};
+    std::uint32_t x_pos {0};
+    std::uint32_t y_pos {0};
+    std::string well_barcode;
+    std::string umi_barcode;
+    std::uint16_t flag {0};
+    std::string reference_name;
+    std::uint32_t position {0};
+    std::uint8_t mapping_quality {0};
+    /// The target features (XT), e.g. the gene, or empty if absent.
+    std::string target_features;
+    /// The alignment status (XS), or empty if absent.
+    std::string alignment_status;
+};
+
+/// \brief A columnar binary file of the read-level metadata of alignment lines.
+/// This class streams the AlignmentInfo of each alignment line to typed,
+/// fixed-width columns, which R and Python can read in place from a memory
+/// mapping of the file. The file is laid out as:
+///
+/// 1) A header of fixed size with the format version and the numbers of
+///    columns and rows.
+/// 2) An entry for each column with its name, its type, and the locations of
+///    its values and its levels.
+/// 3) The values of each column in the order of rows, starting at a multiple
+///    of 8 bytes.
+/// 4) The levels of each dictionary-encoded column, as NUL-terminated strings
+///    in the order of their codes.
+///
+/// The type of a column is a NumPy type string, e.g. <u4 for 32-bit unsigned
+/// integers in little-endian byte order, or |S10 for strings of 10 bytes
+/// padded with NULs. Strings with few distinct values, i.e. the instrument
+/// and flowcell ids, the reference name, the target features, and the
+/// alignment status, are dictionary-encoded as <u4 codes of their levels,
+/// like a factor in R.
+///
+/// The values of each column are spilled to a scratch file in TMPDIR, or
+/// /tmp, while the rows are appended, and the columns are put together into
+/// the table file when it is closed.
+class AlignmentInfoTable
+{
+public:
+
+    /// Magic bytes at the start of a table file.
+    static constexpr char magic[8] {'H','T','S','A','L','I','N','F'};
+
+    /// Version of the table format.
+    static constexpr std::uint32_t format_version {1};
+
+    /// The header of a table file.
+    struct Header
+    {
+        char magic[8] {};
+        std::uint32_t format_version {0};
+        std::uint32_t n_columns {0};
+        std::uint64_t n_rows {0};
+    };
+
+    /// The name, type, and locations of a column.
+    struct ColumnEntry
+    {
+        char name[16] {};
+        char type[8] {};
+        std::uint64_t values_offset {0};
+        std::uint64_t levels_offset {0};
+        std::uint64_t levels_size {0};
+        std::uint64_t n_levels {0};
+    };
+
+private:
+
+    /// A column being written.
+    struct Column
+    {
+        std::string name;
+        std::string type;
+        std::size_t width {0};
+        bool dictionary {false};
+
+        /// Scratch file of the values written so far.
+        std::string scratch_file_path;
+        std::ofstream scratch_file;
+
+        /// Values not written to the scratch file yet.
+        std::string values;
+
+        /// Codes of the levels of a dictionary-encoded column.
+        std::unordered_map<std::string, std::uint32_t> level_codes;
+        std::vector<std::string> levels;
+    };
+
+    /// Size of the values of a column kept in memory before they are written
+    /// to its scratch file.
+    static constexpr std::size_t values_buffer_size {1 << 16};
+
+    /// The output table file.
+    std::string table_file_path;
+
+    /// The columns.
+    std::vector<Column> columns;
+
+    /// Number of rows appended.
+    std::uint64_t n_rows {0};
+
+    /// Indicator of a closed table.
+    bool closed {false};
+
+private:
+
+    /// Add a column of numbers, of fixed-width strings, or of level codes.
+    void addColumn(const std::string& name, char kind, std::size_t width, bool dictionary=false);
+
+    /// Append a value of fixed width to a column.
+    void appendValue(Column& column, const void* value);
+
+    /// Append a number to a column.
+    template<typename T>
+    void appendNumber(Column& column, T value)
+    {
+        appendValue(column, &value);
+    }
+
+    /// Append a string padded with NULs to a column of fixed-width strings.
+    void appendString(Column& column, const std::string& value);
+
+    /// Append the code of a level to a dictionary-encoded column.
+    void appendLevel(Column& column, const std::string& value);
+
+    /// Write the buffered values of a column to its scratch file.
+    void flushValues(Column& column);
+
+    /// Remove all scratch files.
+    void removeScratchFiles() noexcept;
+
+public:
+
+    /// \param  table_file_path  The output table file, or - for the standard
+    ///                          output.
+    /// \param  well_barcode_length  The width of the column of well barcodes.
+    /// \param  umi_barcode_length   The width of the column of UMI barcodes.
+    AlignmentInfoTable(const std::string& table_file_path, std::size_t well_barcode_length, std::size_t umi_barcode_length);
+
+    AlignmentInfoTable(const AlignmentInfoTable&) = delete;
+
+    AlignmentInfoTable& operator=(const AlignmentInfoTable&) = delete;
+
+    ~AlignmentInfoTable() noexcept;
+
+    /// Append the metadata of an alignment line as a row.
+    void append(const AlignmentInfo& align_info);
+
+    /// Write the table file and remove the scratch files.
+    void close();
+
+    /// Number of rows appended.
+    std::size_t getNumberOfRows() const
+    {
+        return static_cast<std::size_t>(n_rows);
+    }
+};
+
+}
+
+#endif /* AlignmentInfoTable_hpp */
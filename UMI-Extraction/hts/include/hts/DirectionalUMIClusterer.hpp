@@ -0,0 +1,92 @@
+//
+//  DirectionalUMIClusterer.hpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#ifndef DirectionalUMIClusterer_hpp
+#define DirectionalUMIClusterer_hpp
+
+#include <vector>
+#include <cstddef>
+#include "UMIBarcodePacker.hpp"
+
+namespace hts
+{
+
+/// \brief Cluster the UMI barcodes of a gene with the directional method.
+/// This class groups the distinct packed UMI barcodes of a single gene into
+/// clusters, each of which is assumed to come from one mRNA molecule, using
+/// the directional adjacency method of UMI-tools:
+///
+/// 1) UMI barcode a is connected to UMI barcode b if they differ by a single
+///    substitution and count(a) >= 2*count(b)-1, i.e. b is likely to be a
+///    sequencing error of a.
+/// 2) Starting from the most abundant UMI barcode not yet clustered, all the
+///    UMI barcodes reachable through such connections form one cluster, whose
+///    root is the starting UMI barcode.
+///
+/// The neighbors of a UMI barcode are found in two ways depending on the
+/// number of UMI barcodes of the gene:
+///
+/// 1) For a few UMI barcodes, all pairs are compared by the XOR of their codes,
+///    where a single substitution leaves exactly one non-zero 2-bit group.
+/// 2) Otherwise, all 3*L single-substitution variants of a L-nt UMI barcode
+///    (30 for 10-nt) are generated by XOR-ing each 2-bit group with 1, 2 and 3,
+///    and probed in a hash table of codes.
+///
+/// Either way, the cost of clustering grows linearly with the number of UMI
+/// barcodes for highly expressed genes.
+class DirectionalUMIClusterer
+{
+public:
+
+    using CodeType = UMIBarcodePacker::CodeType;
+
+    /// A distinct UMI barcode and the number of alignments tagged with it.
+    struct UMICount
+    {
+        CodeType code {0};
+        std::size_t count {0};
+    };
+
+    /// Maximum number of UMI barcodes compared pairwise.
+    static constexpr std::size_t max_pairwise_umis {32};
+
+private:
+
+    /// Length of packed UMI barcode.
+    std::size_t umi_length {0};
+
+private:
+
+    /// Find the neighbors of each UMI barcode by pairwise comparison.
+    void findNeighborsPairwise(const std::vector<UMICount>& umi_counts, std::vector<std::vector<std::size_t>>& neighbors) const;
+
+    /// Find the neighbors of each UMI barcode by probing substitution variants.
+    void findNeighborsByVariants(const std::vector<UMICount>& umi_counts, std::vector<std::vector<std::size_t>>& neighbors) const;
+
+public:
+
+    explicit DirectionalUMIClusterer(std::size_t umi_length);
+
+    /// Check if two packed UMI barcodes differ by a single substitution.
+    static bool isSingleSubstitution(CodeType code_a, CodeType code_b);
+
+    /// Check if UMI barcode b can be absorbed by UMI barcode a.
+    static bool isDirectionalEdge(std::size_t count_a, std::size_t count_b)
+    {
+        return count_a+1 >= 2*count_b;
+    }
+
+    /// \brief Cluster the distinct UMI barcodes of a gene.
+    /// \param   umi_counts  The distinct UMI barcodes and their counts.
+    /// \return  The index of the root UMI barcode of the cluster of each UMI
+    ///          barcode, where a root UMI barcode points to itself.
+    std::vector<std::size_t> cluster(const std::vector<UMICount>& umi_counts) const;
+};
+
+}
+
+#endif /* DirectionalUMIClusterer_hpp */
@@ -9,8 +9,12 @@
 #ifndef FASTQSequenceDemuxController_hpp
 #define FASTQSequenceDemuxController_hpp
 
+#include <memory>
 #include <utility>
 #include <iostream>
+#include <utk/FileUtils.hpp>
+#include <utk/ProgressReporter.hpp>
+#include <utk/AllocationTracker.hpp>
 #include "PairedFASTQFilePathReader.hpp"
 
 namespace hts
@@ -88,6 +92,12 @@ private:
     /// \brief Paths of all input FASTQ files
     PairedFASTQFilePaths fastq_file_paths;
 
+    /// \brief Interval of progress reports in seconds, or 0 for no reports
+    double progress_interval {0};
+
+    /// \brief Path of the status file of progress reports, or empty for stderr
+    std::string progress_file_path;
+
 public:
 
     FASTQSequenceDemuxController(const std::string& fastq_file_paths_file_path, const std::string& well_barcode_file_path, const std::string& demux_file_name, const std::string& demux_file_dir, bool parse_seq=true, bool parse_seq_id_level_1=true, bool parse_seq_id_level_2=false, bool flush_seq_ostream=false, std::size_t n_read_seqs=131072, std::size_t n_group_seqs=131072, bool flush_seqs_ostream=true, const std::string& fastq_paths_file_line_delim_type="unix", const std::string& well_barcode_file_line_delim_type="unix", const std::string& fastq_data_file_line_delim_type="unix", bool verbose=false) :
@@ -112,11 +122,36 @@ public:
         fastq_file_paths = fastq_file_path_reader.read();
     }
 
+    /// \brief Report the progress of the next run periodically
+    /// A timer thread reports the number of sequences read, the throughput,
+    /// and the estimated time to finish from the bytes read of all input
+    /// FASTQ files, without any cost to reading sequences but a few counter
+    /// updates per batch.
+    /// \param  interval_seconds  The interval of reports, or 0 for no reports.
+    /// \param  status_file_path  The status file to replace with the latest
+    ///                           report, or empty for the standard error.
+    void setProgressReporting(double interval_seconds, const std::string& status_file_path="")
+    {
+        progress_interval = interval_seconds;
+        progress_file_path = status_file_path;
+    }
+
     template<typename... ArgTypes>
     void run(ArgTypes&&... args)
     {
+        utk::AllocationTracker::SnapshotType allocation_snapshot;
+        if constexpr (utk::AllocationTracker::enabled) allocation_snapshot = utk::AllocationTracker::getSnapshot();
         // 2) Create a FASTQ sequence demultiplexer.
         FASTQDemuxerType seq_demuxer(well_barcode_file_path, demux_file_name, demux_file_dir, n_group_seqs, flush_seqs_ostream, well_barcode_file_line_delim_type, verbose);
+        // Create a progress reporter for the total size of all input FASTQ files.
+        std::unique_ptr<utk::ProgressReporter> progress_reporter;
+        std::size_t n_read_seqs_before = 0, n_read_bytes_before = 0;
+        if(progress_interval > 0)
+        {
+            std::uintmax_t n_total_bytes = 0;
+            for(const auto& fastq_file_path : fastq_file_paths) n_total_bytes += utk::getFileSize(fastq_file_path.first) + utk::getFileSize(fastq_file_path.second);
+            progress_reporter = std::make_unique<utk::ProgressReporter>(fastq_file_paths_file_path, "sequences", n_total_bytes, progress_interval, progress_file_path);
+        }
         // 3) Demultiplex FASTQ sequences in each paired-end FASTQ file.
         for(const auto& fastq_file_path : fastq_file_paths)
         {
@@ -125,12 +160,22 @@ public:
             FASTQFileType r2_fastq_file(fastq_file_path.second, fastq_data_file_line_delim_type, parse_seq, parse_seq_id_level_1, parse_seq_id_level_2, flush_seq_ostream);
             // Send all sequences from paired FASTQ files to sequence demultiplexer.
             FASTQSequencePipeType<FASTQFileType, FASTQDemuxerType> seq_pipe(r1_fastq_file, r2_fastq_file, seq_demuxer);
+            if(progress_reporter) seq_pipe.setProgressReporter(*progress_reporter, n_read_seqs_before, n_read_bytes_before);
             seq_pipe.run(n_read_seqs, std::forward<ArgTypes>(args)...);
+            if(progress_reporter)
+            {
+                n_read_seqs_before += seq_pipe.getNumberOfReadSequences();
+                n_read_bytes_before += utk::getFileSize(fastq_file_path.first) + utk::getFileSize(fastq_file_path.second);
+                progress_reporter->setProgress(n_read_seqs_before, n_read_bytes_before);
+            }
         }
         // 4) Write out remaining FASTQ sequences in demultiplexer.
         seq_demuxer.writeSequences(true);
+        if(progress_reporter) progress_reporter->finish();
         // 5) Print summary statistics of demultiplexed FASTQ sequences.
         std::cout << "Number of grouped FASTQ sequences: " << seq_demuxer.getNumberOfGroupedSequences() << ";  Number of un-grouped FASTQ sequences: " << seq_demuxer.getNumberOfUngroupedSequences() << std::endl;
+        // Report the heap allocations per sequence of each stage if tracked.
+        if constexpr (utk::AllocationTracker::enabled) utk::AllocationTracker::report(std::cout, allocation_snapshot, seq_demuxer.getNumberOfGroupedSequences()+seq_demuxer.getNumberOfUngroupedSequences(), "sequence");
     }
 };
 
@@ -11,6 +11,8 @@
 
 #include <iostream>
 #include <utility>
+#include <utk/AllocationTracker.hpp>
+#include <utk/Tracer.hpp>
 #include "FASTQSequenceGroups.hpp"
 #include "WellBarcodeReader.hpp"
 
@@ -177,6 +179,8 @@ public:
     /// \param  flush  Whether to flush written sequences in output streams.
     void writeSequences(const GroupIdType& group_id, SequencesType& group_seqs, bool flush=false)
     {
+        UTK_ALLOCATION_SCOPE("write");
+        UTK_TRACE_SCOPE("flush");
         // Output all the sequences in the maxout group to standard output.
         for(const auto& group_seq : group_seqs)
         {
@@ -11,6 +11,7 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <utk/ProgressReporter.hpp>
 
 namespace hts
 {
@@ -39,10 +40,46 @@ private:
     /// A holder of FASTQ sequence demultiplexer.
     SeqDemuxer& seq_demuxer;
 
+    /// Periodic progress reporter, or nullptr if not needed.
+    utk::ProgressReporter* progress_reporter {nullptr};
+
+    /// Numbers of sequences and bytes read from earlier files.
+    std::size_t n_base_seqs {0}, n_base_bytes {0};
+
+    /// Numbers of sequences and bytes read from the current file.
+    std::size_t n_seqs {0}, n_bytes {0};
+
+private:
+
+    /// Publish the numbers of sequences and bytes read so far to the
+    /// progress reporter.
+    void publishProgress()
+    {
+        // The read position is unknown for the standard input stream and at
+        // the end of file, where the last known position is kept.
+        if(auto pos = file_reader.tellg(); pos >= 0) n_bytes = static_cast<std::size_t>(pos);
+        progress_reporter->setProgress(n_base_seqs + n_seqs, n_base_bytes + n_bytes);
+    }
+
 public:
 
     FASTQSequencePipe(FileReader& reader, SeqDemuxer& demuxer) : file_reader{reader}, seq_demuxer{demuxer} {}
 
+    /// Set the progress reporter to publish the sequences and bytes read to
+    /// after each batch, on top of those read from earlier files.
+    void setProgressReporter(utk::ProgressReporter& reporter, std::size_t n_read_seqs_before, std::size_t n_read_bytes_before)
+    {
+        progress_reporter = &reporter;
+        n_base_seqs = n_read_seqs_before;
+        n_base_bytes = n_read_bytes_before;
+    }
+
+    /// Number of sequences read by the last run.
+    std::size_t getNumberOfReadSequences() const
+    {
+        return n_seqs;
+    }
+
     /// \brief Feed all FASTQ sequences from file to demultiplexer
     /// This function reads all FASTQ sequence fragments from a specified FASTQ
     /// file reader and feeds each sequence to a specified sequence demultiplexer
@@ -76,6 +113,8 @@ public:
                         std::cerr << "Warning: " << e.what() << '!' << std::endl;
                     }
                 }
+                n_seqs += seqs.size();
+                if(progress_reporter != nullptr) publishProgress();
             }
         }
     }
@@ -0,0 +1,87 @@
+//
+//  GeneCountTable.hpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#ifndef GeneCountTable_hpp
+#define GeneCountTable_hpp
+
+#include <string>
+#include <vector>
+#include <array>
+#include <mutex>
+#include <unordered_map>
+#include <cstddef>
+
+namespace hts
+{
+
+/// Number of unique molecules of each gene in one sample.
+using GeneCounts = std::unordered_map<std::string, std::size_t>;
+
+/// The end of the last exon of each gene on each reference sequence.
+using GeneExonEnds = std::unordered_map<std::string, std::unordered_map<std::string, std::size_t>>;
+
+/// \brief A gene-by-sample table of unique molecule counts.
+/// This class collects the per-gene counts of unique gene-UMI combinations of
+/// multiple samples, e.g. the wells of a plate, and writes them as a read
+/// counts table in the format of featureCounts:
+///
+/// # Program:... Command:...
+/// Geneid  Chr  Start  End  Strand  Length  Sample-1  Sample-2  ...
+///
+/// The annotation columns from Chr to Length are copied from a read counts
+/// table generated by featureCounts with the same annotation file, which also
+/// provides the genes without any counts. Otherwise only the genes counted in
+/// at least one sample are written, with empty annotation columns.
+class GeneCountTable
+{
+public:
+
+    /// Number of annotation columns in front of sample columns.
+    static constexpr std::size_t n_annotation_columns {6};
+
+    /// Names of annotation columns.
+    static const std::array<std::string, n_annotation_columns> annotation_column_names;
+
+private:
+
+    /// Names of sample columns.
+    std::vector<std::string> sample_names;
+
+    /// Annotated genes in the order of annotation table.
+    std::vector<std::string> annotated_genes;
+
+    /// Annotation columns from Chr to Length of each annotated gene.
+    std::unordered_map<std::string, std::vector<std::string>> gene_annotations;
+
+    /// Counts of all samples of each gene.
+    std::unordered_map<std::string, std::vector<std::size_t>> gene_sample_counts;
+
+    /// Synchronization for samples counted by multiple threads.
+    mutable std::mutex table_mutex;
+
+public:
+
+    explicit GeneCountTable(std::vector<std::string> sample_names);
+
+    /// Read gene annotations from a read counts table of featureCounts.
+    void readAnnotations(const std::string& counts_file_path);
+
+    /// Get the end of the last exon of each annotated gene on each reference
+    /// sequence from the Chr and End columns.
+    GeneExonEnds getGeneExonEnds() const;
+
+    /// Set the gene counts of a sample.
+    /// Note: this function can be called by multiple threads at the same time.
+    void setSampleCounts(std::size_t sample_index, const GeneCounts& gene_counts);
+
+    /// Write the table to a file, with a comment line of the program.
+    void write(const std::string& counts_file_path, const std::string& program_info) const;
+};
+
+}
+
+#endif /* GeneCountTable_hpp */
@@ -0,0 +1,58 @@
+//
+//  GeneUMIKey.hpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#ifndef GeneUMIKey_hpp
+#define GeneUMIKey_hpp
+
+#include <string>
+#include <functional>
+
+namespace hts
+{
+
+/// \brief The gene-UMI combination of a uniquely aligned sequence.
+/// This structure is the classification result of an alignment line produced
+/// by a gene-UMI counter, which can be computed independently for each line
+/// and then counted in the order of input lines.
+struct GeneUMIKey
+{
+    /// The gene that the sequence is uniquely aligned to.
+    std::string target_gene;
+
+    /// The UMI barcode of the sequence.
+    std::string umi_barcode;
+
+    bool operator==(const GeneUMIKey& key) const
+    {
+        return target_gene == key.target_gene && umi_barcode == key.umi_barcode;
+    }
+};
+
+/// Hash function of a gene-UMI combination.
+struct GeneUMIKeyHash
+{
+    std::size_t operator()(const GeneUMIKey& key) const
+    {
+        std::size_t gene_hash = std::hash<std::string>()(key.target_gene);
+        std::size_t umi_hash = std::hash<std::string>()(key.umi_barcode);
+        return gene_hash ^ (umi_hash + 0x9e3779b97f4a7c15ULL + (gene_hash << 6) + (gene_hash >> 2));
+    }
+};
+
+/// Hash function of the gene of a gene-UMI combination, which partitions the
+/// gene-UMI combinations by gene.
+struct GeneUMIKeyGeneHash
+{
+    std::size_t operator()(const GeneUMIKey& key) const
+    {
+        return std::hash<std::string>()(key.target_gene);
+    }
+};
+
+}
+
+#endif /* GeneUMIKey_hpp */
@@ -0,0 +1,34 @@
+//
+//  GeneUMILocusKey.hpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#ifndef GeneUMILocusKey_hpp
+#define GeneUMILocusKey_hpp
+
+#include <string>
+#include "GeneUMIKey.hpp"
+
+namespace hts
+{
+
+/// \brief The gene-UMI combination of a uniquely aligned sequence together
+/// with the locus of its alignment.
+/// This structure extends GeneUMIKey with the reference sequence and the
+/// leftmost position of the alignment, which tell a counter how far a
+/// coordinate-sorted input SAM file has progressed. The locus doesn't take
+/// part in the comparison or the hash of gene-UMI combinations.
+struct GeneUMILocusKey : public GeneUMIKey
+{
+    /// The reference sequence that the sequence is aligned to.
+    std::string reference_name;
+
+    /// The 1-based leftmost position of the alignment.
+    std::size_t position {0};
+};
+
+}
+
+#endif /* GeneUMILocusKey_hpp */
@@ -0,0 +1,37 @@
+//
+//  GeneUMIPositionKey.hpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#ifndef GeneUMIPositionKey_hpp
+#define GeneUMIPositionKey_hpp
+
+#include <string>
+
+namespace hts
+{
+
+/// \brief The gene-UMI-position combination of a uniquely aligned sequence.
+/// This structure extends GeneUMIKey with the strand-aware 5' end of the
+/// alignment, so that the molecules of the same gene tagged with the same UMI
+/// barcode by chance can be told apart by where they start.
+struct GeneUMIPositionKey
+{
+    /// The gene that the sequence is uniquely aligned to.
+    std::string target_gene;
+
+    /// The UMI barcode of the sequence.
+    std::string umi_barcode;
+
+    /// Whether the sequence is aligned to the reverse strand.
+    bool reverse_strand {false};
+
+    /// The 1-based 5' end of the alignment.
+    long long five_prime_pos {0};
+};
+
+}
+
+#endif /* GeneUMIPositionKey_hpp */
@@ -0,0 +1,184 @@
+//
+//  GeneUMISnapshot.hpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#ifndef GeneUMISnapshot_hpp
+#define GeneUMISnapshot_hpp
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <unordered_map>
+#include <utk/MappedFile.hpp>
+#include "GeneCountTable.hpp"
+
+namespace hts
+{
+
+/// \brief A snapshot file of the gene-UMI combinations seen in one sample.
+/// This class keeps the dedup state of a sample between runs, so that new
+/// sequencing lanes of the sample can be deduplicated against the lanes
+/// already counted. The snapshot file is laid out for reading in place from
+/// a memory mapping:
+///
+/// 1) A header of fixed size with the format version, the UMI length, and the
+///    numbers of items in each section.
+/// 2) The genes, each with its count of unique gene-UMI combinations and the
+///    location of its name in the string section.
+/// 3) The sorted packed keys of gene-UMI combinations, each with the gene
+///    index in the upper 32 bits and the 2-bit packed UMI barcode in the lower
+///    32 bits.
+/// 4) The sorted gene-UMI combinations whose UMI barcodes cannot be packed,
+///    each as the location of a gene-tab-UMI string in the string section.
+/// 5) The string section.
+///
+/// Packed keys are found by binary search, so that loading a snapshot costs
+/// no more than mapping it, and only the pages touched by the new lanes are
+/// read from disk.
+class GeneUMISnapshot
+{
+public:
+
+    /// Magic bytes at the start of a snapshot file.
+    static constexpr char magic[8] {'H','T','S','G','U','M','I','S'};
+
+    /// Version of the snapshot format.
+    static constexpr std::uint32_t format_version {1};
+
+    /// The header of a snapshot file.
+    struct Header
+    {
+        char magic[8] {};
+        std::uint32_t format_version {0};
+        std::uint32_t umi_length {0};
+        std::uint64_t n_genes {0};
+        std::uint64_t n_packed_keys {0};
+        std::uint64_t n_unpacked_combos {0};
+        std::uint64_t strings_size {0};
+    };
+
+    /// A gene with its count and the location of its name.
+    struct GeneEntry
+    {
+        std::uint64_t n_combos {0};
+        std::uint64_t name_offset {0};
+        std::uint64_t name_length {0};
+    };
+
+    /// The location of a string in the string section.
+    struct StringEntry
+    {
+        std::uint64_t offset {0};
+        std::uint64_t length {0};
+    };
+
+private:
+
+    /// The mapping of snapshot file.
+    std::unique_ptr<utk::MappedFile> snapshot_file;
+
+    /// The header of snapshot file.
+    Header header;
+
+    /// The sections of snapshot file in the mapping.
+    const GeneEntry* genes {nullptr};
+    const std::uint64_t* packed_keys {nullptr};
+    const StringEntry* unpacked_combos {nullptr};
+    const char* strings {nullptr};
+
+private:
+
+    /// Get a string of the string section.
+    std::string_view getString(std::uint64_t offset, std::uint64_t length) const
+    {
+        return std::string_view(strings+offset, length);
+    }
+
+public:
+
+    /// Create an empty snapshot.
+    explicit GeneUMISnapshot(std::size_t umi_length);
+
+    /// Map a snapshot file and check its format.
+    explicit GeneUMISnapshot(const std::string& snapshot_file_path);
+
+    /// Length of UMI barcode of packed keys.
+    std::size_t getUMILength() const
+    {
+        return header.umi_length;
+    }
+
+    /// Number of genes.
+    std::size_t getNumberOfGenes() const
+    {
+        return static_cast<std::size_t>(header.n_genes);
+    }
+
+    /// Name of a gene.
+    std::string_view getGeneName(std::size_t gene_index) const
+    {
+        return getString(genes[gene_index].name_offset, genes[gene_index].name_length);
+    }
+
+    /// Number of unique gene-UMI combinations of a gene.
+    std::size_t getGeneCount(std::size_t gene_index) const
+    {
+        return static_cast<std::size_t>(genes[gene_index].n_combos);
+    }
+
+    /// Number of gene-UMI combinations.
+    std::size_t getNumberOfCombinations() const
+    {
+        return static_cast<std::size_t>(header.n_packed_keys + header.n_unpacked_combos);
+    }
+
+    /// Sorted packed keys of gene-UMI combinations.
+    const std::uint64_t* getPackedKeys() const
+    {
+        return packed_keys;
+    }
+
+    /// Number of packed keys.
+    std::size_t getNumberOfPackedKeys() const
+    {
+        return static_cast<std::size_t>(header.n_packed_keys);
+    }
+
+    /// The gene-tab-UMI string of a combination whose UMI cannot be packed.
+    std::string_view getUnpackedCombination(std::size_t combo_index) const
+    {
+        return getString(unpacked_combos[combo_index].offset, unpacked_combos[combo_index].length);
+    }
+
+    /// Number of combinations whose UMI barcodes cannot be packed.
+    std::size_t getNumberOfUnpackedCombinations() const
+    {
+        return static_cast<std::size_t>(header.n_unpacked_combos);
+    }
+
+    /// Check if a packed key is in the snapshot.
+    bool containsPackedKey(std::uint64_t packed_key) const;
+
+    /// Check if a gene-tab-UMI string is in the snapshot.
+    bool containsUnpackedCombination(std::string_view gene_umi_combo) const;
+
+    /// \brief Write a snapshot file.
+    /// The file is written next to the snapshot file path and then renamed
+    /// to it, so that an existing snapshot file, which may be mapped at the
+    /// same time, is replaced only by a complete one.
+    /// \param  gene_names       The names of genes indexed by packed keys.
+    /// \param  gene_counts      The number of combinations of each gene.
+    /// \param  packed_keys      The sorted packed keys.
+    /// \param  unpacked_combos  The sorted gene-tab-UMI strings of the
+    ///                          combinations whose UMIs cannot be packed.
+    static void write(const std::string& snapshot_file_path, std::size_t umi_length, const std::vector<std::string>& gene_names, const std::vector<std::size_t>& gene_counts, const std::vector<std::uint64_t>& packed_keys, const std::vector<std::string>& unpacked_combos);
+};
+
+}
+
+#endif /* GeneUMISnapshot_hpp */
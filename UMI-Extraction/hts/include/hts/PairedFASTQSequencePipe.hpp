@@ -11,6 +11,9 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <utk/ProgressReporter.hpp>
+#include <utk/AllocationTracker.hpp>
+#include <utk/Tracer.hpp>
 
 namespace hts
 {
@@ -39,10 +42,46 @@ private:
     /// A holder of FASTQ sequence demultiplexer.
     SeqDemuxer& seq_demuxer;
 
+    /// Periodic progress reporter, or nullptr if not needed.
+    utk::ProgressReporter* progress_reporter {nullptr};
+
+    /// Numbers of sequences and bytes read from earlier files.
+    std::size_t n_base_seqs {0}, n_base_bytes {0};
+
+    /// Numbers of sequences and bytes read from the current file pair.
+    std::size_t n_seqs {0}, n_bytes {0};
+
+private:
+
+    /// Publish the numbers of sequences and bytes read so far to the
+    /// progress reporter.
+    void publishProgress()
+    {
+        // The read position is unknown for the standard input stream and at
+        // the end of file, where the last known position is kept.
+        if(auto pos_1 = file_reader_1.tellg(), pos_2 = file_reader_2.tellg(); pos_1 >= 0 && pos_2 >= 0) n_bytes = static_cast<std::size_t>(pos_1 + pos_2);
+        progress_reporter->setProgress(n_base_seqs + n_seqs, n_base_bytes + n_bytes);
+    }
+
 public:
 
     PairedFASTQSequencePipe(FileReader& reader_1, FileReader& reader_2, SeqDemuxer& demuxer) : file_reader_1{reader_1}, file_reader_2{reader_2}, seq_demuxer{demuxer} {}
 
+    /// Set the progress reporter to publish the sequences and bytes read to
+    /// after each batch, on top of those read from earlier files.
+    void setProgressReporter(utk::ProgressReporter& reporter, std::size_t n_read_seqs_before, std::size_t n_read_bytes_before)
+    {
+        progress_reporter = &reporter;
+        n_base_seqs = n_read_seqs_before;
+        n_base_bytes = n_read_bytes_before;
+    }
+
+    /// Number of sequences read by the last run.
+    std::size_t getNumberOfReadSequences() const
+    {
+        return n_seqs;
+    }
+
     /// \brief Feed all FASTQ sequences from file to demultiplexer
     /// This function reads all FASTQ sequence fragments from a pair of specified
     /// FASTQ file readers and feeds each pair of sequences to a specified sequence
@@ -56,17 +95,26 @@ public:
     template<typename... ArgTypes>
     void run(std::size_t n_read_seqs, ArgTypes&&... args)
     {
+        UTK_ALLOCATION_SCOPE("read");
         // Read multiple FASTQ sequences before reaching the end of FASTQ file.
         while(!file_reader_1.isFileEnd())
         {
             // If the end of FASTQ file is not reached yet, keep reading in
             // next batch of sequences.
-            if(auto seqs_1 = file_reader_1.readSequences(n_read_seqs), seqs_2 = file_reader_2.readSequences(n_read_seqs); seqs_1.size()>0 && seqs_2.size()>0)
+            decltype(file_reader_1.readSequences(n_read_seqs)) seqs_1, seqs_2;
+            {
+                UTK_TRACE_SCOPE("read");
+                seqs_1 = file_reader_1.readSequences(n_read_seqs);
+                seqs_2 = file_reader_2.readSequences(n_read_seqs);
+            }
+            if(seqs_1.size()>0 && seqs_2.size()>0)
             {
+                UTK_TRACE_SCOPE("demux");
                 for(auto iter_1=seqs_1.begin(),iter_2=seqs_2.begin(); iter_1!=seqs_1.end()&&iter_2!=seqs_2.end(); ++iter_1,++iter_2)
                 {
                     try
                     {
+                        UTK_ALLOCATION_SCOPE("demux");
                         // Assemble a FASTQ sequence or a pair of sequences and add it to
                         // corresponding sequence group in demultiplexer.
                         seq_demuxer.addSequence(std::move(*iter_1), std::move(*iter_2), std::forward<ArgTypes>(args)...);
@@ -76,6 +124,8 @@ public:
                         std::cerr << "Warning: " << e.what() << '!' << std::endl;
                     }
                 }
+                n_seqs += seqs_1.size();
+                if(progress_reporter != nullptr) publishProgress();
             }
         }
     }
@@ -9,6 +9,11 @@
 #ifndef SAMAlignmentCounter_hpp
 #define SAMAlignmentCounter_hpp
 
+#include <string>
+#include <utility>
+#include <type_traits>
+#include <utk/HashTableStats.hpp>
+
 namespace hts
 {
 
@@ -16,6 +21,10 @@ namespace hts
 /// This class checks header data line, header comment line, and alignment line
 /// for their output eligibilities in SAMAlignmentPipe.
 ///
+/// Note: SAMAlignmentPipe calls a counter through its concrete type, so a
+/// derived counter should be declared final for these calls to be bound
+/// statically and inlined into the loop of the pipe.
+///
 /// \tparam  SAMHeaderDataLineType     The type of SAM header data line.
 /// \tparam  SAMHeaderCommentLineType  The type of SAM header comment line.
 /// \tparam  SAMAlignmentLineType  The type of SAM alignment line.
@@ -59,6 +68,131 @@ public:
     }
 };
 
+/// \brief Check if a type provides the static interface of a SAM alignment counter.
+/// SAMAlignmentPipe only needs a counter to provide:
+///
+/// 1) bool countHeaderDataLine(const SAMHeaderDataLineType&, bool& aux_count)
+/// 2) bool countHeaderCommentLine(const SAMHeaderCommentLineType&, bool& aux_count)
+/// 3) bool countAlignmentLine(const SAMAlignmentLineType&, bool& aux_count)
+///
+/// which may be non-virtual functions of a class not derived from
+/// SAMAlignmentCounter, such as a SAMFilteredAlignmentCounter fusing filters
+/// with a counter.
+template<typename SAMAlignmentCounterType, typename SAMHeaderDataLineType, typename SAMHeaderCommentLineType, typename SAMAlignmentLineType, typename = void>
+struct isSAMAlignmentCounter : std::false_type {};
+
+template<typename SAMAlignmentCounterType, typename SAMHeaderDataLineType, typename SAMHeaderCommentLineType, typename SAMAlignmentLineType>
+struct isSAMAlignmentCounter<SAMAlignmentCounterType, SAMHeaderDataLineType, SAMHeaderCommentLineType, SAMAlignmentLineType, std::void_t<decltype(std::declval<SAMAlignmentCounterType&>().countHeaderDataLine(std::declval<const SAMHeaderDataLineType&>(), std::declval<bool&>())), decltype(std::declval<SAMAlignmentCounterType&>().countHeaderCommentLine(std::declval<const SAMHeaderCommentLineType&>(), std::declval<bool&>())), decltype(std::declval<SAMAlignmentCounterType&>().countAlignmentLine(std::declval<const SAMAlignmentLineType&>(), std::declval<bool&>()))>> : std::true_type {};
+
+template<typename SAMAlignmentCounterType, typename SAMHeaderDataLineType, typename SAMHeaderCommentLineType, typename SAMAlignmentLineType>
+inline constexpr bool isSAMAlignmentCounter_v = isSAMAlignmentCounter<SAMAlignmentCounterType, SAMHeaderDataLineType, SAMHeaderCommentLineType, SAMAlignmentLineType>::value;
+
+/// \brief Check if a counter supports two-phase counting of alignment lines.
+/// A two-phase counter splits countAlignmentLine into:
+///
+/// 1) bool classifyAlignmentLine(const SAMAlignmentLineType&, AlignmentKeyType&) const
+///    which extracts the key of an alignment line without changing the state
+///    of the counter, so that it can be called by multiple threads at once.
+/// 2) bool countAlignmentKey(const AlignmentKeyType&, bool& aux_count)
+///    which makes the output decision for a classified alignment line, and
+///    must be called in the order of input lines.
+///
+/// SAMAlignmentPipe uses this split to parse and classify alignment lines in
+/// parallel while keeping the output identical to serial processing.
+template<typename SAMAlignmentCounterType, typename SAMAlignmentLineType, typename = void>
+struct isTwoPhaseSAMAlignmentCounter : std::false_type {};
+
+template<typename SAMAlignmentCounterType, typename SAMAlignmentLineType>
+struct isTwoPhaseSAMAlignmentCounter<SAMAlignmentCounterType, SAMAlignmentLineType, std::void_t<typename SAMAlignmentCounterType::AlignmentKeyType, decltype(std::declval<const SAMAlignmentCounterType&>().classifyAlignmentLine(std::declval<const SAMAlignmentLineType&>(), std::declval<typename SAMAlignmentCounterType::AlignmentKeyType&>())), decltype(std::declval<SAMAlignmentCounterType&>().countAlignmentKey(std::declval<const typename SAMAlignmentCounterType::AlignmentKeyType&>(), std::declval<bool&>()))>> : std::true_type {};
+
+template<typename SAMAlignmentCounterType, typename SAMAlignmentLineType>
+inline constexpr bool isTwoPhaseSAMAlignmentCounter_v = isTwoPhaseSAMAlignmentCounter<SAMAlignmentCounterType, SAMAlignmentLineType>::value;
+
+/// \brief Check if a two-phase counter supports external sharded deduplication.
+/// Such a counter additionally provides:
+///
+/// 1) AlignmentKeyHash and AlignmentKeyShardHash, the hash functions of keys
+///    within a shard and for routing keys to shards. All keys that may be
+///    duplicates of each other must be routed to the same shard.
+/// 2) bool countUniqueAlignmentKey(const AlignmentKeyType&, bool unique, bool& aux_count)
+///    which makes the output decision for a classified alignment line whose
+///    key has been deduplicated by a ShardedDedupSet, and must be called in
+///    the order of input lines.
+template<typename SAMAlignmentCounterType, typename SAMAlignmentLineType, typename = void>
+struct isShardedSAMAlignmentCounter : std::false_type {};
+
+template<typename SAMAlignmentCounterType, typename SAMAlignmentLineType>
+struct isShardedSAMAlignmentCounter<SAMAlignmentCounterType, SAMAlignmentLineType, std::void_t<typename SAMAlignmentCounterType::AlignmentKeyHash, typename SAMAlignmentCounterType::AlignmentKeyShardHash, decltype(std::declval<SAMAlignmentCounterType&>().countUniqueAlignmentKey(std::declval<const typename SAMAlignmentCounterType::AlignmentKeyType&>(), std::declval<bool>(), std::declval<bool&>()))>> : std::bool_constant<isTwoPhaseSAMAlignmentCounter_v<SAMAlignmentCounterType, SAMAlignmentLineType>> {};
+
+template<typename SAMAlignmentCounterType, typename SAMAlignmentLineType>
+inline constexpr bool isShardedSAMAlignmentCounter_v = isShardedSAMAlignmentCounter<SAMAlignmentCounterType, SAMAlignmentLineType>::value;
+
+/// \brief Check if a counter defers the output of selected alignment lines.
+/// Such a counter decides the final output only after all alignment lines are
+/// counted, and provides:
+///
+/// 1) void deferAlignmentLine(const std::string& line)
+///    which keeps an alignment line selected by the counter, in place of
+///    writing it to the output SAM file.
+/// 2) std::size_t writeDeferredAlignmentLines(SAMFileWriterType&)
+///    which writes the finally selected alignment lines after the input SAM
+///    file is finished, and returns the number of lines written.
+template<typename SAMAlignmentCounterType, typename = void>
+struct isDeferredSAMAlignmentCounter : std::false_type {};
+
+template<typename SAMAlignmentCounterType>
+struct isDeferredSAMAlignmentCounter<SAMAlignmentCounterType, std::void_t<decltype(std::declval<SAMAlignmentCounterType&>().deferAlignmentLine(std::declval<const std::string&>()))>> : std::true_type {};
+
+template<typename SAMAlignmentCounterType>
+inline constexpr bool isDeferredSAMAlignmentCounter_v = isDeferredSAMAlignmentCounter<SAMAlignmentCounterType>::value;
+
+/// \brief Check if a counter rejects alignment lines before they are parsed.
+/// Such a counter provides:
+///
+/// 1) bool prefilterAlignmentLine(const std::string& line) const
+///    which checks the raw text of an alignment line, and returns false if
+///    the line can never be selected, so that SAMAlignmentPipe skips parsing
+///    and counting it. It can be called by multiple threads at the same time.
+template<typename SAMAlignmentCounterType, typename = void>
+struct hasAlignmentPrefilter : std::false_type {};
+
+template<typename SAMAlignmentCounterType>
+struct hasAlignmentPrefilter<SAMAlignmentCounterType, std::void_t<decltype(std::declval<const SAMAlignmentCounterType&>().prefilterAlignmentLine(std::declval<const std::string&>()))>> : std::true_type {};
+
+template<typename SAMAlignmentCounterType>
+inline constexpr bool hasAlignmentPrefilter_v = hasAlignmentPrefilter<SAMAlignmentCounterType>::value;
+
+/// \brief Check if a counter reports the statistics of its dedup table.
+/// Such a counter provides:
+///
+/// 1) void getDedupTableStats(utk::HashTableStats&) const
+///    which adds the entries and buckets of the hash tables holding its
+///    distinct keys, for the performance report of SAMAlignmentPipe.
+template<typename SAMAlignmentCounterType, typename = void>
+struct hasDedupTableStats : std::false_type {};
+
+template<typename SAMAlignmentCounterType>
+struct hasDedupTableStats<SAMAlignmentCounterType, std::void_t<decltype(std::declval<const SAMAlignmentCounterType&>().getDedupTableStats(std::declval<utk::HashTableStats&>()))>> : std::true_type {};
+
+template<typename SAMAlignmentCounterType>
+inline constexpr bool hasDedupTableStats_v = hasDedupTableStats<SAMAlignmentCounterType>::value;
+
+/// \brief Check if a counter reports the memory of its dedup table.
+/// Such a counter provides:
+///
+/// 1) std::size_t getMemoryUsage() const
+///    which returns the memory of its dedup table in bytes, for the progress
+///    reports of SAMAlignmentPipe. It is called from time to time during the
+///    run, and should be cheap compared with counting a chunk of lines.
+template<typename SAMAlignmentCounterType, typename = void>
+struct hasMemoryUsage : std::false_type {};
+
+template<typename SAMAlignmentCounterType>
+struct hasMemoryUsage<SAMAlignmentCounterType, std::void_t<decltype(std::declval<const SAMAlignmentCounterType&>().getMemoryUsage())>> : std::true_type {};
+
+template<typename SAMAlignmentCounterType>
+inline constexpr bool hasMemoryUsage_v = hasMemoryUsage<SAMAlignmentCounterType>::value;
+
 }
 
 #endif /* SAMAlignmentCounter_hpp */
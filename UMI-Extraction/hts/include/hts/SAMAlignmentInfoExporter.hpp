@@ -0,0 +1,107 @@
+//
+//  SAMAlignmentInfoExporter.hpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#ifndef SAMAlignmentInfoExporter_hpp
+#define SAMAlignmentInfoExporter_hpp
+
+#include <string>
+#include <string_view>
+#include "SAMAlignmentCounter.hpp"
+#include "SAMHeaderDataLine.hpp"
+#include "SAMHeaderCommentLine.hpp"
+#include "SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine.hpp"
+#include "AlignmentInfoTable.hpp"
+
+namespace hts
+{
+
+/// \brief Export the read-level metadata of SAM alignment lines.
+/// This class is the bulk counterpart of SAMAlignmentInfoPrinter: instead of
+/// printing every field of each alignment line, it decodes the sequence
+/// identifier, FLAG, RNAME, POS, MAPQ, and the target features and alignment
+/// status of featureCounts from the raw text of each alignment line, and
+/// writes them to an AlignmentInfoTable file.
+///
+/// The decoding is the classification of a two-phase counter, so that
+/// SAMAlignmentPipe runs it in its worker threads, while the rows are
+/// appended in the order of input lines. No line is selected for the output
+/// SAM file.
+class SAMAlignmentInfoExporter final : public SAMAlignmentCounter<SAMHeaderDataLine, SAMHeaderCommentLine, SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine>
+{
+public:
+
+    using SAMAlignmentCounterInst = SAMAlignmentCounter<SAMHeaderDataLine, SAMHeaderCommentLine, SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine>;
+
+    /// Type of the key of classified alignment line.
+    using AlignmentKeyType = AlignmentInfo;
+
+private:
+
+    /// The output table of alignment info.
+    AlignmentInfoTable info_table;
+
+public:
+
+    /// \param  export_file_path  The output AlignmentInfoTable file.
+    explicit SAMAlignmentInfoExporter(const std::string& export_file_path);
+
+    virtual ~SAMAlignmentInfoExporter() noexcept;
+
+    /// \brief Decode the metadata of an alignment line from its raw text.
+    /// An absent XT or XS tag is decoded as an empty string.
+    /// Note: a logic_error is thrown for a malformed alignment line or
+    /// sequence identifier.
+    static void decodeAlignmentLine(std::string_view line, AlignmentInfo& align_info);
+
+    /// Header lines are not exported.
+    virtual bool countHeaderDataLine(const SAMHeaderDataLine&, bool&) override
+    {
+        return false;
+    }
+
+    /// Header lines are not exported.
+    virtual bool countHeaderCommentLine(const SAMHeaderCommentLine&, bool&) override
+    {
+        return false;
+    }
+
+    /// Export the metadata of an alignment line.
+    virtual bool countAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, bool& aux_count) override;
+
+    /// Decode the metadata of an alignment line.
+    /// Note: this function doesn't change the exporter and can be called by
+    /// multiple threads at the same time.
+    bool classifyAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, AlignmentKeyType& align_info) const
+    {
+        decodeAlignmentLine(alignment_line.getLine(), align_info);
+        return true;
+    }
+
+    /// Append the decoded metadata of an alignment line to the table.
+    /// Note: this function must be called in the order of input lines.
+    bool countAlignmentKey(const AlignmentKeyType& align_info, bool&)
+    {
+        info_table.append(align_info);
+        return false;
+    }
+
+    /// Write the table file after all alignment lines are exported.
+    void close()
+    {
+        info_table.close();
+    }
+
+    /// Number of alignment lines exported.
+    std::size_t getNumberOfExportedAlignments() const
+    {
+        return info_table.getNumberOfRows();
+    }
+};
+
+}
+
+#endif /* SAMAlignmentInfoExporter_hpp */
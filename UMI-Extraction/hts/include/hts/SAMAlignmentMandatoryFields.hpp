@@ -14,6 +14,7 @@
 #include <string>
 #include <ostream>
 #include <cstddef>
+#include <string_view>
 
 namespace hts
 {
@@ -218,6 +219,27 @@ public:
         return flush_ostream;
     }
 
+    /// Check if the sequence is aligned to the reverse strand (FLAG 0x10).
+    bool isReverseStrand() const
+    {
+        return (flag & 0x10) != 0;
+    }
+
+    /// \brief Get the strand-aware 1-based 5' end of the alignment.
+    /// The 5' end is POS minus the leading soft clip for the forward strand,
+    /// or the last aligned reference position plus the trailing soft clip for
+    /// the reverse strand, so that soft clipping doesn't move the 5' end of a
+    /// molecule.
+    /// \return  The 5' end, which may be less than 1 for a forward alignment
+    ///          soft clipped at the start of the reference.
+    long long getFivePrimePosition() const;
+
+    /// \brief Get the strand-aware 1-based 5' end of an alignment from its
+    /// FLAG, POS and CIGAR, e.g. taken from the raw text of an alignment line
+    /// whose mandatory fields aren't parsed.
+    /// \param  qname  The QNAME of the alignment for error messages.
+    static long long getFivePrimePosition(std::size_t flag, std::size_t pos, std::string_view cigar, std::string_view qname);
+
     /// Parse mandatory fields.
     void parse();
 
@@ -14,9 +14,24 @@
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <utk/ConcurrentQueue.hpp>
+#include <utk/LapTimer.hpp>
+#include <utk/ResourceUsage.hpp>
+#include <utk/ProgressReporter.hpp>
+#include <utk/AllocationTracker.hpp>
+#include <utk/Tracer.hpp>
 #include "SAMHeaderDataLine.hpp"
 #include "SAMHeaderCommentLine.hpp"
 #include "SAMAlignmentLine.hpp"
+#include "SAMAlignmentCounter.hpp"
+#include "ShardedDedupSet.hpp"
+#include "SAMAlignmentPipeReport.hpp"
 
 namespace hts
 {
@@ -31,7 +46,9 @@ namespace hts
 /// \tparam  SAMFileReaderType         A SAMFileReader-based SAM file reader.
 /// \tparam  SAMFileWriterType         A LineWriter-based SAM file writer.
 /// \tparam  SAMAlignmentLineType      A SAMAlignmentLine-based SAM alignment line.
-/// \tparam  SAMAlignmentCounterType   A SAMAlignmentCounter-based counter class for SAM alignment lines.
+/// \tparam  SAMAlignmentCounterType   A counter class for SAM alignment lines with the static
+///                                    interface of SAMAlignmentCounter, which is called through
+///                                    its concrete type without virtual dispatch.
 ///
 /// \note    SAMAlignmentLineType and SAMAlignmentCounterType must be compatible
 ///          with each, because SAMAlignmentCounterType needs to call functions
@@ -39,40 +56,20 @@ namespace hts
 template<typename SAMFileReaderType, typename SAMFileWriterType, typename SAMAlignmentLineType, typename SAMAlignmentCounterType>
 class SAMAlignmentPipe
 {
-private:
-
-    /// A holder of SAM file reader.
-    SAMFileReaderType& file_reader;
+    static_assert(isSAMAlignmentCounter_v<SAMAlignmentCounterType, SAMHeaderDataLine, SAMHeaderCommentLine, SAMAlignmentLineType>, "SAMAlignmentCounterType must provide countHeaderDataLine, countHeaderCommentLine, and countAlignmentLine");
 
-    /// A holder of SAM file writer.
-    SAMFileWriterType& file_writer;
-
-    /// A holder of SAM alignment counter.
-    SAMAlignmentCounterType& align_counter;
+public:
 
-    /// Keyword for auxiliary alignment line to read.
-    std::string read_aux_align_line_name;
+    /// Default number of lines in a chunk processed by a worker thread.
+    static constexpr std::size_t default_n_chunk_lines {4096};
 
-    /// Keyword for auxiliary header data line to read.
-    std::string read_aux_header_data_line_name;
+    /// Number of lines between progress updates of serial processing.
+    static constexpr std::size_t n_progress_lines {4096};
 
-    /// Keyword for auxiliary header comment line to read.
-    std::string read_aux_header_comment_line_name;
-
-public:
-
-    SAMAlignmentPipe(SAMFileReaderType& reader, SAMFileWriterType& writer, SAMAlignmentCounterType& counter, const std::string& read_aux_align_line_name = "auxiliary", const std::string& read_aux_header_data_line_name = "auxiliary", const std::string& read_aux_header_comment_line_name = "auxiliary") : file_reader{reader}, file_writer{writer}, align_counter{counter}, read_aux_align_line_name{read_aux_align_line_name}, read_aux_header_data_line_name{read_aux_header_data_line_name}, read_aux_header_comment_line_name{read_aux_header_comment_line_name} {}
+private:
 
-    /// \brief Parse all lines of a SAM file to remove duplicate alignments.
-    ///
-    /// Parse all lines of a SAM file to filter out non-uniquely aligned and
-    /// non-uniquely tagged sequence alignments. The output SAM file contains:
-    ///
-    /// 1) All header data lines.
-    /// 2) All header comment lines.
-    /// 3) Alignments lines for all uniquely aligned sequences tagged with
-    ///    distinct UMI barcodes for each gene.
-    std::size_t run()
+    /// Statistics of input and output lines.
+    struct LineCounts
     {
         // The number of input alignment lines.
         std::size_t n_read_align_lines {0};
@@ -89,7 +86,7 @@ public:
         // The number of auxiliary input header data lines.
         std::size_t n_read_aux_header_data_lines {0};
 
-       // The number of output header data lines.
+        // The number of output header data lines.
         std::size_t n_write_header_data_lines {0};
 
         // The number of input header comment lines.
@@ -101,76 +98,713 @@ public:
         // The number of output header comment lines.
         std::size_t n_write_header_comment_lines {0};
 
+        // The number of bytes of input lines, each with one line delimiter.
+        std::size_t n_read_bytes {0};
+
+        // The number of bytes of output lines, each with one line delimiter.
+        std::size_t n_write_bytes {0};
+    };
+
+    /// Busy wall time and CPU time of the stages of a run.
+    struct StageTimes
+    {
+        // Indicator of the stages running on separate threads.
+        bool parallel {false};
+
+        // Busy wall time of each stage summed over its threads.
+        double read_seconds {0};
+        double parse_seconds {0};
+        double count_seconds {0};
+        double write_seconds {0};
+
+        // CPU time of the reader thread and the worker threads, which is
+        // only measured for parallel processing.
+        double read_cpu_seconds {0};
+        double parse_cpu_seconds {0};
+    };
+
+    /// \brief A chunk of consecutive input lines.
+    /// A chunk is cut from the input SAM file by the reader thread, parsed and
+    /// classified by a worker thread, and then counted and written in the order
+    /// of its sequence number.
+    template<typename AlignmentKeyType, typename DedupBatchType>
+    struct LineChunk
+    {
+        /// Sequence number of the chunk in the input SAM file.
+        std::size_t seq_number {0};
+
+        /// Input lines.
+        std::vector<std::string> lines;
+
+        /// Indicator of each classified alignment line eligible for counting.
+        std::vector<unsigned char> eligibles;
+
+        /// Key of each classified alignment line.
+        std::vector<AlignmentKeyType> keys;
+
+        /// Deduplication results of the keys from a sharded deduplication set.
+        std::shared_ptr<DedupBatchType> dedup_batch;
+
+        /// Position of the first line that failed to be parsed.
+        std::size_t n_error_line {0};
+
+        /// Exception thrown by the first line that failed to be parsed.
+        std::exception_ptr error;
+    };
+
+    /// Sharded deduplication set for the keys of a counter, which is void if
+    /// the counter doesn't support sharded deduplication.
+    template<typename AlignmentCounterType, bool = isShardedSAMAlignmentCounter_v<AlignmentCounterType, SAMAlignmentLineType>>
+    struct DedupSetSelector
+    {
+        using SetType = void;
+        using BatchType = void;
+    };
+
+    template<typename AlignmentCounterType>
+    struct DedupSetSelector<AlignmentCounterType, true>
+    {
+        using SetType = ShardedDedupSet<typename AlignmentCounterType::AlignmentKeyType, typename AlignmentCounterType::AlignmentKeyHash, typename AlignmentCounterType::AlignmentKeyShardHash>;
+        using BatchType = typename SetType::Batch;
+    };
+
+private:
+
+    /// A holder of SAM file reader.
+    SAMFileReaderType& file_reader;
+
+    /// A holder of SAM file writer.
+    SAMFileWriterType& file_writer;
+
+    /// A holder of SAM alignment counter.
+    SAMAlignmentCounterType& align_counter;
+
+    /// Keyword for auxiliary alignment line to read.
+    std::string read_aux_align_line_name;
+
+    /// Keyword for auxiliary header data line to read.
+    std::string read_aux_header_data_line_name;
+
+    /// Keyword for auxiliary header comment line to read.
+    std::string read_aux_header_comment_line_name;
+
+    /// Output stream for the statistics of input and output lines.
+    std::ostream* info_stream {&std::cout};
+
+    /// Performance report of the run, or nullptr if not needed.
+    SAMAlignmentPipeReport* report {nullptr};
+
+    /// Periodic progress reporter of the run, or nullptr if not needed.
+    utk::ProgressReporter* progress_reporter {nullptr};
+
+private:
+
+    /// Check if a line is an alignment line.
+    static bool isAlignmentLine(const std::string& line)
+    {
+        return line.front() != SAMHeaderLine::getBeginChar();
+    }
+
+    /// Check if an alignment line may be selected before parsing it, using
+    /// the prefilter of the counter if it has one.
+    bool prefilterAlignmentLine(const std::string& line) const
+    {
+        if constexpr (hasAlignmentPrefilter_v<SAMAlignmentCounterType>) return align_counter.prefilterAlignmentLine(line);
+        else return true;
+    }
+
+    /// Process a header data line or a header comment line.
+    void processHeaderLine(const std::string& line, LineCounts& counts)
+    {
+        // Process header data line.
+        if(const std::string& comment_record_type = SAMHeaderCommentLine::getStdSAMCommentHeaderRecordType(); line.substr(0,comment_record_type.length()) != comment_record_type)
+        {
+            if(SAMHeaderDataLine data_line; file_reader.template readHeaderDataLine<false>(line, data_line))
+            {
+                bool aux_count = false;
+                if(align_counter.countHeaderDataLine(data_line, aux_count))
+                {
+                    file_writer.writeLine(data_line);
+                    counts.n_write_header_data_lines++;
+                    counts.n_write_bytes += line.size()+1;
+                }
+                if(aux_count) counts.n_read_aux_header_data_lines++;
+            }
+            counts.n_read_header_data_lines++;
+        }
+        // Process header comment line.
+        else
+        {
+            if(SAMHeaderCommentLine comment_line; file_reader.template readHeaderCommentLine<false>(line, comment_line))
+            {
+                bool aux_count = false;
+                if(align_counter.countHeaderCommentLine(comment_line, aux_count))
+                {
+                    file_writer.writeLine(comment_line);
+                    counts.n_write_header_comment_lines++;
+                    counts.n_write_bytes += line.size()+1;
+                }
+                if(aux_count) counts.n_read_aux_header_comment_lines++;
+            }
+            counts.n_read_header_comment_lines++;
+        }
+    }
+
+    /// Write a selected alignment line, or pass it to the counter if the
+    /// counter defers its output.
+    void writeAlignmentLine(const std::string& line, LineCounts& counts)
+    {
+        if constexpr (isDeferredSAMAlignmentCounter_v<SAMAlignmentCounterType>) align_counter.deferAlignmentLine(line);
+        else
+        {
+            file_writer.writeLine(line);
+            counts.n_write_bytes += line.size()+1;
+        }
+    }
+
+    /// Publish the numbers of lines and bytes read so far to the progress
+    /// reporter, and the memory of the dedup table when it is asked for or
+    /// at the end of input.
+    void publishProgress(const LineCounts& counts, bool with_memory_usage=true, bool input_end=false)
+    {
+        progress_reporter->setProgress(counts.n_read_header_data_lines + counts.n_read_header_comment_lines + counts.n_read_align_lines, counts.n_read_bytes);
+        if constexpr (hasMemoryUsage_v<SAMAlignmentCounterType>)
+        {
+            if(with_memory_usage && (input_end || progress_reporter->isMemoryUsageRequested())) progress_reporter->setMemoryUsage(align_counter.getMemoryUsage());
+        }
+    }
+
+    /// Process all lines with a single thread.
+    void runSerial(LineCounts& counts, StageTimes& times)
+    {
+        // Time the stages only for a report.
+        bool timed = report != nullptr;
+        utk::LapTimer timer;
+        std::size_t n_lines = 0;
+        UTK_ALLOCATION_SCOPE("read");
+        UTK_TRACE_SCOPE("serial");
         // Read each line from the input SAM file and use SAMAlignmentCounterType
         // to decide whether to write this line to the output SAM file.
         for(std::string line; file_reader.readLine(line);)
         {
+            if(timed) timer.lap(times.read_seconds);
+            if(progress_reporter != nullptr && ++n_lines % n_progress_lines == 0) publishProgress(counts);
+            counts.n_read_bytes += line.size()+1;
             // Process alignment line.
-            if(line.front() != SAMHeaderLine::getBeginChar())
+            if(isAlignmentLine(line))
             {
-                // Create a SAMAlignmentLineType object.
-                if(SAMAlignmentLineType alignment_line; file_reader.template readAlignmentLine<false>(line, alignment_line))
+                // Create a SAMAlignmentLineType object only if the line isn't
+                // rejected by the prefilter of the counter.
+                if(prefilterAlignmentLine(line))
                 {
-                    bool aux_count = false;
-                    if(align_counter.countAlignmentLine(alignment_line, aux_count))
+                    UTK_ALLOCATION_SCOPE("parse");
+                    SAMAlignmentLineType alignment_line;
+                    bool parsed = file_reader.template readAlignmentLine<false>(line, alignment_line);
+                    if(timed) timer.lap(times.parse_seconds);
+                    if(parsed)
                     {
-                        file_writer.writeLine(alignment_line);
-                        n_write_align_lines++;
+                        bool aux_count = false;
+                        bool selected = false;
+                        {
+                            UTK_ALLOCATION_SCOPE("count");
+                            selected = align_counter.countAlignmentLine(alignment_line, aux_count);
+                        }
+                        if(timed) timer.lap(times.count_seconds);
+                        if(selected)
+                        {
+                            UTK_ALLOCATION_SCOPE("write");
+                            writeAlignmentLine(alignment_line.getLine(), counts);
+                            counts.n_write_align_lines++;
+                            if(timed) timer.lap(times.write_seconds);
+                        }
+                        if(aux_count) counts.n_read_aux_align_lines++;
                     }
-                    if(aux_count) n_read_aux_align_lines++;
                 }
-                n_read_align_lines++;
+                else if(timed) timer.lap(times.parse_seconds);
+                counts.n_read_align_lines++;
             }
+            // Process header line.
             else
             {
-                // Process header data line.
-                if(const std::string& comment_record_type = SAMHeaderCommentLine::getStdSAMCommentHeaderRecordType(); line.substr(0,comment_record_type.length()) != comment_record_type)
+                processHeaderLine(line, counts);
+                if(timed) timer.lap(times.count_seconds);
+            }
+        }
+        if(progress_reporter != nullptr) publishProgress(counts, true, true);
+    }
+
+    /// \brief Process all lines with multiple threads.
+    /// The work is split into three stages:
+    ///
+    /// 1) A reader thread cuts the input SAM file into chunks of consecutive
+    ///    lines.
+    /// 2) Multiple worker threads parse and classify the alignment lines of
+    ///    each chunk independently.
+    /// 3) The calling thread counts the classified alignment lines and writes
+    ///    the selected lines chunk by chunk in the order of input lines.
+    ///
+    /// Since the counting stage sees the lines in their original order, the
+    /// output is identical to that of serial processing.
+    ///
+    /// If n_dedup_shards is positive and the counter supports sharded
+    /// deduplication, the worker threads also route the classified keys of
+    /// each chunk to a ShardedDedupSet, and the counting stage only applies
+    /// the deduplication results, which removes the single key set from the
+    /// calling thread.
+    void runParallel(LineCounts& counts, StageTimes& times, std::size_t n_threads, std::size_t n_dedup_shards, std::size_t n_chunk_lines)
+    {
+        using AlignmentKeyType = typename SAMAlignmentCounterType::AlignmentKeyType;
+        using DedupSetType = typename DedupSetSelector<SAMAlignmentCounterType>::SetType;
+        using DedupBatchType = typename DedupSetSelector<SAMAlignmentCounterType>::BatchType;
+        using LineChunkType = LineChunk<AlignmentKeyType, DedupBatchType>;
+
+        // Sharded deduplication set fed by the worker threads.
+        std::shared_ptr<DedupSetType> dedup_set;
+        if constexpr (isShardedSAMAlignmentCounter_v<SAMAlignmentCounterType, SAMAlignmentLineType>)
+        {
+            if(n_dedup_shards > 0) dedup_set = std::make_shared<DedupSetType>(n_dedup_shards, n_threads);
+        }
+
+        // Maximum number of chunks being read, classified or waiting for output.
+        const std::size_t n_max_pending_chunks = 4*n_threads;
+
+        // Chunks to be classified by worker threads.
+        utk::ConcurrentQueue<LineChunkType> read_chunks(n_max_pending_chunks);
+
+        // Classified chunks waiting for output, ordered by sequence number.
+        std::map<std::size_t, LineChunkType> classified_chunks;
+        std::mutex chunks_mutex;
+        std::condition_variable chunks_cond;
+        std::size_t n_read_chunks {0}, n_written_chunks {0};
+        bool read_finished {false}, aborted {false};
+        std::exception_ptr read_error;
+
+        // Time the stages only for a report.
+        bool timed = report != nullptr;
+        times.parallel = true;
+
+        // Stage 1: cut the input SAM file into chunks.
+        std::thread reader_thread([&]()
+        {
+            UTK_ALLOCATION_SCOPE("read");
+            UTK_TRACE_THREAD_NAME("SAM reader");
+            double start_cpu_seconds = timed ? utk::getThreadCPUTime() : 0;
+            utk::LapTimer timer;
+            try
+            {
+                for(bool file_end = false; !file_end;)
                 {
-                    if(SAMHeaderDataLine data_line; file_reader.template readHeaderDataLine<false>(line, data_line))
+                    // Wait until the number of pending chunks drops below the limit.
                     {
-                        bool aux_count = false;
-                        if(align_counter.countHeaderDataLine(data_line, aux_count))
+                        std::unique_lock<std::mutex> lock(chunks_mutex);
+                        chunks_cond.wait(lock, [&]{ return aborted || n_read_chunks-n_written_chunks < n_max_pending_chunks; });
+                        if(aborted) break;
+                    }
+                    if(timed) timer.restart();
+                    LineChunkType chunk;
+                    {
+                        UTK_TRACE_SCOPE("read");
+                        chunk.lines.reserve(n_chunk_lines);
+                        for(std::string line; chunk.lines.size() < n_chunk_lines;)
                         {
-                            file_writer.writeLine(data_line);
-                            n_write_header_data_lines++;
+                            if(file_reader.readLine(line)) chunk.lines.push_back(std::move(line));
+                            else
+                            {
+                                file_end = true;
+                                break;
+                            }
                         }
-                        if(aux_count) n_read_aux_header_data_lines++;
                     }
-                    n_read_header_data_lines++;
+                    if(timed) timer.lap(times.read_seconds);
+                    if(chunk.lines.empty()) break;
+                    {
+                        std::lock_guard<std::mutex> lock(chunks_mutex);
+                        chunk.seq_number = n_read_chunks++;
+                    }
+                    read_chunks.push(std::move(chunk));
                 }
-                // Process header comment line.
-                else
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock(chunks_mutex);
+                read_error = std::current_exception();
+            }
+            {
+                std::lock_guard<std::mutex> lock(chunks_mutex);
+                read_finished = true;
+                if(timed) times.read_cpu_seconds = utk::getThreadCPUTime()-start_cpu_seconds;
+            }
+            read_chunks.close();
+            chunks_cond.notify_all();
+        });
+
+        // Stage 2: parse and classify alignment lines.
+        std::vector<std::thread> worker_threads;
+        for(std::size_t n = 0; n < n_threads; ++n)
+        {
+            worker_threads.emplace_back([&, n]()
+            {
+                UTK_ALLOCATION_SCOPE("parse");
+                UTK_TRACE_THREAD_NAME("SAM parser " + std::to_string(n));
+                double start_cpu_seconds = timed ? utk::getThreadCPUTime() : 0;
+                double parse_seconds = 0;
+                utk::LapTimer timer;
+                for(LineChunkType chunk; read_chunks.pop(chunk);)
                 {
-                    if(SAMHeaderCommentLine comment_line; file_reader.template readHeaderCommentLine<false>(line, comment_line))
+                    UTK_TRACE_SCOPE("parse");
+                    if(timed) timer.restart();
+                    std::size_t n_lines = chunk.lines.size();
+                    chunk.eligibles.assign(n_lines, 0);
+                    chunk.keys.resize(n_lines);
+                    for(std::size_t i = 0; i < n_lines; ++i)
                     {
-                        bool aux_count = false;
-                        if(align_counter.countHeaderCommentLine(comment_line, aux_count))
+                        if(const std::string& line = chunk.lines[i]; isAlignmentLine(line))
                         {
-                            file_writer.writeLine(comment_line);
-                            n_write_header_comment_lines++;
+                            try
+                            {
+                                if(!prefilterAlignmentLine(line)) continue;
+                                if(SAMAlignmentLineType alignment_line; file_reader.template readAlignmentLine<false>(line, alignment_line))
+                                {
+                                    chunk.eligibles[i] = align_counter.classifyAlignmentLine(alignment_line, chunk.keys[i]);
+                                }
+                            }
+                            catch(...)
+                            {
+                                // Leave the error to the counting stage, which
+                                // stops at the failed line just like serial
+                                // processing does.
+                                chunk.n_error_line = i;
+                                chunk.error = std::current_exception();
+                                break;
+                            }
                         }
-                        if(aux_count) n_read_aux_header_comment_lines++;
                     }
-                    n_read_header_comment_lines++;
+                    // Route the keys before the failed line to the shards.
+                    if constexpr (isShardedSAMAlignmentCounter_v<SAMAlignmentCounterType, SAMAlignmentLineType>)
+                    {
+                        if(dedup_set)
+                        {
+                            std::vector<std::vector<typename DedupSetType::Item>> shard_items(dedup_set->getNumberOfShards());
+                            std::size_t n_key_lines = chunk.error ? chunk.n_error_line : n_lines;
+                            for(std::size_t i = 0; i < n_key_lines; ++i)
+                            {
+                                if(chunk.eligibles[i]) shard_items[dedup_set->getShardIndex(chunk.keys[i])].push_back({i, &chunk.keys[i]});
+                            }
+                            chunk.dedup_batch = dedup_set->makeBatch(chunk.seq_number, n_lines);
+                            dedup_set->submit(n, chunk.dedup_batch, shard_items);
+                        }
+                    }
+                    if(timed) timer.lap(parse_seconds);
+                    {
+                        std::lock_guard<std::mutex> lock(chunks_mutex);
+                        std::size_t seq_number = chunk.seq_number;
+                        classified_chunks.emplace(seq_number, std::move(chunk));
+                    }
+                    chunks_cond.notify_all();
                 }
+                if(timed)
+                {
+                    std::lock_guard<std::mutex> lock(chunks_mutex);
+                    times.parse_seconds += parse_seconds;
+                    times.parse_cpu_seconds += utk::getThreadCPUTime()-start_cpu_seconds;
+                }
+            });
+        }
+
+        // Stage 3: count classified alignment lines and write selected lines.
+        utk::LapTimer timer;
+        UTK_ALLOCATION_SCOPE("count");
+        UTK_TRACE_THREAD_NAME("SAM counter");
+        // The selected alignment lines of a chunk are written together after
+        // counting the chunk, or before a header line to keep the order.
+        std::vector<std::size_t> selected_lines;
+        auto writeSelectedLines = [&](const LineChunkType& chunk)
+        {
+            if(selected_lines.empty()) return;
+            UTK_ALLOCATION_SCOPE("write");
+            UTK_TRACE_SCOPE("write");
+            for(std::size_t i : selected_lines) writeAlignmentLine(chunk.lines[i], counts);
+            counts.n_write_align_lines += selected_lines.size();
+            selected_lines.clear();
+            if(timed) timer.lap(times.write_seconds);
+        };
+        try
+        {
+            for(std::size_t seq_number = 0;; ++seq_number)
+            {
+                LineChunkType chunk;
+                {
+                    std::unique_lock<std::mutex> lock(chunks_mutex);
+                    chunks_cond.wait(lock, [&]{ return classified_chunks.count(seq_number) > 0 || (read_finished && seq_number >= n_read_chunks); });
+                    auto search = classified_chunks.find(seq_number);
+                    if(search == classified_chunks.end())
+                    {
+                        if(read_error) std::rethrow_exception(read_error);
+                        break;
+                    }
+                    chunk = std::move(search->second);
+                    classified_chunks.erase(search);
+                }
+                if constexpr (isShardedSAMAlignmentCounter_v<SAMAlignmentCounterType, SAMAlignmentLineType>)
+                {
+                    if(chunk.dedup_batch) dedup_set->wait(*chunk.dedup_batch);
+                }
+                if(timed) timer.restart();
+                {
+                    UTK_TRACE_SCOPE("dedup");
+                    for(std::size_t i = 0; i < chunk.lines.size(); ++i)
+                    {
+                        if(chunk.error && i == chunk.n_error_line)
+                        {
+                            writeSelectedLines(chunk);
+                            std::rethrow_exception(chunk.error);
+                        }
+                        const std::string& line = chunk.lines[i];
+                        counts.n_read_bytes += line.size()+1;
+                        if(isAlignmentLine(line))
+                        {
+                            if(chunk.eligibles[i])
+                            {
+                                bool aux_count = false;
+                                if(countAlignmentKey(chunk, i, aux_count)) selected_lines.push_back(i);
+                                if(timed) timer.lap(times.count_seconds);
+                                if(aux_count) counts.n_read_aux_align_lines++;
+                            }
+                            counts.n_read_align_lines++;
+                        }
+                        else
+                        {
+                            writeSelectedLines(chunk);
+                            processHeaderLine(line, counts);
+                            if(timed) timer.lap(times.count_seconds);
+                        }
+                    }
+                }
+                writeSelectedLines(chunk);
+                // The dedup table of the counter is not used by the shards.
+                if(progress_reporter != nullptr) publishProgress(counts, !dedup_set);
+                {
+                    std::lock_guard<std::mutex> lock(chunks_mutex);
+                    n_written_chunks++;
+                }
+                chunks_cond.notify_all();
             }
         }
+        catch(...)
+        {
+            // Stop all threads before passing the error to the caller.
+            {
+                std::lock_guard<std::mutex> lock(chunks_mutex);
+                aborted = true;
+            }
+            chunks_cond.notify_all();
+            read_chunks.close();
+            if constexpr (isShardedSAMAlignmentCounter_v<SAMAlignmentCounterType, SAMAlignmentLineType>)
+            {
+                if(dedup_set) dedup_set->stop();
+            }
+            reader_thread.join();
+            for(auto& worker_thread : worker_threads) worker_thread.join();
+            throw;
+        }
+
+        reader_thread.join();
+        for(auto& worker_thread : worker_threads) worker_thread.join();
+        if constexpr (isShardedSAMAlignmentCounter_v<SAMAlignmentCounterType, SAMAlignmentLineType>)
+        {
+            if(dedup_set)
+            {
+                dedup_set->stop();
+                // The keys are deduplicated by the shards instead of the counter.
+                if(report != nullptr)
+                {
+                    dedup_set->getKeySetStats(report->dedup_table);
+                    report->has_dedup_table = true;
+                }
+            }
+        }
+        if(progress_reporter != nullptr) publishProgress(counts, !dedup_set, true);
+    }
+
+    /// Fill the report with the statistics of a finished run.
+    void fillReport(const LineCounts& counts, const StageTimes& times, std::size_t n_threads, std::size_t n_dedup_shards, double wall_seconds, double main_cpu_seconds, double deferred_seconds, double deferred_cpu_seconds)
+    {
+        SAMAlignmentPipeReport& rep = *report;
+        rep.n_threads = n_threads;
+        rep.n_dedup_shards = n_dedup_shards;
+        rep.wall_seconds = wall_seconds;
+
+        // Split the CPU time of the calling thread among the stages it runs
+        // in proportion to their busy wall time.
+        double main_seconds = times.count_seconds + times.write_seconds;
+        if(!times.parallel) main_seconds += times.read_seconds + times.parse_seconds;
+        auto splitCPUTime = [&](double seconds) { return main_seconds > 0 ? main_cpu_seconds*seconds/main_seconds : 0; };
+
+        rep.read_stage = SAMAlignmentPipeStage();
+        rep.read_stage.n_threads = 1;
+        rep.read_stage.n_lines = counts.n_read_header_data_lines + counts.n_read_header_comment_lines + counts.n_read_align_lines;
+        rep.read_stage.n_bytes = counts.n_read_bytes;
+        rep.read_stage.wall_seconds = times.read_seconds;
+        rep.read_stage.cpu_seconds = times.parallel ? times.read_cpu_seconds : splitCPUTime(times.read_seconds);
+
+        rep.parse_stage = SAMAlignmentPipeStage();
+        rep.parse_stage.n_threads = times.parallel ? n_threads : 1;
+        rep.parse_stage.n_lines = counts.n_read_align_lines;
+        rep.parse_stage.wall_seconds = times.parse_seconds;
+        rep.parse_stage.cpu_seconds = times.parallel ? times.parse_cpu_seconds : splitCPUTime(times.parse_seconds);
+
+        rep.count_stage = SAMAlignmentPipeStage();
+        rep.count_stage.n_threads = 1;
+        rep.count_stage.n_lines = rep.read_stage.n_lines;
+        rep.count_stage.wall_seconds = times.count_seconds;
+        rep.count_stage.cpu_seconds = splitCPUTime(times.count_seconds);
+
+        rep.write_stage = SAMAlignmentPipeStage();
+        rep.write_stage.n_threads = 1;
+        rep.write_stage.n_lines = counts.n_write_header_data_lines + counts.n_write_header_comment_lines + counts.n_write_align_lines;
+        rep.write_stage.n_bytes = counts.n_write_bytes;
+        rep.write_stage.wall_seconds = times.write_seconds + deferred_seconds;
+        rep.write_stage.cpu_seconds = splitCPUTime(times.write_seconds) + deferred_cpu_seconds;
+
+        rep.cpu_seconds = main_cpu_seconds + deferred_cpu_seconds + times.read_cpu_seconds + times.parse_cpu_seconds;
+        rep.n_read_lines = rep.read_stage.n_lines;
+        rep.n_write_lines = rep.write_stage.n_lines;
+        rep.n_read_align_lines = counts.n_read_align_lines;
+        rep.n_read_aux_align_lines = counts.n_read_aux_align_lines;
+        rep.n_write_align_lines = counts.n_write_align_lines;
+
+        // Take the dedup table from the counter unless it is sharded.
+        if constexpr (hasDedupTableStats_v<SAMAlignmentCounterType>)
+        {
+            if(!rep.has_dedup_table)
+            {
+                align_counter.getDedupTableStats(rep.dedup_table);
+                rep.has_dedup_table = true;
+            }
+        }
+        rep.peak_rss = utk::getPeakResidentSetSize();
+    }
+
+    /// Make the output decision for a classified alignment line of a chunk,
+    /// using the deduplication result of the chunk if there is one.
+    template<typename LineChunkType>
+    bool countAlignmentKey(const LineChunkType& chunk, std::size_t i, bool& aux_count)
+    {
+        if constexpr (isShardedSAMAlignmentCounter_v<SAMAlignmentCounterType, SAMAlignmentLineType>)
+        {
+            if(chunk.dedup_batch) return align_counter.countUniqueAlignmentKey(chunk.keys[i], chunk.dedup_batch->isUnique(i), aux_count);
+        }
+        return align_counter.countAlignmentKey(chunk.keys[i], aux_count);
+    }
+
+public:
+
+    SAMAlignmentPipe(SAMFileReaderType& reader, SAMFileWriterType& writer, SAMAlignmentCounterType& counter, const std::string& read_aux_align_line_name = "auxiliary", const std::string& read_aux_header_data_line_name = "auxiliary", const std::string& read_aux_header_comment_line_name = "auxiliary") : file_reader{reader}, file_writer{writer}, align_counter{counter}, read_aux_align_line_name{read_aux_align_line_name}, read_aux_header_data_line_name{read_aux_header_data_line_name}, read_aux_header_comment_line_name{read_aux_header_comment_line_name} {}
+
+    /// Set the output stream for the statistics of input and output lines,
+    /// which is std::cout by default.
+    void setInfoStream(std::ostream& stream)
+    {
+        info_stream = &stream;
+    }
+
+    /// Set the performance report to fill in by the next run, which times
+    /// each stage of the run at a small cost per line.
+    void setReport(SAMAlignmentPipeReport& pipe_report)
+    {
+        report = &pipe_report;
+    }
+
+    /// Set the progress reporter to publish the lines and bytes read to,
+    /// once per chunk of lines.
+    void setProgressReporter(utk::ProgressReporter& reporter)
+    {
+        progress_reporter = &reporter;
+    }
+
+    /// \brief Parse all lines of a SAM file to remove duplicate alignments.
+    ///
+    /// Parse all lines of a SAM file to filter out non-uniquely aligned and
+    /// non-uniquely tagged sequence alignments. The output SAM file contains:
+    ///
+    /// 1) All header data lines.
+    /// 2) All header comment lines.
+    /// 3) Alignments lines for all uniquely aligned sequences tagged with
+    ///    distinct UMI barcodes for each gene.
+    ///
+    /// \param  n_threads      Number of worker threads for parsing alignment
+    ///                        lines. More than one thread is used only if
+    ///                        SAMAlignmentCounterType supports two-phase
+    ///                        counting (see isTwoPhaseSAMAlignmentCounter).
+    /// \param  n_dedup_shards Number of shards for deduplicating alignment
+    ///                        keys in parallel with n_threads, or 0 to
+    ///                        deduplicate them in the calling thread. It is
+    ///                        only used if SAMAlignmentCounterType supports
+    ///                        sharded deduplication (see
+    ///                        isShardedSAMAlignmentCounter).
+    /// \param  n_chunk_lines  Number of lines in a chunk for a worker thread.
+    std::size_t run(std::size_t n_threads=1, std::size_t n_dedup_shards=0, std::size_t n_chunk_lines=default_n_chunk_lines)
+    {
+        LineCounts counts;
+        StageTimes times;
+        utk::LapTimer run_timer;
+        double start_cpu_seconds = report != nullptr ? utk::getThreadCPUTime() : 0;
+        if(report != nullptr) report->has_dedup_table = false;
+        utk::AllocationTracker::SnapshotType allocation_snapshot;
+        if constexpr (utk::AllocationTracker::enabled) allocation_snapshot = utk::AllocationTracker::getSnapshot();
+
+        // Process input lines with single or multiple threads.
+        if constexpr (isTwoPhaseSAMAlignmentCounter_v<SAMAlignmentCounterType, SAMAlignmentLineType>)
+        {
+            if(n_threads > 1) runParallel(counts, times, n_threads, n_dedup_shards, n_chunk_lines > 0 ? n_chunk_lines : default_n_chunk_lines);
+            else runSerial(counts, times);
+        }
+        else runSerial(counts, times);
+        double main_cpu_seconds = report != nullptr ? utk::getThreadCPUTime()-start_cpu_seconds : 0;
+
+        // Write the alignment lines finally selected by the counter.
+        double deferred_seconds = 0, deferred_cpu_seconds = 0;
+        if constexpr (isDeferredSAMAlignmentCounter_v<SAMAlignmentCounterType>)
+        {
+            utk::LapTimer deferred_timer;
+            std::streamoff start_pos = report != nullptr ? static_cast<std::streamoff>(file_writer.tellp()) : -1;
+            UTK_ALLOCATION_SCOPE("write");
+            UTK_TRACE_SCOPE("write");
+            counts.n_write_align_lines = align_counter.writeDeferredAlignmentLines(file_writer);
+            if(report != nullptr)
+            {
+                deferred_timer.lap(deferred_seconds);
+                deferred_cpu_seconds = utk::getThreadCPUTime()-start_cpu_seconds-main_cpu_seconds;
+                // The deferred lines are only known by their total size in
+                // the output SAM file.
+                if(std::streamoff end_pos = file_writer.tellp(); start_pos >= 0 && end_pos >= start_pos) counts.n_write_bytes += static_cast<std::size_t>(end_pos-start_pos);
+            }
+        }
+        if(report != nullptr)
+        {
+            double wall_seconds = 0;
+            run_timer.lap(wall_seconds);
+            fillReport(counts, times, n_threads, n_dedup_shards, wall_seconds, main_cpu_seconds, deferred_seconds, deferred_cpu_seconds);
+        }
 
         // Calculate the statistics of input and output lines.
-        std::size_t n_read_lines = n_read_header_data_lines + n_read_header_comment_lines + n_read_align_lines;
-        std::size_t n_write_lines = n_write_header_data_lines + n_write_header_comment_lines + n_write_align_lines;
-        std::cout << "Read " << n_read_header_data_lines << " header data lines" << '\n';
-        std::cout << "Read " << n_read_aux_header_data_lines << ' ' << read_aux_header_data_line_name << " header data lines" << '\n';
-        std::cout << "Write " << n_write_header_data_lines << " selected header data lines" << '\n';
-        std::cout << "Read " << n_read_header_comment_lines << " header comment lines" << '\n';
-        std::cout << "Read " << n_read_aux_header_comment_lines << ' ' << read_aux_header_comment_line_name << " header comment lines" << '\n';
-        std::cout << "Write " << n_write_header_comment_lines << " selected header comment lines" << '\n';
-        std::cout << "Read " << n_read_align_lines << " sequence alignment lines" << '\n';
-
-        std::cout << "Read " << n_read_aux_align_lines << ' ' << read_aux_align_line_name << " sequence alignment lines" << '\n';
-        std::cout << "Write " << n_write_align_lines << " selected sequence alignment lines" << '\n';
-        std::cout << "Read " << n_read_lines << " lines in total" << '\n';
-        std::cout << "Write " << n_write_lines << " selected lines in total" << '\n';
+        std::ostream& info = *info_stream;
+        std::size_t n_read_lines = counts.n_read_header_data_lines + counts.n_read_header_comment_lines + counts.n_read_align_lines;
+        std::size_t n_write_lines = counts.n_write_header_data_lines + counts.n_write_header_comment_lines + counts.n_write_align_lines;
+        info << "Read " << counts.n_read_header_data_lines << " header data lines" << '\n';
+        info << "Read " << counts.n_read_aux_header_data_lines << ' ' << read_aux_header_data_line_name << " header data lines" << '\n';
+        info << "Write " << counts.n_write_header_data_lines << " selected header data lines" << '\n';
+        info << "Read " << counts.n_read_header_comment_lines << " header comment lines" << '\n';
+        info << "Read " << counts.n_read_aux_header_comment_lines << ' ' << read_aux_header_comment_line_name << " header comment lines" << '\n';
+        info << "Write " << counts.n_write_header_comment_lines << " selected header comment lines" << '\n';
+        info << "Read " << counts.n_read_align_lines << " sequence alignment lines" << '\n';
+
+        info << "Read " << counts.n_read_aux_align_lines << ' ' << read_aux_align_line_name << " sequence alignment lines" << '\n';
+        info << "Write " << counts.n_write_align_lines << " selected sequence alignment lines" << '\n';
+        info << "Read " << n_read_lines << " lines in total" << '\n';
+        info << "Write " << n_write_lines << " selected lines in total" << '\n';
+        // Report the heap allocations per line of each stage if tracked.
+        if constexpr (utk::AllocationTracker::enabled) utk::AllocationTracker::report(info, allocation_snapshot, n_read_lines, "line");
 
         // Return the number of uniquely aligned and agged sequence alignments.
         return n_read_lines;
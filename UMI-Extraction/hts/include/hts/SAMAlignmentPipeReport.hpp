@@ -0,0 +1,111 @@
+//
+//  SAMAlignmentPipeReport.hpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#ifndef SAMAlignmentPipeReport_hpp
+#define SAMAlignmentPipeReport_hpp
+
+#include <string>
+#include <ostream>
+#include <cstddef>
+#include <utk/HashTableStats.hpp>
+
+namespace hts
+{
+
+/// \brief Performance statistics of one stage of SAMAlignmentPipe.
+struct SAMAlignmentPipeStage
+{
+    /// Number of threads running the stage.
+    std::size_t n_threads {0};
+
+    /// Number of lines processed by the stage.
+    std::size_t n_lines {0};
+
+    /// Number of bytes of the lines, each with one line delimiter.
+    std::size_t n_bytes {0};
+
+    /// Busy wall time in seconds, summed over the threads of the stage.
+    double wall_seconds {0};
+
+    /// CPU time in seconds of the threads of the stage.
+    double cpu_seconds {0};
+
+    /// Number of lines processed in each second of busy wall time.
+    double getLinesPerSecond() const
+    {
+        return wall_seconds > 0 ? static_cast<double>(n_lines)/wall_seconds : 0;
+    }
+};
+
+/// \brief Performance and statistics report of a run of SAMAlignmentPipe.
+/// The report breaks a run down into four stages:
+///
+/// 1) read: reading lines from the input SAM file.
+/// 2) parse: parsing and classifying alignment lines.
+/// 3) count: counting classified alignment lines and processing header lines.
+/// 4) write: writing selected lines to the output SAM file.
+///
+/// The CPU time of a thread shared by several stages is split among them in
+/// proportion to their busy wall time. The dedup table is the key set of the
+/// counter or of the dedup shards, if the counter reports one. The report is
+/// written as a JSON document for tracking runs across nodes and releases.
+class SAMAlignmentPipeReport
+{
+public:
+
+    /// Version of the JSON document layout.
+    static constexpr unsigned format_version {1};
+
+    /// The input and output SAM files.
+    std::string input_file_path;
+    std::string output_file_path;
+
+    /// Number of worker threads and dedup shards requested.
+    std::size_t n_threads {1};
+    std::size_t n_dedup_shards {0};
+
+    /// Wall time in seconds of the whole run.
+    double wall_seconds {0};
+
+    /// CPU time in seconds of all the threads of the run, not including the
+    /// dedup shard threads.
+    double cpu_seconds {0};
+
+    /// The four stages of the run.
+    SAMAlignmentPipeStage read_stage;
+    SAMAlignmentPipeStage parse_stage;
+    SAMAlignmentPipeStage count_stage;
+    SAMAlignmentPipeStage write_stage;
+
+    /// Statistics of input and output lines.
+    std::size_t n_read_lines {0};
+    std::size_t n_write_lines {0};
+    std::size_t n_read_align_lines {0};
+    std::size_t n_read_aux_align_lines {0};
+    std::size_t n_write_align_lines {0};
+
+    /// Indicator of the dedup table reported by the counter.
+    bool has_dedup_table {false};
+
+    /// Statistics of the dedup table.
+    utk::HashTableStats dedup_table;
+
+    /// Peak resident set size in bytes of the process at the end of the run.
+    std::size_t peak_rss {0};
+
+public:
+
+    /// Write the report as a JSON document to an output stream.
+    void writeJSON(std::ostream& os) const;
+
+    /// Write the report as a JSON document to a file.
+    void writeJSON(const std::string& file_path) const;
+};
+
+}
+
+#endif /* SAMAlignmentPipeReport_hpp */
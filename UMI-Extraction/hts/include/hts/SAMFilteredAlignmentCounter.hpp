@@ -0,0 +1,239 @@
+//
+//  SAMFilteredAlignmentCounter.hpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#ifndef SAMFilteredAlignmentCounter_hpp
+#define SAMFilteredAlignmentCounter_hpp
+
+#include <tuple>
+#include <string>
+#include <string_view>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+#include <utk/HashTableStats.hpp>
+#include "SAMAlignmentCounter.hpp"
+
+namespace hts
+{
+
+/// \brief Check if a type is a filter of alignment lines.
+/// Such a filter provides:
+///
+/// 1) bool filterAlignmentLine(const SAMAlignmentLineType&) const
+///    which decides whether an alignment line is passed on to the counter,
+///    without changing the filter, so that it can be called by multiple
+///    threads at the same time.
+template<typename SAMAlignmentFilterType, typename SAMAlignmentLineType, typename = void>
+struct isSAMAlignmentFilter : std::false_type {};
+
+template<typename SAMAlignmentFilterType, typename SAMAlignmentLineType>
+struct isSAMAlignmentFilter<SAMAlignmentFilterType, SAMAlignmentLineType, std::void_t<decltype(std::declval<const SAMAlignmentFilterType&>().filterAlignmentLine(std::declval<const SAMAlignmentLineType&>()))>> : std::true_type {};
+
+template<typename SAMAlignmentFilterType, typename SAMAlignmentLineType>
+inline constexpr bool isSAMAlignmentFilter_v = isSAMAlignmentFilter<SAMAlignmentFilterType, SAMAlignmentLineType>::value;
+
+/// \brief Check if a type is a filter of the raw text of alignment lines.
+/// Such a filter provides:
+///
+/// 1) bool filterRawAlignmentLine(std::string_view line) const
+///    which decides whether an alignment line is passed on to the counter
+///    from its raw text, so that a rejected line is never parsed. It can be
+///    called by multiple threads at the same time.
+template<typename SAMAlignmentFilterType, typename = void>
+struct isSAMRawAlignmentFilter : std::false_type {};
+
+template<typename SAMAlignmentFilterType>
+struct isSAMRawAlignmentFilter<SAMAlignmentFilterType, std::void_t<decltype(std::declval<const SAMAlignmentFilterType&>().filterRawAlignmentLine(std::declval<std::string_view>()))>> : std::true_type {};
+
+template<typename SAMAlignmentFilterType>
+inline constexpr bool isSAMRawAlignmentFilter_v = isSAMRawAlignmentFilter<SAMAlignmentFilterType>::value;
+
+/// The key type of a two-phase counter, which is absent for other counters.
+template<typename SAMAlignmentCounterType, typename = void>
+struct SAMAlignmentCounterKeyTypes {};
+
+template<typename SAMAlignmentCounterType>
+struct SAMAlignmentCounterKeyTypes<SAMAlignmentCounterType, std::void_t<typename SAMAlignmentCounterType::AlignmentKeyType>>
+{
+    using AlignmentKeyType = typename SAMAlignmentCounterType::AlignmentKeyType;
+};
+
+/// The key hash types of a sharded counter, which are absent for other
+/// counters.
+template<typename SAMAlignmentCounterType, typename = void>
+struct SAMAlignmentCounterKeyHashTypes {};
+
+template<typename SAMAlignmentCounterType>
+struct SAMAlignmentCounterKeyHashTypes<SAMAlignmentCounterType, std::void_t<typename SAMAlignmentCounterType::AlignmentKeyHash, typename SAMAlignmentCounterType::AlignmentKeyShardHash>>
+{
+    using AlignmentKeyHash = typename SAMAlignmentCounterType::AlignmentKeyHash;
+    using AlignmentKeyShardHash = typename SAMAlignmentCounterType::AlignmentKeyShardHash;
+};
+
+/// \brief Count aligned FASTQ sequences that pass a chain of filters.
+/// This class fuses a fixed list of filters with a counter at compile time,
+/// e.g. a SAMRecordFilter of MAPQ and FLAG in front of a gene-UMI counter,
+/// so that SAMAlignmentPipe filters and counts each alignment line
+/// in a single pass with all the calls bound statically. An alignment line
+/// rejected by a filter is neither counted nor passed to the later filters.
+///
+/// A filter of raw text, e.g. a SAMRecordFilter, is applied by the prefilter
+/// of the filtered counter, which SAMAlignmentPipe calls before an alignment
+/// line is parsed, while the other filters are applied to parsed alignment
+/// lines.
+///
+/// The filtered counter provides the same optional interfaces as the counter
+/// it wraps: the filters are applied when a two-phase counter classifies an
+/// alignment line, so that they run in the worker threads of the pipe, while
+/// the keys, the sharded and deferred counting, and the statistics of the
+/// dedup table are forwarded to the counter.
+///
+/// Template Arguments:
+///
+/// \tparam  SAMAlignmentCounterType   A counter class for SAM alignment lines.
+/// \tparam  SAMAlignmentFilterTypes   Filter classes of alignment lines, which
+///                                    are applied in the given order.
+///
+/// Note: the counter is held by reference, so that its results can be read
+/// after the run.
+template<typename SAMAlignmentCounterType, typename... SAMAlignmentFilterTypes>
+class SAMFilteredAlignmentCounter : public SAMAlignmentCounterKeyTypes<SAMAlignmentCounterType>, public SAMAlignmentCounterKeyHashTypes<SAMAlignmentCounterType>
+{
+private:
+
+    /// A holder of SAM alignment counter.
+    SAMAlignmentCounterType& align_counter;
+
+    /// Filters of alignment lines.
+    std::tuple<SAMAlignmentFilterTypes...> align_filters;
+
+private:
+
+    /// Check if a parsed alignment line passes all the filters of parsed
+    /// alignment lines in order.
+    template<typename SAMAlignmentLineType>
+    bool filterAlignmentLine(const SAMAlignmentLineType& alignment_line) const
+    {
+        static_assert(((isSAMRawAlignmentFilter_v<SAMAlignmentFilterTypes> || isSAMAlignmentFilter_v<SAMAlignmentFilterTypes, SAMAlignmentLineType>) && ...), "SAMAlignmentFilterTypes must provide filterRawAlignmentLine or filterAlignmentLine");
+        auto passFilter = [&alignment_line](const auto& align_filter)
+        {
+            if constexpr (isSAMRawAlignmentFilter_v<std::decay_t<decltype(align_filter)>>) return true;
+            else return align_filter.filterAlignmentLine(alignment_line);
+        };
+        return std::apply([&passFilter](const auto&... align_filter) { return (passFilter(align_filter) && ...); }, align_filters);
+    }
+
+public:
+
+    explicit SAMFilteredAlignmentCounter(SAMAlignmentCounterType& counter, SAMAlignmentFilterTypes... filters) : align_counter{counter}, align_filters{std::move(filters)...} {}
+
+    /// Check if the raw text of an alignment line passes the prefilter of the
+    /// counter and all the filters of raw text in order.
+    /// Note: this function can be called by multiple threads at the same time.
+    bool prefilterAlignmentLine(const std::string& line) const
+    {
+        if constexpr (hasAlignmentPrefilter_v<SAMAlignmentCounterType>)
+        {
+            if(!align_counter.prefilterAlignmentLine(line)) return false;
+        }
+        auto passFilter = [&line](const auto& align_filter)
+        {
+            if constexpr (isSAMRawAlignmentFilter_v<std::decay_t<decltype(align_filter)>>) return align_filter.filterRawAlignmentLine(line);
+            else return true;
+        };
+        return std::apply([&passFilter](const auto&... align_filter) { return (passFilter(align_filter) && ...); }, align_filters);
+    }
+
+    /// Check a SAM header data line with the counter.
+    template<typename SAMHeaderDataLineType>
+    bool countHeaderDataLine(const SAMHeaderDataLineType& header_data_line, bool& aux_count)
+    {
+        return align_counter.countHeaderDataLine(header_data_line, aux_count);
+    }
+
+    /// Check a SAM header comment line with the counter.
+    template<typename SAMHeaderCommentLineType>
+    bool countHeaderCommentLine(const SAMHeaderCommentLineType& header_comment_line, bool& aux_count)
+    {
+        return align_counter.countHeaderCommentLine(header_comment_line, aux_count);
+    }
+
+    /// Check a SAM alignment line with the filters and then the counter.
+    template<typename SAMAlignmentLineType>
+    bool countAlignmentLine(const SAMAlignmentLineType& alignment_line, bool& aux_count)
+    {
+        return filterAlignmentLine(alignment_line) && align_counter.countAlignmentLine(alignment_line, aux_count);
+    }
+
+    /// Classify an alignment line that passes all the filters.
+    /// Note: this function can be called by multiple threads at the same time.
+    template<typename SAMAlignmentLineType, typename CounterType = SAMAlignmentCounterType>
+    auto classifyAlignmentLine(const SAMAlignmentLineType& alignment_line, typename CounterType::AlignmentKeyType& align_key) const -> decltype(std::declval<const CounterType&>().classifyAlignmentLine(alignment_line, align_key))
+    {
+        return filterAlignmentLine(alignment_line) && align_counter.classifyAlignmentLine(alignment_line, align_key);
+    }
+
+    /// Make the output decision for a classified alignment line.
+    template<typename CounterType = SAMAlignmentCounterType>
+    auto countAlignmentKey(const typename CounterType::AlignmentKeyType& align_key, bool& aux_count) -> decltype(std::declval<CounterType&>().countAlignmentKey(align_key, aux_count))
+    {
+        return align_counter.countAlignmentKey(align_key, aux_count);
+    }
+
+    /// Make the output decision for a classified alignment line deduplicated
+    /// by a sharded deduplication set.
+    template<typename CounterType = SAMAlignmentCounterType>
+    auto countUniqueAlignmentKey(const typename CounterType::AlignmentKeyType& align_key, bool unique, bool& aux_count) -> decltype(std::declval<CounterType&>().countUniqueAlignmentKey(align_key, unique, aux_count))
+    {
+        return align_counter.countUniqueAlignmentKey(align_key, unique, aux_count);
+    }
+
+    /// Keep an alignment line selected by a deferring counter.
+    template<typename CounterType = SAMAlignmentCounterType>
+    auto deferAlignmentLine(const std::string& line) -> decltype(std::declval<CounterType&>().deferAlignmentLine(line))
+    {
+        return align_counter.deferAlignmentLine(line);
+    }
+
+    /// Write the alignment lines finally selected by a deferring counter.
+    template<typename SAMFileWriterType, typename CounterType = SAMAlignmentCounterType>
+    auto writeDeferredAlignmentLines(SAMFileWriterType& file_writer) -> decltype(std::declval<CounterType&>().writeDeferredAlignmentLines(file_writer))
+    {
+        return align_counter.writeDeferredAlignmentLines(file_writer);
+    }
+
+    /// Add the statistics of the dedup table of the counter.
+    template<typename CounterType = SAMAlignmentCounterType>
+    auto getDedupTableStats(utk::HashTableStats& stats) const -> decltype(std::declval<const CounterType&>().getDedupTableStats(stats))
+    {
+        return align_counter.getDedupTableStats(stats);
+    }
+
+    /// Memory of the dedup table of the counter in bytes.
+    template<typename CounterType = SAMAlignmentCounterType>
+    auto getMemoryUsage() const -> decltype(std::declval<const CounterType&>().getMemoryUsage())
+    {
+        return align_counter.getMemoryUsage();
+    }
+
+    /// Retrieve the counter.
+    SAMAlignmentCounterType& getCounter()
+    {
+        return align_counter;
+    }
+
+    /// Retrieve the i-th filter.
+    template<std::size_t i>
+    const auto& getFilter() const
+    {
+        return std::get<i>(align_filters);
+    }
+};
+
+}
+
+#endif /* SAMFilteredAlignmentCounter_hpp */
@@ -0,0 +1,154 @@
+//
+//  SAMGeneUMIAdaptiveAlignmentCounter.hpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#ifndef SAMGeneUMIAdaptiveAlignmentCounter_hpp
+#define SAMGeneUMIAdaptiveAlignmentCounter_hpp
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <string>
+#include "SAMAlignmentCounter.hpp"
+#include "SAMHeaderDataLine.hpp"
+#include "SAMHeaderCommentLine.hpp"
+#include "SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine.hpp"
+#include "GeneUMIKey.hpp"
+#include "GeneCountTable.hpp"
+#include "DGEIlluminaFASTQSequence.hpp"
+#include "AdaptiveUMIContainer.hpp"
+#include "SAMGeneUMIAlignmentCounter.hpp"
+
+namespace hts
+{
+
+/// \brief Count aligned FASTQ sequences using per-gene adaptive UMI containers.
+/// This class selects the same alignments as SAMGeneUMIAlignmentCounter, i.e.
+/// the first alignment of each distinct gene-UMI combination among uniquely
+/// aligned sequences, but keeps the UMI barcodes seen for each gene in its
+/// own AdaptiveUMIContainer instead of a single pool of concatenated
+/// gene-UMI strings:
+///
+/// 1) Each gene name is mapped to a dense gene index on its first occurrence.
+/// 2) Each UMI barcode is packed into a 2-bit code and inserted into the
+///    container of its gene, whose chunks of up to 2^16 codes each switch
+///    from a sorted array to a bitmap when they become densely tagged.
+///
+/// The memory used by each gene is therefore bounded by the size of the UMI
+/// bitmap (128 KB for 10-nt UMI barcodes) plus the index of its chunks no
+/// matter how deep the library is,
+/// and the number of unique UMI barcodes of each gene is available at any
+/// time without scanning the pool.
+///
+/// Note: UMI barcodes that cannot be packed, e.g. those containing ambiguous
+/// nucleotides or having unexpected lengths, fall back to a pool of gene-UMI
+/// strings, so that the selection stays exact for all alignments.
+class SAMGeneUMIAdaptiveAlignmentCounter final : public SAMAlignmentCounter<SAMHeaderDataLine, SAMHeaderCommentLine, SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine>
+{
+public:
+
+    using SAMAlignmentCounterInst = SAMAlignmentCounter<SAMHeaderDataLine, SAMHeaderCommentLine, SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine>;
+
+    /// Type of the key of classified alignment line.
+    using AlignmentKeyType = GeneUMIKey;
+
+private:
+
+    /// Length of UMI barcode that can be packed.
+    std::size_t umi_length {0};
+
+    /// Maximum number of codes held by the sorted array of each chunk of the
+    /// containers, or 0 for the break-even size of the chunk bitmap.
+    std::size_t max_array_size {0};
+
+    /// Gene index of each gene name.
+    std::unordered_map<std::string, std::size_t> gene_indexes;
+
+    /// Gene names in the order of their first occurrences.
+    std::vector<std::string> gene_names;
+
+    /// Adaptive UMI container of each gene.
+    std::vector<AdaptiveUMIContainer> gene_umi_sets;
+
+    /// Number of unique unpacked UMI barcodes of each gene.
+    std::vector<std::size_t> gene_unpacked_umi_counts;
+
+    /// Pool of gene-UMI combinations whose UMI barcodes cannot be packed.
+    std::unordered_set<std::string> unpacked_gene_umi_pool;
+
+private:
+
+    /// Retrieve the gene index of a gene name, creating it as needed.
+    std::size_t getGeneIndex(const std::string& target_gene);
+
+public:
+
+    SAMGeneUMIAdaptiveAlignmentCounter(std::size_t umi_length=DGEIlluminaFASTQSequence::umi_barcode_length, std::size_t max_array_size=0);
+
+    virtual ~SAMGeneUMIAdaptiveAlignmentCounter() noexcept;
+
+    /// Determine if a sequence is uniquely aligned to a gene and also tagged
+    /// with distinct UMI barcode among all the sequences aligned to that gene.
+    /// An auxiliary count is used to indicate an unique alignment.
+    virtual bool countAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, bool& aux_count) override;
+
+    /// Reject the alignment lines that aren't uniquely aligned to a gene
+    /// before they are parsed.
+    /// Note: this function can be called by multiple threads at the same time.
+    bool prefilterAlignmentLine(const std::string& line) const
+    {
+        return SAMGeneUMIAlignmentCounter::isUniqueGeneAlignmentLine(line);
+    }
+
+    /// Classify an alignment line by its gene-UMI combination.
+    /// \return  True if the sequence is uniquely aligned to a gene.
+    /// Note: this function doesn't change the counter and can be called by
+    /// multiple threads at the same time.
+    bool classifyAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, AlignmentKeyType& gene_umi_key) const
+    {
+        return SAMGeneUMIAlignmentCounter::getUniqueGeneUMI(alignment_line, gene_umi_key.target_gene, gene_umi_key.umi_barcode);
+    }
+
+    /// Determine if a classified gene-UMI combination is distinct among all
+    /// the combinations counted so far.
+    /// Note: this function must be called in the order of input lines.
+    bool countAlignmentKey(const AlignmentKeyType& gene_umi_key, bool& aux_count);
+
+    /// Number of genes with at least one uniquely aligned sequence.
+    std::size_t getNumberOfGenes() const
+    {
+        return gene_names.size();
+    }
+
+    /// Gene names in the order of their first occurrences.
+    const std::vector<std::string>& getGeneNames() const
+    {
+        return gene_names;
+    }
+
+    /// Number of unique UMI barcodes of the gene with given index.
+    std::size_t getUniqueUMICount(std::size_t gene_index) const
+    {
+        return gene_umi_sets[gene_index].size() + gene_unpacked_umi_counts[gene_index];
+    }
+
+    /// Number of unique UMI barcodes of a gene, or zero for an unknown gene.
+    std::size_t getUniqueUMICount(const std::string& target_gene) const;
+
+    /// Add the number of unique UMI barcodes of each gene to the gene counts.
+    void getGeneCounts(GeneCounts& gene_counts) const;
+
+    /// Number of genes whose UMI containers use the dense bitmap layout in
+    /// any chunk.
+    std::size_t getNumberOfBitmapGenes() const;
+
+    /// Number of bytes allocated by all UMI containers.
+    std::size_t getMemoryUsage() const;
+};
+
+}
+
+#endif /* SAMGeneUMIAdaptiveAlignmentCounter_hpp */
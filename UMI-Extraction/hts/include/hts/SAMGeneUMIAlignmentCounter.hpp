@@ -10,11 +10,19 @@
 #define SAMGeneUMIAlignmentCounter_hpp
 
 #include <unordered_set>
+#include <unordered_map>
+#include <vector>
+#include <queue>
 #include <string>
+#include <string_view>
+#include <limits>
 #include "SAMAlignmentCounter.hpp"
 #include "SAMHeaderDataLine.hpp"
 #include "SAMHeaderCommentLine.hpp"
 #include "SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine.hpp"
+#include "GeneUMIKey.hpp"
+#include "GeneUMILocusKey.hpp"
+#include "GeneCountTable.hpp"
 
 namespace hts
 {
@@ -46,15 +54,58 @@ namespace hts
 /// to determine the uniqueness of a given sequence using a combination of
 /// target gene and UMI barcode.
 ///
+/// Sorted Input
+///
+/// For an input SAM file sorted by coordinate, either detected from the
+/// SO:coordinate tag of @HD header line or given explicitly, the gene-UMI
+/// combinations are kept per gene and retired once the input has passed the
+/// last exon of the gene, so that the memory is bounded by the largest locus
+/// instead of the whole library. The last exons of genes are taken from the
+/// gene annotations of featureCounts if given, in the order of reference
+/// sequences of @SQ header lines. Otherwise a gene is retired when the input
+/// moves on to the next reference sequence. A gene aligned again after being
+/// retired, e.g. one on both chrX and chrY without gene annotations, fails
+/// the count with an error instead of having its UMI barcodes counted twice.
+///
 /// Note: This class needs the optional fields of alignment status and
 /// target features contained the report SAM file generated by featureCounts
 /// program.
-class SAMGeneUMIAlignmentCounter : public SAMAlignmentCounter<SAMHeaderDataLine, SAMHeaderCommentLine, SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine>
+class SAMGeneUMIAlignmentCounter final : public SAMAlignmentCounter<SAMHeaderDataLine, SAMHeaderCommentLine, SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine>
 {
 public:
 
     using SAMAlignmentCounterInst = SAMAlignmentCounter<SAMHeaderDataLine, SAMHeaderCommentLine, SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine>;
 
+    /// Type of the key of classified alignment line.
+    using AlignmentKeyType = GeneUMILocusKey;
+
+    /// Hash function of the key of classified alignment line.
+    using AlignmentKeyHash = GeneUMIKeyHash;
+
+    /// Hash function for partitioning the keys by gene into shards.
+    using AlignmentKeyShardHash = GeneUMIKeyGeneHash;
+
+    /// How to determine whether the input SAM file is sorted by coordinate.
+    enum class SortedInputMode { Unsorted, Sorted, Detect };
+
+private:
+
+    /// Index of a reference sequence that is not known yet.
+    static constexpr std::size_t unknown_reference_index {std::numeric_limits<std::size_t>::max()};
+
+    /// The locus after which a gene is retired.
+    struct RetireLocus
+    {
+        std::size_t reference_index {0};
+        std::size_t position {0};
+        std::string target_gene;
+
+        bool operator>(const RetireLocus& locus) const
+        {
+            return reference_index > locus.reference_index || (reference_index == locus.reference_index && position > locus.position);
+        }
+    };
+
 private:
 
     /// \brief The gene-UMI pool for unique gene-UMI combinations.
@@ -62,16 +113,174 @@ private:
     /// gene and UMI barcode.
     std::unordered_set<std::string> gene_umi_pool;
 
+    /// Number of unique gene-UMI combinations of each gene.
+    GeneCounts gene_umi_counts;
+
+    /// Whether to check the @HD header line for sorted input.
+    bool detect_sorted_input {false};
+
+    /// Whether the input SAM file is sorted by coordinate.
+    bool sorted_input {false};
+
+    /// The end of the last exon of each gene on each reference sequence.
+    const GeneExonEnds* gene_exon_ends {nullptr};
+
+    /// Index of each reference sequence in the order of @SQ header lines and
+    /// then of alignment lines.
+    std::unordered_map<std::string, std::size_t> reference_indexes;
+
+    /// The current locus of sorted input.
+    std::size_t current_reference_index {0};
+    std::size_t current_position {0};
+
+    /// UMI barcodes of each gene that is not retired in sorted input.
+    std::unordered_map<std::string, std::unordered_set<std::string>> active_gene_umis;
+
+    /// The loci to retire active genes, with the earliest on top.
+    std::priority_queue<RetireLocus, std::vector<RetireLocus>, std::greater<RetireLocus>> retire_loci;
+
+    /// Genes retired in sorted input.
+    std::unordered_set<std::string> retired_genes;
+
+    /// Current and maximum numbers of gene-UMI combinations of active genes.
+    std::size_t n_active_combos {0};
+    std::size_t max_active_combos {0};
+
+    /// Number of bytes allocated for the gene-UMI strings of the pool beyond
+    /// the strings themselves.
+    std::size_t n_pool_string_bytes {0};
+
+private:
+
+    /// Get the index of a reference sequence, adding it as needed.
+    std::size_t getReferenceIndex(const std::string& reference_name);
+
+    /// Move the current locus of sorted input forward and retire the genes
+    /// whose last exons have been passed.
+    void advanceLocus(const std::string& reference_name, std::size_t position);
+
+    /// Find the locus after which a gene can be retired.
+    RetireLocus getRetireLocus(const std::string& target_gene) const;
+
+    /// Count a gene-UMI combination of sorted input.
+    bool countSortedAlignmentKey(const AlignmentKeyType& gene_umi_key);
+
 public:
 
-    SAMGeneUMIAlignmentCounter();
+    /// \param  sorted_input_mode  Whether the input SAM file is sorted by
+    ///                            coordinate, or to be detected from the @HD
+    ///                            header line.
+    /// \param  gene_exon_ends     The end of the last exon of each gene on
+    ///                            each reference sequence, or nullptr to
+    ///                            retire genes by reference sequence.
+    explicit SAMGeneUMIAlignmentCounter(SortedInputMode sorted_input_mode=SortedInputMode::Unsorted, const GeneExonEnds* gene_exon_ends=nullptr);
 
     virtual ~SAMGeneUMIAlignmentCounter() noexcept;
 
+    /// \brief Retrieve the gene and UMI barcode of a uniquely aligned sequence.
+    /// \param[in]   alignment_line  The alignment line to analyze.
+    /// \param[out]  target_gene     The gene that the sequence is uniquely aligned to.
+    /// \param[out]  umi_barcode     The UMI barcode of the sequence.
+    /// \return      True if the sequence is uniquely aligned to a gene.
+    /// Note: this function is shared by all the counters that identify unique
+    /// gene-UMI combinations, so that they select the same alignments.
+    static bool getUniqueGeneUMI(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, std::string& target_gene, std::string& umi_barcode);
+
+    /// \brief Check the raw text of an alignment line for a unique alignment.
+    /// \param  line  The alignment line to check.
+    /// \return  False if the line has no XN tag or its first XN tag isn't 1,
+    ///          i.e. getUniqueGeneUMI would surely reject it, and true
+    ///          otherwise.
+    /// Note: the XN tag is searched backwards from the end of the line with
+    /// utk::findLastSubstring, since the optional fields follow the long
+    /// sequence and quality fields, so that most rejected lines cost a few
+    /// SIMD comparisons without any memory allocation. The unassigned lines
+    /// of featureCounts carry no XN tag and are rejected this way.
+    static bool isUniqueGeneAlignmentLine(std::string_view line);
+
+    /// Detect sorted input from the @HD header line and collect the order of
+    /// reference sequences from @SQ header lines.
+    virtual bool countHeaderDataLine(const SAMHeaderDataLine& header_data_line, bool& aux_count) override;
+
     /// Determine if a sequence is uniquely aligned to a gene and also tagged
     /// with distinct UMI barcode among all the sequences aligned to that gene.
     /// An auxiliary count is used to indicate an unique alignment.
     virtual bool countAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, bool& aux_count) override;
+
+    /// Reject the alignment lines that aren't uniquely aligned to a gene
+    /// before they are parsed.
+    /// Note: this function can be called by multiple threads at the same time.
+    bool prefilterAlignmentLine(const std::string& line) const
+    {
+        return isUniqueGeneAlignmentLine(line);
+    }
+
+    /// Classify an alignment line by its gene-UMI combination.
+    /// \return  True if the sequence is uniquely aligned to a gene.
+    /// Note: this function doesn't change the counter and can be called by
+    /// multiple threads at the same time.
+    /// The locus of alignment is also retrieved if the input may be sorted.
+    bool classifyAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, AlignmentKeyType& gene_umi_key) const
+    {
+        if(SAMGeneUMIAlignmentCounter::getUniqueGeneUMI(alignment_line, gene_umi_key.target_gene, gene_umi_key.umi_barcode))
+        {
+            if(detect_sorted_input || sorted_input)
+            {
+                gene_umi_key.reference_name = alignment_line.getMandatoryFields().getRName();
+                gene_umi_key.position = alignment_line.getMandatoryFields().getPos();
+            }
+            return true;
+        }
+        else return false;
+    }
+
+    /// Determine if a classified gene-UMI combination is distinct among all
+    /// the combinations counted so far.
+    /// Note: this function must be called in the order of input lines.
+    bool countAlignmentKey(const AlignmentKeyType& gene_umi_key, bool& aux_count);
+
+    /// Make the output decision for a gene-UMI combination that has been
+    /// deduplicated outside the counter, such as by a ShardedDedupSet.
+    /// \param  unique  Whether the combination is the first occurrence.
+    /// Note: this function must be called in the order of input lines.
+    bool countUniqueAlignmentKey(const AlignmentKeyType& gene_umi_key, bool unique, bool& aux_count)
+    {
+        if(unique) ++gene_umi_counts[gene_umi_key.target_gene];
+        // Set auxiliary count to true for uniquely aligned sequence.
+        aux_count = true;
+        return unique;
+    }
+
+    /// Add the number of unique gene-UMI combinations of each gene to the
+    /// gene counts.
+    void getGeneCounts(GeneCounts& gene_counts) const;
+
+    /// Whether the input SAM file is counted as sorted by coordinate.
+    bool isSortedInput() const
+    {
+        return sorted_input;
+    }
+
+    /// Number of genes retired in sorted input.
+    std::size_t getNumberOfRetiredGenes() const
+    {
+        return retired_genes.size();
+    }
+
+    /// Maximum number of gene-UMI combinations kept at the same time in
+    /// sorted input.
+    std::size_t getMaxNumberOfActiveCombinations() const
+    {
+        return max_active_combos;
+    }
+
+    /// Add the statistics of the gene-UMI pool, or of the UMI barcodes of
+    /// active genes in sorted input.
+    void getDedupTableStats(utk::HashTableStats& stats) const;
+
+    /// Estimated memory in bytes of the gene-UMI pool, or of the UMI barcodes
+    /// of active genes in sorted input.
+    std::size_t getMemoryUsage() const;
 };
 
 }
@@ -0,0 +1,209 @@
+//
+//  SAMGeneUMIApproximateAlignmentCounter.hpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#ifndef SAMGeneUMIApproximateAlignmentCounter_hpp
+#define SAMGeneUMIApproximateAlignmentCounter_hpp
+
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <optional>
+#include <cstdint>
+#include <utk/BlockedBloomFilter.hpp>
+#include <utk/HyperLogLog.hpp>
+#include "SAMAlignmentCounter.hpp"
+#include "SAMHeaderDataLine.hpp"
+#include "SAMHeaderCommentLine.hpp"
+#include "SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine.hpp"
+#include "GeneUMIKey.hpp"
+#include "GeneCountTable.hpp"
+#include "DGEIlluminaFASTQSequence.hpp"
+#include "UMIBarcodePacker.hpp"
+#include "SAMGeneUMIAlignmentCounter.hpp"
+
+namespace hts
+{
+
+/// \brief Count aligned FASTQ sequences using gene and UMI information with
+/// bounded memory and a quantified error.
+/// This class selects the first alignment of each distinct gene-UMI
+/// combination among uniquely aligned sequences, as SAMGeneUMIAlignmentCounter
+/// does, but replaces the gene-UMI pool with a cache-blocked Bloom filter of
+/// a fixed size:
+///
+/// 1) Each gene-UMI combination is packed into a 64-bit key and mixed into a
+///    hash value, which is inserted into the Bloom filter. A combination is
+///    regarded as distinct if any of its bits was not set before.
+/// 2) A distinct combination is falsely regarded as a duplicate with the
+///    false positive rate of the filter at that time, which is accumulated
+///    into the estimated number of collisions.
+/// 3) The number of distinct combinations of each gene is counted from the
+///    same hash values, independently of the collisions of the Bloom filter.
+///    The hash values of a gene are kept exactly in a sorted array until the
+///    array would take as much memory as a HyperLogLog sketch (128 hash
+///    values for the default precision), and are then estimated by a sketch
+///    allocated at that time.
+///
+/// The filter is sized from the expected number of distinct combinations and
+/// a target false positive rate, which is exceeded if the actual number of
+/// distinct combinations is larger than expected.
+///
+/// Note: the memory of the filter is fixed, but the memory of gene counts
+/// grows with the number of genes, bounded by the size of a sketch (1 KB for
+/// the default precision) per gene, so that only the genes with many distinct
+/// combinations take the full size of a sketch.
+///
+/// Note: UMI barcodes that cannot be packed are hashed into 32 bits, which
+/// adds a small error for the rare combinations of ambiguous UMI barcodes.
+class SAMGeneUMIApproximateAlignmentCounter final : public SAMAlignmentCounter<SAMHeaderDataLine, SAMHeaderCommentLine, SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine>
+{
+public:
+
+    using SAMAlignmentCounterInst = SAMAlignmentCounter<SAMHeaderDataLine, SAMHeaderCommentLine, SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine>;
+
+    /// Type of the key of classified alignment line.
+    using AlignmentKeyType = GeneUMIKey;
+
+private:
+
+    /// Distinct hash values of the gene-UMI combinations of a gene, kept in a
+    /// sorted array or in a HyperLogLog sketch once the array is full.
+    struct GeneUMISketch
+    {
+        std::vector<std::uint64_t> hashes;
+        std::optional<utk::HyperLogLog> sketch;
+    };
+
+private:
+
+    /// Length of UMI barcode that can be packed.
+    std::size_t umi_length {0};
+
+    /// Number of bits selecting a register of HyperLogLog sketches.
+    unsigned sketch_precision {0};
+
+    /// Maximum number of hash values kept exactly for a gene, which take as
+    /// much memory as a HyperLogLog sketch.
+    std::size_t max_sketch_hashes {0};
+
+    /// Gene index of each gene name.
+    std::unordered_map<std::string, std::uint32_t> gene_indexes;
+
+    /// Bloom filter of the hash values of gene-UMI combinations.
+    utk::BlockedBloomFilter gene_umi_filter;
+
+    /// Distinct hash values of the gene-UMI combinations of each gene.
+    std::vector<GeneUMISketch> gene_umi_sketches;
+
+    /// Number of genes whose hash values are kept in HyperLogLog sketches.
+    std::size_t n_sketch_genes {0};
+
+    /// Number of gene-UMI combinations regarded as distinct.
+    std::size_t n_distinct_combos {0};
+
+    /// Estimated number of distinct gene-UMI combinations falsely regarded as
+    /// duplicates.
+    double n_est_collisions {0};
+
+private:
+
+    /// Retrieve the gene index of a gene name, creating it as needed.
+    std::uint32_t getGeneIndex(const std::string& target_gene);
+
+    /// Hash a gene-UMI combination into a well mixed 64-bit value.
+    std::uint64_t hashKey(std::uint32_t gene_index, const std::string& umi_barcode) const;
+
+    /// Insert the hash value of a gene-UMI combination into the hash values of
+    /// its gene, allocating a HyperLogLog sketch once the array is full.
+    void insertGeneHash(GeneUMISketch& gene_umi_sketch, std::uint64_t hash);
+
+public:
+
+    /// \param  n_expected_combos    The expected number of distinct gene-UMI
+    ///                              combinations.
+    /// \param  false_positive_rate  The target false positive rate of the
+    ///                              Bloom filter.
+    /// \param  sketch_precision     The precision of per-gene HyperLogLog
+    ///                              sketches, which are allocated only for
+    ///                              the genes with more distinct
+    ///                              combinations than a sketch holds in the
+    ///                              same memory as exact hash values.
+    SAMGeneUMIApproximateAlignmentCounter(std::size_t n_expected_combos, double false_positive_rate, unsigned sketch_precision=10, std::size_t umi_length=DGEIlluminaFASTQSequence::umi_barcode_length);
+
+    virtual ~SAMGeneUMIApproximateAlignmentCounter() noexcept;
+
+    /// Determine if a sequence is uniquely aligned to a gene and also tagged
+    /// with distinct UMI barcode among all the sequences aligned to that gene,
+    /// up to the false positive rate of the Bloom filter. An auxiliary count
+    /// is used to indicate an unique alignment.
+    virtual bool countAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, bool& aux_count) override;
+
+    /// Reject the alignment lines that aren't uniquely aligned to a gene
+    /// before they are parsed.
+    /// Note: this function can be called by multiple threads at the same time.
+    bool prefilterAlignmentLine(const std::string& line) const
+    {
+        return SAMGeneUMIAlignmentCounter::isUniqueGeneAlignmentLine(line);
+    }
+
+    /// Classify an alignment line by its gene-UMI combination.
+    /// \return  True if the sequence is uniquely aligned to a gene.
+    /// Note: this function doesn't change the counter and can be called by
+    /// multiple threads at the same time.
+    bool classifyAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, AlignmentKeyType& gene_umi_key) const
+    {
+        return SAMGeneUMIAlignmentCounter::getUniqueGeneUMI(alignment_line, gene_umi_key.target_gene, gene_umi_key.umi_barcode);
+    }
+
+    /// Determine if a classified gene-UMI combination is distinct among all
+    /// the combinations counted so far, up to the false positive rate of the
+    /// Bloom filter.
+    /// Note: this function must be called in the order of input lines.
+    bool countAlignmentKey(const AlignmentKeyType& gene_umi_key, bool& aux_count);
+
+    /// Add the estimated number of distinct gene-UMI combinations of each gene
+    /// to the gene counts.
+    void getGeneCounts(GeneCounts& gene_counts) const;
+
+    /// Number of genes with at least one uniquely aligned sequence.
+    std::size_t getNumberOfGenes() const
+    {
+        return gene_indexes.size();
+    }
+
+    /// Number of genes counted with HyperLogLog sketches.
+    std::size_t getNumberOfSketchGenes() const
+    {
+        return n_sketch_genes;
+    }
+
+    /// Number of gene-UMI combinations regarded as distinct.
+    std::size_t getNumberOfDistinctCombinations() const
+    {
+        return n_distinct_combos;
+    }
+
+    /// \brief Estimated fraction of distinct gene-UMI combinations falsely
+    /// regarded as duplicates.
+    /// Each distinct combination is a collision with the false positive rate
+    /// of the Bloom filter at the time it is counted.
+    double getEstimatedCollisionRate() const;
+
+    /// Current false positive rate of the Bloom filter.
+    double getFalsePositiveRate() const
+    {
+        return gene_umi_filter.getFalsePositiveRate();
+    }
+
+    /// Memory used by the Bloom filter, the hash values and the HyperLogLog
+    /// sketches of genes in bytes.
+    std::size_t getMemoryUsage() const;
+};
+
+}
+
+#endif /* SAMGeneUMIApproximateAlignmentCounter_hpp */
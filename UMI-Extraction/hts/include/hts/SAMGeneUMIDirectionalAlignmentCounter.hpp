@@ -0,0 +1,194 @@
+//
+//  SAMGeneUMIDirectionalAlignmentCounter.hpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#ifndef SAMGeneUMIDirectionalAlignmentCounter_hpp
+#define SAMGeneUMIDirectionalAlignmentCounter_hpp
+
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include "SAMAlignmentCounter.hpp"
+#include "SAMHeaderDataLine.hpp"
+#include "SAMHeaderCommentLine.hpp"
+#include "SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine.hpp"
+#include "GeneUMIKey.hpp"
+#include "GeneCountTable.hpp"
+#include "DGEIlluminaFASTQSequence.hpp"
+#include "UMIBarcodePacker.hpp"
+#include "DirectionalUMIClusterer.hpp"
+#include "SAMGeneUMIAlignmentCounter.hpp"
+
+namespace hts
+{
+
+/// \brief Count aligned FASTQ sequences with UMI error correction.
+/// This class extends the gene-UMI deduplication of SAMGeneUMIAlignmentCounter
+/// by merging the UMI barcodes of a gene that are likely to be sequencing
+/// errors of each other, using DirectionalUMIClusterer on 2-bit packed UMI
+/// barcodes. One alignment is written for each cluster of UMI barcodes, i.e.
+/// the first alignment tagged with the root UMI barcode of the cluster.
+///
+/// Since a cluster is only known after all the UMI barcodes of a gene have
+/// been counted, this class defers the output of alignment lines:
+///
+/// 1) countAlignmentKey counts every gene-UMI combination and selects the
+///    first alignment of each distinct combination as a candidate, whose line
+///    is passed to deferAlignmentLine by SAMAlignmentPipe.
+/// 2) writeDeferredAlignmentLines clusters the UMI barcodes of each gene and
+///    writes the candidates of the root UMI barcodes in the order of input
+///    lines once the input SAM file is finished.
+///
+/// Only the candidate lines are kept in memory, so the input is processed in
+/// a single pass and can be streamed.
+///
+/// Note: UMI barcodes that cannot be packed, e.g. those containing ambiguous
+/// nucleotides, are deduplicated exactly without error correction.
+class SAMGeneUMIDirectionalAlignmentCounter final : public SAMAlignmentCounter<SAMHeaderDataLine, SAMHeaderCommentLine, SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine>
+{
+public:
+
+    using SAMAlignmentCounterInst = SAMAlignmentCounter<SAMHeaderDataLine, SAMHeaderCommentLine, SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine>;
+
+    /// Type of the key of classified alignment line.
+    using AlignmentKeyType = GeneUMIKey;
+
+private:
+
+    using CodeType = UMIBarcodePacker::CodeType;
+
+    /// The count of a distinct UMI barcode and its candidate line.
+    struct UMIRecord
+    {
+        std::size_t count {0};
+        std::size_t line_index {0};
+    };
+
+private:
+
+    /// Length of UMI barcode that can be packed.
+    std::size_t umi_length {0};
+
+    /// Gene index of each gene name.
+    std::unordered_map<std::string, std::size_t> gene_indexes;
+
+    /// Gene names in the order of their first occurrences.
+    std::vector<std::string> gene_names;
+
+    /// Records of the packed UMI barcodes of each gene.
+    std::vector<std::unordered_map<CodeType, UMIRecord>> gene_umi_records;
+
+    /// Candidate line of each gene-UMI combination whose UMI barcode cannot
+    /// be packed.
+    std::unordered_map<std::string, std::size_t> unpacked_gene_umi_lines;
+
+    /// Number of molecules of each gene after error correction.
+    std::vector<std::size_t> gene_molecule_counts;
+
+    /// Candidate lines in the order of input lines.
+    std::vector<std::string> deferred_lines;
+
+    /// Number of candidates selected by countAlignmentKey.
+    std::size_t n_candidates {0};
+
+    /// Number of clusters of UMI barcodes found for all genes.
+    std::size_t n_clusters {0};
+
+private:
+
+    /// Retrieve the gene index of a gene name, creating it as needed.
+    std::size_t getGeneIndex(const std::string& target_gene);
+
+    /// Cluster the UMI barcodes of all genes and select the lines to write.
+    std::vector<unsigned char> selectDeferredLines();
+
+public:
+
+    SAMGeneUMIDirectionalAlignmentCounter(std::size_t umi_length=DGEIlluminaFASTQSequence::umi_barcode_length);
+
+    virtual ~SAMGeneUMIDirectionalAlignmentCounter() noexcept;
+
+    /// Determine if a sequence is uniquely aligned to a gene and tagged with
+    /// a UMI barcode not seen before for that gene, which makes it a candidate
+    /// for output. An auxiliary count is used to indicate an unique alignment.
+    virtual bool countAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, bool& aux_count) override;
+
+    /// Reject the alignment lines that aren't uniquely aligned to a gene
+    /// before they are parsed.
+    /// Note: this function can be called by multiple threads at the same time.
+    bool prefilterAlignmentLine(const std::string& line) const
+    {
+        return SAMGeneUMIAlignmentCounter::isUniqueGeneAlignmentLine(line);
+    }
+
+    /// Classify an alignment line by its gene-UMI combination.
+    /// \return  True if the sequence is uniquely aligned to a gene.
+    /// Note: this function doesn't change the counter and can be called by
+    /// multiple threads at the same time.
+    bool classifyAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, AlignmentKeyType& gene_umi_key) const
+    {
+        return SAMGeneUMIAlignmentCounter::getUniqueGeneUMI(alignment_line, gene_umi_key.target_gene, gene_umi_key.umi_barcode);
+    }
+
+    /// Count a classified gene-UMI combination and determine if it is a
+    /// candidate for output.
+    /// Note: this function must be called in the order of input lines.
+    bool countAlignmentKey(const AlignmentKeyType& gene_umi_key, bool& aux_count);
+
+    /// Keep the line of the candidate selected by the latest call of
+    /// countAlignmentLine or countAlignmentKey.
+    void deferAlignmentLine(const std::string& line)
+    {
+        deferred_lines.push_back(line);
+    }
+
+    /// \brief Write the lines of the root UMI barcodes of all clusters.
+    /// \param   file_writer  A LineWriter-based SAM file writer.
+    /// \return  The number of alignment lines written.
+    template<typename SAMFileWriterType>
+    std::size_t writeDeferredAlignmentLines(SAMFileWriterType& file_writer)
+    {
+        std::size_t n_write_lines {0};
+        std::vector<unsigned char> selected = selectDeferredLines();
+        for(std::size_t i = 0; i < deferred_lines.size(); ++i)
+        {
+            if(selected[i])
+            {
+                file_writer.writeLine(deferred_lines[i]);
+                n_write_lines++;
+            }
+        }
+        deferred_lines.clear();
+        return n_write_lines;
+    }
+
+    /// Number of genes with at least one uniquely aligned sequence.
+    std::size_t getNumberOfGenes() const
+    {
+        return gene_names.size();
+    }
+
+    /// Number of distinct gene-UMI combinations before error correction.
+    std::size_t getNumberOfCandidates() const
+    {
+        return n_candidates;
+    }
+
+    /// Number of molecules after error correction.
+    std::size_t getNumberOfClusters() const
+    {
+        return n_clusters;
+    }
+
+    /// Add the number of molecules of each gene after error correction to the
+    /// gene counts.
+    /// Note: the molecules are only counted by writeDeferredAlignmentLines.
+    void getGeneCounts(GeneCounts& gene_counts) const;
+};
+
+}
+
+#endif /* SAMGeneUMIDirectionalAlignmentCounter_hpp */
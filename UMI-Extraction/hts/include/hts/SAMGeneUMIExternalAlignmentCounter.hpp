@@ -0,0 +1,252 @@
+//
+//  SAMGeneUMIExternalAlignmentCounter.hpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#ifndef SAMGeneUMIExternalAlignmentCounter_hpp
+#define SAMGeneUMIExternalAlignmentCounter_hpp
+
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <stdexcept>
+#include <utk/LineWriter.hpp>
+#include <utk/LineReader.hpp>
+#include "SAMAlignmentCounter.hpp"
+#include "SAMHeaderDataLine.hpp"
+#include "SAMHeaderCommentLine.hpp"
+#include "SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine.hpp"
+#include "GeneUMIKey.hpp"
+#include "GeneCountTable.hpp"
+#include "DGEIlluminaFASTQSequence.hpp"
+#include "UMIBarcodePacker.hpp"
+#include "SAMGeneUMIAlignmentCounter.hpp"
+
+namespace hts
+{
+
+/// Sequential reader of a scratch file of sorted values.
+template<typename T>
+class RunFileReader;
+
+/// \brief Count aligned FASTQ sequences using gene and UMI information within
+/// a memory budget.
+/// This class selects the same alignments as SAMGeneUMIAlignmentCounter, i.e.
+/// the first alignment of each distinct gene-UMI combination among uniquely
+/// aligned sequences, but keeps only a bounded part of the gene-UMI pool in
+/// memory:
+///
+/// 1) Each gene-UMI combination is packed into a 64-bit key, and the first
+///    occurrence of each key is kept in an in-memory run together with its
+///    ordinal among candidate lines. Candidate lines, i.e. the first
+///    occurrences within each run, are deferred to a scratch file.
+/// 2) When the run exceeds the memory budget, it is sorted by key and
+///    spilled to a scratch file.
+/// 3) After all lines are counted, the runs are merged by key in a k-way
+///    merge, which finds the smallest ordinal, i.e. the first occurrence, of
+///    each key across all runs.
+/// 4) The ordinals of first occurrences are sorted, spilling to scratch files
+///    as needed, and the kept lines are written by streaming the candidate
+///    lines in a second pass.
+///
+/// The output is therefore identical to that of SAMGeneUMIAlignmentCounter.
+/// Scratch files are created in the directory given by TMPDIR, or /tmp.
+///
+/// Note: UMI barcodes that cannot be packed are mapped to distinct indexes
+/// kept in memory, which are assumed to be rare.
+class SAMGeneUMIExternalAlignmentCounter final : public SAMAlignmentCounter<SAMHeaderDataLine, SAMHeaderCommentLine, SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine>
+{
+public:
+
+    using SAMAlignmentCounterInst = SAMAlignmentCounter<SAMHeaderDataLine, SAMHeaderCommentLine, SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine>;
+
+    /// Type of the key of classified alignment line.
+    using AlignmentKeyType = GeneUMIKey;
+
+    /// Maximum number of runs merged at the same time.
+    static constexpr std::size_t max_merge_runs {64};
+
+    /// The first occurrence of a packed gene-UMI key in a run.
+    struct KeyRecord
+    {
+        std::uint64_t key {0};
+        std::uint64_t ordinal {0};
+
+        bool operator<(const KeyRecord& record) const
+        {
+            return key < record.key || (key == record.key && ordinal < record.ordinal);
+        }
+    };
+
+private:
+
+    /// Memory budget in bytes for the in-memory run.
+    std::size_t memory_budget {0};
+
+    /// Length of UMI barcode that can be packed.
+    std::size_t umi_length {0};
+
+    /// Gene index of each gene name.
+    std::unordered_map<std::string, std::uint32_t> gene_indexes;
+
+    /// Gene names in the order of their first occurrences.
+    std::vector<std::string> gene_names;
+
+    /// Index of each UMI barcode that cannot be packed.
+    std::unordered_map<std::string, std::uint32_t> unpacked_umi_indexes;
+
+    /// First candidate ordinal of each packed key in the in-memory run.
+    std::unordered_map<std::uint64_t, std::uint64_t> run_keys;
+
+    /// Scratch files of the spilled runs sorted by key.
+    std::vector<std::string> run_file_paths;
+
+    /// Scratch file of candidate lines and its writer.
+    std::string candidate_file_path;
+    utk::LineWriter candidate_writer;
+
+    /// Sorted ordinals of the first occurrences kept in memory, or in the
+    /// scratch file read by kept_ordinal_reader.
+    std::vector<std::uint64_t> kept_ordinals;
+    std::size_t n_read_kept_ordinals {0};
+    std::string kept_ordinal_file_path;
+    std::unique_ptr<RunFileReader<std::uint64_t>> kept_ordinal_reader;
+
+    /// Number of candidates selected by countAlignmentKey.
+    std::size_t n_candidates {0};
+
+    /// Number of runs spilled to scratch files.
+    std::size_t n_spilled_runs {0};
+
+    /// Number of unique gene-UMI combinations of each gene.
+    std::vector<std::size_t> gene_umi_counts;
+
+private:
+
+    /// Retrieve the gene index of a gene name, creating it as needed.
+    std::uint32_t getGeneIndex(const std::string& target_gene);
+
+    /// Pack a gene-UMI combination into a 64-bit key.
+    std::uint64_t packKey(const GeneUMIKey& gene_umi_key);
+
+    /// Estimate the memory used by the in-memory run.
+    std::size_t getRunMemoryUsage() const;
+
+    /// Sort the in-memory run by key and spill it to a scratch file.
+    void spillRun();
+
+    /// \brief Find the ordinals of the first occurrences of all keys.
+    /// The ordinals are sorted in memory if they fit into the memory budget,
+    /// or spilled to a sorted scratch file otherwise.
+    void selectCandidates();
+
+    /// Get the next ordinal of the first occurrences in ascending order.
+    /// \return  False if there is no more ordinal.
+    bool nextKeptOrdinal(std::uint64_t& ordinal);
+
+    /// Remove all scratch files.
+    void removeScratchFiles();
+
+public:
+
+    SAMGeneUMIExternalAlignmentCounter(std::size_t memory_budget, std::size_t umi_length=DGEIlluminaFASTQSequence::umi_barcode_length);
+
+    virtual ~SAMGeneUMIExternalAlignmentCounter() noexcept;
+
+    /// Determine if a sequence is uniquely aligned to a gene and tagged with
+    /// a UMI barcode not seen before for that gene in the current run, which
+    /// makes it a candidate for output. An auxiliary count is used to
+    /// indicate an unique alignment.
+    virtual bool countAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, bool& aux_count) override;
+
+    /// Reject the alignment lines that aren't uniquely aligned to a gene
+    /// before they are parsed.
+    /// Note: this function can be called by multiple threads at the same time.
+    bool prefilterAlignmentLine(const std::string& line) const
+    {
+        return SAMGeneUMIAlignmentCounter::isUniqueGeneAlignmentLine(line);
+    }
+
+    /// Classify an alignment line by its gene-UMI combination.
+    /// \return  True if the sequence is uniquely aligned to a gene.
+    /// Note: this function doesn't change the counter and can be called by
+    /// multiple threads at the same time.
+    bool classifyAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, AlignmentKeyType& gene_umi_key) const
+    {
+        return SAMGeneUMIAlignmentCounter::getUniqueGeneUMI(alignment_line, gene_umi_key.target_gene, gene_umi_key.umi_barcode);
+    }
+
+    /// Count a classified gene-UMI combination and determine if it is a
+    /// candidate for output.
+    /// Note: this function must be called in the order of input lines.
+    bool countAlignmentKey(const AlignmentKeyType& gene_umi_key, bool& aux_count);
+
+    /// Spill the line of the candidate selected by the latest call of
+    /// countAlignmentLine or countAlignmentKey to the scratch file.
+    void deferAlignmentLine(const std::string& line)
+    {
+        candidate_writer.writeLine(line);
+    }
+
+    /// \brief Write the lines of the first occurrences of all gene-UMI
+    /// combinations in the order of input lines.
+    /// \param   file_writer  A LineWriter-based SAM file writer.
+    /// \return  The number of alignment lines written.
+    template<typename SAMFileWriterType>
+    std::size_t writeDeferredAlignmentLines(SAMFileWriterType& file_writer);
+
+    /// Add the number of unique gene-UMI combinations of each gene to the
+    /// gene counts.
+    /// Note: the combinations are only counted by writeDeferredAlignmentLines.
+    void getGeneCounts(GeneCounts& gene_counts) const;
+
+    /// Number of candidates, i.e. first occurrences within each run.
+    std::size_t getNumberOfCandidates() const
+    {
+        return n_candidates;
+    }
+
+    /// Number of runs spilled to scratch files.
+    std::size_t getNumberOfSpilledRuns() const
+    {
+        return n_spilled_runs;
+    }
+};
+
+/// Write the lines of the first occurrences of all gene-UMI combinations.
+template<typename SAMFileWriterType>
+std::size_t SAMGeneUMIExternalAlignmentCounter::writeDeferredAlignmentLines(SAMFileWriterType& file_writer)
+{
+    // Find the ordinals of the kept candidates.
+    selectCandidates();
+
+    // Stream the candidate lines and write the kept ones.
+    std::size_t n_write_lines {0};
+    std::uint64_t kept_ordinal {0};
+    bool has_kept = nextKeptOrdinal(kept_ordinal);
+    {
+        utk::LineReader candidate_reader(candidate_file_path, "unix");
+        std::uint64_t candidate_ordinal {0};
+        for(std::string line; has_kept && candidate_reader.readLine(line); ++candidate_ordinal)
+        {
+            if(candidate_ordinal == kept_ordinal)
+            {
+                file_writer.writeLine(line);
+                n_write_lines++;
+                has_kept = nextKeptOrdinal(kept_ordinal);
+            }
+        }
+    }
+    removeScratchFiles();
+    if(has_kept) throw std::runtime_error("Scratch file " + candidate_file_path + " has fewer candidate lines than expected!");
+
+    return n_write_lines;
+}
+
+}
+
+#endif /* SAMGeneUMIExternalAlignmentCounter_hpp */
@@ -0,0 +1,158 @@
+//
+//  SAMGeneUMIIncrementalAlignmentCounter.hpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#ifndef SAMGeneUMIIncrementalAlignmentCounter_hpp
+#define SAMGeneUMIIncrementalAlignmentCounter_hpp
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "SAMAlignmentCounter.hpp"
+#include "SAMHeaderDataLine.hpp"
+#include "SAMHeaderCommentLine.hpp"
+#include "SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine.hpp"
+#include "GeneUMIKey.hpp"
+#include "GeneUMISnapshot.hpp"
+#include "GeneCountTable.hpp"
+#include "DGEIlluminaFASTQSequence.hpp"
+#include "UMIBarcodePacker.hpp"
+#include "SAMGeneUMIAlignmentCounter.hpp"
+
+namespace hts
+{
+
+/// \brief Count aligned FASTQ sequences using gene and UMI information on top
+/// of the gene-UMI combinations of earlier runs.
+/// This class selects the first alignment of each gene-UMI combination that
+/// is neither in a dedup snapshot of earlier runs nor seen before in the
+/// current run, so that new sequencing lanes of a sample can be counted
+/// without counting the earlier lanes again. The output of all the runs
+/// together is the same as that of SAMGeneUMIAlignmentCounter on all the
+/// lanes at once.
+///
+/// The snapshot is mapped into memory and searched in place, while the new
+/// gene-UMI combinations are packed into 64-bit keys in a hash set. After
+/// the run, the snapshot and the new combinations are merged into a new
+/// snapshot, and the per-gene counts include both.
+///
+/// Note: UMI barcodes that cannot be packed fall back to gene-tab-UMI
+/// strings.
+class SAMGeneUMIIncrementalAlignmentCounter final : public SAMAlignmentCounter<SAMHeaderDataLine, SAMHeaderCommentLine, SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine>
+{
+public:
+
+    using SAMAlignmentCounterInst = SAMAlignmentCounter<SAMHeaderDataLine, SAMHeaderCommentLine, SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine>;
+
+    /// Type of the key of classified alignment line.
+    using AlignmentKeyType = GeneUMIKey;
+
+private:
+
+    /// Length of UMI barcode that can be packed.
+    std::size_t umi_length {0};
+
+    /// The gene-UMI combinations of earlier runs.
+    GeneUMISnapshot snapshot;
+
+    /// Gene index of each gene name, starting with the genes of snapshot.
+    std::unordered_map<std::string, std::uint32_t> gene_indexes;
+
+    /// Gene names in the order of gene indexes.
+    std::vector<std::string> gene_names;
+
+    /// Number of unique gene-UMI combinations of each gene in all runs.
+    std::vector<std::size_t> gene_combo_counts;
+
+    /// Packed keys of new gene-UMI combinations.
+    std::unordered_set<std::uint64_t> new_packed_keys;
+
+    /// New gene-tab-UMI combinations whose UMI barcodes cannot be packed.
+    std::unordered_set<std::string> new_unpacked_combos;
+
+    /// Number of alignments whose gene-UMI combinations are in the snapshot.
+    std::size_t n_snapshot_duplicates {0};
+
+private:
+
+    /// Retrieve the gene index of a gene name, creating it as needed.
+    std::uint32_t getGeneIndex(const std::string& target_gene);
+
+public:
+
+    /// \param  snapshot_file_path  The dedup snapshot file of earlier runs, or
+    ///                             a file that doesn't exist yet for the first
+    ///                             run.
+    explicit SAMGeneUMIIncrementalAlignmentCounter(const std::string& snapshot_file_path, std::size_t umi_length=DGEIlluminaFASTQSequence::umi_barcode_length);
+
+    virtual ~SAMGeneUMIIncrementalAlignmentCounter() noexcept;
+
+    /// Determine if a sequence is uniquely aligned to a gene and also tagged
+    /// with a UMI barcode that is new to that gene in all runs. An auxiliary
+    /// count is used to indicate an unique alignment.
+    virtual bool countAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, bool& aux_count) override;
+
+    /// Reject the alignment lines that aren't uniquely aligned to a gene
+    /// before they are parsed.
+    /// Note: this function can be called by multiple threads at the same time.
+    bool prefilterAlignmentLine(const std::string& line) const
+    {
+        return SAMGeneUMIAlignmentCounter::isUniqueGeneAlignmentLine(line);
+    }
+
+    /// Classify an alignment line by its gene-UMI combination.
+    /// \return  True if the sequence is uniquely aligned to a gene.
+    /// Note: this function doesn't change the counter and can be called by
+    /// multiple threads at the same time.
+    bool classifyAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, AlignmentKeyType& gene_umi_key) const
+    {
+        return SAMGeneUMIAlignmentCounter::getUniqueGeneUMI(alignment_line, gene_umi_key.target_gene, gene_umi_key.umi_barcode);
+    }
+
+    /// Determine if a classified gene-UMI combination is new among all the
+    /// combinations of earlier runs and of the current run so far.
+    /// Note: this function must be called in the order of input lines.
+    bool countAlignmentKey(const AlignmentKeyType& gene_umi_key, bool& aux_count);
+
+    /// Write the gene-UMI combinations of earlier runs and the current run to
+    /// a dedup snapshot file, which may replace the snapshot file read.
+    void writeSnapshot(const std::string& snapshot_file_path) const;
+
+    /// Add the number of unique gene-UMI combinations of each gene in all
+    /// runs to the gene counts.
+    void getGeneCounts(GeneCounts& gene_counts) const;
+
+    /// Number of gene-UMI combinations of earlier runs.
+    std::size_t getNumberOfSnapshotCombinations() const
+    {
+        return snapshot.getNumberOfCombinations();
+    }
+
+    /// Number of new gene-UMI combinations of the current run.
+    std::size_t getNumberOfNewCombinations() const
+    {
+        return new_packed_keys.size() + new_unpacked_combos.size();
+    }
+
+    /// Number of alignments whose gene-UMI combinations are in the snapshot.
+    std::size_t getNumberOfSnapshotDuplicates() const
+    {
+        return n_snapshot_duplicates;
+    }
+
+    /// Add the statistics of the hash sets of new gene-UMI combinations.
+    void getDedupTableStats(utk::HashTableStats& stats) const
+    {
+        stats.add(new_packed_keys);
+        stats.add(new_unpacked_combos);
+    }
+};
+
+}
+
+#endif /* SAMGeneUMIIncrementalAlignmentCounter_hpp */
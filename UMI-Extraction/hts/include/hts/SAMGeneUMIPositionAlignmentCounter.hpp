@@ -0,0 +1,174 @@
+//
+//  SAMGeneUMIPositionAlignmentCounter.hpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#ifndef SAMGeneUMIPositionAlignmentCounter_hpp
+#define SAMGeneUMIPositionAlignmentCounter_hpp
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <string_view>
+#include "SAMAlignmentCounter.hpp"
+#include "SAMHeaderDataLine.hpp"
+#include "SAMHeaderCommentLine.hpp"
+#include "SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine.hpp"
+#include "GeneUMIPositionKey.hpp"
+#include "GeneCountTable.hpp"
+#include "DGEIlluminaFASTQSequence.hpp"
+#include "UMIBarcodePacker.hpp"
+#include "SAMGeneUMIAlignmentCounter.hpp"
+
+namespace hts
+{
+
+/// \brief Count aligned FASTQ sequences using gene, UMI and 5' end information.
+/// This class selects the first alignment of each distinct combination of
+/// target gene, UMI barcode, strand and 5' end among uniquely aligned
+/// sequences. The 5' end can be grouped into windows of a given number of
+/// bases, so that alignments starting a few bases apart are still regarded
+/// as the same molecule.
+///
+/// Each combination is packed into a composite key of two 64-bit words:
+///
+/// 1) The dense index of the gene and the 2-bit packed UMI barcode.
+/// 2) The strand and the window index of the 5' end.
+///
+/// so that the dedup hash set compares and hashes two integers instead of a
+/// concatenated string.
+///
+/// Note: UMI barcodes that cannot be packed, e.g. those containing ambiguous
+/// nucleotides, fall back to a pool of concatenated strings.
+class SAMGeneUMIPositionAlignmentCounter final : public SAMAlignmentCounter<SAMHeaderDataLine, SAMHeaderCommentLine, SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine>
+{
+public:
+
+    using SAMAlignmentCounterInst = SAMAlignmentCounter<SAMHeaderDataLine, SAMHeaderCommentLine, SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine>;
+
+    /// Type of the key of classified alignment line.
+    using AlignmentKeyType = GeneUMIPositionKey;
+
+private:
+
+    /// Composite key of a gene-UMI-position combination.
+    struct PackedKey
+    {
+        /// Gene index in the upper 32 bits and packed UMI barcode in the lower.
+        std::uint64_t gene_umi {0};
+
+        /// Strand in the top bit and window index of 5' end in the others.
+        std::uint64_t strand_window {0};
+
+        bool operator==(const PackedKey& key) const
+        {
+            return gene_umi == key.gene_umi && strand_window == key.strand_window;
+        }
+    };
+
+    /// Hash function of composite keys.
+    struct PackedKeyHash
+    {
+        std::size_t operator()(const PackedKey& key) const
+        {
+            std::uint64_t hash = key.gene_umi * 0x9e3779b97f4a7c15ULL;
+            hash ^= (key.strand_window + 0x632be59bd9b4e019ULL) * 0xbf58476d1ce4e5b9ULL;
+            return static_cast<std::size_t>(hash ^ (hash >> 31));
+        }
+    };
+
+private:
+
+    /// Number of bases in a window of 5' end.
+    std::size_t position_window {1};
+
+    /// Length of UMI barcode that can be packed.
+    std::size_t umi_length {0};
+
+    /// Gene index of each gene name.
+    std::unordered_map<std::string, std::uint32_t> gene_indexes;
+
+    /// Pool of packed gene-UMI-position combinations.
+    std::unordered_set<PackedKey, PackedKeyHash> gene_umi_pos_pool;
+
+    /// Pool of gene-UMI-position combinations whose UMI barcodes cannot be packed.
+    std::unordered_set<std::string> unpacked_gene_umi_pos_pool;
+
+    /// Number of unique gene-UMI-position combinations of each gene.
+    std::vector<std::size_t> gene_combo_counts;
+
+private:
+
+    /// Retrieve the gene index of a gene name, creating it as needed.
+    std::uint32_t getGeneIndex(const std::string& target_gene);
+
+    /// Get the index of the window that a 5' end falls into.
+    long long getWindowIndex(long long five_prime_pos) const;
+
+    /// \brief Get the strand and the 5' end of an alignment from the raw text
+    /// of its FLAG, POS and CIGAR columns.
+    /// Only these columns are scanned, so that the position UMI counter
+    /// doesn't need the costly parsing of all mandatory fields.
+    static void getStrandFivePrimePosition(std::string_view line, bool& reverse_strand, long long& five_prime_pos);
+
+public:
+
+    SAMGeneUMIPositionAlignmentCounter(std::size_t position_window=1, std::size_t umi_length=DGEIlluminaFASTQSequence::umi_barcode_length);
+
+    virtual ~SAMGeneUMIPositionAlignmentCounter() noexcept;
+
+    /// Determine if a sequence is uniquely aligned to a gene and also distinct
+    /// in UMI barcode, strand and 5' end among all the sequences aligned to
+    /// that gene. An auxiliary count is used to indicate an unique alignment.
+    virtual bool countAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, bool& aux_count) override;
+
+    /// Reject the alignment lines that aren't uniquely aligned to a gene
+    /// before they are parsed.
+    /// Note: this function can be called by multiple threads at the same time.
+    bool prefilterAlignmentLine(const std::string& line) const
+    {
+        return SAMGeneUMIAlignmentCounter::isUniqueGeneAlignmentLine(line);
+    }
+
+    /// Classify an alignment line by its gene-UMI-position combination.
+    /// \return  True if the sequence is uniquely aligned to a gene.
+    /// Note: this function doesn't change the counter and can be called by
+    /// multiple threads at the same time.
+    bool classifyAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, AlignmentKeyType& gene_umi_pos_key) const;
+
+    /// Determine if a classified gene-UMI-position combination is distinct
+    /// among all the combinations counted so far.
+    /// Note: this function must be called in the order of input lines.
+    bool countAlignmentKey(const AlignmentKeyType& gene_umi_pos_key, bool& aux_count);
+
+    /// Number of genes with at least one uniquely aligned sequence.
+    std::size_t getNumberOfGenes() const
+    {
+        return gene_indexes.size();
+    }
+
+    /// Add the number of unique gene-UMI-position combinations of each gene to
+    /// the gene counts.
+    void getGeneCounts(GeneCounts& gene_counts) const;
+
+    /// Number of distinct gene-UMI-position combinations.
+    std::size_t getNumberOfCombinations() const
+    {
+        return gene_umi_pos_pool.size() + unpacked_gene_umi_pos_pool.size();
+    }
+
+    /// Add the statistics of the gene-UMI-position pools.
+    void getDedupTableStats(utk::HashTableStats& stats) const
+    {
+        stats.add(gene_umi_pos_pool);
+        stats.add(unpacked_gene_umi_pos_pool);
+    }
+};
+
+}
+
+#endif /* SAMGeneUMIPositionAlignmentCounter_hpp */
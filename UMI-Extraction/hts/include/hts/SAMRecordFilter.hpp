@@ -0,0 +1,139 @@
+//
+//  SAMRecordFilter.hpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#ifndef SAMRecordFilter_hpp
+#define SAMRecordFilter_hpp
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+
+namespace hts
+{
+
+/// \brief Filter alignment lines by a compiled filter expression.
+/// This class compiles a filter expression once into a flat program of tests
+/// and short-circuit jumps, and evaluates the program on the raw text of each
+/// alignment line, so that a rejected line is never parsed. The expression
+/// is made of:
+///
+///     Fields:      QNAME, FLAG, RNAME, POS, MAPQ, CIGAR, RNEXT, PNEXT, TLEN,
+///                  SEQ, QUAL, or the two-character tag of an optional field,
+///                  e.g. XS, XN, or NH.
+///     Literals:    integers in decimal or hexadecimal, e.g. 255 or 0x900, and
+///                  double-quoted strings, e.g. "Assigned".
+///     Tests:       field == literal, !=, <, <=, >, >=, field & integer for any
+///                  of the bits set, or a bare tag for the presence of the tag.
+///     Logic:       !, &&, ||, and parentheses.
+///
+/// e.g. MAPQ >= 255 && !(FLAG & 0x900) && XS == "Assigned" && NH == 1
+///
+/// A field is compared as an integer with an integer literal, and as a
+/// string with a string literal. A test on an absent tag, or on a field that
+/// isn't an integer compared with an integer, is false.
+///
+/// Note: the expression is applied as a filter of SAMFilteredAlignmentCounter.
+class SAMRecordFilter
+{
+private:
+
+    /// Comparison of a field with a literal.
+    enum class Comparison : unsigned char { Present, Equal, NotEqual, Less, LessEqual, Greater, GreaterEqual, AnyBits };
+
+    /// Test of a field of alignment line.
+    struct Test
+    {
+        /// Column of a mandatory field, or the number of mandatory fields for
+        /// an optional field.
+        std::size_t column {0};
+
+        /// Tag of an optional field.
+        char tag[2] {'\0', '\0'};
+
+        /// Comparison with the literal.
+        Comparison comparison {Comparison::Present};
+
+        /// Indicator of a string literal.
+        bool string_literal {false};
+
+        /// Integer literal.
+        long long number {0};
+
+        /// String literal.
+        std::string text;
+    };
+
+    /// Operation of the program.
+    enum class OpCode : unsigned char { Test, Not, JumpIfFalse, JumpIfTrue };
+
+    /// Instruction of the program, whose operand is the index of a test or
+    /// the target of a jump.
+    struct Instruction
+    {
+        OpCode opcode {OpCode::Test};
+        std::size_t operand {0};
+    };
+
+    /// The filter expression.
+    std::string expression;
+
+    /// Tests of the program.
+    std::vector<Test> tests;
+
+    /// Flat program of the filter expression.
+    std::vector<Instruction> program;
+
+    /// Position of the next token during compilation.
+    std::size_t pos {0};
+
+private:
+
+    /// Compile the filter expression into the program.
+    void compile();
+
+    /// Compile an expression of alternatives joined by ||.
+    void compileOr();
+
+    /// Compile an expression of conditions joined by &&.
+    void compileAnd();
+
+    /// Compile a negated, parenthesized, or test expression.
+    void compileUnary();
+
+    /// Compile a test of a field.
+    void compileTest();
+
+    /// Skip white spaces and check if the next token starts with a string.
+    bool peekToken(std::string_view token);
+
+    /// Throw an error of the filter expression at the current position.
+    [[noreturn]] void throwError(const std::string& message) const;
+
+    /// Evaluate a test on the raw text of an alignment line.
+    static bool evaluateTest(const Test& test, std::string_view line);
+
+public:
+
+    /// \param  expression  The filter expression, or empty to pass all lines.
+    explicit SAMRecordFilter(const std::string& expression);
+
+    /// Check if the raw text of an alignment line satisfies the filter
+    /// expression.
+    /// Note: this function can be called by multiple threads at the same time.
+    bool filterRawAlignmentLine(std::string_view line) const;
+
+    /// Retrieve the filter expression.
+    const std::string& getExpression() const
+    {
+        return expression;
+    }
+};
+
+}
+
+#endif /* SAMRecordFilter_hpp */
@@ -0,0 +1,288 @@
+//
+//  ShardedDedupSet.hpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#ifndef ShardedDedupSet_hpp
+#define ShardedDedupSet_hpp
+
+#include <vector>
+#include <string>
+#include <map>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <utility>
+#include <stdexcept>
+#include <functional>
+#include <unordered_set>
+#include <condition_variable>
+#include <utk/SPSCQueue.hpp>
+#include <utk/HashTableStats.hpp>
+#include <utk/Tracer.hpp>
+
+namespace hts
+{
+
+/// \brief A set of keys split into shards for concurrent deduplication
+/// This class deduplicates keys submitted by multiple producer threads with a
+/// fixed number of shards. Each shard owns a part of the key set, chosen by
+/// ShardHashType, and is only accessed by its own shard thread, so that
+/// inserting a key needs no lock. Keys are routed from each producer to each
+/// shard through a lock-free single-producer single-consumer queue.
+///
+/// Keys are submitted in numbered batches, and every batch number must be
+/// submitted exactly once by one of the producers, with one task for each
+/// shard even if the task is empty. Each shard thread processes the batches
+/// strictly in the order of batch number and the keys of a batch in the order
+/// of submission. Therefore, the first occurrence of each key is the same as
+/// that of deduplicating all keys serially with a single set.
+///
+/// \tparam  KeyType        The type of key to deduplicate.
+/// \tparam  KeyHashType    The hash function of keys within a shard.
+/// \tparam  ShardHashType  The hash function for routing keys to shards.
+/// \tparam  KeyEqualType   The equality function of keys.
+template<typename KeyType, typename KeyHashType = std::hash<KeyType>, typename ShardHashType = KeyHashType, typename KeyEqualType = std::equal_to<KeyType>>
+class ShardedDedupSet
+{
+public:
+
+    /// Default capacity of each queue between a producer and a shard.
+    static constexpr std::size_t default_queue_capacity {256};
+
+    /// Deduplication results of a batch of keys.
+    class Batch
+    {
+        friend class ShardedDedupSet;
+
+    private:
+
+        /// Sequence number of the batch.
+        std::size_t batch_number {0};
+
+        /// Indicator of each key slot being the first occurrence of its key.
+        std::vector<unsigned char> uniques;
+
+        /// Number of shards that haven't finished processing the batch.
+        std::atomic<std::size_t> n_pending_shards {0};
+
+    public:
+
+        Batch(std::size_t batch_number, std::size_t n_slots) : batch_number{batch_number}, uniques(n_slots, 0) {}
+
+        /// Check if the key in a slot is the first occurrence of the key.
+        bool isUnique(std::size_t slot) const
+        {
+            return uniques[slot] != 0;
+        }
+    };
+
+    /// A key to deduplicate and its slot in the batch results.
+    struct Item
+    {
+        std::size_t slot {0};
+        const KeyType* key {nullptr};
+    };
+
+private:
+
+    /// The keys of a batch routed to one shard.
+    struct ShardTask
+    {
+        std::shared_ptr<Batch> batch;
+        std::vector<Item> items;
+    };
+
+    /// The key set owned by a shard.
+    using KeySetType = std::unordered_set<KeyType, KeyHashType, KeyEqualType>;
+
+private:
+
+    /// Number of shards.
+    std::size_t n_shards;
+
+    /// Number of producers.
+    std::size_t n_producers;
+
+    /// Key set of each shard.
+    std::vector<KeySetType> shard_key_sets;
+
+    /// Queue from each producer to each shard, indexed by producer*n_shards+shard.
+    std::vector<std::unique_ptr<utk::SPSCQueue<ShardTask>>> task_queues;
+
+    /// Shard threads.
+    std::vector<std::thread> shard_threads;
+
+    /// Indicator of stopping all shard threads.
+    std::atomic<bool> stopping {false};
+
+    /// Synchronization for waiting on finished batches.
+    std::mutex batch_mutex;
+    std::condition_variable batch_cond;
+
+private:
+
+    /// Wait for a while when there is nothing to do.
+    static void backOff(std::size_t& n_idle_rounds)
+    {
+        if(++n_idle_rounds < 64) std::this_thread::yield();
+        else std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+
+    /// Process the tasks of one shard in the order of batch number.
+    void runShard(std::size_t shard)
+    {
+        UTK_TRACE_THREAD_NAME("dedup shard " + std::to_string(shard));
+        KeySetType& key_set = shard_key_sets[shard];
+        // Tasks received ahead of their turn.
+        std::map<std::size_t, ShardTask> early_tasks;
+        std::size_t next_batch_number {0}, n_idle_rounds {0};
+        ShardTask task;
+        while(!stopping.load(std::memory_order_acquire))
+        {
+            bool progressed = false;
+            for(std::size_t producer = 0; producer < n_producers; ++producer)
+            {
+                auto& task_queue = *task_queues[producer*n_shards+shard];
+                while(task_queue.tryPop(task))
+                {
+                    std::size_t batch_number = task.batch->batch_number;
+                    early_tasks.emplace(batch_number, std::move(task));
+                    progressed = true;
+                }
+            }
+            for(auto search = early_tasks.find(next_batch_number); search != early_tasks.end(); search = early_tasks.find(++next_batch_number))
+            {
+                UTK_TRACE_SCOPE("dedup");
+                Batch& batch = *search->second.batch;
+                for(const auto& item : search->second.items)
+                {
+                    batch.uniques[item.slot] = key_set.insert(*item.key).second;
+                }
+                if(batch.n_pending_shards.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    // Notify the waiting thread under lock so that the
+                    // notification cannot be lost.
+                    std::lock_guard<std::mutex> lock(batch_mutex);
+                    batch_cond.notify_all();
+                }
+                early_tasks.erase(search);
+                progressed = true;
+            }
+            if(progressed) n_idle_rounds = 0;
+            else backOff(n_idle_rounds);
+        }
+    }
+
+public:
+
+    /// \param  n_shards        Number of shards, each owned by a shard thread.
+    /// \param  n_producers     Number of threads submitting keys.
+    /// \param  queue_capacity  Capacity of each queue between a producer and a shard.
+    ShardedDedupSet(std::size_t n_shards, std::size_t n_producers, std::size_t queue_capacity=default_queue_capacity) : n_shards{n_shards}, n_producers{n_producers}, shard_key_sets(n_shards)
+    {
+        if(n_shards == 0) throw std::logic_error("Number of shards must be positive");
+        if(n_producers == 0) throw std::logic_error("Number of producers must be positive");
+        for(std::size_t n = 0; n < n_producers*n_shards; ++n)
+        {
+            task_queues.push_back(std::make_unique<utk::SPSCQueue<ShardTask>>(queue_capacity));
+        }
+        for(std::size_t shard = 0; shard < n_shards; ++shard)
+        {
+            shard_threads.emplace_back(&ShardedDedupSet::runShard, this, shard);
+        }
+    }
+
+    ShardedDedupSet(const ShardedDedupSet&) = delete;
+
+    ShardedDedupSet& operator=(const ShardedDedupSet&) = delete;
+
+    ~ShardedDedupSet()
+    {
+        stop();
+    }
+
+    /// Stop all shard threads, after which no more batch is processed.
+    void stop()
+    {
+        stopping.store(true, std::memory_order_release);
+        for(auto& shard_thread : shard_threads)
+        {
+            if(shard_thread.joinable()) shard_thread.join();
+        }
+    }
+
+    std::size_t getNumberOfShards() const
+    {
+        return n_shards;
+    }
+
+    /// Add the statistics of the key sets of all shards.
+    /// Note: this function must be called after stop().
+    void getKeySetStats(utk::HashTableStats& stats) const
+    {
+        for(const auto& key_set : shard_key_sets) stats.add(key_set);
+    }
+
+    /// Find the shard that a key is routed to.
+    std::size_t getShardIndex(const KeyType& key) const
+    {
+        return ShardHashType()(key) % n_shards;
+    }
+
+    /// Create a batch of results with the given number of key slots.
+    std::shared_ptr<Batch> makeBatch(std::size_t batch_number, std::size_t n_slots) const
+    {
+        auto batch = std::make_shared<Batch>(batch_number, n_slots);
+        batch->n_pending_shards.store(n_shards, std::memory_order_relaxed);
+        return batch;
+    }
+
+    /// \brief Submit the keys of a batch from a producer thread.
+    /// \param  producer     The index of the calling producer.
+    /// \param  batch        The batch created by makeBatch.
+    /// \param  shard_items  The items routed to each shard, in the order of
+    ///                      input within each shard.
+    /// \return False if the set is stopped before all items are submitted.
+    /// Note: the keys pointed to by the items must stay valid until the batch
+    /// is finished.
+    bool submit(std::size_t producer, const std::shared_ptr<Batch>& batch, std::vector<std::vector<Item>>& shard_items)
+    {
+        for(std::size_t shard = 0; shard < n_shards; ++shard)
+        {
+            ShardTask task {batch, std::move(shard_items[shard])};
+            auto& task_queue = *task_queues[producer*n_shards+shard];
+            for(std::size_t n_idle_rounds = 0; !task_queue.tryPush(task); backOff(n_idle_rounds))
+            {
+                if(stopping.load(std::memory_order_acquire)) return false;
+            }
+        }
+        return true;
+    }
+
+    /// Wait until all shards finish a batch.
+    /// \return False if the set is stopped before the batch is finished.
+    bool wait(const Batch& batch)
+    {
+        std::unique_lock<std::mutex> lock(batch_mutex);
+        batch_cond.wait(lock, [&]{ return batch.n_pending_shards.load(std::memory_order_acquire) == 0 || stopping.load(std::memory_order_acquire); });
+        return batch.n_pending_shards.load(std::memory_order_acquire) == 0;
+    }
+
+    /// Get the total number of distinct keys in all shards.
+    /// Note: this function must be called after stop.
+    std::size_t size() const
+    {
+        std::size_t n_keys {0};
+        for(const auto& key_set : shard_key_sets) n_keys += key_set.size();
+        return n_keys;
+    }
+};
+
+}
+
+#endif /* ShardedDedupSet_hpp */
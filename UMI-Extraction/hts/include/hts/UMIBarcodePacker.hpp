@@ -0,0 +1,69 @@
+//
+//  UMIBarcodePacker.hpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#ifndef UMIBarcodePacker_hpp
+#define UMIBarcodePacker_hpp
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace hts
+{
+
+/// \brief Pack a UMI barcode into a 2-bit encoded integer.
+/// This class converts a UMI barcode composed of A, C, G and T nucleotides
+/// into an unsigned integer using 2 bits per nucleotide (A:0, C:1, G:2, T:3),
+/// with the first nucleotide placed at the most significant position. A 10-nt
+/// UMI barcode is thus packed into the lowest 20 bits of a 32-bit integer, so
+/// that the UMI space of a gene (4^10 codes) can be addressed directly.
+///
+/// Note: a UMI barcode containing any ambiguous nucleotide (e.g. N) cannot be
+/// packed and must be handled by the caller separately.
+class UMIBarcodePacker
+{
+public:
+
+    /// Type of packed UMI barcode.
+    using CodeType = std::uint32_t;
+
+    /// Number of bits used by each nucleotide.
+    static constexpr std::size_t n_nucleotide_bits {2};
+
+    /// Maximum length of UMI barcode that can be packed.
+    static constexpr std::size_t max_umi_length {sizeof(CodeType)*8/n_nucleotide_bits};
+
+public:
+
+    UMIBarcodePacker() = delete;
+
+    /// Pack a UMI barcode into its 2-bit code.
+    /// \param[in]   umi_barcode  The UMI barcode to pack.
+    /// \param[out]  code         The packed UMI barcode.
+    /// \return      False if the UMI barcode is too long or contains any
+    ///              nucleotide other than A, C, G and T.
+    static bool pack(const std::string& umi_barcode, CodeType& code)
+    {
+        return pack(umi_barcode.data(), umi_barcode.length(), code);
+    }
+
+    /// Pack a UMI barcode stored in a character buffer into its 2-bit code.
+    static bool pack(const char* umi_barcode, std::size_t umi_length, CodeType& code);
+
+    /// Unpack a 2-bit code into a UMI barcode of given length.
+    static std::string unpack(CodeType code, std::size_t umi_length);
+
+    /// Number of bits needed by a packed UMI barcode of given length.
+    static constexpr std::size_t getNumberOfBits(std::size_t umi_length)
+    {
+        return umi_length*n_nucleotide_bits;
+    }
+};
+
+}
+
+#endif /* UMIBarcodePacker_hpp */
@@ -0,0 +1,163 @@
+//
+//  AdaptiveUMIContainer.cpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <hts/AdaptiveUMIContainer.hpp>
+
+namespace hts
+{
+
+namespace
+{
+
+/// Population count of a 64-bit word.
+inline std::size_t popCount(std::uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::size_t>(__builtin_popcountll(word));
+#else
+    std::size_t n_bits {0};
+    for(; word != 0; word &= word-1) ++n_bits;
+    return n_bits;
+#endif
+}
+
+}
+
+AdaptiveUMIContainer::AdaptiveUMIContainer(std::size_t n_code_bits, std::size_t max_array_size) : n_code_bits{n_code_bits}, n_chunk_bits{getNumberOfChunkBits(n_code_bits)}, n_chunk_words{getChunkBitmapSize(n_code_bits)/sizeof(ChunkCodeType)}, max_array_size{max_array_size}
+{
+    if(n_code_bits == 0 || n_code_bits > UMIBarcodePacker::getNumberOfBits(UMIBarcodePacker::max_umi_length) || n_code_bits > 30)
+    {
+        std::ostringstream err_msg;
+        err_msg << "The number of bits of packed UMI barcode must be between 1 and 30 for an adaptive UMI container, but " << n_code_bits << " is given!";
+        throw std::logic_error(err_msg.str());
+    }
+    // Switch a chunk to the bitmap only where its sorted array would outgrow
+    // it, which also keeps the arrays shorter than the bitmaps.
+    if(max_array_size == 0) this->max_array_size = getBreakEvenArraySize(n_code_bits);
+    else if(max_array_size > getBreakEvenArraySize(n_code_bits))
+    {
+        std::ostringstream err_msg;
+        err_msg << "The maximum array size of a chunk of adaptive UMI container must not exceed " << getBreakEvenArraySize(n_code_bits) << ", but " << max_array_size << " is given!";
+        throw std::logic_error(err_msg.str());
+    }
+}
+
+/// Convert the sorted array of a chunk to the bitmap.
+void AdaptiveUMIContainer::convertToBitmap(std::vector<ChunkCodeType>& chunk)
+{
+    std::vector<ChunkCodeType> chunk_bitmap(n_chunk_words, 0);
+    for(ChunkCodeType code : chunk) chunk_bitmap[code/n_word_bits] |= static_cast<ChunkCodeType>(1u << (code%n_word_bits));
+    // Release the memory of the sorted array.
+    chunk.swap(chunk_bitmap);
+    ++n_bitmap_chunks;
+}
+
+/// Insert a packed UMI barcode.
+bool AdaptiveUMIContainer::insert(CodeType code)
+{
+    // Find the chunk of the code, creating it as needed.
+    ChunkKeyType chunk_key = static_cast<ChunkKeyType>(code >> n_chunk_bits);
+    ChunkCodeType chunk_code = static_cast<ChunkCodeType>(code & ((CodeType(1) << n_chunk_bits) - 1));
+    auto key_it = std::lower_bound(chunk_keys.begin(), chunk_keys.end(), chunk_key);
+    auto chunk_it = chunks.begin() + (key_it - chunk_keys.begin());
+    if(key_it == chunk_keys.end() || *key_it != chunk_key)
+    {
+        chunk_keys.insert(key_it, chunk_key);
+        chunk_it = chunks.emplace(chunk_it);
+    }
+    std::vector<ChunkCodeType>& chunk = *chunk_it;
+
+    if(isChunkBitmap(chunk))
+    {
+        ChunkCodeType& word = chunk[chunk_code/n_word_bits];
+        ChunkCodeType mask = static_cast<ChunkCodeType>(1u << (chunk_code%n_word_bits));
+        if(word & mask) return false;
+        word |= mask;
+        ++n_codes;
+        return true;
+    }
+    else
+    {
+        auto it = std::lower_bound(chunk.begin(), chunk.end(), chunk_code);
+        if(it != chunk.end() && *it == chunk_code) return false;
+        chunk.insert(it, chunk_code);
+        ++n_codes;
+        // Switch to the dense layout once the sorted array takes as much
+        // memory as the bitmap.
+        if(chunk.size() >= max_array_size) convertToBitmap(chunk);
+        return true;
+    }
+}
+
+/// Check if a packed UMI barcode is contained.
+bool AdaptiveUMIContainer::contains(CodeType code) const
+{
+    ChunkKeyType chunk_key = static_cast<ChunkKeyType>(code >> n_chunk_bits);
+    ChunkCodeType chunk_code = static_cast<ChunkCodeType>(code & ((CodeType(1) << n_chunk_bits) - 1));
+    auto key_it = std::lower_bound(chunk_keys.begin(), chunk_keys.end(), chunk_key);
+    if(key_it == chunk_keys.end() || *key_it != chunk_key) return false;
+    const std::vector<ChunkCodeType>& chunk = chunks[static_cast<std::size_t>(key_it - chunk_keys.begin())];
+    if(isChunkBitmap(chunk)) return (chunk[chunk_code/n_word_bits] >> (chunk_code%n_word_bits)) & 1;
+    else return std::binary_search(chunk.begin(), chunk.end(), chunk_code);
+}
+
+/// Count the number of distinct codes.
+std::size_t AdaptiveUMIContainer::countCodes() const
+{
+    std::size_t n_counted_codes {0};
+    for(const auto& chunk : chunks)
+    {
+        if(isChunkBitmap(chunk)) for(ChunkCodeType word : chunk) n_counted_codes += popCount(word);
+        else n_counted_codes += chunk.size();
+    }
+    return n_counted_codes;
+}
+
+/// Number of bytes allocated by the container.
+std::size_t AdaptiveUMIContainer::getMemoryUsage() const
+{
+    std::size_t n_bytes = chunk_keys.capacity()*sizeof(ChunkKeyType) + chunks.capacity()*sizeof(std::vector<ChunkCodeType>);
+    for(const auto& chunk : chunks) n_bytes += chunk.capacity()*sizeof(ChunkCodeType);
+    return n_bytes;
+}
+
+/// Retrieve all codes in ascending order.
+std::vector<AdaptiveUMIContainer::CodeType> AdaptiveUMIContainer::getCodes() const
+{
+    std::vector<CodeType> codes;
+    codes.reserve(n_codes);
+    for(std::size_t i = 0; i < chunks.size(); ++i)
+    {
+        CodeType chunk_base = static_cast<CodeType>(chunk_keys[i]) << n_chunk_bits;
+        if(isChunkBitmap(chunks[i]))
+        {
+            for(std::size_t j = 0; j < chunks[i].size(); ++j)
+            {
+                for(std::uint64_t word = chunks[i][j]; word != 0; word &= word-1)
+                {
+                    codes.push_back(chunk_base | static_cast<CodeType>(j*n_word_bits + popCount((word & (~word+1)) - 1)));
+                }
+            }
+        }
+        else for(ChunkCodeType chunk_code : chunks[i]) codes.push_back(chunk_base | chunk_code);
+    }
+    return codes;
+}
+
+/// Remove all codes and return to the sparse layout.
+void AdaptiveUMIContainer::clear()
+{
+    std::vector<ChunkKeyType>().swap(chunk_keys);
+    std::vector<std::vector<ChunkCodeType>>().swap(chunks);
+    n_codes = 0;
+    n_bitmap_chunks = 0;
+}
+
+}
@@ -0,0 +1,242 @@
+//
+//  AlignmentInfoTable.cpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <utk/FileUtils.hpp>
+#include <utk/SystemProperties.hpp>
+#include <hts/AlignmentInfoTable.hpp>
+
+namespace hts
+{
+
+/// Column indexes in the order of columns added by the constructor.
+enum AlignmentInfoColumn : std::size_t { InstrumentColumn, RunColumn, FlowcellColumn, LaneColumn, TileColumn, XColumn, YColumn, WellColumn, UMIColumn, FlagColumn, RNameColumn, PosColumn, MapQColumn, GeneColumn, StatusColumn };
+
+/// Prefix of the names of scratch files.
+static const std::string scratch_file_prefix {"SAM-Alignment-Info"};
+
+/// Round an offset up to a multiple of 8 bytes.
+static std::uint64_t alignOffset(std::uint64_t offset)
+{
+    return (offset + 7) / 8 * 8;
+}
+
+/// Get the NumPy character of the byte order of the host.
+static char getByteOrderChar()
+{
+    const std::uint16_t one = 1;
+    unsigned char first_byte = 0;
+    std::memcpy(&first_byte, &one, 1);
+    return first_byte == 1 ? '<' : '>';
+}
+
+AlignmentInfoTable::AlignmentInfoTable(const std::string& table_file_path, std::size_t well_barcode_length, std::size_t umi_barcode_length) : table_file_path{table_file_path}
+{
+    columns.reserve(StatusColumn+1);
+    try
+    {
+        addColumn("instrument", 'u', 4, true);
+        addColumn("run", 'u', 4);
+        addColumn("flowcell", 'u', 4, true);
+        addColumn("lane", 'u', 2);
+        addColumn("tile", 'u', 2);
+        addColumn("x", 'u', 4);
+        addColumn("y", 'u', 4);
+        addColumn("well", 'S', well_barcode_length);
+        addColumn("umi", 'S', umi_barcode_length);
+        addColumn("flag", 'u', 2);
+        addColumn("rname", 'u', 4, true);
+        addColumn("pos", 'u', 4);
+        addColumn("mapq", 'u', 1);
+        addColumn("gene", 'u', 4, true);
+        addColumn("status", 'u', 4, true);
+    }
+    catch(...)
+    {
+        removeScratchFiles();
+        throw;
+    }
+}
+
+AlignmentInfoTable::~AlignmentInfoTable() noexcept
+{
+    removeScratchFiles();
+}
+
+/// Add a column of numbers, of fixed-width strings, or of level codes.
+void AlignmentInfoTable::addColumn(const std::string& name, char kind, std::size_t width, bool dictionary)
+{
+    Column column;
+    column.name = name;
+    column.type = (kind == 'S' || width == 1 ? '|' : getByteOrderChar()) + std::string(1, kind) + std::to_string(width);
+    column.width = width;
+    column.dictionary = dictionary;
+    column.scratch_file_path = utk::createTempFile(scratch_file_prefix);
+    columns.push_back(std::move(column));
+    Column& added_column = columns.back();
+    added_column.scratch_file.open(added_column.scratch_file_path, std::ios::binary | std::ios::trunc);
+    if(!added_column.scratch_file.is_open()) throw std::runtime_error("Failed to open scratch file " + added_column.scratch_file_path);
+}
+
+/// Append a value of fixed width to a column.
+void AlignmentInfoTable::appendValue(Column& column, const void* value)
+{
+    column.values.append(static_cast<const char*>(value), column.width);
+    if(column.values.size() >= values_buffer_size) flushValues(column);
+}
+
+/// Append a string padded with NULs to a column of fixed-width strings.
+void AlignmentInfoTable::appendString(Column& column, const std::string& value)
+{
+    if(value.size() > column.width) throw std::logic_error("The length of " + value + " exceeds the width of column " + column.name + " of alignment info table!");
+    column.values += value;
+    column.values.append(column.width-value.size(), '\0');
+    if(column.values.size() >= values_buffer_size) flushValues(column);
+}
+
+/// Append the code of a level to a dictionary-encoded column.
+void AlignmentInfoTable::appendLevel(Column& column, const std::string& value)
+{
+    auto search = column.level_codes.find(value);
+    if(search == column.level_codes.end())
+    {
+        search = column.level_codes.emplace(value, static_cast<std::uint32_t>(column.levels.size())).first;
+        column.levels.push_back(value);
+    }
+    appendNumber(column, search->second);
+}
+
+/// Write the buffered values of a column to its scratch file.
+void AlignmentInfoTable::flushValues(Column& column)
+{
+    column.scratch_file.write(column.values.data(), static_cast<std::streamsize>(column.values.size()));
+    if(!column.scratch_file) throw std::runtime_error("Failed to write scratch file " + column.scratch_file_path);
+    column.values.clear();
+}
+
+/// Remove all scratch files.
+void AlignmentInfoTable::removeScratchFiles() noexcept
+{
+    for(auto& column : columns)
+    {
+        if(column.scratch_file.is_open()) column.scratch_file.close();
+        try
+        {
+            utk::removeFile(column.scratch_file_path);
+        }
+        catch(...) {}
+    }
+    columns.clear();
+}
+
+/// Append the metadata of an alignment line as a row.
+void AlignmentInfoTable::append(const AlignmentInfo& align_info)
+{
+    if(closed) throw std::logic_error("Cannot append to a closed alignment info table!");
+    appendLevel(columns[InstrumentColumn], align_info.instrument_id);
+    appendNumber(columns[RunColumn], align_info.run_number);
+    appendLevel(columns[FlowcellColumn], align_info.flowcell_id);
+    appendNumber(columns[LaneColumn], align_info.lane_number);
+    appendNumber(columns[TileColumn], align_info.tile_number);
+    appendNumber(columns[XColumn], align_info.x_pos);
+    appendNumber(columns[YColumn], align_info.y_pos);
+    appendString(columns[WellColumn], align_info.well_barcode);
+    appendString(columns[UMIColumn], align_info.umi_barcode);
+    appendNumber(columns[FlagColumn], align_info.flag);
+    appendLevel(columns[RNameColumn], align_info.reference_name);
+    appendNumber(columns[PosColumn], align_info.position);
+    appendNumber(columns[MapQColumn], align_info.mapping_quality);
+    appendLevel(columns[GeneColumn], align_info.target_features);
+    appendLevel(columns[StatusColumn], align_info.alignment_status);
+    ++n_rows;
+}
+
+/// Write the table file and remove the scratch files.
+void AlignmentInfoTable::close()
+{
+    if(closed) return;
+    closed = true;
+
+    // Complete the scratch files.
+    for(auto& column : columns)
+    {
+        flushValues(column);
+        column.scratch_file.close();
+        if(!column.scratch_file) throw std::runtime_error("Failed to write scratch file " + column.scratch_file_path);
+    }
+
+    // Lay out the values and the levels of columns.
+    Header header;
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.format_version = format_version;
+    header.n_columns = static_cast<std::uint32_t>(columns.size());
+    header.n_rows = n_rows;
+    std::vector<ColumnEntry> column_entries(columns.size());
+    std::uint64_t offset = sizeof(Header) + columns.size()*sizeof(ColumnEntry);
+    for(std::size_t i = 0; i < columns.size(); ++i)
+    {
+        std::strncpy(column_entries[i].name, columns[i].name.c_str(), sizeof(ColumnEntry::name)-1);
+        std::strncpy(column_entries[i].type, columns[i].type.c_str(), sizeof(ColumnEntry::type)-1);
+        offset = alignOffset(offset);
+        column_entries[i].values_offset = offset;
+        offset += n_rows*columns[i].width;
+    }
+    for(std::size_t i = 0; i < columns.size(); ++i)
+    {
+        if(!columns[i].dictionary) continue;
+        column_entries[i].levels_offset = offset;
+        column_entries[i].n_levels = columns[i].levels.size();
+        for(const auto& level : columns[i].levels) column_entries[i].levels_size += level.size()+1;
+        offset += column_entries[i].levels_size;
+    }
+
+    // Write a complete file before replacing the table file, unless it is
+    // written to the standard output, which is written through std::cout
+    // instead of being reopened and truncated.
+    bool std_stream = utk::FileSystem::isStdStream(table_file_path);
+    std::string output_file_path = std_stream ? table_file_path : table_file_path + ".tmp";
+    {
+        std::ofstream output_file;
+        if(!std_stream)
+        {
+            output_file.open(output_file_path, std::ios::binary | std::ios::trunc);
+            if(!output_file.is_open()) throw std::runtime_error("Cannot open output file " + output_file_path + '!');
+        }
+        std::ostream& table_file = std_stream ? std::cout : output_file;
+        table_file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        table_file.write(reinterpret_cast<const char*>(column_entries.data()), static_cast<std::streamsize>(column_entries.size()*sizeof(ColumnEntry)));
+        std::uint64_t written_size = sizeof(Header) + column_entries.size()*sizeof(ColumnEntry);
+        for(std::size_t i = 0; i < columns.size(); ++i)
+        {
+            static const char padding[8] {};
+            table_file.write(padding, static_cast<std::streamsize>(column_entries[i].values_offset-written_size));
+            if(n_rows > 0)
+            {
+                std::ifstream scratch_file(columns[i].scratch_file_path, std::ios::binary);
+                table_file << scratch_file.rdbuf();
+            }
+            written_size = column_entries[i].values_offset + n_rows*columns[i].width;
+        }
+        for(const auto& column : columns)
+        {
+            for(const auto& level : column.levels) table_file.write(level.c_str(), static_cast<std::streamsize>(level.size()+1));
+        }
+        if(std_stream) table_file.flush();
+        else output_file.close();
+        if(!table_file)
+        {
+            if(!std_stream) utk::removeFile(output_file_path);
+            throw std::runtime_error("Failed to write alignment info table file " + output_file_path);
+        }
+    }
+    if(!std_stream) utk::renameFile(output_file_path, table_file_path);
+    removeScratchFiles();
+}
+
+}
@@ -0,0 +1,116 @@
+//
+//  DirectionalUMIClusterer.cpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#include <deque>
+#include <numeric>
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <hts/DirectionalUMIClusterer.hpp>
+
+namespace hts
+{
+
+DirectionalUMIClusterer::DirectionalUMIClusterer(std::size_t umi_length) : umi_length{umi_length}
+{
+    if(umi_length == 0 || umi_length > UMIBarcodePacker::max_umi_length)
+    {
+        std::ostringstream err_msg;
+        err_msg << "The length of UMI barcode must be between 1 and " << UMIBarcodePacker::max_umi_length << " for UMI clustering, but " << umi_length << " is given!";
+        throw std::logic_error(err_msg.str());
+    }
+}
+
+/// Check if two packed UMI barcodes differ by a single substitution.
+bool DirectionalUMIClusterer::isSingleSubstitution(CodeType code_a, CodeType code_b)
+{
+    // Fold each 2-bit group of the difference into its lower bit and check
+    // that exactly one group differs.
+    CodeType diff = code_a ^ code_b;
+    CodeType groups = (diff | (diff >> 1)) & static_cast<CodeType>(0x55555555);
+    return groups != 0 && (groups & (groups-1)) == 0;
+}
+
+/// Find the neighbors of each UMI barcode by pairwise comparison.
+void DirectionalUMIClusterer::findNeighborsPairwise(const std::vector<UMICount>& umi_counts, std::vector<std::vector<std::size_t>>& neighbors) const
+{
+    for(std::size_t a = 0; a < umi_counts.size(); ++a)
+    {
+        for(std::size_t b = 0; b < umi_counts.size(); ++b)
+        {
+            if(a != b && isSingleSubstitution(umi_counts[a].code, umi_counts[b].code)) neighbors[a].push_back(b);
+        }
+    }
+}
+
+/// Find the neighbors of each UMI barcode by probing substitution variants.
+void DirectionalUMIClusterer::findNeighborsByVariants(const std::vector<UMICount>& umi_counts, std::vector<std::vector<std::size_t>>& neighbors) const
+{
+    std::unordered_map<CodeType, std::size_t> umi_indexes;
+    umi_indexes.reserve(umi_counts.size());
+    for(std::size_t a = 0; a < umi_counts.size(); ++a) umi_indexes.emplace(umi_counts[a].code, a);
+    for(std::size_t a = 0; a < umi_counts.size(); ++a)
+    {
+        for(std::size_t pos = 0; pos < umi_length; ++pos)
+        {
+            std::size_t shift = pos*UMIBarcodePacker::n_nucleotide_bits;
+            for(CodeType subst = 1; subst < 4; ++subst)
+            {
+                if(auto search = umi_indexes.find(umi_counts[a].code ^ (subst << shift)); search != umi_indexes.end()) neighbors[a].push_back(search->second);
+            }
+        }
+    }
+}
+
+/// Cluster the distinct UMI barcodes of a gene.
+std::vector<std::size_t> DirectionalUMIClusterer::cluster(const std::vector<UMICount>& umi_counts) const
+{
+    std::size_t n_umis = umi_counts.size();
+    std::vector<std::size_t> roots(n_umis);
+    std::iota(roots.begin(), roots.end(), 0);
+    if(n_umis < 2) return roots;
+
+    // Find the UMI barcodes one substitution away from each UMI barcode.
+    std::vector<std::vector<std::size_t>> neighbors(n_umis);
+    if(n_umis <= max_pairwise_umis) findNeighborsPairwise(umi_counts, neighbors);
+    else findNeighborsByVariants(umi_counts, neighbors);
+
+    // Start clusters from the most abundant UMI barcodes, breaking ties by
+    // code so that the result doesn't depend on the input order.
+    std::vector<std::size_t> orders(n_umis);
+    std::iota(orders.begin(), orders.end(), 0);
+    std::sort(orders.begin(), orders.end(), [&](std::size_t a, std::size_t b){ return umi_counts[a].count != umi_counts[b].count ? umi_counts[a].count > umi_counts[b].count : umi_counts[a].code < umi_counts[b].code; });
+
+    // Absorb all UMI barcodes reachable through directional edges.
+    std::vector<unsigned char> clustered(n_umis, 0);
+    std::deque<std::size_t> pending;
+    for(std::size_t root : orders)
+    {
+        if(clustered[root]) continue;
+        clustered[root] = 1;
+        pending.push_back(root);
+        while(!pending.empty())
+        {
+            std::size_t a = pending.front();
+            pending.pop_front();
+            for(std::size_t b : neighbors[a])
+            {
+                if(!clustered[b] && isDirectionalEdge(umi_counts[a].count, umi_counts[b].count))
+                {
+                    clustered[b] = 1;
+                    roots[b] = root;
+                    pending.push_back(b);
+                }
+            }
+        }
+    }
+
+    return roots;
+}
+
+}
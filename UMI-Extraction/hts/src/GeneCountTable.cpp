@@ -0,0 +1,134 @@
+//
+//  GeneCountTable.cpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include <utk/LineReader.hpp>
+#include <utk/LineWriter.hpp>
+#include <utk/StringUtils.hpp>
+#include <hts/GeneCountTable.hpp>
+
+namespace hts
+{
+
+const std::array<std::string, GeneCountTable::n_annotation_columns> GeneCountTable::annotation_column_names {"Geneid", "Chr", "Start", "End", "Strand", "Length"};
+
+GeneCountTable::GeneCountTable(std::vector<std::string> sample_names) : sample_names{std::move(sample_names)} {}
+
+/// Read gene annotations from a read counts table of featureCounts.
+void GeneCountTable::readAnnotations(const std::string& counts_file_path)
+{
+    utk::LineReader counts_reader(counts_file_path, "unix");
+    bool header_found = false;
+    for(std::string line; counts_reader.readLine(line);)
+    {
+        // Skip comment lines and empty lines.
+        if(line.empty() || line.front() == '#') continue;
+        std::vector<std::string> fields = utk::splitString(line, '\t');
+        if(fields.size() < n_annotation_columns || (!header_found && !std::equal(annotation_column_names.begin(), annotation_column_names.end(), fields.begin())))
+        {
+            std::ostringstream err_msg;
+            err_msg << counts_file_path << " is not a read counts table of featureCounts!";
+            throw std::runtime_error(err_msg.str());
+        }
+        if(!header_found)
+        {
+            header_found = true;
+            continue;
+        }
+        if(gene_annotations.try_emplace(fields.front(), fields.begin()+1, fields.begin()+n_annotation_columns).second) annotated_genes.push_back(fields.front());
+    }
+    if(!header_found)
+    {
+        std::ostringstream err_msg;
+        err_msg << counts_file_path << " doesn't have a header line of featureCounts!";
+        throw std::runtime_error(err_msg.str());
+    }
+}
+
+/// Get the end of the last exon of each annotated gene on each reference
+/// sequence.
+GeneExonEnds GeneCountTable::getGeneExonEnds() const
+{
+    GeneExonEnds gene_exon_ends;
+    for(const auto& [gene, annotation] : gene_annotations)
+    {
+        // The Chr and End columns list all exons of a gene separated by ;.
+        std::vector<std::string> exon_chrs = utk::splitString(annotation[0], ';');
+        std::vector<std::string> exon_ends = utk::splitString(annotation[2], ';');
+        if(exon_chrs.size() != exon_ends.size())
+        {
+            std::ostringstream err_msg;
+            err_msg << "Gene " << gene << " has different numbers of exon chromosomes and ends!";
+            throw std::runtime_error(err_msg.str());
+        }
+        auto& chr_ends = gene_exon_ends[gene];
+        for(std::size_t i = 0; i < exon_chrs.size(); ++i)
+        {
+            std::size_t& chr_end = chr_ends[exon_chrs[i]];
+            chr_end = std::max(chr_end, utk::convert<std::size_t>(exon_ends[i]));
+        }
+    }
+    return gene_exon_ends;
+}
+
+/// Set the gene counts of a sample.
+void GeneCountTable::setSampleCounts(std::size_t sample_index, const GeneCounts& gene_counts)
+{
+    if(sample_index >= sample_names.size()) throw std::logic_error("Sample index is out of range!");
+    std::lock_guard<std::mutex> lock(table_mutex);
+    for(const auto& [gene, count] : gene_counts)
+    {
+        auto result = gene_sample_counts.try_emplace(gene, sample_names.size(), 0);
+        result.first->second[sample_index] = count;
+    }
+}
+
+/// Write the table to a file, with a comment line of the program.
+void GeneCountTable::write(const std::string& counts_file_path, const std::string& program_info) const
+{
+    std::lock_guard<std::mutex> lock(table_mutex);
+
+    // Write annotated genes first, followed by the other counted genes.
+    std::vector<std::string> genes = annotated_genes;
+    std::vector<std::string> unannotated_genes;
+    for(const auto& gene_counts : gene_sample_counts)
+    {
+        if(gene_annotations.find(gene_counts.first) == gene_annotations.end()) unannotated_genes.push_back(gene_counts.first);
+    }
+    std::sort(unannotated_genes.begin(), unannotated_genes.end());
+    genes.insert(genes.end(), unannotated_genes.begin(), unannotated_genes.end());
+
+    utk::LineWriter counts_writer(counts_file_path);
+    counts_writer.writeLine("# " + program_info);
+    std::string line;
+    for(const auto& column_name : annotation_column_names) line += (line.empty() ? "" : "\t") + column_name;
+    for(const auto& sample_name : sample_names) line += '\t' + sample_name;
+    counts_writer.writeLine(line);
+    const std::vector<std::string> empty_annotation(n_annotation_columns-1);
+    const std::vector<std::size_t> zero_counts(sample_names.size(), 0);
+    for(const auto& gene : genes)
+    {
+        line = gene;
+        auto annotation = gene_annotations.find(gene);
+        for(const auto& field : annotation != gene_annotations.end() ? annotation->second : empty_annotation) line += '\t' + field;
+        auto sample_counts = gene_sample_counts.find(gene);
+        for(std::size_t count : sample_counts != gene_sample_counts.end() ? sample_counts->second : zero_counts) line += '\t' + std::to_string(count);
+        counts_writer.writeLine(line);
+    }
+    // Most of the table is written from the buffer when closing.
+    counts_writer.close();
+    if(counts_writer.isWriteFailed())
+    {
+        std::ostringstream err_msg;
+        err_msg << "Failed to write read counts table " << counts_file_path << '!';
+        throw std::runtime_error(err_msg.str());
+    }
+}
+
+}
@@ -0,0 +1,140 @@
+//
+//  GeneUMISnapshot.cpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <utk/FileUtils.hpp>
+#include <hts/GeneUMISnapshot.hpp>
+
+namespace hts
+{
+
+/// Create an empty snapshot.
+GeneUMISnapshot::GeneUMISnapshot(std::size_t umi_length)
+{
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.format_version = format_version;
+    header.umi_length = static_cast<std::uint32_t>(umi_length);
+}
+
+/// Map a snapshot file and check its format.
+GeneUMISnapshot::GeneUMISnapshot(const std::string& snapshot_file_path) : snapshot_file{std::make_unique<utk::MappedFile>(snapshot_file_path)}
+{
+    auto throwCorrupted = [&](const std::string& reason)
+    {
+        std::ostringstream err_msg;
+        err_msg << snapshot_file_path << " is not a valid dedup snapshot file: " << reason << '!';
+        throw std::runtime_error(err_msg.str());
+    };
+
+    // Check the header.
+    const char* data = snapshot_file->getData();
+    std::size_t size = snapshot_file->getSize();
+    if(size < sizeof(Header)) throwCorrupted("too short");
+    std::memcpy(&header, data, sizeof(Header));
+    if(std::memcmp(header.magic, magic, sizeof(magic)) != 0) throwCorrupted("wrong magic bytes");
+    if(header.format_version != format_version) throwCorrupted("unsupported format version " + std::to_string(header.format_version));
+
+    // Locate the sections, checking each count against the bytes left so that no size can wrap around.
+    std::uint64_t offset = sizeof(Header);
+    auto locateSection = [&](std::uint64_t n_entries, std::uint64_t entry_size, const std::string& section_name)
+    {
+        if(n_entries > (size-offset)/entry_size) throwCorrupted(section_name + " section out of range");
+        std::uint64_t section_offset = offset;
+        offset += n_entries*entry_size;
+        return section_offset;
+    };
+    std::uint64_t genes_offset = locateSection(header.n_genes, sizeof(GeneEntry), "gene");
+    std::uint64_t keys_offset = locateSection(header.n_packed_keys, sizeof(std::uint64_t), "packed key");
+    std::uint64_t combos_offset = locateSection(header.n_unpacked_combos, sizeof(StringEntry), "gene-UMI combination");
+    std::uint64_t strings_offset = locateSection(header.strings_size, 1, "string");
+    if(offset != size) throwCorrupted("wrong file size");
+    genes = reinterpret_cast<const GeneEntry*>(data+genes_offset);
+    packed_keys = reinterpret_cast<const std::uint64_t*>(data+keys_offset);
+    unpacked_combos = reinterpret_cast<const StringEntry*>(data+combos_offset);
+    strings = data+strings_offset;
+
+    // Check the strings, whose locations are used without checking later.
+    for(std::uint64_t i = 0; i < header.n_genes; ++i)
+    {
+        if(genes[i].name_offset > header.strings_size || genes[i].name_length > header.strings_size-genes[i].name_offset) throwCorrupted("gene name out of range");
+    }
+    for(std::uint64_t i = 0; i < header.n_unpacked_combos; ++i)
+    {
+        if(unpacked_combos[i].offset > header.strings_size || unpacked_combos[i].length > header.strings_size-unpacked_combos[i].offset) throwCorrupted("gene-UMI combination out of range");
+    }
+}
+
+/// Check if a packed key is in the snapshot.
+bool GeneUMISnapshot::containsPackedKey(std::uint64_t packed_key) const
+{
+    return std::binary_search(packed_keys, packed_keys+header.n_packed_keys, packed_key);
+}
+
+/// Check if a gene-tab-UMI string is in the snapshot.
+bool GeneUMISnapshot::containsUnpackedCombination(std::string_view gene_umi_combo) const
+{
+    const StringEntry* end = unpacked_combos+header.n_unpacked_combos;
+    const StringEntry* search = std::lower_bound(unpacked_combos, end, gene_umi_combo, [this](const StringEntry& entry, std::string_view combo) { return getString(entry.offset, entry.length) < combo; });
+    return search != end && getString(search->offset, search->length) == gene_umi_combo;
+}
+
+/// Write a snapshot file.
+void GeneUMISnapshot::write(const std::string& snapshot_file_path, std::size_t umi_length, const std::vector<std::string>& gene_names, const std::vector<std::size_t>& gene_counts, const std::vector<std::uint64_t>& packed_keys, const std::vector<std::string>& unpacked_combos)
+{
+    if(gene_names.size() != gene_counts.size()) throw std::logic_error("Each gene of dedup snapshot must have a count!");
+
+    // Lay out the string section.
+    std::vector<GeneEntry> gene_entries(gene_names.size());
+    std::vector<StringEntry> combo_entries(unpacked_combos.size());
+    std::string strings;
+    for(std::size_t i = 0; i < gene_names.size(); ++i)
+    {
+        gene_entries[i].n_combos = gene_counts[i];
+        gene_entries[i].name_offset = strings.size();
+        gene_entries[i].name_length = gene_names[i].length();
+        strings += gene_names[i];
+    }
+    for(std::size_t i = 0; i < unpacked_combos.size(); ++i)
+    {
+        combo_entries[i].offset = strings.size();
+        combo_entries[i].length = unpacked_combos[i].length();
+        strings += unpacked_combos[i];
+    }
+
+    Header header;
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.format_version = format_version;
+    header.umi_length = static_cast<std::uint32_t>(umi_length);
+    header.n_genes = gene_entries.size();
+    header.n_packed_keys = packed_keys.size();
+    header.n_unpacked_combos = combo_entries.size();
+    header.strings_size = strings.size();
+
+    // Write a complete file before replacing the snapshot file.
+    std::string temp_file_path = snapshot_file_path + ".tmp";
+    {
+        std::ofstream snapshot_file(temp_file_path, std::ios::binary | std::ios::trunc);
+        snapshot_file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        snapshot_file.write(reinterpret_cast<const char*>(gene_entries.data()), static_cast<std::streamsize>(gene_entries.size()*sizeof(GeneEntry)));
+        snapshot_file.write(reinterpret_cast<const char*>(packed_keys.data()), static_cast<std::streamsize>(packed_keys.size()*sizeof(std::uint64_t)));
+        snapshot_file.write(reinterpret_cast<const char*>(combo_entries.data()), static_cast<std::streamsize>(combo_entries.size()*sizeof(StringEntry)));
+        snapshot_file.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+        snapshot_file.close();
+        if(!snapshot_file)
+        {
+            utk::removeFile(temp_file_path);
+            throw std::runtime_error("Failed to write dedup snapshot file " + temp_file_path);
+        }
+    }
+    utk::renameFile(temp_file_path, snapshot_file_path);
+}
+
+}
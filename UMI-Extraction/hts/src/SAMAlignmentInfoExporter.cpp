@@ -0,0 +1,116 @@
+//
+//  SAMAlignmentInfoExporter.cpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#include <charconv>
+#include <sstream>
+#include <stdexcept>
+#include <hts/SAMAlignmentInfoExporter.hpp>
+#include <hts/DGEIlluminaFASTQSequence.hpp>
+#include <hts/CompositedDGEIlluminaFASTQSequence.hpp>
+
+namespace hts
+{
+
+/// Split the next field separated by a character off a text.
+static std::string_view nextField(std::string_view& text, char sep)
+{
+    std::size_t end = text.find(sep);
+    std::string_view field = text.substr(0, end);
+    text.remove_prefix(end == std::string_view::npos ? text.size() : end+1);
+    return field;
+}
+
+/// Convert a whole field to an unsigned integer of a fixed width.
+template<typename T>
+static T convertField(std::string_view field, const char* field_name)
+{
+    T value = 0;
+    auto result = std::from_chars(field.data(), field.data()+field.size(), value);
+    if(field.empty() || result.ec != std::errc() || result.ptr != field.data()+field.size())
+    {
+        std::ostringstream err_msg;
+        err_msg << "Failed to convert " << field_name << " " << field << " to a " << sizeof(T)*8 << "-bit unsigned integer";
+        throw std::logic_error(err_msg.str());
+    }
+    return value;
+}
+
+SAMAlignmentInfoExporter::SAMAlignmentInfoExporter(const std::string& export_file_path) : SAMAlignmentCounterInst(), info_table(export_file_path, DGEIlluminaFASTQSequence::well_barcode_length, DGEIlluminaFASTQSequence::umi_barcode_length) {}
+
+SAMAlignmentInfoExporter::~SAMAlignmentInfoExporter() noexcept {}
+
+/// Decode the metadata of an alignment line from its raw text.
+void SAMAlignmentInfoExporter::decodeAlignmentLine(std::string_view line, AlignmentInfo& align_info)
+{
+    // Split the mandatory fields.
+    static constexpr std::size_t n_mand_fields = 11;
+    std::string_view mand_fields[n_mand_fields];
+    std::string_view rest = line;
+    std::size_t n_fields = 0;
+    while(n_fields < n_mand_fields && !rest.empty()) mand_fields[n_fields++] = nextField(rest, '\t');
+    if(n_fields != n_mand_fields) throw std::logic_error("Alignment line must have 11 mandatory fields!");
+
+    // Decode the sequence identifier of QNAME.
+    static constexpr std::size_t n_seq_id_parts = CompositedDGEIlluminaFASTQSequence::n_seq_id_parts;
+    std::string_view seq_id_parts[n_seq_id_parts];
+    std::string_view seq_id = mand_fields[0];
+    std::size_t n_parts = 0;
+    while(n_parts < n_seq_id_parts && !seq_id.empty()) seq_id_parts[n_parts++] = nextField(seq_id, ':');
+    if(n_parts != n_seq_id_parts || !seq_id.empty())
+    {
+        std::ostringstream err_msg;
+        err_msg << "Sequence Identifier line must have " << n_seq_id_parts << " elements!";
+        throw std::logic_error(err_msg.str());
+    }
+    align_info.instrument_id = seq_id_parts[0];
+    align_info.run_number = convertField<std::uint32_t>(seq_id_parts[1], "run number");
+    align_info.flowcell_id = seq_id_parts[2];
+    align_info.lane_number = convertField<std::uint16_t>(seq_id_parts[3], "lane number");
+    align_info.tile_number = convertField<std::uint16_t>(seq_id_parts[4], "tile number");
+    align_info.x_pos = convertField<std::uint32_t>(seq_id_parts[5], "X position");
+    align_info.y_pos = convertField<std::uint32_t>(seq_id_parts[6], "Y position");
+    std::string_view barcode = seq_id_parts[7];
+    if(barcode.length() != DGEIlluminaFASTQSequence::well_barcode_length+DGEIlluminaFASTQSequence::umi_barcode_length) throw std::logic_error("The length of barcode part of SeqId line of composited DGE Illumina FASTQ sequence must be the sum of the lengths of well and UMI barcodes!");
+    align_info.well_barcode = barcode.substr(DGEIlluminaFASTQSequence::well_barcode_beg_pos, DGEIlluminaFASTQSequence::well_barcode_length);
+    align_info.umi_barcode = barcode.substr(DGEIlluminaFASTQSequence::umi_barcode_beg_pos, DGEIlluminaFASTQSequence::umi_barcode_length);
+
+    // Decode the other mandatory fields.
+    align_info.flag = convertField<std::uint16_t>(mand_fields[1], "FLAG");
+    align_info.reference_name = mand_fields[2];
+    align_info.position = convertField<std::uint32_t>(mand_fields[3], "POS");
+    align_info.mapping_quality = convertField<std::uint8_t>(mand_fields[4], "MAPQ");
+
+    // Find the first XT and XS tags of the optional fields.
+    align_info.target_features.clear();
+    align_info.alignment_status.clear();
+    bool has_target_features = false, has_alignment_status = false;
+    while(!rest.empty() && !(has_target_features && has_alignment_status))
+    {
+        std::string_view opt_field = nextField(rest, '\t');
+        if(opt_field.size() < 5 || opt_field[0] != 'X' || opt_field[2] != ':' || opt_field[4] != ':') continue;
+        if(opt_field[1] == 'T' && !has_target_features)
+        {
+            align_info.target_features = opt_field.substr(5);
+            has_target_features = true;
+        }
+        else if(opt_field[1] == 'S' && !has_alignment_status)
+        {
+            align_info.alignment_status = opt_field.substr(5);
+            has_alignment_status = true;
+        }
+    }
+}
+
+/// Export the metadata of an alignment line.
+bool SAMAlignmentInfoExporter::countAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, bool& aux_count)
+{
+    AlignmentInfo align_info;
+    classifyAlignmentLine(alignment_line, align_info);
+    return countAlignmentKey(align_info, aux_count);
+}
+
+}
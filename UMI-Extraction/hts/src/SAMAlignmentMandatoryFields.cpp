@@ -308,6 +308,49 @@ void SAMAlignmentMandatoryFields::parse()
     }
 }
 
+/// Get the strand-aware 1-based 5' end of the alignment.
+long long SAMAlignmentMandatoryFields::getFivePrimePosition() const
+{
+    return getFivePrimePosition(flag, pos, cigar, qname);
+}
+
+/// Get the strand-aware 1-based 5' end of an alignment from its FLAG, POS and
+/// CIGAR.
+long long SAMAlignmentMandatoryFields::getFivePrimePosition(std::size_t flag, std::size_t pos, std::string_view cigar, std::string_view qname)
+{
+    // Sum up the reference length and the soft clips at both ends from CIGAR.
+    long long ref_length {0}, lead_clip {0}, trail_clip {0};
+    bool aligned {false};
+    for(std::size_t i = 0, n_cigar = cigar.length(); i < n_cigar && cigar != "*"; ++i)
+    {
+        long long op_length {0};
+        for(; i < n_cigar && cigar[i] >= '0' && cigar[i] <= '9'; ++i) op_length = op_length*10 + (cigar[i]-'0');
+        if(i == n_cigar)
+        {
+            std::ostringstream err_msg;
+            err_msg << qname << " has an incomplete CIGAR string " << cigar << '!';
+            throw std::logic_error(err_msg.str());
+        }
+        switch(cigar[i])
+        {
+            case 'M': case 'D': case 'N': case '=': case 'X':
+                ref_length += op_length;
+                aligned = true;
+                trail_clip = 0;
+                break;
+            case 'S':
+                if(aligned) trail_clip += op_length;
+                else lead_clip += op_length;
+                break;
+            default:
+                break;
+        }
+    }
+    long long start = static_cast<long long>(pos);
+    if((flag & 0x10) != 0) return start + (ref_length > 0 ? ref_length-1 : 0) + trail_clip;
+    else return start - lead_clip;
+}
+
 /// Auxiliary function for generating printable output string.
 std::string SAMAlignmentMandatoryFields::genOutputString() const
 {
@@ -0,0 +1,84 @@
+//
+//  SAMAlignmentPipeReport.cpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#include <fstream>
+#include <stdexcept>
+#include <utk/JSONWriter.hpp>
+#include <hts/SAMAlignmentPipeReport.hpp>
+
+namespace hts
+{
+
+/// Write the statistics of a stage as a JSON object.
+static void writeStage(utk::JSONWriter& writer, const std::string& name, const SAMAlignmentPipeStage& stage)
+{
+    writer.key(name).beginObject();
+    writer.member("threads", stage.n_threads);
+    writer.member("lines", stage.n_lines);
+    writer.member("bytes", stage.n_bytes);
+    writer.member("wall_seconds", stage.wall_seconds);
+    writer.member("cpu_seconds", stage.cpu_seconds);
+    writer.member("lines_per_second", stage.getLinesPerSecond());
+    writer.endObject();
+}
+
+/// Write the report as a JSON document to an output stream.
+void SAMAlignmentPipeReport::writeJSON(std::ostream& os) const
+{
+    utk::JSONWriter writer(os);
+    writer.beginObject();
+    writer.member("format_version", format_version);
+    writer.member("input_file", input_file_path);
+    writer.member("output_file", output_file_path);
+    writer.member("threads", n_threads);
+    writer.member("dedup_shards", n_dedup_shards);
+    writer.member("wall_seconds", wall_seconds);
+    writer.member("cpu_seconds", cpu_seconds);
+    writer.member("peak_rss_bytes", peak_rss);
+
+    writer.key("stages").beginObject();
+    writeStage(writer, "read", read_stage);
+    writeStage(writer, "parse", parse_stage);
+    writeStage(writer, "count", count_stage);
+    writeStage(writer, "write", write_stage);
+    writer.endObject();
+
+    writer.key("lines").beginObject();
+    writer.member("read", n_read_lines);
+    writer.member("write", n_write_lines);
+    writer.member("read_alignments", n_read_align_lines);
+    writer.member("read_aux_alignments", n_read_aux_align_lines);
+    writer.member("write_alignments", n_write_align_lines);
+    writer.endObject();
+
+    if(has_dedup_table)
+    {
+        writer.key("dedup_table").beginObject();
+        writer.member("entries", dedup_table.n_entries);
+        writer.member("peak_entries", dedup_table.n_peak_entries);
+        writer.member("buckets", dedup_table.n_buckets);
+        writer.member("load_factor", dedup_table.getLoadFactor());
+        writer.key("probe_length_counts").beginArray();
+        for(std::size_t n_probes : dedup_table.probe_length_counts) writer.value(n_probes);
+        writer.endArray();
+        writer.endObject();
+    }
+    else writer.key("dedup_table").beginObject().endObject();
+    writer.endObject();
+}
+
+/// Write the report as a JSON document to a file.
+void SAMAlignmentPipeReport::writeJSON(const std::string& file_path) const
+{
+    std::ofstream report_file(file_path);
+    if(!report_file.is_open()) throw std::runtime_error("Failed to open report file " + file_path);
+    writeJSON(report_file);
+    report_file.close();
+    if(!report_file) throw std::runtime_error("Failed to write report file " + file_path);
+}
+
+}
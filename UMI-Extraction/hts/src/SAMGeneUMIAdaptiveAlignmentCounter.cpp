@@ -0,0 +1,110 @@
+//
+//  SAMGeneUMIAdaptiveAlignmentCounter.cpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#include <sstream>
+#include <stdexcept>
+#include <hts/SAMGeneUMIAdaptiveAlignmentCounter.hpp>
+#include <hts/SAMGeneUMIAlignmentCounter.hpp>
+#include <hts/UMIBarcodePacker.hpp>
+
+namespace hts
+{
+
+SAMGeneUMIAdaptiveAlignmentCounter::SAMGeneUMIAdaptiveAlignmentCounter(std::size_t umi_length, std::size_t max_array_size) : SAMAlignmentCounterInst(), umi_length{umi_length}, max_array_size{max_array_size}
+{
+    // Check if the UMI barcode can be addressed by an adaptive UMI container.
+    if(umi_length == 0 || UMIBarcodePacker::getNumberOfBits(umi_length) > 30)
+    {
+        std::ostringstream err_msg;
+        err_msg << "The length of UMI barcode must be between 1 and 15 for adaptive UMI containers, but " << umi_length << " is given!";
+        throw std::logic_error(err_msg.str());
+    }
+}
+
+SAMGeneUMIAdaptiveAlignmentCounter::~SAMGeneUMIAdaptiveAlignmentCounter() noexcept {}
+
+/// Retrieve the gene index of a gene name, creating it as needed.
+std::size_t SAMGeneUMIAdaptiveAlignmentCounter::getGeneIndex(const std::string& target_gene)
+{
+    auto result = gene_indexes.try_emplace(target_gene, gene_names.size());
+    if(result.second)
+    {
+        // Add a new gene with an empty UMI container.
+        gene_names.push_back(target_gene);
+        gene_umi_sets.emplace_back(UMIBarcodePacker::getNumberOfBits(umi_length), max_array_size);
+        gene_unpacked_umi_counts.push_back(0);
+    }
+    return result.first->second;
+}
+
+/// Determine if a sequence is uniquely aligned to a gene and also tagged
+/// with distinct UMI barcode among all the sequences aligned to that gene.
+bool SAMGeneUMIAdaptiveAlignmentCounter::countAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, bool& aux_count)
+{
+    // Retrieve the gene and UMI barcode of uniquely aligned sequence.
+    if(GeneUMIKey gene_umi_key; classifyAlignmentLine(alignment_line, gene_umi_key)) return countAlignmentKey(gene_umi_key, aux_count);
+    else return false;
+}
+
+/// Determine if a classified gene-UMI combination is distinct among all
+/// the combinations counted so far.
+bool SAMGeneUMIAdaptiveAlignmentCounter::countAlignmentKey(const GeneUMIKey& gene_umi_key, bool& aux_count)
+{
+    // Initialize the status to false.
+    bool status = false;
+
+    const std::string& target_gene = gene_umi_key.target_gene;
+    const std::string& umi_barcode = gene_umi_key.umi_barcode;
+    std::size_t gene_index = getGeneIndex(target_gene);
+    if(UMIBarcodePacker::CodeType umi_code = 0; umi_barcode.length() == umi_length && UMIBarcodePacker::pack(umi_barcode, umi_code))
+    {
+        // Insert packed UMI barcode into the container of its gene.
+        status = gene_umi_sets[gene_index].insert(umi_code);
+    }
+    else
+    {
+        // Insert gene-UMI combo into the fall-back pool.
+        status = unpacked_gene_umi_pool.insert(target_gene + umi_barcode).second;
+        if(status) ++gene_unpacked_umi_counts[gene_index];
+    }
+    // Set auxiliary count to true for uniquely aligned sequence.
+    aux_count = true;
+
+    // Return eligibility status.
+    return status;
+}
+
+/// Number of unique UMI barcodes of a gene, or zero for an unknown gene.
+std::size_t SAMGeneUMIAdaptiveAlignmentCounter::getUniqueUMICount(const std::string& target_gene) const
+{
+    if(auto search = gene_indexes.find(target_gene); search != gene_indexes.end()) return getUniqueUMICount(search->second);
+    else return 0;
+}
+
+/// Add the number of unique UMI barcodes of each gene to the gene counts.
+void SAMGeneUMIAdaptiveAlignmentCounter::getGeneCounts(GeneCounts& gene_counts) const
+{
+    for(std::size_t gene_index = 0; gene_index < gene_names.size(); ++gene_index) gene_counts[gene_names[gene_index]] += getUniqueUMICount(gene_index);
+}
+
+/// Number of genes whose UMI containers use the dense bitmap layout.
+std::size_t SAMGeneUMIAdaptiveAlignmentCounter::getNumberOfBitmapGenes() const
+{
+    std::size_t n_bitmap_genes {0};
+    for(const auto& gene_umi_set : gene_umi_sets) if(gene_umi_set.isBitmap()) ++n_bitmap_genes;
+    return n_bitmap_genes;
+}
+
+/// Number of bytes allocated by all UMI containers.
+std::size_t SAMGeneUMIAdaptiveAlignmentCounter::getMemoryUsage() const
+{
+    std::size_t n_bytes {0};
+    for(const auto& gene_umi_set : gene_umi_sets) n_bytes += gene_umi_set.getMemoryUsage();
+    return n_bytes;
+}
+
+}
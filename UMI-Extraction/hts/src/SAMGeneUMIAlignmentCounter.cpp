@@ -6,24 +6,24 @@
 //  Copyright © 2018 Yuguang Xiong. All rights reserved.
 //
 
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include <charconv>
+#include <utk/StringSearch.hpp>
 #include <hts/SAMGeneUMIAlignmentCounter.hpp>
 #include <hts/CompositedDGEIlluminaFASTQSequence.hpp>
 
 namespace hts
 {
 
-SAMGeneUMIAlignmentCounter::SAMGeneUMIAlignmentCounter() : SAMAlignmentCounterInst() {}
+SAMGeneUMIAlignmentCounter::SAMGeneUMIAlignmentCounter(SortedInputMode sorted_input_mode, const GeneExonEnds* gene_exon_ends) : SAMAlignmentCounterInst(), detect_sorted_input{sorted_input_mode == SortedInputMode::Detect}, sorted_input{sorted_input_mode == SortedInputMode::Sorted}, gene_exon_ends{gene_exon_ends} {}
 
 SAMGeneUMIAlignmentCounter::~SAMGeneUMIAlignmentCounter() noexcept {}
 
-/// Determine if a sequence is uniquely aligned to a gene and also tagged
-/// with distinct UMI barcode among all the sequences aligned to that gene.
-/// An auxiliary count is used to indicate an unique alignment.
-bool SAMGeneUMIAlignmentCounter::countAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, bool& aux_count)
+/// Retrieve the gene and UMI barcode of a uniquely aligned sequence.
+bool SAMGeneUMIAlignmentCounter::getUniqueGeneUMI(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, std::string& target_gene, std::string& umi_barcode)
 {
-    // Initialize the status to false.
-    bool status = false;
-
     // Assuming the SAM file only includes uniquely aligned genes, retrieve
     // the gene and the UMI barcode.
     const auto& align_opt_fields = alignment_line.getOptionalFields();
@@ -35,27 +35,219 @@ bool SAMGeneUMIAlignmentCounter::countAlignmentLine(const SAMCompositedDGEIllumi
             if(std::vector<std::string> target_features; align_opt_fields.getTargetFeatures(target_features))
             {
                 // Get the uniquely aligned target gene.
-                const std::string& target_gene = target_features.front();
+                target_gene = std::move(target_features.front());
                 // Get UMI barcode by creating a composite DGE Illumina FASTQ sequence with
                 // the minimum overheads.
                 CompositedDGEIlluminaFASTQSequence compos_dge_seq(alignment_line.getMandatoryFields().getQName(), "", "", "", true, false);
-                std::string umi_barcode = compos_dge_seq.getUMIBarcode();
-                // Concatenate gene name and UMI barcode.
-                std::string gene_umi_combo = target_gene + umi_barcode;
-                // Insert gene-UMI combo tag into the pool.
-                auto result = gene_umi_pool.insert(gene_umi_combo);
-                // Get the status of insertion:
-                // True: the gene-UMI combo is unique and the insertion succeeds.
-                // False: the gene-UMI combo is duplicate and the insertion fails.
-                status = result.second;
-                // Set auxiliary count to true for uniquely aligned sequence.
-                aux_count = true;
+                umi_barcode = std::move(compos_dge_seq.getUMIBarcode());
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/// Check the raw text of an alignment line for a unique alignment.
+bool SAMGeneUMIAlignmentCounter::isUniqueGeneAlignmentLine(std::string_view line)
+{
+    static constexpr std::string_view xn_tag {"\tXN:"};
+    std::size_t tag_pos = utk::findLastSubstring(line, xn_tag);
+    if(tag_pos == std::string_view::npos) return false;
+    // Only reject an XN:TYPE:VALUE field whose value is an integer other
+    // than 1, and leave any other form to the parser.
+    std::size_t value_begin = tag_pos + xn_tag.size() + 2;
+    if(value_begin > line.size() || line[value_begin-1] != ':') return true;
+    std::size_t value_end = std::min(line.find('\t', value_begin), line.size());
+    std::size_t n_target_features = 0;
+    auto result = std::from_chars(line.data()+value_begin, line.data()+value_end, n_target_features);
+    if(result.ec != std::errc() || result.ptr != line.data()+value_end || n_target_features == 1) return true;
+    // The first XN tag is the one used by getUniqueGeneUMI.
+    return utk::findLastSubstring(line.substr(0, tag_pos), xn_tag) != std::string_view::npos;
+}
+
+/// Detect sorted input from the @HD header line and collect the order of
+/// reference sequences from @SQ header lines.
+bool SAMGeneUMIAlignmentCounter::countHeaderDataLine(const SAMHeaderDataLine& header_data_line, bool&)
+{
+    // Use the line string, which is available whether or not the header line
+    // is parsed.
+    const std::string& line = header_data_line.getLine();
+    if(line.compare(0, 4, "@HD\t") == 0)
+    {
+        if(detect_sorted_input && (line + '\t').find("\tSO:coordinate\t") != std::string::npos) sorted_input = true;
+    }
+    else if(line.compare(0, 4, "@SQ\t") == 0)
+    {
+        if(std::size_t name_begin = line.find("\tSN:"); name_begin != std::string::npos)
+        {
+            name_begin += 4;
+            getReferenceIndex(line.substr(name_begin, line.find('\t', name_begin)-name_begin));
+        }
+    }
+    return true;
+}
+
+/// Get the index of a reference sequence, adding it as needed.
+std::size_t SAMGeneUMIAlignmentCounter::getReferenceIndex(const std::string& reference_name)
+{
+    return reference_indexes.try_emplace(reference_name, reference_indexes.size()).first->second;
+}
+
+/// Find the locus after which a gene can be retired.
+SAMGeneUMIAlignmentCounter::RetireLocus SAMGeneUMIAlignmentCounter::getRetireLocus(const std::string& target_gene) const
+{
+    RetireLocus retire_locus;
+    retire_locus.target_gene = target_gene;
+    if(gene_exon_ends != nullptr)
+    {
+        if(auto gene_search = gene_exon_ends->find(target_gene); gene_search != gene_exon_ends->end())
+        {
+            // Take the last exon in the order of reference sequences, and keep
+            // the gene till the end if any of its reference sequences is not
+            // known yet.
+            for(const auto& [reference_name, exon_end] : gene_search->second)
+            {
+                auto ref_search = reference_indexes.find(reference_name);
+                RetireLocus exon_locus;
+                exon_locus.reference_index = ref_search != reference_indexes.end() ? ref_search->second : unknown_reference_index;
+                exon_locus.position = exon_end;
+                if(exon_locus > retire_locus)
+                {
+                    retire_locus.reference_index = exon_locus.reference_index;
+                    retire_locus.position = exon_locus.position;
+                }
             }
+            // Fall back to the end of current reference sequence if the
+            // annotations don't agree with the alignments.
+            if(retire_locus.reference_index > current_reference_index || (retire_locus.reference_index == current_reference_index && retire_locus.position >= current_position)) return retire_locus;
         }
     }
+    // Retire the gene at the end of current reference sequence.
+    retire_locus.reference_index = current_reference_index;
+    retire_locus.position = std::numeric_limits<std::size_t>::max();
+    return retire_locus;
+}
 
-    // Return eligibility status.
+/// Move the current locus of sorted input forward and retire the genes whose
+/// last exons have been passed.
+void SAMGeneUMIAlignmentCounter::advanceLocus(const std::string& reference_name, std::size_t position)
+{
+    std::size_t reference_index = getReferenceIndex(reference_name);
+    if(reference_index < current_reference_index || (reference_index == current_reference_index && position < current_position))
+    {
+        std::ostringstream err_msg;
+        err_msg << "Input SAM file is not sorted by coordinate at " << reference_name << ':' << position << '!';
+        throw std::runtime_error(err_msg.str());
+    }
+    current_reference_index = reference_index;
+    current_position = position;
+
+    // An alignment starting after the last exon of a gene can't overlap it,
+    // and nor can any later alignment.
+    while(!retire_loci.empty() && (retire_loci.top().reference_index < reference_index || (retire_loci.top().reference_index == reference_index && retire_loci.top().position < position)))
+    {
+        const std::string& target_gene = retire_loci.top().target_gene;
+        if(auto search = active_gene_umis.find(target_gene); search != active_gene_umis.end())
+        {
+            n_active_combos -= search->second.size();
+            active_gene_umis.erase(search);
+            retired_genes.insert(target_gene);
+        }
+        retire_loci.pop();
+    }
+}
+
+/// Count a gene-UMI combination of sorted input.
+bool SAMGeneUMIAlignmentCounter::countSortedAlignmentKey(const GeneUMILocusKey& gene_umi_key)
+{
+    advanceLocus(gene_umi_key.reference_name, gene_umi_key.position);
+    auto gene_result = active_gene_umis.try_emplace(gene_umi_key.target_gene);
+    if(gene_result.second)
+    {
+        // A retired gene has released its UMI barcodes, which can't be told
+        // apart from the UMI barcodes aligned to it again.
+        if(retired_genes.count(gene_umi_key.target_gene) > 0)
+        {
+            active_gene_umis.erase(gene_result.first);
+            std::ostringstream err_msg;
+            err_msg << "Gene " << gene_umi_key.target_gene << " is aligned again at " << gene_umi_key.reference_name << ':' << gene_umi_key.position << " after being retired in sorted input, which needs the last exons of genes or to be counted as unsorted input!";
+            throw std::runtime_error(err_msg.str());
+        }
+        // Schedule the retirement of a newly active gene.
+        retire_loci.push(getRetireLocus(gene_umi_key.target_gene));
+    }
+    bool status = gene_result.first->second.insert(gene_umi_key.umi_barcode).second;
+    if(status)
+    {
+        ++gene_umi_counts[gene_umi_key.target_gene];
+        max_active_combos = std::max(max_active_combos, ++n_active_combos);
+    }
     return status;
 }
 
+/// Determine if a sequence is uniquely aligned to a gene and also tagged
+/// with distinct UMI barcode among all the sequences aligned to that gene.
+/// An auxiliary count is used to indicate an unique alignment.
+bool SAMGeneUMIAlignmentCounter::countAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, bool& aux_count)
+{
+    // Retrieve the gene and UMI barcode of uniquely aligned sequence.
+    if(GeneUMILocusKey gene_umi_key; classifyAlignmentLine(alignment_line, gene_umi_key)) return countAlignmentKey(gene_umi_key, aux_count);
+    else return false;
+}
+
+/// Determine if a classified gene-UMI combination is distinct among all
+/// the combinations counted so far.
+bool SAMGeneUMIAlignmentCounter::countAlignmentKey(const GeneUMILocusKey& gene_umi_key, bool& aux_count)
+{
+    // Set auxiliary count to true for uniquely aligned sequence.
+    aux_count = true;
+    // Keep the gene-UMI combinations of active genes only for sorted input.
+    if(sorted_input) return countSortedAlignmentKey(gene_umi_key);
+
+    // Concatenate gene name and UMI barcode.
+    std::string gene_umi_combo = gene_umi_key.target_gene + gene_umi_key.umi_barcode;
+    // Insert gene-UMI combo tag into the pool.
+    auto result = gene_umi_pool.insert(std::move(gene_umi_combo));
+    if(result.second)
+    {
+        ++gene_umi_counts[gene_umi_key.target_gene];
+        // Track the strings too long for the small string buffer.
+        if(std::size_t capacity = result.first->capacity(); capacity > std::string().capacity()) n_pool_string_bytes += capacity+1;
+    }
+    // Get the status of insertion:
+    // True: the gene-UMI combo is unique and the insertion succeeds.
+    // False: the gene-UMI combo is duplicate and the insertion fails.
+    return result.second;
+}
+
+/// Add the number of unique gene-UMI combinations of each gene to the gene
+/// counts.
+void SAMGeneUMIAlignmentCounter::getGeneCounts(GeneCounts& gene_counts) const
+{
+    for(const auto& [target_gene, n_umis] : gene_umi_counts) gene_counts[target_gene] += n_umis;
+}
+
+/// Add the statistics of the gene-UMI pool, or of the UMI barcodes of active
+/// genes in sorted input.
+void SAMGeneUMIAlignmentCounter::getDedupTableStats(utk::HashTableStats& stats) const
+{
+    if(sorted_input)
+    {
+        for(const auto& [target_gene, umi_barcodes] : active_gene_umis) stats.add(umi_barcodes);
+        stats.n_peak_entries = std::max(stats.n_peak_entries, max_active_combos);
+    }
+    else stats.add(gene_umi_pool);
+}
+
+/// Estimated memory in bytes of the gene-UMI pool, or of the UMI barcodes of
+/// active genes in sorted input.
+std::size_t SAMGeneUMIAlignmentCounter::getMemoryUsage() const
+{
+    // Each entry of a hash set takes a node with the string, a link, and a
+    // cached hash value, and each bucket takes a pointer.
+    constexpr std::size_t n_node_bytes = sizeof(std::string) + 2*sizeof(void*);
+    if(sorted_input) return n_active_combos*(n_node_bytes+sizeof(void*)) + active_gene_umis.size()*(sizeof(std::string)+sizeof(std::unordered_set<std::string>)+2*sizeof(void*));
+    return gene_umi_pool.size()*n_node_bytes + gene_umi_pool.bucket_count()*sizeof(void*) + n_pool_string_bytes;
+}
+
 }
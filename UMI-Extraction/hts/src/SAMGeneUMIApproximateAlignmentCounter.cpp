@@ -0,0 +1,144 @@
+//
+//  SAMGeneUMIApproximateAlignmentCounter.cpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#include <cmath>
+#include <algorithm>
+#include <sstream>
+#include <functional>
+#include <stdexcept>
+#include <hts/SAMGeneUMIApproximateAlignmentCounter.hpp>
+
+namespace hts
+{
+
+SAMGeneUMIApproximateAlignmentCounter::SAMGeneUMIApproximateAlignmentCounter(std::size_t n_expected_combos, double false_positive_rate, unsigned sketch_precision, std::size_t umi_length) : SAMAlignmentCounterInst(), umi_length{umi_length}, sketch_precision{sketch_precision}, gene_umi_filter(n_expected_combos, false_positive_rate)
+{
+    // Check if the UMI barcode can be packed.
+    if(umi_length == 0 || umi_length > UMIBarcodePacker::max_umi_length)
+    {
+        std::ostringstream err_msg;
+        err_msg << "The length of UMI barcode must be between 1 and " << UMIBarcodePacker::max_umi_length << " for packed keys, but " << umi_length << " is given!";
+        throw std::logic_error(err_msg.str());
+    }
+    // Check the precision of sketches.
+    if(sketch_precision < utk::HyperLogLog::min_precision || sketch_precision > utk::HyperLogLog::max_precision)
+    {
+        std::ostringstream err_msg;
+        err_msg << "The precision of HyperLogLog sketches must be between " << utk::HyperLogLog::min_precision << " and " << utk::HyperLogLog::max_precision << ", but " << sketch_precision << " is given!";
+        throw std::logic_error(err_msg.str());
+    }
+    // Keep the hash values of a gene exactly until they would outgrow a
+    // sketch.
+    max_sketch_hashes = std::max<std::size_t>((std::size_t(1) << sketch_precision) / sizeof(std::uint64_t), 1);
+}
+
+SAMGeneUMIApproximateAlignmentCounter::~SAMGeneUMIApproximateAlignmentCounter() noexcept {}
+
+/// Retrieve the gene index of a gene name, creating it as needed.
+std::uint32_t SAMGeneUMIApproximateAlignmentCounter::getGeneIndex(const std::string& target_gene)
+{
+    auto result = gene_indexes.try_emplace(target_gene, static_cast<std::uint32_t>(gene_indexes.size()));
+    if(result.second) gene_umi_sketches.emplace_back();
+    return result.first->second;
+}
+
+/// Hash a gene-UMI combination into a well mixed 64-bit value.
+std::uint64_t SAMGeneUMIApproximateAlignmentCounter::hashKey(std::uint32_t gene_index, const std::string& umi_barcode) const
+{
+    // Pack the gene index in the upper 31 bits, a flag of unpacked UMI barcode
+    // in the next bit, and the packed or hashed UMI barcode in the lower 32
+    // bits, so that packed combinations have distinct hash values.
+    std::uint64_t key = static_cast<std::uint64_t>(gene_index) << 33;
+    if(UMIBarcodePacker::CodeType umi_code = 0; umi_barcode.length() == umi_length && UMIBarcodePacker::pack(umi_barcode, umi_code)) key |= umi_code;
+    else key |= (std::uint64_t(1) << 32) | static_cast<std::uint32_t>(std::hash<std::string>()(umi_barcode));
+    return utk::BlockedBloomFilter::mixHash(key);
+}
+
+/// Insert the hash value of a gene-UMI combination into the hash values of its
+/// gene.
+void SAMGeneUMIApproximateAlignmentCounter::insertGeneHash(GeneUMISketch& gene_umi_sketch, std::uint64_t hash)
+{
+    if(gene_umi_sketch.sketch) gene_umi_sketch.sketch->insert(hash);
+    else
+    {
+        auto it = std::lower_bound(gene_umi_sketch.hashes.begin(), gene_umi_sketch.hashes.end(), hash);
+        if(it != gene_umi_sketch.hashes.end() && *it == hash) return;
+        if(gene_umi_sketch.hashes.size() < max_sketch_hashes) gene_umi_sketch.hashes.insert(it, hash);
+        else
+        {
+            // Switch to a sketch once the array takes as much memory as it.
+            gene_umi_sketch.sketch.emplace(sketch_precision);
+            for(std::uint64_t gene_hash : gene_umi_sketch.hashes) gene_umi_sketch.sketch->insert(gene_hash);
+            gene_umi_sketch.sketch->insert(hash);
+            std::vector<std::uint64_t>().swap(gene_umi_sketch.hashes);
+            ++n_sketch_genes;
+        }
+    }
+}
+
+/// Determine if a sequence is uniquely aligned to a gene and also tagged
+/// with distinct UMI barcode among all the sequences aligned to that gene.
+bool SAMGeneUMIApproximateAlignmentCounter::countAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, bool& aux_count)
+{
+    // Retrieve the gene and UMI barcode of uniquely aligned sequence.
+    if(GeneUMIKey gene_umi_key; classifyAlignmentLine(alignment_line, gene_umi_key)) return countAlignmentKey(gene_umi_key, aux_count);
+    else return false;
+}
+
+/// Determine if a classified gene-UMI combination is distinct among all the
+/// combinations counted so far.
+bool SAMGeneUMIApproximateAlignmentCounter::countAlignmentKey(const GeneUMIKey& gene_umi_key, bool& aux_count)
+{
+    std::uint32_t gene_index = getGeneIndex(gene_umi_key.target_gene);
+    std::uint64_t hash = hashKey(gene_index, gene_umi_key.umi_barcode);
+    insertGeneHash(gene_umi_sketches[gene_index], hash);
+
+    // Take the false positive rate before inserting the combination.
+    double false_positive_rate = gene_umi_filter.getFalsePositiveRate();
+    bool status = gene_umi_filter.insert(hash);
+    if(status)
+    {
+        // Each combination regarded as distinct stands for 1/(1-p) distinct
+        // combinations, of which p/(1-p) are falsely regarded as duplicates.
+        n_distinct_combos++;
+        n_est_collisions += false_positive_rate/(1-false_positive_rate);
+    }
+    // Set auxiliary count to true for uniquely aligned sequence.
+    aux_count = true;
+
+    return status;
+}
+
+/// Add the estimated number of distinct gene-UMI combinations of each gene to
+/// the gene counts.
+void SAMGeneUMIApproximateAlignmentCounter::getGeneCounts(GeneCounts& gene_counts) const
+{
+    for(const auto& [target_gene, gene_index] : gene_indexes)
+    {
+        const GeneUMISketch& gene_umi_sketch = gene_umi_sketches[gene_index];
+        gene_counts[target_gene] += gene_umi_sketch.sketch ? static_cast<std::size_t>(std::llround(gene_umi_sketch.sketch->estimate())) : gene_umi_sketch.hashes.size();
+    }
+}
+
+/// Estimated fraction of distinct gene-UMI combinations falsely regarded as
+/// duplicates.
+double SAMGeneUMIApproximateAlignmentCounter::getEstimatedCollisionRate() const
+{
+    double n_est_combos = static_cast<double>(n_distinct_combos) + n_est_collisions;
+    return n_est_combos > 0 ? n_est_collisions/n_est_combos : 0;
+}
+
+/// Memory used by the Bloom filter, the hash values and the HyperLogLog
+/// sketches of genes in bytes.
+std::size_t SAMGeneUMIApproximateAlignmentCounter::getMemoryUsage() const
+{
+    std::size_t n_bytes = gene_umi_filter.getMemoryUsage();
+    for(const auto& gene_umi_sketch : gene_umi_sketches) n_bytes += gene_umi_sketch.hashes.capacity()*sizeof(std::uint64_t) + (gene_umi_sketch.sketch ? gene_umi_sketch.sketch->getMemoryUsage() : 0);
+    return n_bytes;
+}
+
+}
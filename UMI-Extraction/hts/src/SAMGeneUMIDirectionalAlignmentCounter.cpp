@@ -0,0 +1,132 @@
+//
+//  SAMGeneUMIDirectionalAlignmentCounter.cpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#include <sstream>
+#include <stdexcept>
+#include <hts/SAMGeneUMIDirectionalAlignmentCounter.hpp>
+
+namespace hts
+{
+
+SAMGeneUMIDirectionalAlignmentCounter::SAMGeneUMIDirectionalAlignmentCounter(std::size_t umi_length) : SAMAlignmentCounterInst(), umi_length{umi_length}
+{
+    // Check if the UMI barcode can be packed.
+    if(umi_length == 0 || umi_length > UMIBarcodePacker::max_umi_length)
+    {
+        std::ostringstream err_msg;
+        err_msg << "The length of UMI barcode must be between 1 and " << UMIBarcodePacker::max_umi_length << " for UMI error correction, but " << umi_length << " is given!";
+        throw std::logic_error(err_msg.str());
+    }
+}
+
+SAMGeneUMIDirectionalAlignmentCounter::~SAMGeneUMIDirectionalAlignmentCounter() noexcept {}
+
+/// Retrieve the gene index of a gene name, creating it as needed.
+std::size_t SAMGeneUMIDirectionalAlignmentCounter::getGeneIndex(const std::string& target_gene)
+{
+    auto result = gene_indexes.try_emplace(target_gene, gene_names.size());
+    if(result.second)
+    {
+        gene_names.push_back(target_gene);
+        gene_umi_records.emplace_back();
+        gene_molecule_counts.push_back(0);
+    }
+    return result.first->second;
+}
+
+/// Determine if a sequence is a candidate for output.
+bool SAMGeneUMIDirectionalAlignmentCounter::countAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, bool& aux_count)
+{
+    // Retrieve the gene and UMI barcode of uniquely aligned sequence.
+    if(GeneUMIKey gene_umi_key; classifyAlignmentLine(alignment_line, gene_umi_key)) return countAlignmentKey(gene_umi_key, aux_count);
+    else return false;
+}
+
+/// Count a classified gene-UMI combination and determine if it is a
+/// candidate for output.
+bool SAMGeneUMIDirectionalAlignmentCounter::countAlignmentKey(const GeneUMIKey& gene_umi_key, bool& aux_count)
+{
+    // Initialize the status to false.
+    bool status = false;
+
+    const std::string& target_gene = gene_umi_key.target_gene;
+    const std::string& umi_barcode = gene_umi_key.umi_barcode;
+    std::size_t gene_index = getGeneIndex(target_gene);
+    if(CodeType umi_code = 0; umi_barcode.length() == umi_length && UMIBarcodePacker::pack(umi_barcode, umi_code))
+    {
+        // Count packed UMI barcode and select its first alignment.
+        auto result = gene_umi_records[gene_index].try_emplace(umi_code, UMIRecord{0, n_candidates});
+        result.first->second.count++;
+        status = result.second;
+    }
+    else
+    {
+        // Select the first alignment of unpacked gene-UMI combo.
+        status = unpacked_gene_umi_lines.try_emplace(target_gene + umi_barcode, n_candidates).second;
+        // Unpacked UMI barcodes are never merged.
+        if(status) gene_molecule_counts[gene_index]++;
+    }
+    if(status) n_candidates++;
+    // Set auxiliary count to true for uniquely aligned sequence.
+    aux_count = true;
+
+    // Return eligibility status.
+    return status;
+}
+
+/// Cluster the UMI barcodes of all genes and select the lines to write.
+std::vector<unsigned char> SAMGeneUMIDirectionalAlignmentCounter::selectDeferredLines()
+{
+    if(deferred_lines.size() != n_candidates)
+    {
+        std::ostringstream err_msg;
+        err_msg << "The number of deferred alignment lines " << deferred_lines.size() << " doesn't match with the number of candidates " << n_candidates << '!';
+        throw std::logic_error(err_msg.str());
+    }
+
+    // Select the candidates of unpacked gene-UMI combos.
+    std::vector<unsigned char> selected(n_candidates, 0);
+    for(const auto& [gene_umi_combo, line_index] : unpacked_gene_umi_lines) selected[line_index] = 1;
+    n_clusters = unpacked_gene_umi_lines.size();
+
+    // Select the candidates of the root UMI barcodes of each gene.
+    DirectionalUMIClusterer umi_clusterer(umi_length);
+    std::vector<DirectionalUMIClusterer::UMICount> umi_counts;
+    std::vector<std::size_t> line_indexes;
+    for(std::size_t gene_index = 0; gene_index < gene_umi_records.size(); ++gene_index)
+    {
+        const auto& umi_records = gene_umi_records[gene_index];
+        umi_counts.clear();
+        line_indexes.clear();
+        for(const auto& [umi_code, umi_record] : umi_records)
+        {
+            umi_counts.push_back({umi_code, umi_record.count});
+            line_indexes.push_back(umi_record.line_index);
+        }
+        std::vector<std::size_t> roots = umi_clusterer.cluster(umi_counts);
+        for(std::size_t i = 0; i < roots.size(); ++i)
+        {
+            if(roots[i] == i)
+            {
+                selected[line_indexes[i]] = 1;
+                gene_molecule_counts[gene_index]++;
+                n_clusters++;
+            }
+        }
+    }
+
+    return selected;
+}
+
+/// Add the number of molecules of each gene after error correction to the
+/// gene counts.
+void SAMGeneUMIDirectionalAlignmentCounter::getGeneCounts(GeneCounts& gene_counts) const
+{
+    for(std::size_t gene_index = 0; gene_index < gene_names.size(); ++gene_index) gene_counts[gene_names[gene_index]] += gene_molecule_counts[gene_index];
+}
+
+}
@@ -0,0 +1,334 @@
+//
+//  SAMGeneUMIExternalAlignmentCounter.cpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#include <fstream>
+#include <sstream>
+#include <queue>
+#include <algorithm>
+#include <stdexcept>
+#include <utk/FileUtils.hpp>
+#include <hts/SAMGeneUMIExternalAlignmentCounter.hpp>
+
+namespace hts
+{
+
+/// Sequential reader of a scratch file of sorted values.
+template<typename T>
+class RunFileReader
+{
+private:
+
+    std::ifstream run_file;
+    std::vector<T> buffer;
+    std::size_t n_buffered {0};
+    std::size_t pos {0};
+
+public:
+
+    explicit RunFileReader(const std::string& run_file_path, std::size_t buffer_size=8192) : run_file(run_file_path, std::ios::binary), buffer(buffer_size)
+    {
+        if(!run_file.is_open()) throw std::runtime_error("Failed to open scratch file " + run_file_path);
+    }
+
+    /// Read the next value.
+    /// \return  False if there is no more value.
+    bool read(T& value)
+    {
+        if(pos == n_buffered)
+        {
+            run_file.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()*sizeof(T)));
+            n_buffered = static_cast<std::size_t>(run_file.gcount()) / sizeof(T);
+            pos = 0;
+            if(n_buffered == 0) return false;
+        }
+        value = buffer[pos++];
+        return true;
+    }
+};
+
+namespace
+{
+
+/// Prefix of the names of scratch files.
+const std::string scratch_file_prefix {"SAM-Alignment-Counter"};
+
+/// Write sorted values to a new scratch file.
+template<typename T>
+std::string writeRunFile(const std::vector<T>& values)
+{
+    std::string run_file_path = utk::createTempFile(scratch_file_prefix);
+    std::ofstream run_file(run_file_path, std::ios::binary | std::ios::trunc);
+    run_file.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size()*sizeof(T)));
+    run_file.close();
+    if(!run_file)
+    {
+        utk::removeFile(run_file_path);
+        throw std::runtime_error("Failed to write scratch file " + run_file_path);
+    }
+    return run_file_path;
+}
+
+/// Merge scratch files of sorted values in a k-way merge, and pass all the
+/// values to emit in ascending order.
+template<typename T, typename Emit>
+void mergeRunFiles(const std::vector<std::string>& run_file_paths, Emit emit)
+{
+    std::vector<RunFileReader<T>> run_readers;
+    run_readers.reserve(run_file_paths.size());
+    for(const auto& run_file_path : run_file_paths) run_readers.emplace_back(run_file_path);
+
+    // Keep the head value of each run in a min-heap.
+    using HeadValue = std::pair<T, std::size_t>;
+    auto greater = [](const HeadValue& a, const HeadValue& b){ return b.first < a.first; };
+    std::priority_queue<HeadValue, std::vector<HeadValue>, decltype(greater)> heads(greater);
+    for(std::size_t i = 0; i < run_readers.size(); ++i)
+    {
+        if(T value; run_readers[i].read(value)) heads.push({value, i});
+    }
+    while(!heads.empty())
+    {
+        auto [value, i] = heads.top();
+        heads.pop();
+        emit(value);
+        if(run_readers[i].read(value)) heads.push({value, i});
+    }
+}
+
+/// Merge groups of at most max_merge_runs scratch files of sorted values
+/// until there are at most max_runs files, keeping only the values accepted
+/// by keep.
+template<typename T, typename Keep>
+void reduceRunFiles(std::vector<std::string>& run_file_paths, std::size_t max_runs, std::size_t max_buffer_size, Keep keep)
+{
+    const std::size_t max_merge_runs = SAMGeneUMIExternalAlignmentCounter::max_merge_runs;
+    while(run_file_paths.size() > max_runs)
+    {
+        std::vector<std::string> merged_file_paths;
+        for(std::size_t i = 0; i < run_file_paths.size(); i += max_merge_runs)
+        {
+            std::vector<std::string> group(run_file_paths.begin()+i, run_file_paths.begin()+std::min(i+max_merge_runs, run_file_paths.size()));
+            std::string merged_file_path = utk::createTempFile(scratch_file_prefix);
+            merged_file_paths.push_back(merged_file_path);
+            std::ofstream merged_file(merged_file_path, std::ios::binary | std::ios::trunc);
+            std::vector<T> buffer;
+            buffer.reserve(max_buffer_size);
+            bool has_last = false;
+            T last_value {};
+            mergeRunFiles<T>(group, [&](const T& value)
+            {
+                if(keep(value, has_last ? &last_value : nullptr))
+                {
+                    buffer.push_back(value);
+                    if(buffer.size() == max_buffer_size)
+                    {
+                        merged_file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()*sizeof(T)));
+                        buffer.clear();
+                    }
+                }
+                last_value = value;
+                has_last = true;
+            });
+            merged_file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()*sizeof(T)));
+            merged_file.close();
+            if(!merged_file) throw std::runtime_error("Failed to write scratch file " + merged_file_path);
+            for(const auto& run_file_path : group) utk::removeFile(run_file_path);
+        }
+        run_file_paths = std::move(merged_file_paths);
+    }
+}
+
+/// Keep the first record, i.e. the smallest ordinal, of each key.
+bool isFirstKeyRecord(const SAMGeneUMIExternalAlignmentCounter::KeyRecord& record, const SAMGeneUMIExternalAlignmentCounter::KeyRecord* last_record)
+{
+    return last_record == nullptr || last_record->key != record.key;
+}
+
+/// Keep all ordinals.
+bool isAnyOrdinal(const std::uint64_t&, const std::uint64_t*)
+{
+    return true;
+}
+
+}
+
+SAMGeneUMIExternalAlignmentCounter::SAMGeneUMIExternalAlignmentCounter(std::size_t memory_budget, std::size_t umi_length) : SAMAlignmentCounterInst(), memory_budget{memory_budget}, umi_length{umi_length}
+{
+    if(memory_budget == 0) throw std::logic_error("The memory budget of external gene-UMI counter must be greater than zero!");
+    // Check if the UMI barcode can be packed.
+    if(umi_length == 0 || umi_length > UMIBarcodePacker::max_umi_length)
+    {
+        std::ostringstream err_msg;
+        err_msg << "The length of UMI barcode must be between 1 and " << UMIBarcodePacker::max_umi_length << " for packed keys, but " << umi_length << " is given!";
+        throw std::logic_error(err_msg.str());
+    }
+    candidate_file_path = utk::createTempFile(scratch_file_prefix);
+    candidate_writer = utk::LineWriter(candidate_file_path);
+}
+
+SAMGeneUMIExternalAlignmentCounter::~SAMGeneUMIExternalAlignmentCounter() noexcept
+{
+    removeScratchFiles();
+}
+
+/// Remove all scratch files.
+void SAMGeneUMIExternalAlignmentCounter::removeScratchFiles()
+{
+    if(candidate_writer.is_open()) candidate_writer.close();
+    kept_ordinal_reader.reset();
+    for(const auto& run_file_path : run_file_paths) utk::removeFile(run_file_path);
+    run_file_paths.clear();
+    if(!candidate_file_path.empty()) utk::removeFile(candidate_file_path);
+    if(!kept_ordinal_file_path.empty()) utk::removeFile(kept_ordinal_file_path);
+}
+
+/// Retrieve the gene index of a gene name, creating it as needed.
+std::uint32_t SAMGeneUMIExternalAlignmentCounter::getGeneIndex(const std::string& target_gene)
+{
+    auto result = gene_indexes.try_emplace(target_gene, static_cast<std::uint32_t>(gene_names.size()));
+    if(result.second)
+    {
+        gene_names.push_back(target_gene);
+        gene_umi_counts.push_back(0);
+    }
+    return result.first->second;
+}
+
+/// Pack a gene-UMI combination into a 64-bit key, with the gene index in the
+/// upper 31 bits, a flag of unpacked UMI barcode in the next bit, and the
+/// packed UMI barcode or the index of unpacked UMI barcode in the lower 32 bits.
+std::uint64_t SAMGeneUMIExternalAlignmentCounter::packKey(const GeneUMIKey& gene_umi_key)
+{
+    std::uint64_t key = static_cast<std::uint64_t>(getGeneIndex(gene_umi_key.target_gene)) << 33;
+    const std::string& umi_barcode = gene_umi_key.umi_barcode;
+    if(UMIBarcodePacker::CodeType umi_code = 0; umi_barcode.length() == umi_length && UMIBarcodePacker::pack(umi_barcode, umi_code)) key |= umi_code;
+    else key |= (std::uint64_t(1) << 32) | unpacked_umi_indexes.try_emplace(umi_barcode, static_cast<std::uint32_t>(unpacked_umi_indexes.size())).first->second;
+    return key;
+}
+
+/// Estimate the memory used by the in-memory run.
+std::size_t SAMGeneUMIExternalAlignmentCounter::getRunMemoryUsage() const
+{
+    // Each node holds a key-ordinal pair and a next pointer, plus the heap
+    // allocation overhead, and each bucket holds a pointer.
+    return run_keys.size()*(sizeof(KeyRecord)+2*sizeof(void*)) + run_keys.bucket_count()*sizeof(void*);
+}
+
+/// Sort the in-memory run by key and spill it to a scratch file.
+void SAMGeneUMIExternalAlignmentCounter::spillRun()
+{
+    std::vector<KeyRecord> records;
+    records.reserve(run_keys.size());
+    for(const auto& [key, ordinal] : run_keys) records.push_back({key, ordinal});
+    // Release the memory of the run before sorting its records.
+    std::unordered_map<std::uint64_t, std::uint64_t>().swap(run_keys);
+    std::sort(records.begin(), records.end());
+    run_file_paths.push_back(writeRunFile(records));
+    n_spilled_runs++;
+}
+
+/// Determine if a sequence is a candidate for output.
+bool SAMGeneUMIExternalAlignmentCounter::countAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, bool& aux_count)
+{
+    // Retrieve the gene and UMI barcode of uniquely aligned sequence.
+    if(GeneUMIKey gene_umi_key; classifyAlignmentLine(alignment_line, gene_umi_key)) return countAlignmentKey(gene_umi_key, aux_count);
+    else return false;
+}
+
+/// Count a classified gene-UMI combination and determine if it is a
+/// candidate for output.
+bool SAMGeneUMIExternalAlignmentCounter::countAlignmentKey(const GeneUMIKey& gene_umi_key, bool& aux_count)
+{
+    // Select the first occurrence of the key in the in-memory run.
+    bool status = run_keys.try_emplace(packKey(gene_umi_key), n_candidates).second;
+    if(status)
+    {
+        n_candidates++;
+        if(getRunMemoryUsage() > memory_budget) spillRun();
+    }
+    // Set auxiliary count to true for uniquely aligned sequence.
+    aux_count = true;
+
+    // Return eligibility status.
+    return status;
+}
+
+/// Find the ordinals of the first occurrences of all keys.
+void SAMGeneUMIExternalAlignmentCounter::selectCandidates()
+{
+    candidate_writer.close();
+    if(candidate_writer.isWriteFailed()) throw std::runtime_error("Failed to write scratch file " + candidate_file_path);
+
+    kept_ordinals.clear();
+    n_read_kept_ordinals = 0;
+    if(run_file_paths.empty())
+    {
+        // All candidates are first occurrences if nothing has been spilled.
+        kept_ordinals.reserve(run_keys.size());
+        for(const auto& [key, ordinal] : run_keys)
+        {
+            kept_ordinals.push_back(ordinal);
+            gene_umi_counts[key >> 33]++;
+        }
+        std::unordered_map<std::uint64_t, std::uint64_t>().swap(run_keys);
+        std::sort(kept_ordinals.begin(), kept_ordinals.end());
+        return;
+    }
+
+    // Spill the last run and merge all runs by key.
+    if(!run_keys.empty()) spillRun();
+    std::size_t max_records = std::max<std::size_t>(memory_budget/sizeof(KeyRecord), 1);
+    reduceRunFiles<KeyRecord>(run_file_paths, max_merge_runs, max_records, isFirstKeyRecord);
+    std::size_t max_ordinals = std::max<std::size_t>(memory_budget/sizeof(std::uint64_t), 1);
+    std::vector<std::string> ordinal_file_paths;
+    bool has_last = false;
+    KeyRecord last_record;
+    mergeRunFiles<KeyRecord>(run_file_paths, [&](const KeyRecord& record)
+    {
+        if(isFirstKeyRecord(record, has_last ? &last_record : nullptr))
+        {
+            kept_ordinals.push_back(record.ordinal);
+            gene_umi_counts[record.key >> 33]++;
+            if(kept_ordinals.size() == max_ordinals)
+            {
+                std::sort(kept_ordinals.begin(), kept_ordinals.end());
+                ordinal_file_paths.push_back(writeRunFile(kept_ordinals));
+                kept_ordinals.clear();
+            }
+        }
+        last_record = record;
+        has_last = true;
+    });
+    for(const auto& run_file_path : run_file_paths) utk::removeFile(run_file_path);
+    run_file_paths.clear();
+    std::sort(kept_ordinals.begin(), kept_ordinals.end());
+    if(ordinal_file_paths.empty()) return;
+
+    // Merge the sorted runs of ordinals into one scratch file.
+    if(!kept_ordinals.empty()) ordinal_file_paths.push_back(writeRunFile(kept_ordinals));
+    std::vector<std::uint64_t>().swap(kept_ordinals);
+    reduceRunFiles<std::uint64_t>(ordinal_file_paths, 1, max_ordinals, isAnyOrdinal);
+    kept_ordinal_file_path = ordinal_file_paths.front();
+    kept_ordinal_reader = std::make_unique<RunFileReader<std::uint64_t>>(kept_ordinal_file_path);
+}
+
+/// Get the next ordinal of the first occurrences in ascending order.
+bool SAMGeneUMIExternalAlignmentCounter::nextKeptOrdinal(std::uint64_t& ordinal)
+{
+    if(kept_ordinal_reader) return kept_ordinal_reader->read(ordinal);
+    if(n_read_kept_ordinals == kept_ordinals.size()) return false;
+    ordinal = kept_ordinals[n_read_kept_ordinals++];
+    return true;
+}
+
+/// Add the number of unique gene-UMI combinations of each gene to the gene
+/// counts.
+void SAMGeneUMIExternalAlignmentCounter::getGeneCounts(GeneCounts& gene_counts) const
+{
+    for(std::size_t gene_index = 0; gene_index < gene_names.size(); ++gene_index) gene_counts[gene_names[gene_index]] += gene_umi_counts[gene_index];
+}
+
+}
@@ -0,0 +1,132 @@
+//
+//  SAMGeneUMIIncrementalAlignmentCounter.cpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#include <sstream>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <utk/FileUtils.hpp>
+#include <hts/SAMGeneUMIIncrementalAlignmentCounter.hpp>
+
+namespace hts
+{
+
+SAMGeneUMIIncrementalAlignmentCounter::SAMGeneUMIIncrementalAlignmentCounter(const std::string& snapshot_file_path, std::size_t umi_length) : SAMAlignmentCounterInst(), umi_length{umi_length}, snapshot{utk::isFileReadable(snapshot_file_path) ? GeneUMISnapshot(snapshot_file_path) : GeneUMISnapshot(umi_length)}
+{
+    // Check if the UMI barcode can be packed.
+    if(umi_length == 0 || umi_length > UMIBarcodePacker::max_umi_length)
+    {
+        std::ostringstream err_msg;
+        err_msg << "The length of UMI barcode must be between 1 and " << UMIBarcodePacker::max_umi_length << " for packed keys, but " << umi_length << " is given!";
+        throw std::logic_error(err_msg.str());
+    }
+    // Packed keys of a snapshot are only comparable with the same UMI length.
+    if(snapshot.getUMILength() != umi_length)
+    {
+        std::ostringstream err_msg;
+        err_msg << "The length of UMI barcode of dedup snapshot " << snapshot_file_path << " is " << snapshot.getUMILength() << ", but " << umi_length << " is given!";
+        throw std::runtime_error(err_msg.str());
+    }
+
+    // Start with the genes of snapshot so that its packed keys stay valid.
+    gene_names.reserve(snapshot.getNumberOfGenes());
+    gene_combo_counts.reserve(snapshot.getNumberOfGenes());
+    for(std::size_t i = 0; i < snapshot.getNumberOfGenes(); ++i)
+    {
+        gene_names.emplace_back(snapshot.getGeneName(i));
+        gene_combo_counts.push_back(snapshot.getGeneCount(i));
+        gene_indexes.emplace(gene_names.back(), static_cast<std::uint32_t>(i));
+    }
+}
+
+SAMGeneUMIIncrementalAlignmentCounter::~SAMGeneUMIIncrementalAlignmentCounter() noexcept {}
+
+/// Retrieve the gene index of a gene name, creating it as needed.
+std::uint32_t SAMGeneUMIIncrementalAlignmentCounter::getGeneIndex(const std::string& target_gene)
+{
+    auto result = gene_indexes.try_emplace(target_gene, static_cast<std::uint32_t>(gene_names.size()));
+    if(result.second)
+    {
+        gene_names.push_back(target_gene);
+        gene_combo_counts.push_back(0);
+    }
+    return result.first->second;
+}
+
+/// Determine if a sequence is uniquely aligned to a gene and also tagged
+/// with a UMI barcode that is new to that gene in all runs.
+bool SAMGeneUMIIncrementalAlignmentCounter::countAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, bool& aux_count)
+{
+    // Retrieve the gene and UMI barcode of uniquely aligned sequence.
+    if(GeneUMIKey gene_umi_key; classifyAlignmentLine(alignment_line, gene_umi_key)) return countAlignmentKey(gene_umi_key, aux_count);
+    else return false;
+}
+
+/// Determine if a classified gene-UMI combination is new among all the
+/// combinations of earlier runs and of the current run so far.
+bool SAMGeneUMIIncrementalAlignmentCounter::countAlignmentKey(const GeneUMIKey& gene_umi_key, bool& aux_count)
+{
+    std::uint32_t gene_index = getGeneIndex(gene_umi_key.target_gene);
+    bool in_snapshot = false;
+    bool status = false;
+    if(UMIBarcodePacker::CodeType umi_code = 0; gene_umi_key.umi_barcode.length() == umi_length && UMIBarcodePacker::pack(gene_umi_key.umi_barcode, umi_code))
+    {
+        std::uint64_t packed_key = (static_cast<std::uint64_t>(gene_index) << 32) | umi_code;
+        in_snapshot = snapshot.containsPackedKey(packed_key);
+        if(!in_snapshot) status = new_packed_keys.insert(packed_key).second;
+    }
+    else
+    {
+        std::string gene_umi_combo = gene_umi_key.target_gene + '\t' + gene_umi_key.umi_barcode;
+        in_snapshot = snapshot.containsUnpackedCombination(gene_umi_combo);
+        if(!in_snapshot) status = new_unpacked_combos.insert(std::move(gene_umi_combo)).second;
+    }
+    if(in_snapshot) n_snapshot_duplicates++;
+    if(status) gene_combo_counts[gene_index]++;
+    // Set auxiliary count to true for uniquely aligned sequence.
+    aux_count = true;
+
+    return status;
+}
+
+/// Write the gene-UMI combinations of earlier runs and the current run to a
+/// dedup snapshot file.
+void SAMGeneUMIIncrementalAlignmentCounter::writeSnapshot(const std::string& snapshot_file_path) const
+{
+    // Merge the sorted packed keys of snapshot with the new ones.
+    std::vector<std::uint64_t> sorted_new_keys(new_packed_keys.begin(), new_packed_keys.end());
+    std::sort(sorted_new_keys.begin(), sorted_new_keys.end());
+    std::vector<std::uint64_t> packed_keys;
+    packed_keys.reserve(snapshot.getNumberOfPackedKeys() + sorted_new_keys.size());
+    std::merge(snapshot.getPackedKeys(), snapshot.getPackedKeys() + snapshot.getNumberOfPackedKeys(), sorted_new_keys.begin(), sorted_new_keys.end(), std::back_inserter(packed_keys));
+
+    // Merge the sorted gene-tab-UMI strings likewise.
+    std::vector<std::string> sorted_new_combos(new_unpacked_combos.begin(), new_unpacked_combos.end());
+    std::sort(sorted_new_combos.begin(), sorted_new_combos.end());
+    std::vector<std::string> unpacked_combos;
+    unpacked_combos.reserve(snapshot.getNumberOfUnpackedCombinations() + sorted_new_combos.size());
+    auto new_combo = sorted_new_combos.begin();
+    for(std::size_t i = 0; i < snapshot.getNumberOfUnpackedCombinations(); ++i)
+    {
+        std::string_view old_combo = snapshot.getUnpackedCombination(i);
+        for(; new_combo != sorted_new_combos.end() && *new_combo < old_combo; ++new_combo) unpacked_combos.push_back(std::move(*new_combo));
+        unpacked_combos.emplace_back(old_combo);
+    }
+    std::move(new_combo, sorted_new_combos.end(), std::back_inserter(unpacked_combos));
+
+    GeneUMISnapshot::write(snapshot_file_path, umi_length, gene_names, gene_combo_counts, packed_keys, unpacked_combos);
+}
+
+/// Add the number of unique gene-UMI combinations of each gene in all runs
+/// to the gene counts.
+void SAMGeneUMIIncrementalAlignmentCounter::getGeneCounts(GeneCounts& gene_counts) const
+{
+    for(std::size_t i = 0; i < gene_names.size(); ++i) gene_counts[gene_names[i]] += gene_combo_counts[i];
+}
+
+}
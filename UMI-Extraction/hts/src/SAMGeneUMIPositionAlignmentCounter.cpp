@@ -0,0 +1,144 @@
+//
+//  SAMGeneUMIPositionAlignmentCounter.cpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#include <sstream>
+#include <stdexcept>
+#include <charconv>
+#include <string_view>
+#include <hts/SAMGeneUMIPositionAlignmentCounter.hpp>
+
+namespace hts
+{
+
+SAMGeneUMIPositionAlignmentCounter::SAMGeneUMIPositionAlignmentCounter(std::size_t position_window, std::size_t umi_length) : SAMAlignmentCounterInst(), position_window{position_window}, umi_length{umi_length}
+{
+    if(position_window == 0) throw std::logic_error("The window of 5' end must have at least 1 base!");
+    // Check if the UMI barcode can be packed.
+    if(umi_length == 0 || umi_length > UMIBarcodePacker::max_umi_length)
+    {
+        std::ostringstream err_msg;
+        err_msg << "The length of UMI barcode must be between 1 and " << UMIBarcodePacker::max_umi_length << " for composite keys, but " << umi_length << " is given!";
+        throw std::logic_error(err_msg.str());
+    }
+}
+
+SAMGeneUMIPositionAlignmentCounter::~SAMGeneUMIPositionAlignmentCounter() noexcept {}
+
+/// Retrieve the gene index of a gene name, creating it as needed.
+std::uint32_t SAMGeneUMIPositionAlignmentCounter::getGeneIndex(const std::string& target_gene)
+{
+    auto result = gene_indexes.try_emplace(target_gene, static_cast<std::uint32_t>(gene_indexes.size()));
+    if(result.second) gene_combo_counts.push_back(0);
+    return result.first->second;
+}
+
+/// Get the index of the window that a 5' end falls into.
+long long SAMGeneUMIPositionAlignmentCounter::getWindowIndex(long long five_prime_pos) const
+{
+    // Round down for 5' ends before the start of reference.
+    long long window = static_cast<long long>(position_window);
+    return five_prime_pos >= 0 ? five_prime_pos/window : -((-five_prime_pos+window-1)/window);
+}
+
+/// Get the strand and the 5' end of an alignment from the raw text of its
+/// FLAG, POS and CIGAR columns.
+void SAMGeneUMIPositionAlignmentCounter::getStrandFivePrimePosition(std::string_view line, bool& reverse_strand, long long& five_prime_pos)
+{
+    // Take the first 6 tab-separated columns: QNAME, FLAG, RNAME, POS, MAPQ,
+    // and CIGAR.
+    std::string_view columns[6];
+    std::size_t column_begin = 0;
+    for(std::size_t i = 0; i < 6; ++i)
+    {
+        std::size_t column_end = line.find('\t', column_begin);
+        if(column_end == std::string_view::npos)
+        {
+            if(i < 5) throw std::logic_error("Alignment line has fewer than 6 mandatory fields!");
+            column_end = line.size();
+        }
+        columns[i] = line.substr(column_begin, column_end-column_begin);
+        column_begin = column_end + 1;
+    }
+    auto toNumber = [](std::string_view column, const char* field_name)
+    {
+        std::size_t value {0};
+        auto result = std::from_chars(column.data(), column.data()+column.size(), value);
+        if(result.ec != std::errc() || result.ptr != column.data()+column.size())
+        {
+            std::ostringstream err_msg;
+            err_msg << "Failed to convert " << field_name << " to std::size_t type!";
+            throw std::logic_error(err_msg.str());
+        }
+        return value;
+    };
+    std::size_t flag = toNumber(columns[1], "FLAG");
+    reverse_strand = (flag & 0x10) != 0;
+    five_prime_pos = SAMAlignmentMandatoryFields::getFivePrimePosition(flag, toNumber(columns[3], "POS"), columns[5], columns[0]);
+}
+
+/// Classify an alignment line by its gene-UMI-position combination.
+bool SAMGeneUMIPositionAlignmentCounter::classifyAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, GeneUMIPositionKey& gene_umi_pos_key) const
+{
+    if(SAMGeneUMIAlignmentCounter::getUniqueGeneUMI(alignment_line, gene_umi_pos_key.target_gene, gene_umi_pos_key.umi_barcode))
+    {
+        // The mandatory fields don't need to be parsed for the position.
+        getStrandFivePrimePosition(alignment_line.getLine(), gene_umi_pos_key.reverse_strand, gene_umi_pos_key.five_prime_pos);
+        return true;
+    }
+    else return false;
+}
+
+/// Determine if a sequence is uniquely aligned to a gene and also distinct
+/// in UMI barcode, strand and 5' end among all the sequences aligned to that
+/// gene.
+bool SAMGeneUMIPositionAlignmentCounter::countAlignmentLine(const SAMCompositedDGEIlluminaSTARFeatureCountsAlignmentLine& alignment_line, bool& aux_count)
+{
+    // Retrieve the gene, UMI barcode and position of uniquely aligned sequence.
+    if(GeneUMIPositionKey gene_umi_pos_key; classifyAlignmentLine(alignment_line, gene_umi_pos_key)) return countAlignmentKey(gene_umi_pos_key, aux_count);
+    else return false;
+}
+
+/// Determine if a classified gene-UMI-position combination is distinct among
+/// all the combinations counted so far.
+bool SAMGeneUMIPositionAlignmentCounter::countAlignmentKey(const GeneUMIPositionKey& gene_umi_pos_key, bool& aux_count)
+{
+    // Initialize the status to false.
+    bool status = false;
+
+    std::uint32_t gene_index = getGeneIndex(gene_umi_pos_key.target_gene);
+    long long window_index = getWindowIndex(gene_umi_pos_key.five_prime_pos);
+    if(UMIBarcodePacker::CodeType umi_code = 0; gene_umi_pos_key.umi_barcode.length() == umi_length && UMIBarcodePacker::pack(gene_umi_pos_key.umi_barcode, umi_code))
+    {
+        // Insert composite key into the pool.
+        PackedKey packed_key;
+        packed_key.gene_umi = (static_cast<std::uint64_t>(gene_index) << 32) | umi_code;
+        packed_key.strand_window = (static_cast<std::uint64_t>(gene_umi_pos_key.reverse_strand) << 63) | (static_cast<std::uint64_t>(window_index) & ~(std::uint64_t(1) << 63));
+        status = gene_umi_pos_pool.insert(packed_key).second;
+    }
+    else
+    {
+        // Insert concatenated gene-UMI-position combo into the fall-back pool.
+        std::ostringstream gene_umi_pos_combo;
+        gene_umi_pos_combo << gene_umi_pos_key.target_gene << '\t' << gene_umi_pos_key.umi_barcode << '\t' << (gene_umi_pos_key.reverse_strand ? '-' : '+') << window_index;
+        status = unpacked_gene_umi_pos_pool.insert(gene_umi_pos_combo.str()).second;
+    }
+    if(status) gene_combo_counts[gene_index]++;
+    // Set auxiliary count to true for uniquely aligned sequence.
+    aux_count = true;
+
+    // Return eligibility status.
+    return status;
+}
+
+/// Add the number of unique gene-UMI-position combinations of each gene to
+/// the gene counts.
+void SAMGeneUMIPositionAlignmentCounter::getGeneCounts(GeneCounts& gene_counts) const
+{
+    for(const auto& [target_gene, gene_index] : gene_indexes) gene_counts[target_gene] += gene_combo_counts[gene_index];
+}
+
+}
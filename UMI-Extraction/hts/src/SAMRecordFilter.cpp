@@ -0,0 +1,280 @@
+//
+//  SAMRecordFilter.cpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#include <cctype>
+#include <charconv>
+#include <sstream>
+#include <stdexcept>
+#include <hts/SAMRecordFilter.hpp>
+
+namespace hts
+{
+
+/// Names of the mandatory fields in the order of columns.
+static const std::string_view mand_field_names[] {"QNAME", "FLAG", "RNAME", "POS", "MAPQ", "CIGAR", "RNEXT", "PNEXT", "TLEN", "SEQ", "QUAL"};
+
+/// Number of mandatory fields.
+static constexpr std::size_t n_mand_fields {sizeof(mand_field_names)/sizeof(mand_field_names[0])};
+
+/// Find the start of a column of a tab-separated line, or npos if the line
+/// has fewer columns.
+static std::size_t findColumn(std::string_view line, std::size_t column)
+{
+    std::size_t start = 0;
+    for(std::size_t i = 0; i < column; ++i)
+    {
+        std::size_t tab = line.find('\t', start);
+        if(tab == std::string_view::npos) return std::string_view::npos;
+        start = tab + 1;
+    }
+    return start;
+}
+
+/// Parse a whole field as an integer.
+static bool parseInteger(std::string_view value, long long& number)
+{
+    auto result = std::from_chars(value.data(), value.data()+value.size(), number);
+    return result.ec == std::errc() && result.ptr == value.data()+value.size();
+}
+
+SAMRecordFilter::SAMRecordFilter(const std::string& expression) : expression{expression}
+{
+    compile();
+}
+
+/// Throw an error of the filter expression at the current position.
+void SAMRecordFilter::throwError(const std::string& message) const
+{
+    std::ostringstream err_msg;
+    err_msg << "Invalid filter expression \"" << expression << "\" at position " << pos+1 << ": " << message;
+    throw std::logic_error(err_msg.str());
+}
+
+/// Skip white spaces and check if the next token starts with a string.
+bool SAMRecordFilter::peekToken(std::string_view token)
+{
+    while(pos < expression.size() && std::isspace(static_cast<unsigned char>(expression[pos]))) ++pos;
+    return std::string_view(expression).substr(pos, token.size()) == token;
+}
+
+/// Compile the filter expression into the program.
+void SAMRecordFilter::compile()
+{
+    pos = 0;
+    // An empty expression passes all lines.
+    if(peekToken("") && pos == expression.size()) return;
+    compileOr();
+    if(peekToken("") && pos < expression.size()) throwError("unexpected character");
+}
+
+/// Compile an expression of alternatives joined by ||.
+void SAMRecordFilter::compileOr()
+{
+    std::vector<std::size_t> jumps;
+    compileAnd();
+    while(peekToken("||"))
+    {
+        pos += 2;
+        // Skip the remaining alternatives once one of them is true.
+        jumps.push_back(program.size());
+        program.push_back({OpCode::JumpIfTrue, 0});
+        compileAnd();
+    }
+    for(std::size_t jump : jumps) program[jump].operand = program.size();
+}
+
+/// Compile an expression of conditions joined by &&.
+void SAMRecordFilter::compileAnd()
+{
+    std::vector<std::size_t> jumps;
+    compileUnary();
+    while(peekToken("&&"))
+    {
+        pos += 2;
+        // Skip the remaining conditions once one of them is false.
+        jumps.push_back(program.size());
+        program.push_back({OpCode::JumpIfFalse, 0});
+        compileUnary();
+    }
+    for(std::size_t jump : jumps) program[jump].operand = program.size();
+}
+
+/// Compile a negated, parenthesized, or test expression.
+void SAMRecordFilter::compileUnary()
+{
+    if(peekToken("!") && !peekToken("!="))
+    {
+        ++pos;
+        compileUnary();
+        program.push_back({OpCode::Not, 0});
+    }
+    else if(peekToken("("))
+    {
+        ++pos;
+        compileOr();
+        if(!peekToken(")")) throwError("missing )");
+        ++pos;
+    }
+    else compileTest();
+}
+
+/// Compile a test of a field.
+void SAMRecordFilter::compileTest()
+{
+    Test test;
+
+    // Read the name of field.
+    peekToken("");
+    std::size_t name_start = pos;
+    while(pos < expression.size() && std::isalnum(static_cast<unsigned char>(expression[pos]))) ++pos;
+    std::string_view name = std::string_view(expression).substr(name_start, pos-name_start);
+    if(name.empty()) throwError("missing field");
+    test.column = n_mand_fields;
+    for(std::size_t i = 0; i < n_mand_fields; ++i)
+    {
+        if(name == mand_field_names[i]) test.column = i;
+    }
+    if(test.column == n_mand_fields)
+    {
+        if(name.size() != 2 || !std::isalpha(static_cast<unsigned char>(name[0]))) throwError("unknown field " + std::string(name));
+        test.tag[0] = name[0];
+        test.tag[1] = name[1];
+    }
+
+    // Read the comparison.
+    static const std::pair<std::string_view, Comparison> comparisons[] {{"==", Comparison::Equal}, {"!=", Comparison::NotEqual}, {"<=", Comparison::LessEqual}, {">=", Comparison::GreaterEqual}, {"<", Comparison::Less}, {">", Comparison::Greater}};
+    bool compared = false;
+    for(const auto& comparison : comparisons)
+    {
+        if(peekToken(comparison.first))
+        {
+            test.comparison = comparison.second;
+            pos += comparison.first.size();
+            compared = true;
+            break;
+        }
+    }
+    if(!compared && peekToken("&") && !peekToken("&&"))
+    {
+        test.comparison = Comparison::AnyBits;
+        ++pos;
+        compared = true;
+    }
+    if(!compared)
+    {
+        // A bare tag tests for the presence of the tag.
+        if(test.column < n_mand_fields) throwError("missing comparison of " + std::string(name));
+        test.comparison = Comparison::Present;
+        tests.push_back(std::move(test));
+        program.push_back({OpCode::Test, tests.size()-1});
+        return;
+    }
+
+    // Read the literal.
+    if(peekToken("\""))
+    {
+        if(test.comparison == Comparison::AnyBits) throwError("bits must be an integer");
+        test.string_literal = true;
+        for(++pos; pos < expression.size() && expression[pos] != '"'; ++pos)
+        {
+            if(expression[pos] == '\\' && pos+1 < expression.size()) ++pos;
+            test.text += expression[pos];
+        }
+        if(pos == expression.size()) throwError("missing closing quote");
+        ++pos;
+    }
+    else
+    {
+        std::size_t literal_start = pos;
+        if(pos < expression.size() && (expression[pos] == '-' || expression[pos] == '+')) ++pos;
+        int base = 10;
+        if(expression.compare(pos, 2, "0x") == 0 || expression.compare(pos, 2, "0X") == 0)
+        {
+            base = 16;
+            pos += 2;
+        }
+        std::size_t digits_start = pos;
+        while(pos < expression.size() && std::isxdigit(static_cast<unsigned char>(expression[pos]))) ++pos;
+        auto result = std::from_chars(expression.data()+digits_start, expression.data()+pos, test.number, base);
+        if(pos == digits_start || result.ec != std::errc() || result.ptr != expression.data()+pos)
+        {
+            pos = literal_start;
+            throwError("invalid literal");
+        }
+        if(expression[literal_start] == '-') test.number = -test.number;
+    }
+    tests.push_back(std::move(test));
+    program.push_back({OpCode::Test, tests.size()-1});
+}
+
+/// Evaluate a test on the raw text of an alignment line.
+bool SAMRecordFilter::evaluateTest(const Test& test, std::string_view line)
+{
+    // Locate the value of the field.
+    std::string_view value;
+    std::size_t start = findColumn(line, test.column);
+    if(start == std::string_view::npos) return false;
+    if(test.column < n_mand_fields)
+    {
+        value = line.substr(start, line.find('\t', start)-start);
+    }
+    else
+    {
+        // Search the optional fields for TAG:TYPE:VALUE.
+        for(;;)
+        {
+            std::size_t end = line.find('\t', start);
+            std::string_view field = line.substr(start, end-start);
+            if(field.size() >= 5 && field[0] == test.tag[0] && field[1] == test.tag[1] && field[2] == ':' && field[4] == ':')
+            {
+                value = field.substr(5);
+                break;
+            }
+            if(end == std::string_view::npos) return false;
+            start = end + 1;
+        }
+        if(test.comparison == Comparison::Present) return true;
+    }
+
+    // Compare the value with the literal.
+    int order = 0;
+    long long number = 0;
+    if(test.string_literal) order = value.compare(test.text);
+    else if(!parseInteger(value, number)) return false;
+    else if(test.comparison == Comparison::AnyBits) return (number & test.number) != 0;
+    else order = number < test.number ? -1 : (number > test.number ? 1 : 0);
+    switch(test.comparison)
+    {
+        case Comparison::Equal: return order == 0;
+        case Comparison::NotEqual: return order != 0;
+        case Comparison::Less: return order < 0;
+        case Comparison::LessEqual: return order <= 0;
+        case Comparison::Greater: return order > 0;
+        case Comparison::GreaterEqual: return order >= 0;
+        default: return false;
+    }
+}
+
+/// Check if the raw text of an alignment line satisfies the filter expression.
+bool SAMRecordFilter::filterRawAlignmentLine(std::string_view line) const
+{
+    bool status = true;
+    for(std::size_t i = 0; i < program.size();)
+    {
+        const Instruction& instruction = program[i];
+        switch(instruction.opcode)
+        {
+            case OpCode::Test: status = evaluateTest(tests[instruction.operand], line); ++i; break;
+            case OpCode::Not: status = !status; ++i; break;
+            case OpCode::JumpIfFalse: i = status ? i+1 : instruction.operand; break;
+            case OpCode::JumpIfTrue: i = status ? instruction.operand : i+1; break;
+        }
+    }
+    return status;
+}
+
+}
@@ -0,0 +1,138 @@
+//
+//  UMIBarcodePacker.cpp
+//  High-Throughput-Sequencing
+//
+//  Created on 10/18/26.
+//
+
+#include <array>
+#include <utk/CPUFeatures.hpp>
+#ifdef UTK_SIMD_DISPATCH
+#include <immintrin.h>
+#endif
+#include <hts/UMIBarcodePacker.hpp>
+
+namespace hts
+{
+
+namespace
+{
+
+/// Lookup table from nucleotide character to 2-bit code, where 4 marks an
+/// ambiguous nucleotide. Both upper and lower cases are accepted.
+constexpr std::array<unsigned char, 256> makeNucleotideCodes()
+{
+    std::array<unsigned char, 256> codes {};
+    for(auto& code : codes) code = 4;
+    codes['A'] = 0; codes['a'] = 0;
+    codes['C'] = 1; codes['c'] = 1;
+    codes['G'] = 2; codes['g'] = 2;
+    codes['T'] = 3; codes['t'] = 3;
+    return codes;
+}
+
+constexpr std::array<unsigned char, 256> nucleotide_codes = makeNucleotideCodes();
+
+constexpr char nucleotide_chars[] = {'A', 'C', 'G', 'T'};
+
+using CodeType = UMIBarcodePacker::CodeType;
+
+using PackFunction = bool (*)(const char*, std::size_t, CodeType&);
+
+/// Pack a UMI barcode by looking up the code of each nucleotide.
+bool packBaseline(const char* umi_barcode, std::size_t umi_length, CodeType& code)
+{
+    if(umi_length > UMIBarcodePacker::max_umi_length) return false;
+    CodeType packed {0};
+    // Merge the codes of all nucleotides and check ambiguity only once at the
+    // end to keep the loop free of branches.
+    unsigned char ambiguous {0};
+    for(std::size_t i = 0; i < umi_length; ++i)
+    {
+        unsigned char nt_code = nucleotide_codes[static_cast<unsigned char>(umi_barcode[i])];
+        ambiguous |= nt_code;
+        packed = (packed << UMIBarcodePacker::n_nucleotide_bits) | (nt_code & 3);
+    }
+    if(ambiguous & 4) return false;
+    code = packed;
+    return true;
+}
+
+#ifdef UTK_SIMD_DISPATCH
+
+/// \brief Validate and pack a UMI barcode of up to 16 nucleotides at once.
+/// The nucleotides beyond the UMI barcode must be A, whose code is 0.
+/// The 2-bit code of A, C, G and T in either case is ((c>>1)^(c>>2))&3, and
+/// the codes are merged by multiply-adds into a byte of each 4 nucleotides.
+UTK_TARGET_AVX512 inline bool packBlock(__m128i chars, std::size_t umi_length, CodeType& code)
+{
+    // Check that the UMI barcode only has A, C, G and T in either case.
+    const __m128i upper_chars = _mm_and_si128(chars, _mm_set1_epi8(static_cast<char>(0xdf)));
+    __m128i valid = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(upper_chars, _mm_set1_epi8('A')), _mm_cmpeq_epi8(upper_chars, _mm_set1_epi8('C'))), _mm_or_si128(_mm_cmpeq_epi8(upper_chars, _mm_set1_epi8('G')), _mm_cmpeq_epi8(upper_chars, _mm_set1_epi8('T'))));
+    const unsigned length_mask = (1u << umi_length) - 1;
+    if((static_cast<unsigned>(_mm_movemask_epi8(valid)) & length_mask) != length_mask) return false;
+    // The bits shifted in from the next byte are masked out.
+    __m128i nt_codes = _mm_and_si128(_mm_xor_si128(_mm_srli_epi16(chars, 1), _mm_srli_epi16(chars, 2)), _mm_set1_epi8(3));
+    __m128i pair_codes = _mm_maddubs_epi16(nt_codes, _mm_set1_epi16(0x0104));
+    __m128i quad_codes = _mm_madd_epi16(pair_codes, _mm_set1_epi32(0x00010010));
+    // Place the code of the first 4 nucleotides in the most significant byte.
+    __m128i packed = _mm_shuffle_epi8(quad_codes, _mm_setr_epi8(12, 8, 4, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1));
+    code = static_cast<CodeType>(_mm_cvtsi128_si32(packed)) >> (2*(16-umi_length));
+    return true;
+}
+
+/// Pack a UMI barcode loaded into a block padded with A by a masked load,
+/// which doesn't touch the memory beyond the UMI barcode.
+UTK_TARGET_AVX512 bool packAVX512(const char* umi_barcode, std::size_t umi_length, CodeType& code)
+{
+    if(umi_length > UMIBarcodePacker::max_umi_length) return false;
+    if(umi_length == 0)
+    {
+        code = 0;
+        return true;
+    }
+    __mmask16 length_mask = static_cast<__mmask16>((1u << umi_length) - 1);
+    return packBlock(_mm_mask_loadu_epi8(_mm_set1_epi8('A'), length_mask, umi_barcode), umi_length, code);
+}
+
+#endif
+
+/// Select the implementation of pack for the running CPU. Below AVX-512, the
+/// UMI barcode must be copied into a padded block, which is slower than the
+/// lookup table, so that only the masked load of AVX-512 is used.
+PackFunction selectPack()
+{
+#ifdef UTK_SIMD_DISPATCH
+    switch(utk::getSIMDLevel())
+    {
+        case utk::SIMDLevel::avx512: return packAVX512;
+        default: break;
+    }
+#endif
+    return packBaseline;
+}
+
+/// Implementation selected at startup.
+const PackFunction pack_umi_barcode = selectPack();
+
+}
+
+/// Pack a UMI barcode stored in a character buffer into its 2-bit code.
+bool UMIBarcodePacker::pack(const char* umi_barcode, std::size_t umi_length, CodeType& code)
+{
+    return pack_umi_barcode(umi_barcode, umi_length, code);
+}
+
+/// Unpack a 2-bit code into a UMI barcode of given length.
+std::string UMIBarcodePacker::unpack(CodeType code, std::size_t umi_length)
+{
+    std::string umi_barcode(umi_length, 'A');
+    for(std::size_t i = umi_length; i > 0; --i)
+    {
+        umi_barcode[i-1] = nucleotide_chars[code & 3];
+        code >>= n_nucleotide_bits;
+    }
+    return umi_barcode;
+}
+
+}
@@ -0,0 +1,125 @@
+//
+//  AllocationTracker.hpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#ifndef AllocationTracker_hpp
+#define AllocationTracker_hpp
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace utk
+{
+
+/// \brief Counts of heap allocations.
+struct AllocationCounts
+{
+    std::uint64_t n_allocs {0};
+    std::uint64_t n_bytes {0};
+};
+
+/// \brief An opt-in tracker of heap allocations attributed to scoped tags.
+/// When the library is built with UTK_ALLOCATION_TRACKING (the CMake option
+/// of the same name), the global operator new of the program is replaced to
+/// count each allocation and its bytes under the current tag of the calling
+/// thread. A tag names a pipeline stage, e.g. "read" or "parse", and is set
+/// for a scope by UTK_ALLOCATION_SCOPE, which restores the enclosing tag at
+/// the end of the scope. The allocations outside any scope are counted under
+/// the tag "untagged".
+///
+/// Without UTK_ALLOCATION_TRACKING, UTK_ALLOCATION_SCOPE compiles to nothing
+/// and the operator new is not replaced, so that there is no cost at all.
+class AllocationTracker
+{
+public:
+
+    /// Whether the allocation tracking is compiled in.
+#ifdef UTK_ALLOCATION_TRACKING
+    static constexpr bool enabled {true};
+#else
+    static constexpr bool enabled {false};
+#endif
+
+    /// Maximum number of tags, beyond which new tags are counted as untagged.
+    static constexpr std::size_t max_n_tags {64};
+
+    /// Counts of all tags indexed by tag.
+    using SnapshotType = std::vector<AllocationCounts>;
+
+public:
+
+    /// \brief Get the tag of a name, registering it on first use.
+    /// Note: the name must be a string of static storage, e.g. a literal.
+    static std::size_t getTag(const char* name);
+
+    /// Get the name of a tag.
+    static const char* getTagName(std::size_t tag);
+
+    /// Get the current tag of the calling thread.
+    static std::size_t getCurrentTag();
+
+    /// Set the current tag of the calling thread.
+    static void setCurrentTag(std::size_t tag);
+
+    /// Count an allocation under the current tag of the calling thread.
+    static void countAllocation(std::size_t size);
+
+    /// Get the counts of all tags so far.
+    static SnapshotType getSnapshot();
+
+    /// Get the total counts of all tags so far.
+    static AllocationCounts getTotalCounts();
+
+    /// \brief Write the allocations per record of each tag since a snapshot.
+    /// \param  os              The output stream.
+    /// \param  begin_snapshot  The snapshot at the beginning of the run.
+    /// \param  n_records       The number of records of the run.
+    /// \param  record_name     The name of records, e.g. "line".
+    static void report(std::ostream& os, const SnapshotType& begin_snapshot, std::uint64_t n_records, const std::string& record_name);
+};
+
+/// \brief A scope of a tag of the allocation tracker.
+class AllocationScope
+{
+private:
+
+    std::size_t enclosing_tag;
+
+public:
+
+    explicit AllocationScope(std::size_t tag) : enclosing_tag{AllocationTracker::getCurrentTag()}
+    {
+        AllocationTracker::setCurrentTag(tag);
+    }
+
+    AllocationScope(const AllocationScope&) = delete;
+
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+    ~AllocationScope()
+    {
+        AllocationTracker::setCurrentTag(enclosing_tag);
+    }
+};
+
+}
+
+#define UTK_ALLOCATION_CONCAT_IMPL(a, b) a##b
+#define UTK_ALLOCATION_CONCAT(a, b) UTK_ALLOCATION_CONCAT_IMPL(a, b)
+
+/// Count the heap allocations of the rest of the enclosing scope under a tag.
+#ifdef UTK_ALLOCATION_TRACKING
+#define UTK_ALLOCATION_SCOPE(name) \
+    static const std::size_t UTK_ALLOCATION_CONCAT(utk_allocation_tag_, __LINE__) = utk::AllocationTracker::getTag(name); \
+    utk::AllocationScope UTK_ALLOCATION_CONCAT(utk_allocation_scope_, __LINE__)(UTK_ALLOCATION_CONCAT(utk_allocation_tag_, __LINE__))
+#else
+#define UTK_ALLOCATION_SCOPE(name) static_cast<void>(0)
+#endif
+
+#endif /* AllocationTracker_hpp */
@@ -0,0 +1,132 @@
+//
+//  BlockedBloomFilter.hpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#ifndef BlockedBloomFilter_hpp
+#define BlockedBloomFilter_hpp
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace utk
+{
+
+/// \brief A cache-blocked Bloom filter of 64-bit hash values.
+/// This class splits the bit array into blocks of one cache line each, and
+/// sets all the bits of a hash value within a single block chosen by the
+/// upper half of the hash value, so that each query touches only one cache
+/// line. The bits within the block are drawn from the top bits of successive
+/// multiplicative rehashes of the whole hash value.
+///
+/// The filter is sized from an expected number of distinct values and a
+/// target false positive rate. Blocking makes the bits unevenly loaded, so
+/// that a blocked filter needs slightly more bits than a standard one for
+/// the same false positive rate, which is compensated by extra bits per
+/// value.
+///
+/// Note: the hash values are expected to be well mixed, e.g. by mixHash.
+class BlockedBloomFilter
+{
+public:
+
+    /// Number of bits in a block, i.e. a cache line of 64 bytes.
+    static constexpr std::size_t block_bits {512};
+
+    /// Maximum number of bits set for each value.
+    static constexpr std::size_t max_n_hashes {16};
+
+private:
+
+    /// A block of bits aligned to a cache line.
+    struct alignas(64) Block
+    {
+        std::uint64_t words[block_bits/64] {};
+    };
+
+private:
+
+    /// Blocks of the bit array.
+    std::vector<Block> blocks;
+
+    /// Number of bits set for each value.
+    std::size_t n_hashes {1};
+
+    /// False positive rate of a block with each number of bits set.
+    std::vector<double> block_rates;
+
+    /// Sum of the false positive rates of all blocks.
+    double sum_block_rates {0};
+
+private:
+
+    /// Rehash the bits of a hash value and draw the position of next bit in
+    /// its block from the top 9 bits.
+    static std::size_t nextBlockBit(std::uint64_t& bits)
+    {
+        bits *= 0x9e3779b97f4a7c15ULL;
+        return static_cast<std::size_t>(bits >> 55);
+    }
+
+public:
+
+    /// \brief Create a filter for an expected number of distinct values.
+    /// \param  n_expected_values  The expected number of distinct values.
+    /// \param  false_positive_rate  The target false positive rate at the
+    ///                              expected number of distinct values.
+    BlockedBloomFilter(std::size_t n_expected_values, double false_positive_rate);
+
+    /// \brief Finalize a 64-bit value into a well mixed hash value.
+    /// This is the finalizer of SplitMix64, which is a bijection, so that
+    /// distinct values always have distinct hash values.
+    static std::uint64_t mixHash(std::uint64_t value)
+    {
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+        return value ^ (value >> 31);
+    }
+
+    /// Insert a hash value into the filter.
+    /// \return  True if the hash value was not present, or false if it was
+    ///          present or is a false positive.
+    bool insert(std::uint64_t hash);
+
+    /// Check if a hash value is present in the filter, with false positives.
+    bool contains(std::uint64_t hash) const;
+
+    /// \brief Estimate the current false positive rate from the number of
+    /// bits set in each block.
+    /// A query falls into each block with equal probability, and is a false
+    /// positive if all its bits happen to be set in that block. The rates of
+    /// blocks are updated by insert, so that the estimate accounts for the
+    /// uneven load of blocks in constant time.
+    double getFalsePositiveRate() const
+    {
+        return sum_block_rates/static_cast<double>(blocks.size());
+    }
+
+    /// Number of bits set for each value.
+    std::size_t getNumberOfHashes() const
+    {
+        return n_hashes;
+    }
+
+    /// Number of bits in the bit array.
+    std::size_t getNumberOfBits() const
+    {
+        return blocks.size()*block_bits;
+    }
+
+    /// Memory used by the bit array in bytes.
+    std::size_t getMemoryUsage() const
+    {
+        return blocks.size()*sizeof(Block);
+    }
+};
+
+}
+
+#endif /* BlockedBloomFilter_hpp */
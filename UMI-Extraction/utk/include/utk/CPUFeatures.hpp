@@ -0,0 +1,56 @@
+//
+//  CPUFeatures.hpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#ifndef CPUFeatures_hpp
+#define CPUFeatures_hpp
+
+namespace utk
+{
+
+/// \brief Levels of the SIMD instruction sets of x86-64 CPUs.
+/// Each level includes all lower levels:
+///
+/// 1) baseline: SSE2, which every x86-64 CPU has.
+/// 2) sse42: SSE4.2 and POPCNT.
+/// 3) avx2: AVX2, BMI1 and BMI2.
+/// 4) avx512: AVX-512 F, DQ, BW and VL.
+enum class SIMDLevel
+{
+    baseline,
+    sse42,
+    avx2,
+    avx512
+};
+
+/// \brief Get the SIMD level of the running CPU.
+/// The level is detected once by cpuid, and by xgetbv for the AVX and
+/// AVX-512 registers to be saved by the operating system. It can be lowered,
+/// but never raised, by the environment variable UTK_SIMD_LEVEL set to the
+/// name of a level, e.g. to compare the implementations of a SIMD kernel on
+/// the same CPU. The level is always baseline on other architectures.
+SIMDLevel getSIMDLevel();
+
+/// Get the name of a SIMD level, i.e. baseline, sse4.2, avx2, or avx512.
+const char* getSIMDLevelName(SIMDLevel level);
+
+}
+
+/// \brief Compile a function for a SIMD level above the baseline.
+/// The SIMD kernels define a version of each level with these attributes in
+/// the same translation unit, and select the version of the running CPU by
+/// getSIMDLevel at startup, so that a portable build still uses the widest
+/// instructions of each CPU without crashing on older ones.
+/// Note: lambdas don't inherit the target of their enclosing function, so
+/// that intrinsics must be called from functions with these attributes.
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define UTK_SIMD_DISPATCH
+#define UTK_TARGET_SSE42 __attribute__((target("sse4.2,popcnt")))
+#define UTK_TARGET_AVX2 __attribute__((target("avx2,bmi,bmi2,popcnt")))
+#define UTK_TARGET_AVX512 __attribute__((target("avx512f,avx512dq,avx512bw,avx512vl,avx2,bmi,bmi2,popcnt")))
+#endif
+
+#endif /* CPUFeatures_hpp */
@@ -0,0 +1,107 @@
+//
+//  ConcurrentQueue.hpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#ifndef ConcurrentQueue_hpp
+#define ConcurrentQueue_hpp
+
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <condition_variable>
+
+namespace utk
+{
+
+/// \brief A bounded blocking queue shared by multiple threads
+/// This class passes work items between producer and consumer threads. A
+/// producer blocks when the queue is full and a consumer blocks when the
+/// queue is empty, until the queue is closed by the producer side, after
+/// which the remaining items can still be retrieved.
+///
+/// \tparam  T  The type of queued item.
+template<typename T>
+class ConcurrentQueue
+{
+private:
+
+    /// Queued items.
+    std::deque<T> items;
+
+    /// Maximum number of queued items (0 for unlimited).
+    std::size_t capacity {0};
+
+    /// Flag for a closed queue that accepts no more items.
+    bool closed {false};
+
+    /// Synchronization of all data members.
+    mutable std::mutex items_mutex;
+
+    /// Notification of queue state change.
+    std::condition_variable not_empty, not_full;
+
+public:
+
+    explicit ConcurrentQueue(std::size_t capacity=0) : capacity{capacity} {}
+
+    ConcurrentQueue(const ConcurrentQueue&) = delete;
+
+    ConcurrentQueue& operator=(const ConcurrentQueue&) = delete;
+
+    /// Add an item to the queue, waiting while the queue is full.
+    /// \return  False if the queue has been closed and the item is discarded.
+    bool push(T item)
+    {
+        std::unique_lock<std::mutex> lock(items_mutex);
+        not_full.wait(lock, [this]{ return closed || capacity == 0 || items.size() < capacity; });
+        if(closed) return false;
+        items.push_back(std::move(item));
+        lock.unlock();
+        not_empty.notify_one();
+        return true;
+    }
+
+    /// Remove an item from the queue, waiting while the queue is empty.
+    /// \return  False if the queue is closed and has no more items.
+    bool pop(T& item)
+    {
+        std::unique_lock<std::mutex> lock(items_mutex);
+        not_empty.wait(lock, [this]{ return closed || !items.empty(); });
+        if(items.empty()) return false;
+        item = std::move(items.front());
+        items.pop_front();
+        lock.unlock();
+        not_full.notify_one();
+        return true;
+    }
+
+    /// Close the queue and wake up all waiting threads.
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(items_mutex);
+            closed = true;
+        }
+        not_empty.notify_all();
+        not_full.notify_all();
+    }
+
+    bool isClosed() const
+    {
+        std::lock_guard<std::mutex> lock(items_mutex);
+        return closed;
+    }
+
+    std::size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(items_mutex);
+        return items.size();
+    }
+};
+
+}
+
+#endif /* ConcurrentQueue_hpp */
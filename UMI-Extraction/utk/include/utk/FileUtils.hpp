@@ -10,6 +10,9 @@
 #define FileUtils_hpp
 
 #include <string>
+#include <vector>
+#include <tuple>
+#include <cstdint>
 
 namespace utk
 {
@@ -26,6 +29,27 @@ std::tuple<std::string, std::string> extractFileNameDirectory(const std::string&
 /// Extract main and extended names of a file name.
 std::tuple<std::string, std::string> extractFileMainExtNames(const std::string& file_name, char sep='.');
 
-#endif /* FileUtils_hpp */
+/// Check if a file path is a wildcard pattern.
+bool isFilePattern(const std::string& file_path);
+
+/// Find all the file paths matching a wildcard pattern in sorted order.
+std::vector<std::string> expandFilePattern(const std::string& file_pattern);
+
+/// Get the size of a file in bytes.
+std::uintmax_t getFileSize(const std::string& file_path);
+
+/// \brief Create an empty temporary file with a unique name.
+/// The file is created in the directory given by the TMPDIR environment
+/// variable, or in /tmp if TMPDIR is not set.
+/// \return  The path of the created file.
+std::string createTempFile(const std::string& name_prefix);
+
+/// Remove a file, ignoring a file that doesn't exist.
+void removeFile(const std::string& file_path);
+
+/// Rename a file, replacing the destination file if it exists.
+void renameFile(const std::string& old_file_path, const std::string& new_file_path);
 
 }
+
+#endif /* FileUtils_hpp */
@@ -0,0 +1,99 @@
+//
+//  HardwareCounters.hpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#ifndef HardwareCounters_hpp
+#define HardwareCounters_hpp
+
+#include <array>
+#include <string>
+#include <cstddef>
+
+namespace utk
+{
+
+/// \brief Hardware performance counters of the calling thread.
+/// This class opens a Linux perf_event_open counter of user-space events
+/// for each of cycles, instructions, L1 data cache read misses, last-level
+/// cache misses, branch misses, and data TLB read misses, which count the
+/// calling thread between start and stop, and optionally the threads and
+/// child processes it creates afterwards.
+///
+/// Each counter is opened independently, so that a counter unsupported by
+/// the CPU or the kernel leaves the others usable. When no counter can be
+/// opened, e.g. inside a container without access to perf events or on
+/// another platform, all counts are NaN and the reason is kept, instead of
+/// failing.
+class HardwareCounters
+{
+public:
+
+    /// Hardware events counted.
+    enum Event : std::size_t
+    {
+        cycles,
+        instructions,
+        l1d_misses,
+        llc_misses,
+        branch_misses,
+        dtlb_misses,
+        n_events
+    };
+
+    /// Counts of all events, or NaN for a counter unavailable.
+    using CountsType = std::array<double, n_events>;
+
+private:
+
+    /// File descriptor of each counter, or -1 for a counter unavailable.
+    std::array<int, n_events> fds;
+
+    /// Reason of the first counter failed to open.
+    std::string unavailable_reason;
+
+public:
+
+    /// \param  inherit  Whether to also count the threads and child
+    ///                  processes created after opening the counters, whose
+    ///                  counts are added when they exit.
+    explicit HardwareCounters(bool inherit=false);
+
+    HardwareCounters(const HardwareCounters&) = delete;
+
+    HardwareCounters& operator=(const HardwareCounters&) = delete;
+
+    ~HardwareCounters() noexcept;
+
+    /// Get the short name of an event, e.g. "cycles".
+    static const char* getEventName(std::size_t event);
+
+    /// Check if any counter is available.
+    bool isAvailable() const;
+
+    /// \brief Get the reason of an unavailable counter.
+    /// \return  The error of the first counter failed to open, or empty if
+    ///          all counters are available.
+    const std::string& getUnavailableReason() const
+    {
+        return unavailable_reason;
+    }
+
+    /// Reset and start all counters.
+    void start();
+
+    /// Stop all counters.
+    void stop();
+
+    /// \brief Read all counters.
+    /// The counts are scaled up by the fraction of time each counter was
+    /// scheduled on the CPU, when the kernel multiplexes more counters than
+    /// the CPU has.
+    CountsType read() const;
+};
+
+}
+
+#endif /* HardwareCounters_hpp */
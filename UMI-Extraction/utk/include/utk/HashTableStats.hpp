@@ -0,0 +1,61 @@
+//
+//  HashTableStats.hpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#ifndef HashTableStats_hpp
+#define HashTableStats_hpp
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+namespace utk
+{
+
+/// \brief Occupancy statistics of chained hash tables.
+/// This class adds up the entries and buckets of one or more standard
+/// unordered containers, together with a histogram of probe lengths, i.e. the
+/// number of entries that are found at each position of their bucket chains.
+/// A histogram concentrated at length 1 indicates a well spread hash function.
+struct HashTableStats
+{
+    /// Number of entries at the end.
+    std::size_t n_entries {0};
+
+    /// Largest number of entries at any time, if tracked by the owner.
+    std::size_t n_peak_entries {0};
+
+    /// Number of buckets at the end.
+    std::size_t n_buckets {0};
+
+    /// Number of entries found after 1, 2, 3, ... probes.
+    std::vector<std::size_t> probe_length_counts;
+
+    /// Average number of entries in a bucket.
+    double getLoadFactor() const
+    {
+        return n_buckets > 0 ? static_cast<double>(n_entries)/static_cast<double>(n_buckets) : 0;
+    }
+
+    /// Add the entries and buckets of an unordered container.
+    template<typename HashTableType>
+    void add(const HashTableType& table)
+    {
+        n_entries += table.size();
+        n_buckets += table.bucket_count();
+        n_peak_entries = std::max(n_peak_entries, n_entries);
+        for(std::size_t n = 0; n < table.bucket_count(); ++n)
+        {
+            std::size_t bucket_size = table.bucket_size(n);
+            if(bucket_size > probe_length_counts.size()) probe_length_counts.resize(bucket_size, 0);
+            for(std::size_t i = 0; i < bucket_size; ++i) probe_length_counts[i]++;
+        }
+    }
+};
+
+}
+
+#endif /* HashTableStats_hpp */
@@ -0,0 +1,79 @@
+//
+//  HyperLogLog.hpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#ifndef HyperLogLog_hpp
+#define HyperLogLog_hpp
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace utk
+{
+
+/// \brief A HyperLogLog sketch estimating the number of distinct 64-bit hash
+/// values.
+/// This class keeps 2^precision registers of one byte each. The upper bits
+/// of a hash value select a register, which keeps the maximum rank of the
+/// first set bit among the remaining bits. The relative standard error of
+/// the estimate is about 1.04/sqrt(2^precision), and small cardinalities are
+/// estimated by linear counting of empty registers.
+///
+/// Note: the hash values are expected to be well mixed.
+class HyperLogLog
+{
+public:
+
+    /// Minimum and maximum numbers of bits selecting a register.
+    static constexpr unsigned min_precision {4};
+    static constexpr unsigned max_precision {18};
+
+private:
+
+    /// Number of bits selecting a register.
+    unsigned precision {0};
+
+    /// Maximum rank of each register.
+    std::vector<std::uint8_t> registers;
+
+public:
+
+    explicit HyperLogLog(unsigned precision=10);
+
+    /// Insert a hash value into the sketch.
+    void insert(std::uint64_t hash)
+    {
+        std::size_t index = static_cast<std::size_t>(hash >> (64-precision));
+        // Rank the first set bit of the remaining bits, with a sentinel bit
+        // that limits the rank.
+        std::uint64_t rest = (hash << precision) | (std::uint64_t(1) << (precision-1));
+        std::uint8_t rank = static_cast<std::uint8_t>(__builtin_clzll(rest)+1);
+        if(rank > registers[index]) registers[index] = rank;
+    }
+
+    /// Merge another sketch of the same precision into this sketch.
+    void merge(const HyperLogLog& sketch);
+
+    /// Estimate the number of distinct hash values inserted.
+    double estimate() const;
+
+    /// Number of bits selecting a register.
+    unsigned getPrecision() const
+    {
+        return precision;
+    }
+
+    /// Memory used by the registers in bytes.
+    std::size_t getMemoryUsage() const
+    {
+        return registers.size();
+    }
+};
+
+}
+
+#endif /* HyperLogLog_hpp */
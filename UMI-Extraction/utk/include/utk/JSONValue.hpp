@@ -0,0 +1,113 @@
+//
+//  JSONValue.hpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#ifndef JSONValue_hpp
+#define JSONValue_hpp
+
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace utk
+{
+
+/// \brief A value of a parsed JSON document.
+/// This class holds a null, boolean, number, string, array, or object value
+/// parsed from a JSON document, with the members of an object kept in their
+/// order in the document. It complements JSONWriter for reading back small
+/// documents such as reports and configuration files.
+class JSONValue
+{
+public:
+
+    /// Type of JSON value.
+    enum class Type
+    {
+        null,
+        boolean,
+        number,
+        string,
+        array,
+        object
+    };
+
+    using ArrayType = std::vector<JSONValue>;
+
+    using ObjectType = std::vector<std::pair<std::string, JSONValue>>;
+
+private:
+
+    Type type {Type::null};
+
+    bool bool_value {false};
+
+    double number_value {0};
+
+    std::string string_value;
+
+    ArrayType array_value;
+
+    ObjectType object_value;
+
+private:
+
+    /// Check the type of the value.
+    void checkType(Type expected_type) const;
+
+    friend class JSONParser;
+
+public:
+
+    JSONValue() = default;
+
+    /// \brief Parse a JSON document.
+    /// Note: a std::runtime_error is thrown with the offset of the first
+    /// invalid character of a malformed document.
+    static JSONValue parse(const std::string& text);
+
+    /// Read and parse a JSON file.
+    static JSONValue readFile(const std::string& file_path);
+
+    /// Get the type of the value.
+    Type getType() const
+    {
+        return type;
+    }
+
+    /// Check if the value is null.
+    bool isNull() const
+    {
+        return type == Type::null;
+    }
+
+    /// \brief Get the boolean value.
+    /// Note: a std::runtime_error is thrown if the value has a different type,
+    /// and likewise for the other typed getters.
+    bool getBool() const;
+
+    /// Get the numeric value.
+    double getNumber() const;
+
+    /// Get the string value.
+    const std::string& getString() const;
+
+    /// Get the elements of an array value.
+    const ArrayType& getArray() const;
+
+    /// Get the members of an object value.
+    const ObjectType& getObject() const;
+
+    /// Find a member of an object value, or return nullptr if it's absent.
+    const JSONValue* find(const std::string& name) const;
+
+    /// Get a member of an object value, which must be present.
+    const JSONValue& at(const std::string& name) const;
+};
+
+}
+
+#endif /* JSONValue_hpp */
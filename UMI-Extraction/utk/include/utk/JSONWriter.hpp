@@ -0,0 +1,99 @@
+//
+//  JSONWriter.hpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#ifndef JSONWriter_hpp
+#define JSONWriter_hpp
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <type_traits>
+
+namespace utk
+{
+
+/// \brief A streaming writer of JSON documents.
+/// This class writes nested objects and arrays to an output stream as they
+/// are built, with one member or element on each line, so that reports can
+/// be written without building a document tree first. The caller is
+/// responsible for a well-formed nesting of objects, arrays, and keys.
+class JSONWriter
+{
+private:
+
+    /// Output stream of JSON document.
+    std::ostream& os;
+
+    /// Indicator of an empty object or array at each nesting level.
+    std::vector<bool> empty_levels;
+
+    /// Indicator of a key written without its value yet.
+    bool key_written {false};
+
+private:
+
+    /// Start a new member or element at the current nesting level.
+    void beginItem();
+
+    /// Write a quoted and escaped string.
+    void writeString(const std::string& str);
+
+    /// Write a floating-point number, or null for NaN and infinity.
+    void writeNumber(double number);
+
+public:
+
+    explicit JSONWriter(std::ostream& os) : os{os} {}
+
+    /// Begin an object.
+    JSONWriter& beginObject();
+
+    /// End the current object.
+    JSONWriter& endObject();
+
+    /// Begin an array.
+    JSONWriter& beginArray();
+
+    /// End the current array.
+    JSONWriter& endArray();
+
+    /// Write the key of an object member, to be followed by its value.
+    JSONWriter& key(const std::string& name);
+
+    /// Write a string value.
+    JSONWriter& value(const std::string& str);
+
+    /// Write a string value.
+    JSONWriter& value(const char* str)
+    {
+        return value(std::string(str));
+    }
+
+    /// Write a boolean value.
+    JSONWriter& value(bool flag);
+
+    /// Write a numeric value.
+    template<typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+    JSONWriter& value(T number)
+    {
+        beginItem();
+        if constexpr (std::is_integral_v<T>) os << number;
+        else writeNumber(static_cast<double>(number));
+        return *this;
+    }
+
+    /// Write a member of an object.
+    template<typename T>
+    JSONWriter& member(const std::string& name, const T& val)
+    {
+        return key(name).value(val);
+    }
+};
+
+}
+
+#endif /* JSONWriter_hpp */
@@ -0,0 +1,50 @@
+//
+//  LapTimer.hpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#ifndef LapTimer_hpp
+#define LapTimer_hpp
+
+#include <chrono>
+
+namespace utk
+{
+
+/// \brief A wall-clock timer for splitting the time of a thread into laps.
+/// Each lap adds the time since the previous lap to an accumulator, so that
+/// the busy time of interleaved stages of work on one thread can be added up
+/// separately.
+class LapTimer
+{
+private:
+
+    using ClockType = std::chrono::steady_clock;
+
+    /// The end of the previous lap.
+    ClockType::time_point lap_end;
+
+public:
+
+    LapTimer() : lap_end{ClockType::now()} {}
+
+    /// Start a new lap without adding the time since the previous one.
+    void restart()
+    {
+        lap_end = ClockType::now();
+    }
+
+    /// Add the time in seconds since the previous lap to an accumulator.
+    void lap(double& seconds)
+    {
+        ClockType::time_point now = ClockType::now();
+        seconds += std::chrono::duration<double>(now-lap_end).count();
+        lap_end = now;
+    }
+};
+
+}
+
+#endif /* LapTimer_hpp */
@@ -12,6 +12,8 @@
 #include <string>
 #include <vector>
 #include <fstream>
+#include <memory>
+#include <utk/StdStreamBuffer.hpp>
 
 namespace utk
 {
@@ -28,8 +30,16 @@ public:
 
     using LinesType = std::vector<std::string>;
 
+public:
+
+    /// Default size of stream buffer.
+    static constexpr std::size_t default_buffer_size {1 << 20};
+
 private:
 
+    /// Buffer of file stream, which must live as long as the stream.
+    std::unique_ptr<char[]> stream_buffer;
+
     /// Name of input file
     std::string file_name;
 
@@ -48,8 +58,22 @@ private:
     /// Flag for failed reading operation.
     bool read_failed {false};
 
+    /// Large buffer over the standard input stream if it is read instead
+    /// of a file.
+    std::unique_ptr<StdStreamBuffer> std_stream_buffer;
+
 private:
 
+    /// \brief Open a file or the standard input stream with a large buffer.
+    /// The file name "-" stands for the standard input stream, which is read
+    /// sequentially without any seek through the stream buffer of std::cin,
+    /// so that it is never reopened, e.g. when it is a socket.
+    void openStream();
+
+    /// Switch the stream buffer between the file and the standard input
+    /// stream, keeping the I/O state.
+    void attachStreamBuffer();
+
     /// Check if an input file is opened.
     /// If not, throw an exception.
     void checkFileOpen();
@@ -106,6 +130,12 @@ public:
         return file_name;
     }
 
+    /// Check if an input file or the standard input stream is open.
+    bool is_open() const
+    {
+        return std_stream_buffer || std::ifstream::is_open();
+    }
+
     /// Check if the end of file is reached
     bool isFileEnd() const
     {
@@ -119,6 +149,7 @@ public:
     }
 
     /// User-level function for resetting low-level output stream to initial state.
+    /// Note: the standard input stream cannot be rewound.
     void resetStream()
     {
         // Reset read flags of LineReader to initial state.
@@ -11,14 +11,24 @@
 
 #include <string>
 #include <fstream>
+#include <memory>
+#include <utk/StdStreamBuffer.hpp>
 
 namespace utk
 {
 
 class LineWriter : public std::ofstream
 {
+public:
+
+    /// Default size of stream buffer.
+    static constexpr std::size_t default_buffer_size {1 << 20};
+
 private:
 
+    /// Buffer of file stream, which must live as long as the stream.
+    std::unique_ptr<char[]> stream_buffer;
+
     /// Name of output file.
     std::string file_name;
 
@@ -28,8 +38,23 @@ private:
     /// Flag for failed writing operation.
     bool write_failed {false};
 
+    /// Large buffer over the standard output stream if it is written instead
+    /// of a file.
+    std::unique_ptr<StdStreamBuffer> std_stream_buffer;
+
 private:
 
+    /// \brief Open a file or the standard output stream with a large buffer.
+    /// The file name "-" stands for the standard output stream, which is
+    /// written sequentially without any seek through the stream buffer of
+    /// std::cout, so that it is neither reopened nor truncated, e.g. when it
+    /// is appended to a file or is a socket.
+    void openStream();
+
+    /// Switch the stream buffer between the file and the standard output
+    /// stream, keeping the I/O state.
+    void attachStreamBuffer();
+
     /// Check if an output file is opened.
     /// If not, throw an exception.
     void checkFileOpen();
@@ -77,7 +102,9 @@ public:
     /// Open file and initialize parameters.
     void open(const std::string& file_name_arg);
 
-    /// Close file.
+    /// \brief Close file.
+    /// Note: the buffered lines are written when closing, so that isWriteFailed
+    /// should be checked after closing for the lines to be surely written.
     void close();
 
     const std::string& getFileName() const
@@ -85,13 +112,21 @@ public:
         return file_name;
     }
 
-    /// Check if the end of file is reached
+    /// Check if an output file or the standard output stream is open.
+    bool is_open() const
+    {
+        return std_stream_buffer || std::ofstream::is_open();
+    }
+
+    /// Check if writing failed, including the buffered lines written when
+    /// closing.
     bool isWriteFailed() const
     {
         return write_failed;
     }
 
     /// User-level function for resetting low-level output stream to initial state.
+    /// Note: the standard output stream cannot be rewound.
     void resetStream()
     {
         // Reset write flags of LineWriter to initial state.
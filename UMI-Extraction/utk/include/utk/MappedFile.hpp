@@ -0,0 +1,65 @@
+//
+//  MappedFile.hpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#ifndef MappedFile_hpp
+#define MappedFile_hpp
+
+#include <string>
+#include <cstddef>
+
+namespace utk
+{
+
+/// \brief A read-only memory mapping of a whole file.
+/// This class maps a file into memory for reading in place, so that a large
+/// file is paged in on demand instead of being read into a buffer up front.
+/// The mapping is removed when the object is destroyed.
+class MappedFile
+{
+private:
+
+    /// The path of mapped file.
+    std::string file_path;
+
+    /// The start of mapped contents, or nullptr for an empty file.
+    const char* data {nullptr};
+
+    /// The size of mapped contents in bytes.
+    std::size_t size {0};
+
+public:
+
+    explicit MappedFile(const std::string& file_path);
+
+    ~MappedFile() noexcept;
+
+    MappedFile(const MappedFile&) = delete;
+
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// Get the path of mapped file.
+    const std::string& getFilePath() const
+    {
+        return file_path;
+    }
+
+    /// Get the start of mapped contents.
+    const char* getData() const
+    {
+        return data;
+    }
+
+    /// Get the size of mapped contents in bytes.
+    std::size_t getSize() const
+    {
+        return size;
+    }
+};
+
+}
+
+#endif /* MappedFile_hpp */
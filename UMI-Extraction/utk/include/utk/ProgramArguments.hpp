@@ -63,6 +63,9 @@ public:
     /// \brief Check input arguments
     /// Note: this function needs to be called by main function.
     void check();
+
+    /// \brief Get the command line of all input arguments separated by spaces
+    std::string getCommandLine() const;
 };
 
 }
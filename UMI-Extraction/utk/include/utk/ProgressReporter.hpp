@@ -0,0 +1,137 @@
+//
+//  ProgressReporter.hpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#ifndef ProgressReporter_hpp
+#define ProgressReporter_hpp
+
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <condition_variable>
+
+namespace utk
+{
+
+/// \brief Periodic progress report of a long-running task.
+/// This class runs a timer thread that wakes up at a fixed interval and
+/// reports the number of records processed, the current and average
+/// throughput, the estimated time to finish from the bytes consumed out of
+/// the total input size, and the memory of the dedup table if known.
+///
+/// The working thread only publishes its progress with relaxed atomic stores
+/// from time to time, e.g. once per chunk of records, so that the hot loop
+/// doesn't check any clock. The memory of the dedup table, which may take
+/// some work to estimate, is only published when the timer thread asks for
+/// it, and shows up in the next report.
+///
+/// Each report is a single line written to standard error, or written over a
+/// status file which always holds the latest report.
+class ProgressReporter
+{
+public:
+
+    using ClockType = std::chrono::steady_clock;
+
+private:
+
+    /// Name of the task in each report.
+    std::string task_name;
+
+    /// Name of the records processed by the task.
+    std::string record_name;
+
+    /// Total number of input bytes, or 0 if unknown.
+    std::uintmax_t n_total_bytes {0};
+
+    /// Interval between reports.
+    std::chrono::duration<double> interval;
+
+    /// Status file holding the latest report, or empty for standard error.
+    std::string status_file_path;
+
+    /// Progress published by the working thread.
+    std::atomic<std::uintmax_t> n_records {0};
+    std::atomic<std::uintmax_t> n_bytes {0};
+    std::atomic<std::uintmax_t> n_memory_bytes {0};
+    std::atomic<bool> memory_published {false};
+    std::atomic<bool> memory_requested {true};
+
+    /// Start time of the task.
+    ClockType::time_point start_time;
+
+    /// Time and number of records of the previous report.
+    ClockType::time_point last_report_time;
+    std::uintmax_t n_last_records {0};
+
+    /// Synchronization for stopping the timer thread.
+    std::mutex timer_mutex;
+    std::condition_variable timer_cond;
+    bool stopping {false};
+
+    /// The timer thread.
+    std::thread timer_thread;
+
+private:
+
+    /// Wake up at each interval and report the progress.
+    void runTimer();
+
+    /// Write a report of the progress so far.
+    void report(bool finished);
+
+    /// Write a report line to standard error or the status file.
+    void writeReport(const std::string& report_line) const;
+
+public:
+
+    /// \param  task_name         Name of the task in each report.
+    /// \param  record_name       Name of the records, e.g. "lines".
+    /// \param  n_total_bytes     Total number of input bytes for estimating the
+    ///                           time to finish, or 0 if unknown.
+    /// \param  interval_seconds  Interval in seconds between reports.
+    /// \param  status_file_path  Status file holding the latest report, or
+    ///                           empty to write each report to standard error.
+    ProgressReporter(const std::string& task_name, const std::string& record_name, std::uintmax_t n_total_bytes, double interval_seconds, const std::string& status_file_path="");
+
+    ProgressReporter(const ProgressReporter&) = delete;
+
+    ProgressReporter& operator=(const ProgressReporter&) = delete;
+
+    /// Stop the timer thread without a final report.
+    ~ProgressReporter() noexcept;
+
+    /// Publish the total numbers of records processed and bytes consumed.
+    void setProgress(std::uintmax_t records, std::uintmax_t bytes)
+    {
+        n_records.store(records, std::memory_order_relaxed);
+        n_bytes.store(bytes, std::memory_order_relaxed);
+    }
+
+    /// Check if the timer thread asks for the memory of the dedup table.
+    bool isMemoryUsageRequested() const
+    {
+        return memory_requested.load(std::memory_order_relaxed);
+    }
+
+    /// Publish the memory of the dedup table in bytes.
+    void setMemoryUsage(std::uintmax_t bytes)
+    {
+        n_memory_bytes.store(bytes, std::memory_order_relaxed);
+        memory_published.store(true, std::memory_order_relaxed);
+        memory_requested.store(false, std::memory_order_relaxed);
+    }
+
+    /// Stop the timer thread and write a final report.
+    void finish();
+};
+
+}
+
+#endif /* ProgressReporter_hpp */
@@ -0,0 +1,27 @@
+//
+//  ResourceUsage.hpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#ifndef ResourceUsage_hpp
+#define ResourceUsage_hpp
+
+#include <cstddef>
+
+namespace utk
+{
+
+/// CPU time in seconds used by all threads of the calling process.
+double getProcessCPUTime();
+
+/// CPU time in seconds used by the calling thread.
+double getThreadCPUTime();
+
+/// Peak resident set size in bytes of the calling process.
+std::size_t getPeakResidentSetSize();
+
+}
+
+#endif /* ResourceUsage_hpp */
@@ -0,0 +1,103 @@
+//
+//  SPSCQueue.hpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#ifndef SPSCQueue_hpp
+#define SPSCQueue_hpp
+
+#include <vector>
+#include <atomic>
+#include <utility>
+#include <cstddef>
+
+namespace utk
+{
+
+/// \brief A lock-free bounded queue for a single producer and a single consumer
+/// This class passes items from exactly one producer thread to exactly one
+/// consumer thread through a ring buffer. The producer only writes the tail
+/// index and the consumer only writes the head index, so that neither side
+/// needs a lock. Both functions return immediately instead of blocking, and
+/// the caller decides how to wait.
+///
+/// \tparam  T  The type of queued item, which must be default constructible
+///             and movable.
+template<typename T>
+class SPSCQueue
+{
+private:
+
+    /// Assumed size of cache line for separating the indexes.
+    static constexpr std::size_t cache_line_size {64};
+
+private:
+
+    /// Ring buffer of items with a power-of-two size.
+    std::vector<T> slots;
+
+    /// Mask for wrapping an index into the ring buffer.
+    std::size_t index_mask {0};
+
+    /// Index of next item to pop, written by the consumer only.
+    alignas(cache_line_size) std::atomic<std::size_t> head {0};
+
+    /// Index of next item to push, written by the producer only.
+    alignas(cache_line_size) std::atomic<std::size_t> tail {0};
+
+private:
+
+    static std::size_t roundUpCapacity(std::size_t capacity)
+    {
+        std::size_t n_slots {1};
+        while(n_slots < capacity) n_slots <<= 1;
+        return n_slots;
+    }
+
+public:
+
+    explicit SPSCQueue(std::size_t capacity=1024) : slots(roundUpCapacity(capacity)), index_mask{slots.size()-1} {}
+
+    SPSCQueue(const SPSCQueue&) = delete;
+
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    /// Add an item to the queue from the producer thread.
+    /// \return  False if the queue is full and the item is left untouched.
+    bool tryPush(T& item)
+    {
+        std::size_t tail_index = tail.load(std::memory_order_relaxed);
+        if(tail_index - head.load(std::memory_order_acquire) == slots.size()) return false;
+        slots[tail_index & index_mask] = std::move(item);
+        tail.store(tail_index+1, std::memory_order_release);
+        return true;
+    }
+
+    /// Remove an item from the queue from the consumer thread.
+    /// \return  False if the queue is empty.
+    bool tryPop(T& item)
+    {
+        std::size_t head_index = head.load(std::memory_order_relaxed);
+        if(head_index == tail.load(std::memory_order_acquire)) return false;
+        item = std::move(slots[head_index & index_mask]);
+        head.store(head_index+1, std::memory_order_release);
+        return true;
+    }
+
+    /// Check if the queue is empty.
+    bool empty() const
+    {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+    std::size_t capacity() const
+    {
+        return slots.size();
+    }
+};
+
+}
+
+#endif /* SPSCQueue_hpp */
@@ -0,0 +1,69 @@
+//
+//  StdStreamBuffer.hpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#ifndef StdStreamBuffer_hpp
+#define StdStreamBuffer_hpp
+
+#include <cstddef>
+#include <streambuf>
+
+namespace utk
+{
+
+/// \brief A large buffer over the stream buffer of a standard stream.
+/// The stream buffers of std::cin and std::cout synchronized with C stdio
+/// read and write a character at a time, so that this class reads and writes
+/// them in blocks of a large buffer instead, without reopening the standard
+/// stream by its device path, which would truncate a file it is appended to
+/// and fail on a socket. It is sequential, i.e. it can't seek.
+class StdStreamBuffer : public std::streambuf
+{
+private:
+
+    /// Stream buffer of the standard stream.
+    std::streambuf* std_buffer;
+
+    /// The large buffer, which must live as long as this object.
+    char* buffer;
+
+    std::size_t buffer_size;
+
+private:
+
+    /// Write the buffered characters to the standard stream.
+    bool flushBuffer();
+
+protected:
+
+    /// Read a block of characters from the standard stream.
+    virtual int_type underflow() override;
+
+    /// Write the buffered characters and a character to the standard stream.
+    virtual int_type overflow(int_type c) override;
+
+    /// Write the buffered characters to the standard stream and flush it.
+    virtual int sync() override;
+
+public:
+
+    /// \param  std_buffer   The stream buffer of a standard stream, e.g.
+    ///                      std::cin.rdbuf() or std::cout.rdbuf().
+    /// \param  buffer       The large buffer.
+    /// \param  buffer_size  The size of the large buffer.
+    StdStreamBuffer(std::streambuf* std_buffer, char* buffer, std::size_t buffer_size);
+
+    StdStreamBuffer(const StdStreamBuffer&) = delete;
+
+    StdStreamBuffer& operator=(const StdStreamBuffer&) = delete;
+
+    /// Write the buffered characters to the standard stream.
+    virtual ~StdStreamBuffer() noexcept;
+};
+
+}
+
+#endif /* StdStreamBuffer_hpp */
@@ -0,0 +1,44 @@
+//
+//  StringSearch.hpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#ifndef StringSearch_hpp
+#define StringSearch_hpp
+
+#include <vector>
+#include <string_view>
+
+namespace utk
+{
+
+/// \brief Find the last occurrence of a substring in a text.
+/// This function compares the first and the last characters of the
+/// substring with a block of 64 (AVX-512), 32 (AVX2) or 16 (SSE2) positions
+/// of the text at a time, from the end of the text backwards, and only
+/// compares the whole substring at the positions where both match, which is
+/// much faster than a scalar search for a short substring near the end of a
+/// long text, e.g. a tag of the optional fields of an alignment line. The
+/// block size is selected at startup for the running CPU.
+/// \return  The position of the last occurrence, or std::string_view::npos if
+///          the substring isn't found.
+/// Note: a scalar search is used for a text shorter than a block, or without
+/// SSE2.
+std::size_t findLastSubstring(std::string_view text, std::string_view pattern);
+
+/// \brief Find the positions of all occurrences of a character in a text.
+/// This function compares a block of 64 (AVX-512), 32 (AVX2) or 16 (SSE2)
+/// characters at a time, selected at startup for the running CPU, and
+/// appends the positions of the matched characters in increasing order,
+/// which scans the delimiters of a whole line at once instead of searching
+/// for each of them separately.
+/// \param[in]   text       The text to scan.
+/// \param[in]   c          The character to find.
+/// \param[out]  positions  The positions appended to.
+void findCharPositions(std::string_view text, char c, std::vector<std::size_t>& positions);
+
+}
+
+#endif /* StringSearch_hpp */
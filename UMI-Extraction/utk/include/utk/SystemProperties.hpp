@@ -54,8 +54,24 @@ public:
     
     /// \brief User home directory
     static const std::string home_dir;
+
+    /// \brief File name standing for standard input or standard output
+    static const std::string std_stream_name;
+
+    /// \brief Path of standard input stream in current operating system
+    static const std::string std_input_path;
+
+    /// \brief Path of standard output stream in current operating system
+    static const std::string std_output_path;
     
 private:
+
+    /// \brief Table of paths of standard input stream
+    static const std::map<const std::string, const std::string> std_input_paths;
+
+    /// \brief Table of paths of standard output stream
+    static const std::map<const std::string, const std::string> std_output_paths;
+
     
     /// \brief Table of environment variables for user home directory
     static const std::map<const std::string, const std::string> home_vars;
@@ -80,6 +96,12 @@ public:
 
     /// \brief Determine if a path is a directory
     static bool isDir(const std::string& path);
+
+    /// \brief Determine if a file name stands for standard input or output
+    static bool isStdStream(const std::string& file_name)
+    {
+        return file_name == std_stream_name;
+    }
 };
 
 }
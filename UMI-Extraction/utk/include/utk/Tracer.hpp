@@ -0,0 +1,104 @@
+//
+//  Tracer.hpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#ifndef Tracer_hpp
+#define Tracer_hpp
+
+#include <string>
+#include <cstddef>
+#include <ostream>
+
+namespace utk
+{
+
+/// \brief An opt-in timeline tracer of pipeline stages and worker threads.
+/// When the library is built with UTK_TRACING (the CMake option of the same
+/// name), UTK_TRACE_SCOPE records a begin event and an end event of a named
+/// span with steady_clock timestamps into a ring buffer of the calling
+/// thread. Each thread only writes its own buffer, so that recording takes
+/// no lock, and the oldest events of a thread are overwritten once its
+/// buffer is full. The events of all threads are written as a Chrome trace
+/// JSON document, which can be opened by chrome://tracing or Perfetto to see
+/// the stalls, starved queues, and backpressure between threads.
+///
+/// Without UTK_TRACING, UTK_TRACE_SCOPE and UTK_TRACE_THREAD_NAME compile to
+/// nothing, so that there is no cost at all.
+class Tracer
+{
+public:
+
+    /// Whether the tracing is compiled in.
+#ifdef UTK_TRACING
+    static constexpr bool enabled {true};
+#else
+    static constexpr bool enabled {false};
+#endif
+
+    /// Number of events kept in the ring buffer of each thread.
+    static constexpr std::size_t buffer_capacity {65536};
+
+public:
+
+    /// \brief Record the beginning of a span in the calling thread.
+    /// Note: the name must be a string of static storage, e.g. a literal.
+    static void begin(const char* name);
+
+    /// Record the end of the innermost span in the calling thread.
+    static void end(const char* name);
+
+    /// Name the calling thread in the trace, e.g. "parser 1".
+    static void setThreadName(const std::string& name);
+
+    /// \brief Write the events of all threads as a Chrome trace document.
+    /// The end events whose begin events have been overwritten are dropped.
+    /// Note: the threads being traced should be idle, e.g. joined, so that
+    /// their buffers are not overwritten while being written.
+    static void writeChromeTrace(std::ostream& os);
+
+    /// Write the events of all threads as a Chrome trace file.
+    static void writeChromeTrace(const std::string& file_path);
+};
+
+/// \brief A span of the tracer over a scope.
+class TraceScope
+{
+private:
+
+    const char* name;
+
+public:
+
+    explicit TraceScope(const char* name) : name{name}
+    {
+        Tracer::begin(name);
+    }
+
+    TraceScope(const TraceScope&) = delete;
+
+    TraceScope& operator=(const TraceScope&) = delete;
+
+    ~TraceScope()
+    {
+        Tracer::end(name);
+    }
+};
+
+}
+
+#define UTK_TRACE_CONCAT_IMPL(a, b) a##b
+#define UTK_TRACE_CONCAT(a, b) UTK_TRACE_CONCAT_IMPL(a, b)
+
+/// Trace the rest of the enclosing scope as a span of a name.
+#ifdef UTK_TRACING
+#define UTK_TRACE_SCOPE(name) utk::TraceScope UTK_TRACE_CONCAT(utk_trace_scope_, __LINE__)(name)
+#define UTK_TRACE_THREAD_NAME(name) utk::Tracer::setThreadName(name)
+#else
+#define UTK_TRACE_SCOPE(name) static_cast<void>(0)
+#define UTK_TRACE_THREAD_NAME(name) static_cast<void>(0)
+#endif
+
+#endif /* Tracer_hpp */
@@ -0,0 +1,128 @@
+//
+//  WorkStealingThreadPool.hpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#ifndef WorkStealingThreadPool_hpp
+#define WorkStealingThreadPool_hpp
+
+#include <deque>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <exception>
+#include <condition_variable>
+
+namespace utk
+{
+
+/// \brief A pool of worker threads that steal tasks from each other
+/// Each worker thread owns a double-ended task queue. A worker takes its own
+/// tasks from the back of its queue, which keeps the tasks it submits itself
+/// close together, and steals tasks from the front of the other queues when
+/// its own queue is empty. Tasks submitted from outside the pool are spread
+/// over the queues in turn.
+///
+/// The first exception thrown by a task is kept and rethrown by wait.
+class WorkStealingThreadPool
+{
+public:
+
+    using TaskType = std::function<void()>;
+
+private:
+
+    /// The task queue owned by a worker thread.
+    struct WorkerQueue
+    {
+        std::mutex queue_mutex;
+        std::deque<TaskType> tasks;
+    };
+
+private:
+
+    /// Task queue of each worker thread.
+    std::vector<std::unique_ptr<WorkerQueue>> worker_queues;
+
+    /// Worker threads.
+    std::vector<std::thread> worker_threads;
+
+    /// Synchronization for idle workers and for waiting on all tasks.
+    std::mutex pool_mutex;
+    std::condition_variable task_cond;
+    std::condition_variable done_cond;
+
+    /// Number of tasks queued but not started.
+    std::atomic<std::size_t> n_queued_tasks {0};
+
+    /// Number of tasks submitted but not finished.
+    std::size_t n_unfinished_tasks {0};
+
+    /// Number of worker threads running a task.
+    std::atomic<std::size_t> n_busy_workers {0};
+
+    /// Queue for the next task submitted from outside the pool.
+    std::size_t next_queue {0};
+
+    /// Indicator of stopping all worker threads.
+    bool stopping {false};
+
+    /// The first exception thrown by a task.
+    std::exception_ptr task_error;
+
+private:
+
+    /// Take a task from the own queue of a worker or steal one from others.
+    bool takeTask(std::size_t worker, TaskType& task);
+
+    /// Run tasks in a worker thread until the pool is stopped.
+    void runWorker(std::size_t worker);
+
+public:
+
+    /// \param  n_threads  Number of worker threads, which is the number of
+    ///                    hardware threads if zero.
+    explicit WorkStealingThreadPool(std::size_t n_threads=0);
+
+    WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+
+    WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+    /// Stop all worker threads after the queued tasks are finished.
+    ~WorkStealingThreadPool() noexcept;
+
+    /// Add a task to the pool, which goes to the queue of the calling worker
+    /// if it is called from a task.
+    void submit(TaskType task);
+
+    /// Wait until all submitted tasks are finished and rethrow the first
+    /// exception thrown by a task.
+    void wait();
+
+    std::size_t getNumberOfThreads() const
+    {
+        return worker_threads.size();
+    }
+
+    /// Get the number of tasks queued but not started.
+    std::size_t getNumberOfQueuedTasks() const
+    {
+        return n_queued_tasks.load();
+    }
+
+    /// Get the number of worker threads without a task to run.
+    std::size_t getNumberOfIdleThreads() const
+    {
+        std::size_t n_busy = n_busy_workers.load();
+        return n_busy < worker_threads.size() ? worker_threads.size()-n_busy : 0;
+    }
+};
+
+}
+
+#endif /* WorkStealingThreadPool_hpp */
@@ -0,0 +1,229 @@
+//
+//  AllocationTracker.cpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#include <new>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <algorithm>
+#include <utk/AllocationTracker.hpp>
+
+namespace utk
+{
+
+/// Counters of a tag, on its own cache line to keep threads of different
+/// tags from contending.
+struct alignas(64) TagCounters
+{
+    std::atomic<std::uint64_t> n_allocs {0};
+    std::atomic<std::uint64_t> n_bytes {0};
+};
+
+/// Counters of all tags.
+static std::array<TagCounters, AllocationTracker::max_n_tags> tag_counters;
+
+/// Names of registered tags, where tag 0 is for untagged allocations.
+static std::array<const char*, AllocationTracker::max_n_tags> tag_names {{"untagged"}};
+
+static std::atomic<std::size_t> n_tags {1};
+
+static std::mutex tag_mutex;
+
+/// Current tag of each thread.
+static thread_local std::size_t current_tag {0};
+
+/// Get the tag of a name, registering it on first use.
+std::size_t AllocationTracker::getTag(const char* name)
+{
+    std::lock_guard<std::mutex> lock(tag_mutex);
+    std::size_t n = n_tags.load(std::memory_order_relaxed);
+    for(std::size_t tag = 0; tag < n; ++tag)
+    {
+        if(std::strcmp(tag_names[tag], name) == 0) return tag;
+    }
+    if(n == max_n_tags) return 0;
+    tag_names[n] = name;
+    n_tags.store(n+1, std::memory_order_release);
+    return n;
+}
+
+/// Get the name of a tag.
+const char* AllocationTracker::getTagName(std::size_t tag)
+{
+    return tag < n_tags.load(std::memory_order_acquire) ? tag_names[tag] : "unknown";
+}
+
+/// Get the current tag of the calling thread.
+std::size_t AllocationTracker::getCurrentTag()
+{
+    return current_tag;
+}
+
+/// Set the current tag of the calling thread.
+void AllocationTracker::setCurrentTag(std::size_t tag)
+{
+    current_tag = tag;
+}
+
+/// Count an allocation under the current tag of the calling thread.
+void AllocationTracker::countAllocation(std::size_t size)
+{
+    TagCounters& counters = tag_counters[current_tag];
+    counters.n_allocs.fetch_add(1, std::memory_order_relaxed);
+    counters.n_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+/// Get the counts of all tags so far.
+AllocationTracker::SnapshotType AllocationTracker::getSnapshot()
+{
+    SnapshotType snapshot(n_tags.load(std::memory_order_acquire));
+    for(std::size_t tag = 0; tag < snapshot.size(); ++tag)
+    {
+        snapshot[tag].n_allocs = tag_counters[tag].n_allocs.load(std::memory_order_relaxed);
+        snapshot[tag].n_bytes = tag_counters[tag].n_bytes.load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+/// Get the total counts of all tags so far.
+AllocationCounts AllocationTracker::getTotalCounts()
+{
+    AllocationCounts total;
+    for(std::size_t tag = 0; tag < max_n_tags; ++tag)
+    {
+        total.n_allocs += tag_counters[tag].n_allocs.load(std::memory_order_relaxed);
+        total.n_bytes += tag_counters[tag].n_bytes.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+/// Write the allocations per record of each tag since a snapshot.
+void AllocationTracker::report(std::ostream& os, const SnapshotType& begin_snapshot, std::uint64_t n_records, const std::string& record_name)
+{
+    SnapshotType end_snapshot = getSnapshot();
+    double n = static_cast<double>(std::max(n_records, std::uint64_t(1)));
+    AllocationCounts total;
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision(2);
+    os << std::fixed;
+    for(std::size_t tag = 0; tag < end_snapshot.size(); ++tag)
+    {
+        AllocationCounts counts = end_snapshot[tag];
+        if(tag < begin_snapshot.size())
+        {
+            counts.n_allocs -= begin_snapshot[tag].n_allocs;
+            counts.n_bytes -= begin_snapshot[tag].n_bytes;
+        }
+        if(counts.n_allocs == 0) continue;
+        total.n_allocs += counts.n_allocs;
+        total.n_bytes += counts.n_bytes;
+        os << "Allocate " << static_cast<double>(counts.n_allocs)/n << " heap blocks of " << static_cast<double>(counts.n_bytes)/n << " bytes per " << record_name << " in " << getTagName(tag) << '\n';
+    }
+    os << "Allocate " << static_cast<double>(total.n_allocs)/n << " heap blocks of " << static_cast<double>(total.n_bytes)/n << " bytes per " << record_name << " in total" << '\n';
+    os.precision(precision);
+    os.flags(flags);
+}
+
+}
+
+#ifdef UTK_ALLOCATION_TRACKING
+
+/// Allocate heap memory and count the allocation.
+static void* allocateCounted(std::size_t size)
+{
+    utk::AllocationTracker::countAllocation(size);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+/// Allocate aligned heap memory and count the allocation.
+static void* allocateCounted(std::size_t size, std::align_val_t alignment)
+{
+    utk::AllocationTracker::countAllocation(size);
+    std::size_t align = std::max(static_cast<std::size_t>(alignment), sizeof(void*));
+    void* ptr = nullptr;
+    if(posix_memalign(&ptr, align, size == 0 ? 1 : size) != 0) ptr = nullptr;
+    return ptr;
+}
+
+void* operator new(std::size_t size)
+{
+    if(void* ptr = allocateCounted(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    if(void* ptr = allocateCounted(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocateCounted(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocateCounted(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if(void* ptr = allocateCounted(size, alignment)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    if(void* ptr = allocateCounted(size, alignment)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+#endif
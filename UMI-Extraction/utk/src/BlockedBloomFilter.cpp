@@ -0,0 +1,122 @@
+//
+//  BlockedBloomFilter.cpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#include <cmath>
+#include <algorithm>
+#include <bitset>
+#include <stdexcept>
+#include <utk/CPUFeatures.hpp>
+#include <utk/BlockedBloomFilter.hpp>
+
+namespace utk
+{
+
+namespace
+{
+
+using CountBitsFunction = std::size_t (*)(const std::uint64_t*, std::size_t);
+
+/// Count the bits set in an array of words without POPCNT.
+std::size_t countBitsBaseline(const std::uint64_t* words, std::size_t n_words)
+{
+    std::size_t n_bits {0};
+    for(std::size_t i = 0; i < n_words; ++i) n_bits += std::bitset<64>(words[i]).count();
+    return n_bits;
+}
+
+#ifdef UTK_SIMD_DISPATCH
+
+/// Count the bits set in an array of words with POPCNT.
+UTK_TARGET_SSE42 std::size_t countBitsSSE42(const std::uint64_t* words, std::size_t n_words)
+{
+    std::size_t n_bits {0};
+    for(std::size_t i = 0; i < n_words; ++i) n_bits += static_cast<std::size_t>(__builtin_popcountll(words[i]));
+    return n_bits;
+}
+
+#endif
+
+/// Select the implementation of counting bits for the running CPU, where
+/// POPCNT is the fastest for the 8 words of a block at all levels.
+CountBitsFunction selectCountBits()
+{
+#ifdef UTK_SIMD_DISPATCH
+    if(getSIMDLevel() >= SIMDLevel::sse42) return countBitsSSE42;
+#endif
+    return countBitsBaseline;
+}
+
+/// Implementation selected at startup.
+const CountBitsFunction count_bits = selectCountBits();
+
+}
+
+/// Create a filter for an expected number of distinct values.
+BlockedBloomFilter::BlockedBloomFilter(std::size_t n_expected_values, double false_positive_rate)
+{
+    if(n_expected_values == 0) throw std::logic_error("The expected number of distinct values of Bloom filter must be greater than zero!");
+    if(!(false_positive_rate > 0 && false_positive_rate < 1)) throw std::logic_error("The false positive rate of Bloom filter must be between 0 and 1!");
+
+    // Size a standard Bloom filter with the optimal number of hash functions.
+    const double ln2 = std::log(2.0);
+    double bits_per_value = -std::log(false_positive_rate)/(ln2*ln2);
+    n_hashes = std::clamp<std::size_t>(static_cast<std::size_t>(std::lround(bits_per_value*ln2)), 1, max_n_hashes);
+
+    // Add 20% more bits for the uneven load of blocks.
+    double n_bits = std::ceil(bits_per_value*1.2*static_cast<double>(n_expected_values));
+    std::size_t n_blocks = static_cast<std::size_t>(std::ceil(n_bits/block_bits));
+    blocks.resize(std::max<std::size_t>(n_blocks, 1));
+
+    // Tabulate the false positive rate of a block by its number of bits set.
+    block_rates.resize(block_bits+1);
+    for(std::size_t n_block_bits = 0; n_block_bits <= block_bits; ++n_block_bits)
+    {
+        block_rates[n_block_bits] = std::pow(static_cast<double>(n_block_bits)/block_bits, static_cast<double>(n_hashes));
+    }
+}
+
+/// Insert a hash value into the filter.
+bool BlockedBloomFilter::insert(std::uint64_t hash)
+{
+    // Select the block by the upper half of hash value.
+    Block& block = blocks[static_cast<std::size_t>(((hash >> 32)*blocks.size()) >> 32)];
+    // Derive the bits in the block from the whole hash value.
+    std::uint64_t bits = hash;
+    std::size_t n_new_bits {0};
+    for(std::size_t i = 0; i < n_hashes; ++i)
+    {
+        std::size_t pos = nextBlockBit(bits);
+        std::uint64_t mask = std::uint64_t(1) << (pos % 64);
+        std::uint64_t& word = block.words[pos/64];
+        if((word & mask) == 0)
+        {
+            word |= mask;
+            n_new_bits++;
+        }
+    }
+    if(n_new_bits == 0) return false;
+
+    // Update the false positive rate of the block.
+    std::size_t n_block_bits = count_bits(block.words, block_bits/64);
+    sum_block_rates += block_rates[n_block_bits] - block_rates[n_block_bits-n_new_bits];
+    return true;
+}
+
+/// Check if a hash value is present in the filter, with false positives.
+bool BlockedBloomFilter::contains(std::uint64_t hash) const
+{
+    const Block& block = blocks[static_cast<std::size_t>(((hash >> 32)*blocks.size()) >> 32)];
+    std::uint64_t bits = hash;
+    for(std::size_t i = 0; i < n_hashes; ++i)
+    {
+        std::size_t pos = nextBlockBit(bits);
+        if((block.words[pos/64] & (std::uint64_t(1) << (pos % 64))) == 0) return false;
+    }
+    return true;
+}
+
+}
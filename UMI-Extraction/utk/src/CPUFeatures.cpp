@@ -0,0 +1,89 @@
+//
+//  CPUFeatures.cpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <utk/CPUFeatures.hpp>
+#ifdef UTK_SIMD_DISPATCH
+#include <cpuid.h>
+#endif
+
+namespace utk
+{
+
+#ifdef UTK_SIMD_DISPATCH
+
+/// Read the register states enabled by the operating system.
+static std::uint64_t readXCR0()
+{
+    std::uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<std::uint64_t>(edx) << 32) | eax;
+}
+
+/// Detect the highest SIMD level supported by the CPU and the OS.
+static SIMDLevel detectSIMDLevel()
+{
+    unsigned eax, ebx, ecx, edx;
+    if(!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return SIMDLevel::baseline;
+    if(!(ecx & bit_SSE4_2) || !(ecx & bit_POPCNT)) return SIMDLevel::baseline;
+    // The YMM registers must be saved by the OS, i.e. the XMM and YMM states.
+    if(!(ecx & bit_OSXSAVE) || !(ecx & bit_AVX)) return SIMDLevel::sse42;
+    std::uint64_t xcr0 = readXCR0();
+    if((xcr0 & 0x6) != 0x6) return SIMDLevel::sse42;
+    if(!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return SIMDLevel::sse42;
+    if(!(ebx & bit_AVX2) || !(ebx & bit_BMI) || !(ebx & bit_BMI2)) return SIMDLevel::sse42;
+    // The ZMM registers and mask registers must also be saved by the OS.
+    if(!(ebx & bit_AVX512F) || !(ebx & bit_AVX512DQ) || !(ebx & bit_AVX512BW) || !(ebx & bit_AVX512VL)) return SIMDLevel::avx2;
+    if((xcr0 & 0xe6) != 0xe6) return SIMDLevel::avx2;
+    return SIMDLevel::avx512;
+}
+
+#else
+
+static SIMDLevel detectSIMDLevel()
+{
+    return SIMDLevel::baseline;
+}
+
+#endif
+
+/// Get the SIMD level of the running CPU.
+SIMDLevel getSIMDLevel()
+{
+    static const SIMDLevel simd_level = []
+    {
+        SIMDLevel level = detectSIMDLevel();
+        // Lower the level to the one named by UTK_SIMD_LEVEL.
+        if(const char* level_name = std::getenv("UTK_SIMD_LEVEL"))
+        {
+            for(SIMDLevel lower_level : {SIMDLevel::baseline, SIMDLevel::sse42, SIMDLevel::avx2})
+            {
+                if(lower_level < level && std::strcmp(level_name, getSIMDLevelName(lower_level)) == 0) level = lower_level;
+            }
+        }
+        return level;
+    }();
+    return simd_level;
+}
+
+/// Get the name of a SIMD level.
+const char* getSIMDLevelName(SIMDLevel level)
+{
+    switch(level)
+    {
+        case SIMDLevel::baseline: return "baseline";
+        case SIMDLevel::sse42: return "sse4.2";
+        case SIMDLevel::avx2: return "avx2";
+        case SIMDLevel::avx512: return "avx512";
+    }
+    return "unknown";
+}
+
+}
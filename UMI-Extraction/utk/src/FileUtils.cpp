@@ -9,6 +9,11 @@
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
+#include <cstdio>
+#include <cstdlib>
+#include <glob.h>
+#include <unistd.h>
+#include <sys/stat.h>
 #include <utk/FileUtils.hpp>
 #include <utk/StringUtils.hpp>
 #include <utk/SystemProperties.hpp>
@@ -68,4 +73,76 @@ std::tuple<std::string, std::string> extractFileMainExtNames(const std::string&
     return file_main_ext_names;
 }
 
+/// Check if a file path is a wildcard pattern.
+bool isFilePattern(const std::string& file_path)
+{
+    return file_path.find_first_of("*?[") != std::string::npos;
+}
+
+/// Find all the file paths matching a wildcard pattern in sorted order.
+std::vector<std::string> expandFilePattern(const std::string& file_pattern)
+{
+    std::vector<std::string> file_paths;
+    glob_t glob_result;
+    int status = glob(file_pattern.c_str(), 0, nullptr, &glob_result);
+    if(status == 0)
+    {
+        for(std::size_t i = 0; i < glob_result.gl_pathc; ++i) file_paths.emplace_back(glob_result.gl_pathv[i]);
+    }
+    globfree(&glob_result);
+    if(status != 0 && status != GLOB_NOMATCH)
+    {
+        std::stringstream str;
+        str << "Failed to search for files matching " << file_pattern;
+        throw std::runtime_error(str.str());
+    }
+    return file_paths;
+}
+
+/// Get the size of a file in bytes.
+std::uintmax_t getFileSize(const std::string& file_path)
+{
+    struct stat file_stat;
+    if(stat(file_path.c_str(), &file_stat) != 0)
+    {
+        std::stringstream str;
+        str << "Failed to get the size of " << file_path;
+        throw std::runtime_error(str.str());
+    }
+    return static_cast<std::uintmax_t>(file_stat.st_size);
+}
+
+/// Create an empty temporary file with a unique name.
+std::string createTempFile(const std::string& name_prefix)
+{
+    const char* temp_dir = std::getenv("TMPDIR");
+    std::string file_path = std::string(temp_dir != nullptr && temp_dir[0] != '\0' ? temp_dir : "/tmp") + '/' + name_prefix + ".XXXXXX";
+    int file_desc = mkstemp(file_path.data());
+    if(file_desc < 0)
+    {
+        std::stringstream str;
+        str << "Failed to create temporary file " << file_path;
+        throw std::runtime_error(str.str());
+    }
+    close(file_desc);
+    return file_path;
+}
+
+/// Remove a file, ignoring a file that doesn't exist.
+void removeFile(const std::string& file_path)
+{
+    std::remove(file_path.c_str());
+}
+
+/// Rename a file, replacing the destination file if it exists.
+void renameFile(const std::string& old_file_path, const std::string& new_file_path)
+{
+    if(std::rename(old_file_path.c_str(), new_file_path.c_str()) != 0)
+    {
+        std::stringstream str;
+        str << "Failed to rename " << old_file_path << " to " << new_file_path;
+        throw std::runtime_error(str.str());
+    }
+}
+
 }
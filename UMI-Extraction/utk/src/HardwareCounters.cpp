@@ -0,0 +1,143 @@
+//
+//  HardwareCounters.cpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#include <cerrno>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <utk/HardwareCounters.hpp>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+namespace utk
+{
+
+#ifdef __linux__
+
+/// Type and configuration of the perf event of each counted event.
+static const std::array<std::pair<std::uint32_t, std::uint64_t>, HardwareCounters::n_events> perf_events {{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)}
+}};
+
+HardwareCounters::HardwareCounters(bool inherit)
+{
+    fds.fill(-1);
+    for(std::size_t event = 0; event < n_events; ++event)
+    {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = perf_events[event].first;
+        attr.config = perf_events[event].second;
+        attr.disabled = 1;
+        attr.inherit = inherit ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        fds[event] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if(fds[event] < 0 && unavailable_reason.empty())
+        {
+            unavailable_reason = std::string("perf_event_open of ") + getEventName(event) + " failed: " + std::strerror(errno);
+        }
+    }
+}
+
+HardwareCounters::~HardwareCounters() noexcept
+{
+    for(int fd : fds)
+    {
+        if(fd >= 0) close(fd);
+    }
+}
+
+/// Reset and start all counters.
+void HardwareCounters::start()
+{
+    for(int fd : fds)
+    {
+        if(fd < 0) continue;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+/// Stop all counters.
+void HardwareCounters::stop()
+{
+    for(int fd : fds)
+    {
+        if(fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+}
+
+/// Read all counters.
+HardwareCounters::CountsType HardwareCounters::read() const
+{
+    CountsType counts;
+    counts.fill(std::numeric_limits<double>::quiet_NaN());
+    for(std::size_t event = 0; event < n_events; ++event)
+    {
+        // The value is followed by the times enabled and running.
+        std::uint64_t values[3] {0, 0, 0};
+        if(fds[event] < 0 || ::read(fds[event], values, sizeof(values)) != static_cast<ssize_t>(sizeof(values))) continue;
+        if(values[2] > 0) counts[event] = static_cast<double>(values[0]) * (static_cast<double>(values[1]) / static_cast<double>(values[2]));
+        else if(values[1] == 0) counts[event] = 0;
+    }
+    return counts;
+}
+
+#else
+
+HardwareCounters::HardwareCounters(bool)
+{
+    fds.fill(-1);
+    unavailable_reason = "hardware counters are only supported on Linux";
+}
+
+HardwareCounters::~HardwareCounters() noexcept {}
+
+void HardwareCounters::start() {}
+
+void HardwareCounters::stop() {}
+
+HardwareCounters::CountsType HardwareCounters::read() const
+{
+    CountsType counts;
+    counts.fill(std::numeric_limits<double>::quiet_NaN());
+    return counts;
+}
+
+#endif
+
+/// Get the short name of an event.
+const char* HardwareCounters::getEventName(std::size_t event)
+{
+    static const char* event_names[n_events] = {"cycles", "instructions", "L1D-misses", "LLC-misses", "branch-misses", "dTLB-misses"};
+    return event < n_events ? event_names[event] : "unknown";
+}
+
+/// Check if any counter is available.
+bool HardwareCounters::isAvailable() const
+{
+    for(int fd : fds)
+    {
+        if(fd >= 0) return true;
+    }
+    return false;
+}
+
+}
@@ -0,0 +1,60 @@
+//
+//  HyperLogLog.cpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#include <cmath>
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <utk/HyperLogLog.hpp>
+
+namespace utk
+{
+
+HyperLogLog::HyperLogLog(unsigned precision) : precision{precision}
+{
+    if(precision < min_precision || precision > max_precision)
+    {
+        std::ostringstream err_msg;
+        err_msg << "The precision of HyperLogLog must be between " << min_precision << " and " << max_precision << ", but " << precision << " is given!";
+        throw std::logic_error(err_msg.str());
+    }
+    registers.resize(std::size_t(1) << precision, 0);
+}
+
+/// Merge another sketch of the same precision into this sketch.
+void HyperLogLog::merge(const HyperLogLog& sketch)
+{
+    if(sketch.precision != precision) throw std::logic_error("HyperLogLog sketches of different precisions cannot be merged!");
+    for(std::size_t i = 0; i < registers.size(); ++i) registers[i] = std::max(registers[i], sketch.registers[i]);
+}
+
+/// Estimate the number of distinct hash values inserted.
+double HyperLogLog::estimate() const
+{
+    const double m = static_cast<double>(registers.size());
+    double alpha {0};
+    if(registers.size() == 16) alpha = 0.673;
+    else if(registers.size() == 32) alpha = 0.697;
+    else if(registers.size() == 64) alpha = 0.709;
+    else alpha = 0.7213/(1+1.079/m);
+
+    // Harmonic mean of the registers.
+    double sum {0};
+    std::size_t n_zeros {0};
+    for(auto rank : registers)
+    {
+        sum += std::ldexp(1.0, -static_cast<int>(rank));
+        if(rank == 0) n_zeros++;
+    }
+    double raw_estimate = alpha*m*m/sum;
+
+    // Use linear counting for small cardinalities.
+    if(raw_estimate <= 2.5*m && n_zeros > 0) return m*std::log(m/static_cast<double>(n_zeros));
+    else return raw_estimate;
+}
+
+}
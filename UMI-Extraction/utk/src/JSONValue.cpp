@@ -0,0 +1,319 @@
+//
+//  JSONValue.cpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utk/JSONValue.hpp>
+
+namespace utk
+{
+
+/// \brief A recursive-descent parser of JSON documents.
+class JSONParser
+{
+private:
+
+    /// Maximum nesting depth of arrays and objects.
+    static constexpr std::size_t max_depth {256};
+
+    const std::string& text;
+
+    std::size_t pos {0};
+
+    std::size_t depth {0};
+
+private:
+
+    /// Throw an exception at the current position.
+    [[noreturn]] void fail(const std::string& message) const
+    {
+        throw std::runtime_error("Invalid JSON at offset " + std::to_string(pos) + ": " + message);
+    }
+
+    /// Skip white spaces.
+    void skipSpaces()
+    {
+        while(pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n' || text[pos] == '\r')) ++pos;
+    }
+
+    /// Consume an expected literal.
+    void expect(const char* literal)
+    {
+        for(const char* c = literal; *c != '\0'; ++c, ++pos)
+        {
+            if(pos >= text.size() || text[pos] != *c) fail(std::string("expected ") + literal);
+        }
+    }
+
+    /// Read 4 hexadecimal digits of a \u escape.
+    unsigned readHexDigits()
+    {
+        if(pos+4 > text.size()) fail("incomplete \\u escape");
+        unsigned code = 0;
+        for(std::size_t i = 0; i < 4; ++i, ++pos)
+        {
+            char c = text[pos];
+            code <<= 4;
+            if(c >= '0' && c <= '9') code |= static_cast<unsigned>(c-'0');
+            else if(c >= 'a' && c <= 'f') code |= static_cast<unsigned>(c-'a'+10);
+            else if(c >= 'A' && c <= 'F') code |= static_cast<unsigned>(c-'A'+10);
+            else fail("invalid \\u escape");
+        }
+        return code;
+    }
+
+    /// Append a code point encoded in UTF-8.
+    static void appendUTF8(std::string& str, unsigned code)
+    {
+        if(code < 0x80) str += static_cast<char>(code);
+        else if(code < 0x800)
+        {
+            str += static_cast<char>(0xC0 | (code >> 6));
+            str += static_cast<char>(0x80 | (code & 0x3F));
+        }
+        else if(code < 0x10000)
+        {
+            str += static_cast<char>(0xE0 | (code >> 12));
+            str += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            str += static_cast<char>(0x80 | (code & 0x3F));
+        }
+        else
+        {
+            str += static_cast<char>(0xF0 | (code >> 18));
+            str += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            str += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            str += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    /// Parse a string after its opening quote.
+    std::string parseString()
+    {
+        std::string str;
+        while(true)
+        {
+            if(pos >= text.size()) fail("unterminated string");
+            char c = text[pos++];
+            if(c == '"') return str;
+            if(static_cast<unsigned char>(c) < 0x20) fail("control character in string");
+            if(c != '\\')
+            {
+                str += c;
+                continue;
+            }
+            if(pos >= text.size()) fail("unterminated string");
+            switch(text[pos++])
+            {
+                case '"': str += '"'; break;
+                case '\\': str += '\\'; break;
+                case '/': str += '/'; break;
+                case 'b': str += '\b'; break;
+                case 'f': str += '\f'; break;
+                case 'n': str += '\n'; break;
+                case 'r': str += '\r'; break;
+                case 't': str += '\t'; break;
+                case 'u':
+                {
+                    unsigned code = readHexDigits();
+                    // Combine a surrogate pair into one code point.
+                    if(code >= 0xD800 && code < 0xDC00 && pos+1 < text.size() && text[pos] == '\\' && text[pos+1] == 'u')
+                    {
+                        pos += 2;
+                        unsigned low = readHexDigits();
+                        if(low < 0xDC00 || low >= 0xE000) fail("invalid surrogate pair");
+                        code = 0x10000 + ((code-0xD800) << 10) + (low-0xDC00);
+                    }
+                    appendUTF8(str, code);
+                    break;
+                }
+                default: --pos; fail("invalid escape");
+            }
+        }
+    }
+
+    /// Parse a number.
+    double parseNumber()
+    {
+        std::size_t begin = pos;
+        if(pos < text.size() && text[pos] == '-') ++pos;
+        while(pos < text.size() && ((text[pos] >= '0' && text[pos] <= '9') || text[pos] == '.' || text[pos] == 'e' || text[pos] == 'E' || text[pos] == '+' || text[pos] == '-')) ++pos;
+        std::string number_text = text.substr(begin, pos-begin);
+        char* end = nullptr;
+        double number = std::strtod(number_text.c_str(), &end);
+        if(number_text.empty() || end != number_text.c_str()+number_text.size())
+        {
+            pos = begin;
+            fail("invalid number");
+        }
+        return number;
+    }
+
+    /// Parse a value.
+    JSONValue parseValue()
+    {
+        skipSpaces();
+        if(pos >= text.size()) fail("unexpected end of document");
+        JSONValue value;
+        char c = text[pos];
+        if(c == '{' || c == '[')
+        {
+            if(++depth > max_depth) fail("nesting too deep");
+            ++pos;
+            skipSpaces();
+            char close = c == '{' ? '}' : ']';
+            value.type = c == '{' ? JSONValue::Type::object : JSONValue::Type::array;
+            if(pos < text.size() && text[pos] == close) ++pos;
+            else
+            {
+                while(true)
+                {
+                    if(c == '{')
+                    {
+                        skipSpaces();
+                        expect("\"");
+                        std::string name = parseString();
+                        skipSpaces();
+                        expect(":");
+                        value.object_value.emplace_back(std::move(name), parseValue());
+                    }
+                    else value.array_value.push_back(parseValue());
+                    skipSpaces();
+                    if(pos < text.size() && text[pos] == ',') ++pos;
+                    else if(pos < text.size() && text[pos] == close)
+                    {
+                        ++pos;
+                        break;
+                    }
+                    else fail(std::string("expected , or ") + close);
+                }
+            }
+            --depth;
+        }
+        else if(c == '"')
+        {
+            ++pos;
+            value.type = JSONValue::Type::string;
+            value.string_value = parseString();
+        }
+        else if(c == 't')
+        {
+            expect("true");
+            value.type = JSONValue::Type::boolean;
+            value.bool_value = true;
+        }
+        else if(c == 'f')
+        {
+            expect("false");
+            value.type = JSONValue::Type::boolean;
+        }
+        else if(c == 'n') expect("null");
+        else
+        {
+            value.type = JSONValue::Type::number;
+            value.number_value = parseNumber();
+        }
+        return value;
+    }
+
+public:
+
+    explicit JSONParser(const std::string& text) : text{text} {}
+
+    /// Parse the document as a single value.
+    JSONValue parse()
+    {
+        JSONValue value = parseValue();
+        skipSpaces();
+        if(pos != text.size()) fail("trailing characters");
+        return value;
+    }
+};
+
+/// Check the type of the value.
+void JSONValue::checkType(Type expected_type) const
+{
+    static const char* type_names[] = {"null", "boolean", "number", "string", "array", "object"};
+    if(type != expected_type) throw std::runtime_error(std::string("JSON value is ") + type_names[static_cast<int>(type)] + " instead of " + type_names[static_cast<int>(expected_type)]);
+}
+
+/// Parse a JSON document.
+JSONValue JSONValue::parse(const std::string& text)
+{
+    return JSONParser(text).parse();
+}
+
+/// Read and parse a JSON file.
+JSONValue JSONValue::readFile(const std::string& file_path)
+{
+    std::ifstream file(file_path);
+    if(!file.is_open()) throw std::runtime_error("Cannot open JSON file " + file_path);
+    std::ostringstream text;
+    text << file.rdbuf();
+    try
+    {
+        return parse(text.str());
+    } catch(const std::runtime_error& e)
+    {
+        throw std::runtime_error(std::string(e.what()) + " of " + file_path);
+    }
+}
+
+/// Get the boolean value.
+bool JSONValue::getBool() const
+{
+    checkType(Type::boolean);
+    return bool_value;
+}
+
+/// Get the numeric value.
+double JSONValue::getNumber() const
+{
+    checkType(Type::number);
+    return number_value;
+}
+
+/// Get the string value.
+const std::string& JSONValue::getString() const
+{
+    checkType(Type::string);
+    return string_value;
+}
+
+/// Get the elements of an array value.
+const JSONValue::ArrayType& JSONValue::getArray() const
+{
+    checkType(Type::array);
+    return array_value;
+}
+
+/// Get the members of an object value.
+const JSONValue::ObjectType& JSONValue::getObject() const
+{
+    checkType(Type::object);
+    return object_value;
+}
+
+/// Find a member of an object value.
+const JSONValue* JSONValue::find(const std::string& name) const
+{
+    for(const auto& member : getObject())
+    {
+        if(member.first == name) return &member.second;
+    }
+    return nullptr;
+}
+
+/// Get a member of an object value.
+const JSONValue& JSONValue::at(const std::string& name) const
+{
+    if(const JSONValue* value = find(name)) return *value;
+    throw std::runtime_error("JSON object has no member " + name);
+}
+
+}
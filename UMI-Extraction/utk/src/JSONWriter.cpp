@@ -0,0 +1,137 @@
+//
+//  JSONWriter.cpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <utk/JSONWriter.hpp>
+
+namespace utk
+{
+
+/// Start a new member or element at the current nesting level.
+void JSONWriter::beginItem()
+{
+    // The value of an object member follows its key on the same line.
+    if(key_written)
+    {
+        key_written = false;
+        return;
+    }
+    if(!empty_levels.empty())
+    {
+        if(!empty_levels.back()) os << ',';
+        empty_levels.back() = false;
+        os << '\n' << std::string(2*empty_levels.size(), ' ');
+    }
+}
+
+/// Write a quoted and escaped string.
+void JSONWriter::writeString(const std::string& str)
+{
+    os << '"';
+    for(char c : str)
+    {
+        switch(c)
+        {
+            case '"': os << "\\\""; break;
+            case '\\': os << "\\\\"; break;
+            case '\n': os << "\\n"; break;
+            case '\r': os << "\\r"; break;
+            case '\t': os << "\\t"; break;
+            default:
+                if(static_cast<unsigned char>(c) < 0x20)
+                {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                    os << escaped;
+                }
+                else os << c;
+        }
+    }
+    os << '"';
+}
+
+/// Write a floating-point number, or null for NaN and infinity.
+void JSONWriter::writeNumber(double number)
+{
+    if(std::isfinite(number))
+    {
+        std::streamsize precision = os.precision(std::numeric_limits<double>::digits10);
+        os << number;
+        os.precision(precision);
+    }
+    else os << "null";
+}
+
+/// Begin an object.
+JSONWriter& JSONWriter::beginObject()
+{
+    beginItem();
+    os << '{';
+    empty_levels.push_back(true);
+    return *this;
+}
+
+/// End the current object.
+JSONWriter& JSONWriter::endObject()
+{
+    bool empty = empty_levels.back();
+    empty_levels.pop_back();
+    if(!empty) os << '\n' << std::string(2*empty_levels.size(), ' ');
+    os << '}';
+    if(empty_levels.empty()) os << '\n';
+    return *this;
+}
+
+/// Begin an array.
+JSONWriter& JSONWriter::beginArray()
+{
+    beginItem();
+    os << '[';
+    empty_levels.push_back(true);
+    return *this;
+}
+
+/// End the current array.
+JSONWriter& JSONWriter::endArray()
+{
+    bool empty = empty_levels.back();
+    empty_levels.pop_back();
+    if(!empty) os << '\n' << std::string(2*empty_levels.size(), ' ');
+    os << ']';
+    if(empty_levels.empty()) os << '\n';
+    return *this;
+}
+
+/// Write the key of an object member.
+JSONWriter& JSONWriter::key(const std::string& name)
+{
+    beginItem();
+    writeString(name);
+    os << ": ";
+    key_written = true;
+    return *this;
+}
+
+/// Write a string value.
+JSONWriter& JSONWriter::value(const std::string& str)
+{
+    beginItem();
+    writeString(str);
+    return *this;
+}
+
+/// Write a boolean value.
+JSONWriter& JSONWriter::value(bool flag)
+{
+    beginItem();
+    os << (flag ? "true" : "false");
+    return *this;
+}
+
+}
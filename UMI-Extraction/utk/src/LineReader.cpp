@@ -25,45 +25,80 @@ namespace utk
 LineReader::LineReader() : std::ifstream() {}
 
 LineReader::LineReader(const std::string& file_name_arg, const std::string& line_delim_type_arg) :
-    std::ifstream(file_name_arg),
+    std::ifstream(),
     file_name{file_name_arg},
     line_delim_type{line_delim_type_arg},
     line_delim{widen(FileSystem::line_delims.at(line_delim_type))},
     pre_delim{widen(FileSystem::pre_delims.at(line_delim_type))}
 {
-    checkFileOpen();
+    openStream();
 }
 
 LineReader::LineReader(LineReader&& file) :
     std::ifstream(std::move(file)),
+    stream_buffer{std::move(file.stream_buffer)},
     file_name{std::move(file.file_name)},
     line_delim_type{std::move(file.line_delim_type)},
     line_delim{file.line_delim},
     pre_delim{file.pre_delim},
     file_end{file.file_end},
-    read_failed{file.read_failed}
+    read_failed{file.read_failed},
+    std_stream_buffer{std::move(file.std_stream_buffer)}
 {
+    attachStreamBuffer();
     file.reset();
 }
 
-LineReader::~LineReader() noexcept {}
+LineReader::~LineReader() noexcept
+{
+    // Close the stream before its buffer is released.
+    if(std::ifstream::is_open()) std::ifstream::close();
+}
 
 LineReader& LineReader::operator=(LineReader&& file)
 {
     if(this != &file)
     {
         std::ifstream::operator=(std::move(file));
+        // Replace the buffer over the standard stream before the large
+        // buffer under it.
+        std_stream_buffer = std::move(file.std_stream_buffer);
+        stream_buffer = std::move(file.stream_buffer);
         file_name = std::move(file.file_name);
         line_delim_type = std::move(file.line_delim_type);
         line_delim = file.line_delim;
         pre_delim = file.pre_delim;
         file_end = file.file_end;
         read_failed = file.read_failed;
+        attachStreamBuffer();
         file.reset();
     }
     return *this;
 }
 
+/// Open a file or the standard input stream with a large buffer.
+void LineReader::openStream()
+{
+    if(!stream_buffer) stream_buffer = std::make_unique<char[]>(default_buffer_size);
+    if(FileSystem::isStdStream(file_name)) std_stream_buffer = std::make_unique<StdStreamBuffer>(std::cin.rdbuf(), stream_buffer.get(), default_buffer_size);
+    else
+    {
+        // The buffer must be set before opening the file.
+        rdbuf()->pubsetbuf(stream_buffer.get(), default_buffer_size);
+        std::ifstream::open(file_name);
+    }
+    attachStreamBuffer();
+    checkFileOpen();
+}
+
+/// Switch the stream buffer between the file and the standard input stream.
+void LineReader::attachStreamBuffer()
+{
+    std::ios::iostate state = rdstate();
+    std::ios::rdbuf(std_stream_buffer ? static_cast<std::streambuf*>(std_stream_buffer.get()) : rdbuf());
+    std::ios::clear(state);
+}
+
 /// Check if input file is open.
 void LineReader::checkFileOpen()
 {
@@ -83,6 +118,9 @@ void LineReader::reset()
     line_delim_type.clear();
     line_delim = '\0';
     pre_delim = '\0';
+    // Detach the standard input stream.
+    std_stream_buffer.reset();
+    attachStreamBuffer();
     // Do NOT call resetStream to reset input stream because it's a common
     // system resource so that its change will affect all the objects that
     // operate it.
@@ -92,8 +130,7 @@ void LineReader::reset()
 void LineReader::open(const std::string& file_name_arg, const std::string& line_delim_type_arg)
 {
     file_name = file_name_arg;
-    std::ifstream::open(file_name);
-    checkFileOpen();
+    openStream();
     line_delim_type = line_delim_type_arg;
     line_delim = widen(FileSystem::line_delims.at(line_delim_type));
     pre_delim = widen(FileSystem::pre_delims.at(line_delim_type));
@@ -102,8 +139,8 @@ void LineReader::open(const std::string& file_name_arg, const std::string& line_
 /// Close file.
 void LineReader::close()
 {
-    // Close input file stream.
-    std::ifstream::close();
+    // Close input file stream, but leave the standard input stream open.
+    if(!std_stream_buffer) std::ifstream::close();
     if(fail()) std::cerr << "Error occurred when closing the file " << file_name << " and ignore it!" << '\n';
     // Clear all error state flags of input stream.
     std::ios::clear();
@@ -11,37 +11,72 @@
 #include <iostream>
 #include <stdexcept>
 #include <utk/LineWriter.hpp>
+#include <utk/SystemProperties.hpp>
 
 namespace utk
 {
 
 LineWriter::LineWriter() : std::ofstream() {}
 
-    LineWriter::LineWriter(const std::string& file_name_arg, std::ios::char_type line_delim_arg) : std::ofstream(file_name_arg), file_name{file_name_arg}, line_delim{line_delim_arg}
+    LineWriter::LineWriter(const std::string& file_name_arg, std::ios::char_type line_delim_arg) : std::ofstream(), file_name{file_name_arg}, line_delim{line_delim_arg}
 {
-    checkFileOpen();
+    openStream();
 }
 
-    LineWriter::LineWriter(LineWriter&& file) : std::ofstream(std::move(file)), file_name{std::move(file.file_name)}, line_delim{file.line_delim}, write_failed{file.write_failed}
+    LineWriter::LineWriter(LineWriter&& file) : std::ofstream(std::move(file)), stream_buffer{std::move(file.stream_buffer)}, file_name{std::move(file.file_name)}, line_delim{file.line_delim}, write_failed{file.write_failed}, std_stream_buffer{std::move(file.std_stream_buffer)}
 {
+    attachStreamBuffer();
     file.reset();
 }
 
-LineWriter::~LineWriter() noexcept {}
+LineWriter::~LineWriter() noexcept
+{
+    // Close the stream before its buffer is released.
+    if(std_stream_buffer) flush();
+    else if(std::ofstream::is_open()) std::ofstream::close();
+}
 
 LineWriter& LineWriter::operator=(LineWriter&& file)
 {
     if(this != &file)
     {
         std::ofstream::operator=(std::move(file));
+        // Replace the buffer over the standard stream before the large
+        // buffer under it.
+        std_stream_buffer = std::move(file.std_stream_buffer);
+        stream_buffer = std::move(file.stream_buffer);
         file_name = std::move(file.file_name);
         line_delim = file.line_delim;
         write_failed = file.write_failed;
+        attachStreamBuffer();
         file.reset();
     }
     return *this;
 }
 
+/// Open a file or the standard output stream with a large buffer.
+void LineWriter::openStream()
+{
+    if(!stream_buffer) stream_buffer = std::make_unique<char[]>(default_buffer_size);
+    if(FileSystem::isStdStream(file_name)) std_stream_buffer = std::make_unique<StdStreamBuffer>(std::cout.rdbuf(), stream_buffer.get(), default_buffer_size);
+    else
+    {
+        // The buffer must be set before opening the file.
+        rdbuf()->pubsetbuf(stream_buffer.get(), default_buffer_size);
+        std::ofstream::open(file_name);
+    }
+    attachStreamBuffer();
+    checkFileOpen();
+}
+
+/// Switch the stream buffer between the file and the standard output stream.
+void LineWriter::attachStreamBuffer()
+{
+    std::ios::iostate state = rdstate();
+    std::ios::rdbuf(std_stream_buffer ? static_cast<std::streambuf*>(std_stream_buffer.get()) : rdbuf());
+    std::ios::clear(state);
+}
+
 /// Check if output file is open.
 void LineWriter::checkFileOpen()
 {
@@ -60,6 +95,9 @@ void LineWriter::reset()
     file_name.clear();
     /// Clear line delimiter.
     line_delim = '\0';
+    // Detach the standard output stream.
+    std_stream_buffer.reset();
+    attachStreamBuffer();
     // Do NOT call resetStream to reset output stream because it's a common
     // system resource so that its change will affect all the objects that
     // operate it.
@@ -69,20 +107,22 @@ void LineWriter::reset()
 void LineWriter::open(const std::string& file_name_arg)
 {
     file_name = file_name_arg;
-    std::ofstream::open(file_name);
-    checkFileOpen();
+    // Reset write flags of LineWriter to initial state.
+    resetIOFlags();
+    openStream();
 }
 
 /// Close file.
 void LineWriter::close()
 {
-    // Close output file stream.
-    std::ofstream::close();
-    if(fail()) std::cerr << "Error occurred when closing the file " << file_name << " and ignore it!" << '\n';
+    // Close output file stream, or only flush the standard output stream.
+    if(std_stream_buffer) flush();
+    else std::ofstream::close();
+    // Keep the flag of failed writing for the buffered lines written when
+    // closing, e.g. on a full disk, until the next file is opened.
+    if(fail()) write_failed = true;
     // Clear all error state flags of output stream.
     std::ios::clear();
-    // Reset write flags of LineReader to initial state.
-    resetIOFlags();
     /// Clear all data member about file contents.
     reset();
 }
@@ -0,0 +1,59 @@
+//
+//  MappedFile.cpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#include <sstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <utk/MappedFile.hpp>
+
+namespace utk
+{
+
+MappedFile::MappedFile(const std::string& file_path) : file_path{file_path}
+{
+    int file_desc = open(file_path.c_str(), O_RDONLY);
+    if(file_desc < 0)
+    {
+        std::stringstream str;
+        str << "Failed to open " << file_path << " for mapping";
+        throw std::runtime_error(str.str());
+    }
+    struct stat file_stat;
+    if(fstat(file_desc, &file_stat) != 0)
+    {
+        close(file_desc);
+        std::stringstream str;
+        str << "Failed to get the size of " << file_path;
+        throw std::runtime_error(str.str());
+    }
+    size = static_cast<std::size_t>(file_stat.st_size);
+    // An empty file can't be mapped and has nothing to read.
+    if(size > 0)
+    {
+        void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file_desc, 0);
+        if(addr == MAP_FAILED)
+        {
+            close(file_desc);
+            std::stringstream str;
+            str << "Failed to map " << file_path << " into memory";
+            throw std::runtime_error(str.str());
+        }
+        data = static_cast<const char*>(addr);
+    }
+    // The mapping stays valid after the file is closed.
+    close(file_desc);
+}
+
+MappedFile::~MappedFile() noexcept
+{
+    if(data != nullptr) munmap(const_cast<char*>(data), size);
+}
+
+}
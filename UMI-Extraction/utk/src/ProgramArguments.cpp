@@ -47,6 +47,18 @@ void ProgramArguments::checkNumberOfArguments()
     }
 }
 
+/// Get the command line of all input arguments separated by spaces
+std::string ProgramArguments::getCommandLine() const
+{
+    std::string command_line;
+    for(int i = 0; i < argc; ++i)
+    {
+        if(i > 0) command_line += ' ';
+        command_line += argv[i];
+    }
+    return command_line;
+}
+
 ///// Assign mandatory input arguments
 //void ProgramArguments::assignMandatoryArguments()
 //{
@@ -0,0 +1,144 @@
+//
+//  ProgressReporter.cpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <utk/FileUtils.hpp>
+#include <utk/ProgressReporter.hpp>
+
+namespace utk
+{
+
+/// Format a number of bytes with a binary unit.
+static std::string formatBytes(std::uintmax_t n_bytes)
+{
+    static const char* const units[] {"B", "KB", "MB", "GB", "TB"};
+    double size = static_cast<double>(n_bytes);
+    std::size_t unit = 0;
+    for(; size >= 1024 && unit+1 < sizeof(units)/sizeof(units[0]); ++unit) size /= 1024;
+    std::ostringstream str;
+    str << std::fixed << std::setprecision(unit > 0 ? 1 : 0) << size << ' ' << units[unit];
+    return str.str();
+}
+
+/// Format a number of seconds as hours, minutes, and seconds.
+static std::string formatDuration(double seconds)
+{
+    auto n_seconds = static_cast<std::uintmax_t>(seconds + 0.5);
+    char duration[32];
+    std::snprintf(duration, sizeof(duration), "%ju:%02ju:%02ju", n_seconds/3600, n_seconds/60%60, n_seconds%60);
+    return duration;
+}
+
+ProgressReporter::ProgressReporter(const std::string& task_name, const std::string& record_name, std::uintmax_t n_total_bytes, double interval_seconds, const std::string& status_file_path) : task_name{task_name}, record_name{record_name}, n_total_bytes{n_total_bytes}, interval{interval_seconds}, status_file_path{status_file_path}, start_time{ClockType::now()}, last_report_time{start_time}
+{
+    if(!(interval_seconds > 0)) throw std::logic_error("Interval of progress reports must be positive");
+    timer_thread = std::thread(&ProgressReporter::runTimer, this);
+}
+
+ProgressReporter::~ProgressReporter() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(timer_mutex);
+        stopping = true;
+    }
+    timer_cond.notify_all();
+    if(timer_thread.joinable()) timer_thread.join();
+}
+
+/// Wake up at each interval and report the progress.
+void ProgressReporter::runTimer()
+{
+    std::unique_lock<std::mutex> lock(timer_mutex);
+    while(!timer_cond.wait_for(lock, interval, [this]{ return stopping; }))
+    {
+        lock.unlock();
+        try
+        {
+            report(false);
+        }
+        catch(const std::exception& e)
+        {
+            // A failed report must not stop the task.
+            std::cerr << "Warning: " << e.what() << '!' << std::endl;
+        }
+        // Ask for the memory of the dedup table for the next report.
+        memory_requested.store(true, std::memory_order_relaxed);
+        lock.lock();
+    }
+}
+
+/// Write a report of the progress so far.
+void ProgressReporter::report(bool finished)
+{
+    ClockType::time_point now = ClockType::now();
+    std::uintmax_t records = n_records.load(std::memory_order_relaxed);
+    std::uintmax_t bytes = n_bytes.load(std::memory_order_relaxed);
+    double elapsed_seconds = std::chrono::duration<double>(now-start_time).count();
+    double interval_seconds = std::chrono::duration<double>(now-last_report_time).count();
+    double average_rate = elapsed_seconds > 0 ? static_cast<double>(records)/elapsed_seconds : 0;
+    double current_rate = interval_seconds > 0 && records >= n_last_records ? static_cast<double>(records-n_last_records)/interval_seconds : 0;
+    last_report_time = now;
+    n_last_records = records;
+
+    std::ostringstream report_line;
+    report_line << (finished ? "Finish " : "Progress of ") << task_name << ": " << records << ' ' << record_name;
+    if(n_total_bytes > 0) report_line << ", " << formatBytes(bytes) << " of " << formatBytes(n_total_bytes) << " (" << std::fixed << std::setprecision(1) << 100.0*static_cast<double>(bytes)/static_cast<double>(n_total_bytes) << "%)";
+    else report_line << ", " << formatBytes(bytes);
+    report_line << std::fixed << std::setprecision(0);
+    if(!finished) report_line << ", " << current_rate << ' ' << record_name << "/s now";
+    report_line << ", " << average_rate << ' ' << record_name << "/s on average";
+    report_line << ", elapsed " << formatDuration(elapsed_seconds);
+    // Estimate the time to finish from the average rate of input bytes.
+    if(!finished && n_total_bytes > 0 && bytes > 0 && bytes <= n_total_bytes)
+    {
+        double remaining_seconds = elapsed_seconds*static_cast<double>(n_total_bytes-bytes)/static_cast<double>(bytes);
+        report_line << ", ETA " << formatDuration(remaining_seconds);
+    }
+    if(memory_published.load(std::memory_order_relaxed)) report_line << ", dedup table " << formatBytes(n_memory_bytes.load(std::memory_order_relaxed));
+    writeReport(report_line.str());
+}
+
+/// Write a report line to standard error or the status file.
+void ProgressReporter::writeReport(const std::string& report_line) const
+{
+    if(status_file_path.empty())
+    {
+        // Write the whole line at once to keep the lines of concurrent tasks
+        // apart.
+        std::cerr << report_line + '\n' << std::flush;
+        return;
+    }
+    // Replace the status file only with a complete report.
+    std::string temp_file_path = status_file_path + ".tmp";
+    {
+        std::ofstream status_file(temp_file_path, std::ios::trunc);
+        status_file << report_line << '\n';
+        status_file.close();
+        if(!status_file) throw std::runtime_error("Failed to write status file " + temp_file_path);
+    }
+    renameFile(temp_file_path, status_file_path);
+}
+
+/// Stop the timer thread and write a final report.
+void ProgressReporter::finish()
+{
+    {
+        std::lock_guard<std::mutex> lock(timer_mutex);
+        if(stopping) return;
+        stopping = true;
+    }
+    timer_cond.notify_all();
+    if(timer_thread.joinable()) timer_thread.join();
+    report(true);
+}
+
+}
@@ -0,0 +1,50 @@
+//
+//  ResourceUsage.cpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#include <ctime>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <utk/ResourceUsage.hpp>
+
+namespace utk
+{
+
+/// Read a CPU-time clock in seconds.
+static double getClockSeconds(clockid_t clock_id)
+{
+    timespec time_spec {};
+    if(clock_gettime(clock_id, &time_spec) != 0) return 0;
+    return static_cast<double>(time_spec.tv_sec) + static_cast<double>(time_spec.tv_nsec)*1e-9;
+}
+
+/// CPU time in seconds used by all threads of the calling process.
+double getProcessCPUTime()
+{
+    return getClockSeconds(CLOCK_PROCESS_CPUTIME_ID);
+}
+
+/// CPU time in seconds used by the calling thread.
+double getThreadCPUTime()
+{
+    return getClockSeconds(CLOCK_THREAD_CPUTIME_ID);
+}
+
+/// Peak resident set size in bytes of the calling process.
+std::size_t getPeakResidentSetSize()
+{
+    rusage usage {};
+    if(getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    // macOS reports the size in bytes.
+    return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+    // Linux reports the size in kilobytes.
+    return static_cast<std::size_t>(usage.ru_maxrss)*1024;
+#endif
+}
+
+}
@@ -0,0 +1,62 @@
+//
+//  StdStreamBuffer.cpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#include <utk/StdStreamBuffer.hpp>
+
+namespace utk
+{
+
+StdStreamBuffer::StdStreamBuffer(std::streambuf* std_buffer, char* buffer, std::size_t buffer_size) : std::streambuf(), std_buffer{std_buffer}, buffer{buffer}, buffer_size{buffer_size}
+{
+    // Start with an empty get area and a full put area.
+    setg(buffer, buffer, buffer);
+    setp(buffer, buffer+buffer_size);
+}
+
+StdStreamBuffer::~StdStreamBuffer() noexcept
+{
+    flushBuffer();
+}
+
+/// Write the buffered characters to the standard stream.
+bool StdStreamBuffer::flushBuffer()
+{
+    std::streamsize n_chars = pptr() - pbase();
+    if(n_chars == 0) return true;
+    bool status = std_buffer->sputn(pbase(), n_chars) == n_chars;
+    setp(buffer, buffer+buffer_size);
+    return status;
+}
+
+/// Read a block of characters from the standard stream.
+StdStreamBuffer::int_type StdStreamBuffer::underflow()
+{
+    if(gptr() < egptr()) return traits_type::to_int_type(*gptr());
+    std::streamsize n_chars = std_buffer->sgetn(buffer, static_cast<std::streamsize>(buffer_size));
+    if(n_chars <= 0) return traits_type::eof();
+    setg(buffer, buffer, buffer+n_chars);
+    return traits_type::to_int_type(*gptr());
+}
+
+/// Write the buffered characters and a character to the standard stream.
+StdStreamBuffer::int_type StdStreamBuffer::overflow(int_type c)
+{
+    if(!flushBuffer()) return traits_type::eof();
+    if(traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+    return c;
+}
+
+/// Write the buffered characters to the standard stream and flush it.
+int StdStreamBuffer::sync()
+{
+    if(!flushBuffer()) return -1;
+    return std_buffer->pubsync();
+}
+
+}
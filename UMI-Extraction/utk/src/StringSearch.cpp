@@ -0,0 +1,245 @@
+//
+//  StringSearch.cpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#include <cstdint>
+#include <cstring>
+#include <utk/CPUFeatures.hpp>
+#ifdef UTK_SIMD_DISPATCH
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include <utk/StringSearch.hpp>
+
+namespace utk
+{
+
+namespace
+{
+
+using FindLastSubstringFunction = std::size_t (*)(std::string_view, std::string_view);
+
+using FindCharPositionsFunction = void (*)(std::string_view, char, std::vector<std::size_t>&);
+
+/// Compare the middle characters at the candidate positions of a block marked
+/// by the mask, whose first and last characters both match, from the end.
+inline std::size_t matchBlock(std::string_view text, std::string_view pattern, std::size_t block_begin, std::uint64_t mask)
+{
+    const std::size_t n_pattern_chars = pattern.size();
+    while(mask != 0)
+    {
+        unsigned bit = 63 - static_cast<unsigned>(__builtin_clzll(mask));
+        const char* candidate = text.data() + block_begin + bit;
+        std::size_t i = 1;
+        while(i < n_pattern_chars - 1 && candidate[i] == pattern[i]) ++i;
+        if(i == n_pattern_chars - 1) return block_begin + bit;
+        mask &= ~(std::uint64_t(1) << bit);
+    }
+    return std::string_view::npos;
+}
+
+/// Append the positions of a block marked by the mask in increasing order.
+inline void appendMaskPositions(std::size_t block_begin, std::uint64_t mask, std::vector<std::size_t>& positions)
+{
+    while(mask != 0)
+    {
+        positions.push_back(block_begin + static_cast<std::size_t>(__builtin_ctzll(mask)));
+        mask &= mask - 1;
+    }
+}
+
+/// Append the positions of a character from a position to the end of text.
+inline void appendCharPositions(std::string_view text, std::size_t begin, char c, std::vector<std::size_t>& positions)
+{
+    for(std::size_t i = begin; i < text.size(); ++i)
+    {
+        if(text[i] == c) positions.push_back(i);
+    }
+}
+
+/// Find the last occurrence of a substring with SSE2, or without SIMD.
+std::size_t findLastSubstringBaseline(std::string_view text, std::string_view pattern)
+{
+    const std::size_t n_pattern_chars = pattern.size();
+    if(n_pattern_chars < 2 || n_pattern_chars > text.size()) return text.rfind(pattern);
+#if defined(__SSE2__)
+    if(const std::size_t n_text_candidates = text.size() - n_pattern_chars + 1; n_text_candidates >= 16)
+    {
+        const __m128i first_chars = _mm_set1_epi8(pattern.front());
+        const __m128i last_chars = _mm_set1_epi8(pattern.back());
+        auto findMatches = [&](std::size_t block_begin)
+        {
+            __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + block_begin));
+            __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + block_begin + n_pattern_chars - 1));
+            return static_cast<std::uint64_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(block_first, first_chars), _mm_cmpeq_epi8(block_last, last_chars))));
+        };
+        // Check the candidate positions in blocks of 16 from the end, and
+        // the remaining positions with a block at the beginning that
+        // overlaps the checked positions.
+        std::size_t n_candidates = n_text_candidates;
+        for(; n_candidates >= 16; n_candidates -= 16)
+        {
+            if(std::size_t pos = matchBlock(text, pattern, n_candidates - 16, findMatches(n_candidates - 16)); pos != std::string_view::npos) return pos;
+        }
+        if(n_candidates == 0) return std::string_view::npos;
+        return matchBlock(text, pattern, 0, findMatches(0) & ((std::uint64_t(1) << n_candidates) - 1));
+    }
+#endif
+    return text.rfind(pattern);
+}
+
+/// Find the positions of a character with SSE2, or without SIMD.
+void findCharPositionsBaseline(std::string_view text, char c, std::vector<std::size_t>& positions)
+{
+    std::size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i chars = _mm_set1_epi8(c);
+    for(; i + 16 <= text.size(); i += 16)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + i));
+        appendMaskPositions(i, static_cast<std::uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, chars))), positions);
+    }
+#endif
+    appendCharPositions(text, i, c, positions);
+}
+
+#ifdef UTK_SIMD_DISPATCH
+
+/// Find the candidate positions of a block of 32 whose first and last
+/// characters both match.
+UTK_TARGET_AVX2 inline std::uint64_t findMatchesAVX2(const char* block_first_chars, std::size_t n_pattern_chars, __m256i first_chars, __m256i last_chars)
+{
+    __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block_first_chars));
+    __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block_first_chars + n_pattern_chars - 1));
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(block_first, first_chars), _mm256_cmpeq_epi8(block_last, last_chars))));
+}
+
+/// Find the last occurrence of a substring in blocks of 32 with AVX2.
+UTK_TARGET_AVX2 std::size_t findLastSubstringAVX2(std::string_view text, std::string_view pattern)
+{
+    const std::size_t n_pattern_chars = pattern.size();
+    if(n_pattern_chars < 2 || n_pattern_chars > text.size()) return text.rfind(pattern);
+    const std::size_t n_text_candidates = text.size() - n_pattern_chars + 1;
+    if(n_text_candidates < 32) return findLastSubstringBaseline(text, pattern);
+    const __m256i first_chars = _mm256_set1_epi8(pattern.front());
+    const __m256i last_chars = _mm256_set1_epi8(pattern.back());
+    std::size_t n_candidates = n_text_candidates;
+    for(; n_candidates >= 32; n_candidates -= 32)
+    {
+        if(std::size_t pos = matchBlock(text, pattern, n_candidates - 32, findMatchesAVX2(text.data() + n_candidates - 32, n_pattern_chars, first_chars, last_chars)); pos != std::string_view::npos) return pos;
+    }
+    if(n_candidates == 0) return std::string_view::npos;
+    return matchBlock(text, pattern, 0, findMatchesAVX2(text.data(), n_pattern_chars, first_chars, last_chars) & ((std::uint64_t(1) << n_candidates) - 1));
+}
+
+/// Find the positions of a character in blocks of 32 with AVX2.
+UTK_TARGET_AVX2 void findCharPositionsAVX2(std::string_view text, char c, std::vector<std::size_t>& positions)
+{
+    const __m256i chars = _mm256_set1_epi8(c);
+    std::size_t i = 0;
+    for(; i + 32 <= text.size(); i += 32)
+    {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text.data() + i));
+        appendMaskPositions(i, static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, chars))), positions);
+    }
+    appendCharPositions(text, i, c, positions);
+}
+
+/// Find the candidate positions of a block of 64 whose first and last
+/// characters both match.
+UTK_TARGET_AVX512 inline std::uint64_t findMatchesAVX512(const char* block_first_chars, std::size_t n_pattern_chars, __m512i first_chars, __m512i last_chars)
+{
+    __m512i block_first = _mm512_loadu_si512(block_first_chars);
+    __m512i block_last = _mm512_loadu_si512(block_first_chars + n_pattern_chars - 1);
+    return _mm512_cmpeq_epi8_mask(block_first, first_chars) & _mm512_cmpeq_epi8_mask(block_last, last_chars);
+}
+
+/// Find the last occurrence of a substring in blocks of 64 with AVX-512.
+UTK_TARGET_AVX512 std::size_t findLastSubstringAVX512(std::string_view text, std::string_view pattern)
+{
+    const std::size_t n_pattern_chars = pattern.size();
+    if(n_pattern_chars < 2 || n_pattern_chars > text.size()) return text.rfind(pattern);
+    const std::size_t n_text_candidates = text.size() - n_pattern_chars + 1;
+    if(n_text_candidates < 64) return findLastSubstringAVX2(text, pattern);
+    const __m512i first_chars = _mm512_set1_epi8(pattern.front());
+    const __m512i last_chars = _mm512_set1_epi8(pattern.back());
+    std::size_t n_candidates = n_text_candidates;
+    for(; n_candidates >= 64; n_candidates -= 64)
+    {
+        if(std::size_t pos = matchBlock(text, pattern, n_candidates - 64, findMatchesAVX512(text.data() + n_candidates - 64, n_pattern_chars, first_chars, last_chars)); pos != std::string_view::npos) return pos;
+    }
+    if(n_candidates == 0) return std::string_view::npos;
+    return matchBlock(text, pattern, 0, findMatchesAVX512(text.data(), n_pattern_chars, first_chars, last_chars) & ((std::uint64_t(1) << n_candidates) - 1));
+}
+
+/// Find the positions of a character in blocks of 64 with AVX-512, and the
+/// remaining characters with a masked block.
+UTK_TARGET_AVX512 void findCharPositionsAVX512(std::string_view text, char c, std::vector<std::size_t>& positions)
+{
+    const __m512i chars = _mm512_set1_epi8(c);
+    std::size_t i = 0;
+    for(; i + 64 <= text.size(); i += 64)
+    {
+        appendMaskPositions(i, _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(text.data() + i), chars), positions);
+    }
+    if(i < text.size())
+    {
+        __mmask64 tail_mask = _bzhi_u64(~std::uint64_t(0), static_cast<unsigned>(text.size() - i));
+        appendMaskPositions(i, _mm512_mask_cmpeq_epi8_mask(tail_mask, _mm512_maskz_loadu_epi8(tail_mask, text.data() + i), chars), positions);
+    }
+}
+
+#endif
+
+/// Select the implementation of findLastSubstring for the running CPU. The
+/// SSE2 implementation is used below AVX2, since SSE4.2 adds nothing to it.
+FindLastSubstringFunction selectFindLastSubstring()
+{
+#ifdef UTK_SIMD_DISPATCH
+    switch(getSIMDLevel())
+    {
+        case SIMDLevel::avx512: return findLastSubstringAVX512;
+        case SIMDLevel::avx2: return findLastSubstringAVX2;
+        default: break;
+    }
+#endif
+    return findLastSubstringBaseline;
+}
+
+/// Select the implementation of findCharPositions for the running CPU.
+FindCharPositionsFunction selectFindCharPositions()
+{
+#ifdef UTK_SIMD_DISPATCH
+    switch(getSIMDLevel())
+    {
+        case SIMDLevel::avx512: return findCharPositionsAVX512;
+        case SIMDLevel::avx2: return findCharPositionsAVX2;
+        default: break;
+    }
+#endif
+    return findCharPositionsBaseline;
+}
+
+/// Implementations selected at startup.
+const FindLastSubstringFunction find_last_substring = selectFindLastSubstring();
+const FindCharPositionsFunction find_char_positions = selectFindCharPositions();
+
+}
+
+/// Find the last occurrence of a substring in a text.
+std::size_t findLastSubstring(std::string_view text, std::string_view pattern)
+{
+    return find_last_substring(text, pattern);
+}
+
+/// Find the positions of all occurrences of a character in a text.
+void findCharPositions(std::string_view text, char c, std::vector<std::size_t>& positions)
+{
+    find_char_positions(text, c, positions);
+}
+
+}
@@ -11,18 +11,47 @@
 #include <cstring>
 #include <stdexcept>
 #include <algorithm>
+#include <utk/StringSearch.hpp>
 #include <utk/StringUtils.hpp>
 
 namespace utk
 {
 
+/// Check if a character matches only itself as a regex.
+static bool isLiteralRegexChar(char c)
+{
+    return c != '\0' && std::strchr("^$\\.*+?()[]{}|", c) == nullptr;
+}
+
+/// Split a string at each occurrence of a character, which gives the same
+/// parts as the regex split without building a regex.
+static std::vector<std::string> splitStringAtChar(const std::string& str, char sep)
+{
+    // Reuse the positions of separators across calls of each thread.
+    static thread_local std::vector<std::size_t> sep_positions;
+    sep_positions.clear();
+    findCharPositions(str, sep, sep_positions);
+    std::vector<std::string> parts;
+    parts.reserve(sep_positions.size()+1);
+    std::size_t part_begin = 0;
+    for(std::size_t sep_pos : sep_positions)
+    {
+        parts.emplace_back(str, part_begin, sep_pos-part_begin);
+        part_begin = sep_pos+1;
+    }
+    parts.emplace_back(str, part_begin, str.size()-part_begin);
+    return parts;
+}
+
 /// Split a string using a specified separator.
 std::vector<std::string> splitString(const std::string& str, const std::string& sep)
 {
     std::vector<std::string> parts;
     if(!str.empty())
     {
-        if(sep.length() > 0)
+        // A single literal character is split without regex.
+        if(sep.length() == 1 && isLiteralRegexChar(sep.front())) parts = splitStringAtChar(str, sep.front());
+        else if(sep.length() > 0)
         {
             if(sep != "|")
             {
@@ -45,6 +45,10 @@ const std::map<const std::string, const char> FileSystem::line_delims = { {"wind
 const std::map<const std::string, const char> FileSystem::pre_delims = { {"windows",'\r'}, {"unix",'\0'}, {"macintosh",'\0'}, {"unknown",'\0'} };
 /// Initialize table of environment variables for user home directory
 const std::map<const std::string, const std::string> FileSystem::home_vars = { {"windows","USERPROFILE"}, {"unix","HOME"}, {"macintosh","HOME"}, {"unknown",""} };
+/// Initialize table of paths of standard input stream
+const std::map<const std::string, const std::string> FileSystem::std_input_paths = { {"windows","CONIN$"}, {"unix","/dev/stdin"}, {"macintosh","/dev/stdin"}, {"unknown",""} };
+/// Initialize table of paths of standard output stream
+const std::map<const std::string, const std::string> FileSystem::std_output_paths = { {"windows","CONOUT$"}, {"unix","/dev/stdout"}, {"macintosh","/dev/stdout"}, {"unknown",""} };
 
 /// Initialize path separator in current operating system
 const char FileSystem::path_sep {FileSystem::path_seps.at(OperatingSystem::type)};
@@ -58,6 +62,13 @@ const std::string FileSystem::home_var {FileSystem::home_vars.at(OperatingSystem
 /// Initialize user home directory in current operating system
 const std::string FileSystem::home_dir{initHomeDir(FileSystem::home_var)};
 
+/// Initialize file name standing for standard input or standard output
+const std::string FileSystem::std_stream_name {"-"};
+/// Initialize path of standard input stream in current operating system
+const std::string FileSystem::std_input_path {FileSystem::std_input_paths.at(OperatingSystem::type)};
+/// Initialize path of standard output stream in current operating system
+const std::string FileSystem::std_output_path {FileSystem::std_output_paths.at(OperatingSystem::type)};
+
 /// Initialize user home directory from environment variable
 std::string FileSystem::initHomeDir(const std::string& home_var_arg)
 {
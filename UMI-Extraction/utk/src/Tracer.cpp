@@ -0,0 +1,151 @@
+//
+//  Tracer.cpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+#include <utk/JSONWriter.hpp>
+#include <utk/Tracer.hpp>
+
+namespace utk
+{
+
+/// A begin or end event of a span.
+struct TraceEvent
+{
+    const char* name;
+    std::int64_t timestamp;
+    bool begin;
+};
+
+/// Ring buffer of the events of a thread, which is only written by its own
+/// thread and outlives the thread until the end of the program.
+struct ThreadTrace
+{
+    std::size_t thread_id {0};
+    std::string thread_name;
+    std::vector<TraceEvent> events;
+    std::atomic<std::uint64_t> n_events {0};
+};
+
+/// Ring buffers of all threads that have recorded an event.
+static std::vector<std::unique_ptr<ThreadTrace>> thread_traces;
+
+static std::mutex trace_mutex;
+
+/// Ring buffer of the calling thread, created on its first event.
+static thread_local ThreadTrace* thread_trace {nullptr};
+
+/// Get the ring buffer of the calling thread, registering it on first use.
+static ThreadTrace& getThreadTrace()
+{
+    if(thread_trace == nullptr)
+    {
+        auto trace = std::make_unique<ThreadTrace>();
+        trace->events.resize(Tracer::buffer_capacity);
+        std::lock_guard<std::mutex> lock(trace_mutex);
+        trace->thread_id = thread_traces.size();
+        thread_trace = trace.get();
+        thread_traces.push_back(std::move(trace));
+    }
+    return *thread_trace;
+}
+
+/// Append an event to the ring buffer of the calling thread.
+static void recordEvent(const char* name, bool begin)
+{
+    std::int64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    ThreadTrace& trace = getThreadTrace();
+    std::uint64_t n = trace.n_events.load(std::memory_order_relaxed);
+    trace.events[n%Tracer::buffer_capacity] = {name, timestamp, begin};
+    trace.n_events.store(n+1, std::memory_order_release);
+}
+
+/// Record the beginning of a span in the calling thread.
+void Tracer::begin(const char* name)
+{
+    recordEvent(name, true);
+}
+
+/// Record the end of the innermost span in the calling thread.
+void Tracer::end(const char* name)
+{
+    recordEvent(name, false);
+}
+
+/// Name the calling thread in the trace.
+void Tracer::setThreadName(const std::string& name)
+{
+    ThreadTrace& trace = getThreadTrace();
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    trace.thread_name = name;
+}
+
+/// Write the events of all threads as a Chrome trace document.
+void Tracer::writeChromeTrace(std::ostream& os)
+{
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    // The range of events kept in the ring buffer of each thread.
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> event_ranges;
+    std::int64_t start_timestamp = std::numeric_limits<std::int64_t>::max();
+    for(const auto& trace : thread_traces)
+    {
+        std::uint64_t n_events = trace->n_events.load(std::memory_order_acquire);
+        std::uint64_t first_event = n_events > buffer_capacity ? n_events-buffer_capacity : 0;
+        event_ranges.emplace_back(first_event, n_events);
+        if(first_event < n_events) start_timestamp = std::min(start_timestamp, trace->events[first_event%buffer_capacity].timestamp);
+    }
+
+    // Timestamps are in microseconds since the earliest event kept.
+    JSONWriter writer(os);
+    writer.beginObject();
+    writer.key("traceEvents").beginArray();
+    for(std::size_t n = 0; n < thread_traces.size(); ++n)
+    {
+        const ThreadTrace& trace = *thread_traces[n];
+        std::string thread_name = trace.thread_name.empty() ? "thread " + std::to_string(trace.thread_id) : trace.thread_name;
+        writer.beginObject();
+        writer.member("name", "thread_name").member("ph", "M").member("pid", 1).member("tid", trace.thread_id);
+        writer.key("args").beginObject().member("name", thread_name).endObject();
+        writer.endObject();
+        std::size_t depth = 0;
+        for(std::uint64_t i = event_ranges[n].first; i < event_ranges[n].second; ++i)
+        {
+            const TraceEvent& event = trace.events[i%buffer_capacity];
+            // Drop the end events of the spans begun before the oldest event.
+            if(event.begin) ++depth;
+            else if(depth == 0) continue;
+            else --depth;
+            writer.beginObject();
+            writer.member("name", event.name).member("ph", event.begin ? "B" : "E");
+            writer.member("ts", static_cast<double>(event.timestamp-start_timestamp)/1000);
+            writer.member("pid", 1).member("tid", trace.thread_id);
+            writer.endObject();
+        }
+    }
+    writer.endArray();
+    writer.member("displayTimeUnit", "ms");
+    writer.endObject();
+}
+
+/// Write the events of all threads as a Chrome trace file.
+void Tracer::writeChromeTrace(const std::string& file_path)
+{
+    std::ofstream trace_file(file_path);
+    if(!trace_file.is_open()) throw std::runtime_error("Cannot open output file " + file_path);
+    writeChromeTrace(trace_file);
+    if(!trace_file) throw std::runtime_error("Cannot write output file " + file_path);
+}
+
+}
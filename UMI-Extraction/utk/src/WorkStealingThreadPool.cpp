@@ -0,0 +1,142 @@
+//
+//  WorkStealingThreadPool.cpp
+//  Universal-Toolkit
+//
+//  Created on 10/18/26.
+//
+
+#include <utility>
+#include <utk/WorkStealingThreadPool.hpp>
+
+namespace utk
+{
+
+namespace
+{
+
+/// Index of the pool worker running on the current thread.
+thread_local const WorkStealingThreadPool* current_pool {nullptr};
+thread_local std::size_t current_worker {0};
+
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool(std::size_t n_threads)
+{
+    if(n_threads == 0) n_threads = std::thread::hardware_concurrency();
+    if(n_threads == 0) n_threads = 1;
+    for(std::size_t n = 0; n < n_threads; ++n) worker_queues.push_back(std::make_unique<WorkerQueue>());
+    for(std::size_t n = 0; n < n_threads; ++n) worker_threads.emplace_back(&WorkStealingThreadPool::runWorker, this, n);
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() noexcept
+{
+    {
+        std::unique_lock<std::mutex> lock(pool_mutex);
+        done_cond.wait(lock, [this]{ return n_unfinished_tasks == 0; });
+        stopping = true;
+    }
+    task_cond.notify_all();
+    for(auto& worker_thread : worker_threads) worker_thread.join();
+}
+
+/// Add a task to the pool.
+void WorkStealingThreadPool::submit(TaskType task)
+{
+    std::size_t queue;
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        n_unfinished_tasks++;
+        if(current_pool == this) queue = current_worker;
+        else
+        {
+            queue = next_queue;
+            next_queue = (next_queue+1) % worker_queues.size();
+        }
+    }
+    {
+        WorkerQueue& worker_queue = *worker_queues[queue];
+        std::lock_guard<std::mutex> lock(worker_queue.queue_mutex);
+        worker_queue.tasks.push_back(std::move(task));
+        n_queued_tasks++;
+    }
+    // Notify under lock so that an idle worker cannot miss the new task.
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    task_cond.notify_one();
+}
+
+/// Take a task from the own queue of a worker or steal one from others.
+bool WorkStealingThreadPool::takeTask(std::size_t worker, TaskType& task)
+{
+    std::size_t n_queues = worker_queues.size();
+    for(std::size_t n = 0; n < n_queues; ++n)
+    {
+        std::size_t queue = (worker+n) % n_queues;
+        WorkerQueue& worker_queue = *worker_queues[queue];
+        std::lock_guard<std::mutex> lock(worker_queue.queue_mutex);
+        if(!worker_queue.tasks.empty())
+        {
+            // Take own task from the back and steal from the front.
+            if(queue == worker)
+            {
+                task = std::move(worker_queue.tasks.back());
+                worker_queue.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(worker_queue.tasks.front());
+                worker_queue.tasks.pop_front();
+            }
+            n_queued_tasks--;
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Run tasks in a worker thread until the pool is stopped.
+void WorkStealingThreadPool::runWorker(std::size_t worker)
+{
+    current_pool = this;
+    current_worker = worker;
+    for(TaskType task;;)
+    {
+        if(takeTask(worker, task))
+        {
+            n_busy_workers++;
+            try
+            {
+                task();
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock(pool_mutex);
+                if(!task_error) task_error = std::current_exception();
+            }
+            task = nullptr;
+            n_busy_workers--;
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            if(--n_unfinished_tasks == 0) done_cond.notify_all();
+        }
+        else
+        {
+            std::unique_lock<std::mutex> lock(pool_mutex);
+            task_cond.wait(lock, [this]{ return stopping || n_queued_tasks.load() > 0; });
+            if(stopping && n_queued_tasks.load() == 0) break;
+        }
+    }
+}
+
+/// Wait until all submitted tasks are finished.
+void WorkStealingThreadPool::wait()
+{
+    std::unique_lock<std::mutex> lock(pool_mutex);
+    done_cond.wait(lock, [this]{ return n_unfinished_tasks == 0; });
+    if(task_error)
+    {
+        std::exception_ptr error = task_error;
+        task_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+}